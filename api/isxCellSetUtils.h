@@ -1,6 +1,7 @@
 #ifndef ISX_CELL_SET_UTILS_H
 #define ISX_CELL_SET_UTILS_H
 
+#include "isxCore.h"
 #include "isxCoreFwd.h"
 
 namespace isx
@@ -16,13 +17,16 @@ namespace isx
     /// \param  inNormalizedThreshold   If inNormalizeImages == true, threshold the image after normalization,
     ///                                 zeroing out any values that are less than inNormalizeThreshold, which should
     ///                                 be between 0 and 1.
+    /// \param  inMaxNumThreads         The maximum number of threads used to accumulate the cell images,
+    ///                                 or 0 to use the number of hardware threads.
     /// \return                         The cell map.
     SpImage_t
     cellSetToCellMap(
         const SpCellSet_t & inCellSet,
         bool inAcceptedCellsOnly,
         bool inNormalizeImages,
-        float inNormalizedThreshold = 0.0f);
+        float inNormalizedThreshold = 0.0f,
+        isize_t inMaxNumThreads = 0);
 
     /// Gets the min and max values from an image.
     ///
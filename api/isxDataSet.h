@@ -129,6 +129,15 @@ public:
     /// \throw  ExceptionDataIO If the string cannot be parsed.
     static std::shared_ptr<DataSet> fromJsonString(const std::string & inString, const std::string & inAbsolutePathToPrepend = std::string());
 
+    /// Create a data set from a JSON tree.
+    ///
+    /// \param  inJson      The JSON tree.
+    /// \param  inAbsolutePathToPrepend The path the is preprended to any relative filenames in the dataset
+    /// \return             The deserialized data set, or nullptr if the tree is an empty object.
+    ///
+    /// \throw  ExceptionDataIO If the tree does not represent a data set.
+    static std::shared_ptr<DataSet> fromJson(const nlohmann::json & inJson, const std::string & inAbsolutePathToPrepend = std::string());
+
     /// \return The timing info associated with this data set.
     ///
     /// \throw  ExceptionFileIO If the data set file cannot be read.
@@ -165,8 +174,16 @@ public:
     void setModified();
 
     /// \return JSON representation of this DataSet
+    ///
+    /// If the meta data of the file has been read, it is included along with
+    /// the size and modification time of the file, so that it can be restored
+    /// without reading the file again if the file has not changed.
     std::string toJsonString(const bool inPretty = false, const std::string & inPathToOmit = std::string()) const;
 
+    /// \return The JSON tree of this DataSet, which is what toJsonString formats.
+    /// \param  inPathToOmit the path from filenames to omit for serialization (to obtain relative paths)
+    nlohmann::json toJson(const std::string & inPathToOmit = std::string()) const;
+
     /// \return Whether this DataSet is equal to another given DataSet
     /// \param other Other DataSet
     ///
@@ -249,6 +266,15 @@ private:
     /// True if the meta data has been read.
     bool m_hasMetaData = false;
 
+    /// The size of the file when its meta data was last read, or -1 if unknown.
+    /// Together with the modification time, this is saved in the project so
+    /// that the meta data can be restored without opening an unchanged file.
+    int64_t m_metaDataFileSize = -1;
+
+    /// The modification time of the file in milliseconds since the Unix epoch
+    /// when its meta data was last read.
+    int64_t m_metaDataFileModifiedMs = 0;
+
     /// True if this was imported, false otherwise.
     /// Imported data sets should not delete the files they own.
     bool m_imported = true;
@@ -261,10 +287,17 @@ private:
 
     /// Read the meta data from the data set file.
     ///
+    /// If the file has not changed since the meta data was last read or
+    /// restored from a project, this does not open the file.
+    ///
     /// \throw  ExceptionFileIO     If the read fails.
     /// \throw  ExceptionDataIO     If the file format is not recognized.
     void readMetaData();
 
+    /// Forget the size and modification time of the file, so the meta
+    /// data is read again from the file next time it is requested.
+    void invalidateMetaDataCache();
+
 }; // class DataSet
 
 /// Get the Inscopix DataSet type of a file.
@@ -115,6 +115,34 @@ public:
     void
     getLogicalDataAsync(const std::string & inCellName, EventsGetLogicalDataCB_t inCallback) = 0;
 
+    /// Get the logical traces of all cells within a time window.
+    ///
+    /// By default this calls getLogicalData for each cell, but implementations
+    /// read the data of all cells at once when the file format allows it.
+    ///
+    /// \param  inStartMicroSecs    The start of the time window in microseconds from the start
+    ///                             of the timing info.
+    /// \param  inEndMicroSecs      The end of the time window, which is excluded.
+    /// \return                     The values of each cell in the order of getCellNamesList,
+    ///                             with offsets from the start of the timing info.
+    virtual
+    LogicalTraceTable
+    getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs);
+
+    /// Get the logical trace of a cell within a time window.
+    ///
+    /// By default this filters the result of getLogicalData, but implementations
+    /// only read the data within the window when the file format allows it.
+    ///
+    /// \param  inCellName  The name of the requested cell (as returned by getCellNamesList()).
+    /// \param  inStartTime The start of the time window.
+    /// \param  inEndTime   The end of the time window, which is excluded.
+    /// \return             The logical trace of the cell within the time window, or nullptr
+    ///                     if the file doesn't contain data for that cell.
+    virtual
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inCellName, const Time & inStartTime, const Time & inEndTime);
+
     /// \return     The timing information read from the Events set.
     ///             Depending on the signal, you may not want to trust the step and number
     ///             of times, as they may simply spoofing until we have a proper way to
@@ -19,6 +19,7 @@ struct EventsExporterParams
     /// \param inAutoOutputProps     if true, automatically output a properties file
     /// \param inWriteSparseOutput   if true, produce sparse output, otherwise produce dense output
     /// \param inWriteAmplitude      if true, write amplitude of event, otherwise write boolean value
+    /// \param inTraceFileFormat     the files to write, where NumPy files require sparse output
     EventsExporterParams(
         const std::vector<SpEvents_t> & inSrcs,
         const std::string & inFileName,
@@ -26,7 +27,8 @@ struct EventsExporterParams
         const std::string & inPropertiesFilename = "",
         const bool inAutoOutputProps = false,
         const bool inWriteSparseOutput = true,
-        const bool inWriteAmplitude = true)
+        const bool inWriteAmplitude = true,
+        const TraceFileFormat inTraceFileFormat = TraceFileFormat::CSV)
     : m_srcs(inSrcs)
     , m_fileName(inFileName)
     , m_writeTimeRelativeTo(inWriteTimeRelativeTo)
@@ -34,6 +36,7 @@ struct EventsExporterParams
     , m_autoOutputProps(inAutoOutputProps)
     , m_writeSparseOutput(inWriteSparseOutput)
     , m_writeAmplitude(inWriteAmplitude)
+    , m_traceFileFormat(inTraceFileFormat)
     {
     }
 
@@ -62,6 +65,10 @@ struct EventsExporterParams
     ///
     std::vector<std::string> getOutputFilePaths() const;
 
+    /// \return The path of the NumPy file next to the CSV file.
+    ///
+    std::string getNpyFilePath() const;
+
     std::vector<SpEvents_t> m_srcs;                 ///< input event sets
     std::string             m_fileName;             ///< name of output file
     WriteTimeRelativeTo     m_writeTimeRelativeTo;  ///< how to write time stamps in file
@@ -77,6 +84,10 @@ struct EventsExporterParams
                                                     ///< where events occur, 
     bool                    m_writeAmplitude;       ///< If true, write events with their amplitude.
                                                     ///< Otherwise, write a boolean value.
+    TraceFileFormat         m_traceFileFormat;      ///< The files to write. NumPy files contain the same
+                                                    ///< values as the sparse CSV output, so require it.
+                                                    ///< When only writing a NumPy file, it is written to
+                                                    ///< m_fileName, otherwise next to it with a .npy extension.
 };
 
 /// There are no output parameters for exporting events.
@@ -24,6 +24,16 @@ enum class WriteTimeRelativeTo
 };
 /// \endcond doxygen chokes on enum class inside of namespace
 
+/// \cond doxygen chokes on enum class inside of namespace
+/// Enum to select the files to which to export traces
+enum class TraceFileFormat
+{
+    CSV,            ///< write traces to a CSV file
+    NPY,            ///< write traces to a NumPy .npy file instead of a CSV file
+    CSV_AND_NPY     ///< write traces to a CSV file and a NumPy .npy file next to it
+};
+/// \endcond doxygen chokes on enum class inside of namespace
+
 /// Write logical traces with names to an output stream, which is used when
 /// exporting logical GPIO traces and events.
 ///
@@ -87,6 +97,31 @@ bool writeTraces(
         const DataSet::Type intType,
         AsyncCheckInCB_t inCheckInCB = [](float){return false;});
 
+/// Write regular traces with names to a NumPy .npy file.
+///
+/// The file contains a one dimensional array with a structured data type,
+/// which has a "Time (s)" float64 field followed by a float32 field named
+/// after each trace, so that each element corresponds to a row of the CSV
+/// file written by writeTraces.
+///
+/// \param  inFileName      The name of the file to write.
+/// \param  inTraces        Outer dimension corresponds to number of segments,
+///                         inner dimension to number of named traces.
+/// \param  inNames         The names of the traces, which must be unique.
+/// \param  inBaseTime      The 0 time, with which to write relative to.
+/// \param  inCheckInCB     Check-in callback function that is periodically invoked
+///                         with progress and to tell algo whether to cancel / abort.
+/// \return                 True if cancelled.
+///
+/// \throw  isx::ExceptionUserInput If the trace names are not unique.
+/// \throw  isx::ExceptionFileIO    If writing to the file fails.
+bool writeTracesNpy(
+        const std::string & inFileName,
+        const std::vector<std::vector<SpFTrace_t>> & inTraces,
+        const std::vector<std::string> & inNames,
+        const Time & inBaseTime,
+        AsyncCheckInCB_t inCheckInCB = [](float){return false;});
+
 /// Export an image to TIFF
 ///
 /// \param inFileName   The filename for the output file.
@@ -0,0 +1,210 @@
+#ifndef ISX_FILE_HANDLE_POOL_H
+#define ISX_FILE_HANDLE_POOL_H
+
+#include "isxCore.h"
+
+#include <fstream>
+#include <functional>
+#include <list>
+#include <string>
+
+namespace isx
+{
+
+/// The statistics of the file handle pool.
+///
+struct FileHandlePoolStats
+{
+    /// The number of times a pooled file was opened.
+    uint64_t m_numOpens = 0;
+
+    /// The number of times an idle pooled file was closed to make room for another one.
+    uint64_t m_numEvictions = 0;
+
+    /// The number of pooled files that are currently open.
+    isize_t m_numOpenHandles = 0;
+};
+
+class PooledFileHandle;
+
+/// A thread-safe pool that bounds the number of pooled files that are open at once.
+///
+/// Readers of multi-file movies and series keep one reader per file for
+/// their lifetime, which can exceed the per-process limit on open files
+/// for long recordings split into thousands of segments. A reader whose
+/// file is pooled opens it on first access and the pool closes the least
+/// recently used idle file when too many are open, so sequential reading
+/// opens each file once.
+///
+/// A file that is being accessed is never closed, so the number of open
+/// files can exceed the maximum while more files than that are accessed
+/// at once.
+class FileHandlePool
+{
+public:
+
+    /// The default maximum number of open pooled files.
+    static const isize_t s_defaultMaxOpenHandles = 128;
+
+    /// \return The statistics of the pool.
+    ///
+    static
+    FileHandlePoolStats
+    getStats();
+
+    /// Reset the open and eviction counts of the pool to zero.
+    ///
+    static
+    void
+    resetStats();
+
+    /// \return The maximum number of open pooled files.
+    ///
+    static
+    isize_t
+    getMaxOpenHandles();
+
+    /// Set the maximum number of open pooled files, closing the least
+    /// recently used idle files if more are currently open.
+    ///
+    /// \param  inMaxOpenHandles    The maximum number of open files, which must be at least 1.
+    static
+    void
+    setMaxOpenHandles(const isize_t inMaxOpenHandles);
+
+private:
+
+    friend class PooledFileHandle;
+
+    static
+    void
+    acquire(PooledFileHandle * inHandle);
+
+    static
+    void
+    release(PooledFileHandle * inHandle);
+
+    static
+    void
+    add(PooledFileHandle * inHandle, const bool inIsOpen);
+
+    static
+    void
+    remove(PooledFileHandle * inHandle);
+
+    /// Close the least recently used idle files until at most the given number are open.
+    static
+    void
+    evictIdle(const isize_t inMaxOpenHandles);
+};
+
+/// The pool entry of the file of a reader.
+///
+/// The reader passes functions that open and close its file to manage,
+/// after which every access to the file must hold
+/// a Lease. The pool may have closed the file when the reader unmanages or
+/// destroys the handle, so the reader must only close its file afterwards
+/// if it is still open.
+///
+/// A handle that is not managed does nothing, so that readers that can also
+/// write files only pool the files they read.
+class PooledFileHandle
+{
+public:
+
+    /// The type of the function that opens the file.
+    ///
+    /// It must throw an exception if the file cannot be opened.
+    typedef std::function<void()> OpenFn_t;
+
+    /// The type of the function that closes the file.
+    typedef std::function<void()> CloseFn_t;
+
+    /// Keeps the file of a handle open while it is in scope,
+    /// reopening the file if it was closed by the pool.
+    ///
+    class Lease
+    {
+    public:
+
+        /// \param  inHandle    The handle of the file to access.
+        /// \throw  isx::ExceptionFileIO    If the file cannot be reopened.
+        explicit Lease(PooledFileHandle & inHandle);
+
+        /// Allow the pool to close the file again.
+        ///
+        ~Lease();
+
+        Lease(const Lease &) = delete;
+        Lease & operator=(const Lease &) = delete;
+
+    private:
+        PooledFileHandle & m_handle;
+    };
+
+    /// Construct a handle that is not managed by the pool.
+    ///
+    PooledFileHandle();
+
+    /// Remove the handle from the pool without closing its file.
+    ///
+    ~PooledFileHandle();
+
+    PooledFileHandle(const PooledFileHandle &) = delete;
+    PooledFileHandle & operator=(const PooledFileHandle &) = delete;
+
+    /// Add the file of a reader to the pool.
+    ///
+    /// \param  inOpen      The function that opens the file.
+    /// \param  inClose     The function that closes the file.
+    /// \param  inIsOpen    True if the reader already opened the file,
+    ///                     false to open it on the first Lease.
+    void
+    manage(OpenFn_t inOpen, CloseFn_t inClose, const bool inIsOpen = true);
+
+    /// Add the file stream of a reader to the pool.
+    ///
+    /// Readers open their file to read its header when they are constructed.
+    /// The stream is closed here and reopened by the first Lease, so that a series
+    /// of many files does not keep them all open until they are accessed.
+    ///
+    /// \param  inFile      The file stream, which must outlive the handle.
+    /// \param  inFileName  The name of the file, which must outlive the handle.
+    /// \param  inOpenMode  The mode to reopen the file with.
+    void
+    manageStream(std::fstream & inFile, const std::string & inFileName, const std::ios_base::openmode inOpenMode);
+
+    /// Remove the handle from the pool without reopening or closing its file.
+    ///
+    /// This must be called before a reader closes its file itself.
+    void
+    unmanage();
+
+    /// \return True if the handle is managed by the pool.
+    ///
+    bool
+    isManaged() const;
+
+private:
+
+    friend class FileHandlePool;
+
+    OpenFn_t m_openFn;
+    CloseFn_t m_closeFn;
+
+    /// True if the handle is in the pool.
+    bool m_managed = false;
+
+    /// True if the file is open.
+    bool m_isOpen = false;
+
+    /// The number of leases currently held on the handle.
+    isize_t m_numLeases = 0;
+
+    /// The position of the handle in the least recently used list of the pool.
+    std::list<PooledFileHandle *>::iterator m_lruPos;
+};
+
+} // namespace isx
+
+#endif // ISX_FILE_HANDLE_POOL_H
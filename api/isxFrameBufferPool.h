@@ -0,0 +1,122 @@
+#ifndef ISX_FRAME_BUFFER_POOL_H
+#define ISX_FRAME_BUFFER_POOL_H
+
+#include "isxCore.h"
+
+#include <memory>
+
+namespace isx
+{
+
+/// The statistics of the frame buffer pool.
+///
+struct FrameBufferPoolStats
+{
+    /// The number of allocations that reused a cached buffer.
+    uint64_t m_numHits = 0;
+
+    /// The number of allocations that had to allocate a new buffer.
+    uint64_t m_numMisses = 0;
+
+    /// The number of released buffers that were freed instead of cached
+    /// because the pool was full.
+    uint64_t m_numDiscarded = 0;
+
+    /// The number of buffers currently cached.
+    isize_t m_numCachedBuffers = 0;
+
+    /// The total size in bytes of the buffers currently cached.
+    isize_t m_numCachedBytes = 0;
+};
+
+/// A thread-safe pool of 64-byte aligned buffers for the pixels of images and frames.
+///
+/// Reading or exporting a movie allocates a buffer of the same size for
+/// every frame, so released buffers are cached in buckets by size and
+/// reused by the next allocation of that size instead of going back to
+/// the heap. The total size of the cached buffers is bounded, after which
+/// released buffers are freed.
+///
+/// Like new char[], the contents of an allocated buffer are not initialized.
+class FrameBufferPool
+{
+public:
+
+    /// The alignment in bytes of all buffers.
+    static const isize_t s_alignment = 64;
+
+    /// The default maximum total size in bytes of the cached buffers.
+    static const isize_t s_defaultMaxCachedBytes = isize_t(256) << 20;
+
+    /// Allocate a buffer, reusing a cached one of the same size if possible.
+    ///
+    /// \param  inSizeInBytes   The size of the buffer in bytes.
+    /// \return                 The aligned buffer, which must be released with release
+    ///                         with the same size.
+    /// \throw  std::bad_alloc  If the buffer cannot be allocated.
+    static
+    char *
+    allocate(const isize_t inSizeInBytes);
+
+    /// Release a buffer back to the pool.
+    ///
+    /// \param  inBuffer        The buffer, which may be nullptr.
+    /// \param  inSizeInBytes   The size the buffer was allocated with.
+    static
+    void
+    release(char * inBuffer, const isize_t inSizeInBytes);
+
+    /// \return The statistics of the pool.
+    ///
+    static
+    FrameBufferPoolStats
+    getStats();
+
+    /// Reset the hit, miss and discard counts of the pool to zero.
+    ///
+    static
+    void
+    resetStats();
+
+    /// Free all cached buffers.
+    ///
+    static
+    void
+    clear();
+
+    /// Set the maximum total size of the cached buffers, freeing cached buffers
+    /// if they currently exceed it. A maximum of 0 disables caching.
+    ///
+    /// \param  inMaxCachedBytes    The maximum total size in bytes.
+    static
+    void
+    setMaxCachedBytes(const isize_t inMaxCachedBytes);
+};
+
+/// Releases a buffer allocated by FrameBufferPool back to the pool.
+///
+struct FrameBufferDeleter
+{
+    /// The size the buffer was allocated with.
+    isize_t m_sizeInBytes = 0;
+
+    /// \param  inBuffer    The buffer to release.
+    ///
+    void
+    operator()(char * inBuffer) const
+    {
+        FrameBufferPool::release(inBuffer, m_sizeInBytes);
+    }
+};
+
+/// A buffer allocated by FrameBufferPool that is released when destroyed.
+typedef std::unique_ptr<char, FrameBufferDeleter> UpFrameBuffer_t;
+
+/// \param  inSizeInBytes   The size of the buffer in bytes.
+/// \return                 A buffer from the pool that is released when destroyed.
+UpFrameBuffer_t
+makeFrameBuffer(const isize_t inSizeInBytes);
+
+} // namespace isx
+
+#endif // ISX_FRAME_BUFFER_POOL_H
@@ -97,6 +97,34 @@ public:
     void
     getLogicalDataAsync(const std::string & inChannelName, GpioGetLogicalDataCB_t inCallback) = 0;
 
+    /// Get the logical traces of all channels within a time window.
+    ///
+    /// By default this calls getLogicalData for each channel, but implementations
+    /// read the data of all channels at once when the file format allows it.
+    ///
+    /// \param  inStartMicroSecs    The start of the time window in microseconds from the start
+    ///                             of the timing info.
+    /// \param  inEndMicroSecs      The end of the time window, which is excluded.
+    /// \return                     The values of each channel in the order of getChannelList,
+    ///                             with offsets from the start of the timing info.
+    virtual
+    LogicalTraceTable
+    getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs);
+
+    /// Get the logical trace of a channel within a time window.
+    ///
+    /// By default this filters the result of getLogicalData, but implementations
+    /// only read the data within the window when the file format allows it.
+    ///
+    /// \param  inChannelName   The name of the requested channel (as returned by getChannelList()).
+    /// \param  inStartTime     The start of the time window.
+    /// \param  inEndTime       The end of the time window, which is excluded.
+    /// \return                 The logical trace of the channel within the time window, or nullptr
+    ///                         if the file doesn't contain data for that channel.
+    virtual
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime);
+
     /// \return     The timing information read from the GPIO set.
     /// \param inChannelName the name of the requested channel (as returned by getChannelList())
     /// IMPORTANT: When interested in the timing info including dropped samples, make sure
@@ -42,6 +42,15 @@ public:
     ///
     /// \throw  ExceptionDataIO If the string cannot be parsed.
     static SpGroup_t fromJsonString(const std::string & inString, const std::string & inAbsolutePathToPrepend = std::string());
+
+    /// Create a group from a JSON tree.
+    ///
+    /// \param  inJson      The JSON tree.
+    /// \param  inAbsolutePathToPrepend The path the is preprended to any relative filenames in the group
+    /// \return             The deserialized group.
+    ///
+    /// \throw  ExceptionDataIO If the tree does not represent a group.
+    static SpGroup_t fromJson(const nlohmann::json & inJson, const std::string & inAbsolutePathToPrepend = std::string());
     
     /// \return number of this Group's members.
     ///
@@ -119,6 +128,8 @@ public:
     void setUnmodified() override;
 
     std::string toJsonString(const bool inPretty = false, const std::string & inPathToOmit = std::string()) const override;
+
+    nlohmann::json toJson(const std::string & inPathToOmit = std::string()) const override;
     
     bool operator ==(const ProjectItem & other) const override;
 
@@ -1,7 +1,9 @@
 #ifndef ISX_IMUFILE_H
 #define ISX_IMUFILE_H
 
+#include <fstream>
 #include <unordered_map>
+#include <vector>
 
 #include "isxAsync.h"
 #include "isxCore.h"
@@ -110,8 +112,26 @@ public:
     static constexpr uint8_t s_maxMagArrSize = 3; ///<max axis data elements for magnetometer, XYZ
     static constexpr uint8_t s_maxOriArrSize = 3; ///<max orientation data elements, yaw-pitch-roll
     static constexpr uint8_t s_accOriRate = 20; ///<step between acc/ori data packets in ms
+    static constexpr size_t s_numPktsPerRead = 1 << 16; ///<number of packets read from the file at a time
+    static constexpr size_t s_numPktsPerWrite = 1 << 16; ///<number of packets written to the output file at a time
 
 private:
+    /// Reads all packets of one stream in large blocks and reports progress.
+    /// \param inOffset             the offset of the packets in bytes from the beginning of the file
+    /// \param inCount              the number of packets
+    /// \param outPayloads          the packets read
+    /// \param inProgressMultiplier converts a file position to a progress percentage
+    /// \param ioProgress           the last progress percentage reported
+    /// \throw isx::ExceptionFileIO if the packets could not be read
+    /// \return whether the process was cancelled
+    template <typename Payload>
+    bool readPayloads(
+            const uint64_t inOffset,
+            const uint64_t inCount,
+            std::vector<Payload> & outPayloads,
+            const double inProgressMultiplier,
+            size_t & ioProgress);
+
     /// The name of the data file.
     std::string m_fileName;
 
@@ -6,6 +6,7 @@
 #include "isxSpacingInfo.h"
 #include "isxCore.h"
 #include "isxException.h"
+#include "isxFrameBufferPool.h"
 
 namespace isx
 {
@@ -166,8 +167,8 @@ public:
 
 private:
 
-    /// The byte array used to store data.
-    std::unique_ptr<char []> m_pixels = 0;
+    /// The byte array used to store data, which is drawn from the frame buffer pool.
+    UpFrameBuffer_t m_pixels;
 
     /// The spacing information of the image.
     SpacingInfo m_spacingInfo;
@@ -18,29 +18,29 @@
 #ifdef NDEBUG
 #define ISX_LOG_DEBUG(...)
 #else
-#define ISX_LOG_DEBUG(...) isx::internal::log_(__VA_ARGS__)
+#define ISX_LOG_DEBUG(...) isx::internal::log_<isx::LogLevel::DEBUG_LEVEL>(__VA_ARGS__)
 #endif
 
 /// \def ISX_LOG_INFO(...)
 ///
 /// Logs the arguments as strings in an info message.
-#define ISX_LOG_INFO(...) isx::internal::log_(__VA_ARGS__)
+#define ISX_LOG_INFO(...) isx::internal::log_<isx::LogLevel::INFO_LEVEL>(__VA_ARGS__)
 
 /// \def ISX_LOG_INFO_NO_PRINT(...)
 ///
 /// Logs the arguments as strings in an info message that is serialized to a file.
-#define ISX_LOG_INFO_NO_PRINT(...) isx::internal::logNoPrint_(__VA_ARGS__)
+#define ISX_LOG_INFO_NO_PRINT(...) isx::internal::logNoPrint_<isx::LogLevel::INFO_LEVEL>(__VA_ARGS__)
 
 
 /// \def ISX_LOG_WARNING(...)
 ///
 /// Logs the arguments as strings in a warning message.
-#define ISX_LOG_WARNING(...) isx::internal::log_(__VA_ARGS__)
+#define ISX_LOG_WARNING(...) isx::internal::log_<isx::LogLevel::WARNING_LEVEL>(__VA_ARGS__)
 
 /// \def ISX_LOG_ERROR(...)
 ///
 /// Logs the arguments as strings in an error message.
-#define ISX_LOG_ERROR(...) isx::internal::log_(__VA_ARGS__)
+#define ISX_LOG_ERROR(...) isx::internal::log_<isx::LogLevel::ERROR_LEVEL>(__VA_ARGS__)
 
 // DO NOT USE THESE FUNCTIONS DIRECTLY! USE MACROS ABOVE INSTEAD!
 namespace isx
@@ -81,10 +81,17 @@ std::string varArgsToString(Rest && ...rest)
 
 /// Appends variadic arguments to a platform specific output buffer.
 ///
+/// The arguments are only formatted if the severity is enabled.
+///
+/// \tparam Level   The severity of the message.
 /// \param  rest    The arguments to append to the output buffer.
-template<typename ...Rest>
+template<LogLevel Level, typename ...Rest>
 void log_(Rest && ...rest)
 {
+    if (!Logger::isLevelEnabled(Level))
+    {
+        return;
+    }
     std::string str = isx::internal::varArgsToString(std::forward<Rest>(rest)..., "\n");
 #if ISX_OS_WIN32
     if (IsDebuggerPresent())
@@ -105,10 +112,15 @@ void log_(Rest && ...rest)
 
 /// Appends variadic arguments to a log file.
 ///
+/// \tparam Level   The severity of the message.
 /// \param  rest    The arguments to the log file.
-template<typename ...Rest>
+template<LogLevel Level, typename ...Rest>
 void logNoPrint_(Rest && ...rest)
 {
+    if (!Logger::isLevelEnabled(Level))
+    {
+        return;
+    }
     std::string str = isx::internal::varArgsToString(std::forward<Rest>(rest)..., "\n");
     Logger::log(str);
 }
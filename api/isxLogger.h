@@ -2,14 +2,29 @@
 #define ISX_LOGGER_H
 
 
+#include <cstdint>
 #include <memory>
 #include <string> 
 
 namespace isx {
 
+/// \cond doxygen chokes on enum class inside of namespace
+/// The severity of a log message, in increasing order.
+enum class LogLevel
+{
+    DEBUG_LEVEL = 0,            ///< debug info
+    INFO_LEVEL,                 ///< user actions and other info
+    WARNING_LEVEL,              ///< warnings
+    ERROR_LEVEL                 ///< errors
+};
+/// \endcond doxygen chokes on enum class inside of namespace
+
 /// A class implementing a singleton Logger to be used
 /// application-wide for logging user actions, errors, debug info and warnings to a file.
 ///
+/// Lines are queued in a bounded ring buffer and written by a background
+/// thread that keeps the log file open, so logging does not block on
+/// file IO. Call flush to make sure all queued lines have been written.
 class Logger
 {
 public:
@@ -42,6 +57,44 @@ public:
     void
     log(const std::string & text);
 
+    /// Wait until all lines queued so far have been written to the log file.
+    ///
+    /// This is called on shutdown and when the program terminates due to an
+    /// uncaught exception, so that the last lines before a crash are not lost.
+    static
+    void
+    flush();
+
+    /// Like flush, but never blocks for longer than a timeout.
+    ///
+    /// This returns immediately on the thread that writes the log file,
+    /// which could never see its own lines written.
+    ///
+    /// \param  inTimeoutMs The maximum time to wait in milliseconds.
+    /// \return             True if all lines queued so far have been written.
+    static
+    bool
+    tryFlush(const uint32_t inTimeoutMs);
+
+    /// Set the minimum severity of messages to log.
+    /// Messages with a lower severity are discarded before being formatted.
+    /// \param inLevel the minimum severity
+    static
+    void
+    setMinLevel(const LogLevel inLevel);
+
+    /// \return the minimum severity of messages to log
+    ///
+    static
+    LogLevel
+    getMinLevel();
+
+    /// \param inLevel the severity of a message
+    /// \return true if messages with the given severity should be logged
+    static
+    bool
+    isLevelEnabled(const LogLevel inLevel);
+
     /// \return log filename
     ///
     static
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include "isxTimingInfo.h"
 
 namespace isx
@@ -86,6 +87,53 @@ private:
 
 }; // class
 
+/// The values of several logical traces stored contiguously.
+///
+/// The time of each value is stored as a whole number of microseconds
+/// from a start time, e.g. the start of the events or GPIO data.
+/// The values of trace i are at the indices [m_traceStarts[i], m_traceStarts[i + 1]).
+struct LogicalTraceTable
+{
+    std::vector<int64_t>    m_offsetsMicroSecs;     ///< The offset of each value from the start time.
+    std::vector<float>      m_values;               ///< The values of all traces.
+    std::vector<size_t>     m_traceStarts = {0};    ///< The index of the first value of each trace,
+                                                    ///< followed by the total number of values.
+
+    /// \return The number of traces in the table.
+    ///
+    size_t getNumTraces() const
+    {
+        return m_traceStarts.size() - 1;
+    }
+};
+
+/// Appends the values of a logical trace within a time window to a table.
+///
+/// Offsets are rounded to the nearest microsecond.
+///
+/// \param  inTrace             The trace to append, which may be null for a trace without values.
+/// \param  inStartTime         The time that offsets are relative to.
+/// \param  inStartMicroSecs    The start of the time window as an offset from the start time.
+/// \param  inEndMicroSecs      The end of the time window, which is excluded.
+/// \param  outTable            The table to append to.
+void
+appendToLogicalTraceTable(
+        const SpLogicalTrace_t & inTrace,
+        const Time & inStartTime,
+        const int64_t inStartMicroSecs,
+        const int64_t inEndMicroSecs,
+        LogicalTraceTable & outTable);
+
+/// Gets the values of a logical trace within a time window.
+///
+/// \param  inTrace     The trace, which may be null.
+/// \param  inStartTime The start of the time window.
+/// \param  inEndTime   The end of the time window, which is excluded.
+/// \return             A trace with the same timing info and name that only has the values
+///                     within the time window, or null if the trace is null.
+SpLogicalTrace_t
+getLogicalTraceInRange(const SpLogicalTrace_t & inTrace, const Time & inStartTime, const Time & inEndTime);
+
 /// Gets the plot coordinates for a logical trace.
 ///
 /// \param  inTrace                 The trace to plot, which could be a series.
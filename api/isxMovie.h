@@ -8,12 +8,15 @@
 #include "isxSpacingInfo.h"
 #include "isxVideoFrame.h"
 #include "isxAsyncTaskResult.h"
+#include "isxPixelStatistics.h"
 
 #include <unordered_map>
 
 namespace isx
 {
 
+class BoundingBox;
+
 /// The type of callback for getting a frame asynchronously
 using MovieGetFrameCB_t = std::function<void(AsyncTaskResult<SpVideoFrame_t>)>;
 using GetFrameCB_t = std::function<SpVideoFrame_t()>;
@@ -76,6 +79,18 @@ public:
     std::string
     getFrameMetadata(const size_t inFrameNumber);
 
+    /// Get the tracked bounding box of a frame.
+    /// Runs synchronously on the same thread that calls it.
+    ///
+    /// By default this parses the frame metadata, but movies that decode
+    /// their frame metadata up front can avoid parsing it for every frame.
+    ///
+    /// \param  inFrameNumber   The frame number.
+    /// \return                 The bounding box associated with a given frame number.
+    virtual
+    BoundingBox
+    getFrameBoundingBox(const size_t inFrameNumber);
+
     /// Get the frame footer. Runs synchronously on the same thread that calls it.
     ///
     /// \param  inFrameNumber   The frame number.
@@ -84,6 +99,25 @@ public:
     std::vector<uint16_t>
     getFrameFooter(const size_t inFrameNumber);
 
+    /// Get a frame as it is stored, including its header and footer if it has them.
+    /// Runs synchronously on the same thread that calls it.
+    ///
+    /// By default this copies the pixels of the frame, which is all that is stored
+    /// for movies without frame headers and footers.
+    ///
+    /// \param  inFrameNumber   The frame number.
+    /// \param  outBuffer       The buffer to read into, which must be of at least
+    ///                         getRawFrameSizeInBytes bytes.
+    virtual
+    void
+    getRawFrame(const size_t inFrameNumber, char * outBuffer);
+
+    /// \return     The size of a frame including its header and footer in bytes.
+    ///
+    virtual
+    isize_t
+    getRawFrameSizeInBytes() const;
+
     /// cancel all pending read requests (scheduled via getFrameAsync) for this movie
     ///
     virtual
@@ -148,6 +182,45 @@ public:
     uint64_t
     getFrameTimestamp(const isize_t inIndex);
 
+    /// Get the timestamps of a range of frames, which is faster than calling
+    /// getFrameTimestamp for each frame for movies that override it.
+    ///
+    /// \param  inFirstIndex    The index of the first frame in this movie.
+    /// \param  inNumFrames     The number of frames, which must not go past the last frame.
+    /// \return                 The timestamp associated with each frame of the range,
+    ///                         which is 0 for frames that do not have one.
+    virtual
+    std::vector<uint64_t>
+    getFrameTimestamps(const isize_t inFirstIndex, const isize_t inNumFrames);
+
+    /// Get the timestamps of all frames, which is faster than calling
+    /// getFrameTimestamp for each frame for movies that override it.
+    ///
+    /// \return             The timestamp associated with each frame of this movie,
+    ///                     which is 0 for frames that do not have one.
+    virtual
+    std::vector<uint64_t>
+    getAllFrameTimestamps();
+
+    /// \return     True if the movie has precomputed pixel statistics (e.g. stored
+    ///             in the footer when it was written), false otherwise.
+    virtual
+    bool
+    hasPixelStatistics() const;
+
+    /// \return     The precomputed pixel statistics over all frames of the movie,
+    ///             or empty statistics if the movie does not have any.
+    virtual
+    PixelStatistics
+    getPixelStatistics() const;
+
+    /// \param  inFrameNumber   The index of a frame in this movie.
+    /// \return                 The precomputed pixel statistics of the given frame without
+    ///                         a histogram, or empty statistics if the movie does not have any.
+    virtual
+    PixelStatistics
+    getFramePixelStatistics(const isize_t inFrameNumber) const;
+
     /// \return     Aggressively close the file stream
     virtual
     void
@@ -114,6 +114,17 @@ std::string getCanonicalPath(const std::string & inPath);
 /// \return             True if the path exists on the file system.
 bool pathExists(const std::string & inPath);
 
+/// Get the size and the last modification time of a file.
+///
+/// These are used to check if a file has changed since it was last read.
+///
+/// \param  inPath              The path of the file.
+/// \param  outSizeInBytes      The size of the file in bytes.
+/// \param  outModifiedMs       The last modification time of the file in milliseconds
+///                             since the Unix epoch.
+/// \return                     True if the file exists, false otherwise.
+bool getFileStamp(const std::string & inPath, int64_t & outSizeInBytes, int64_t & outModifiedMs);
+
 /// Returns all fileNames from specified directory.
 ///
 /// \param  inPath      The path to check for existence.
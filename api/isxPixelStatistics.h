@@ -0,0 +1,133 @@
+#ifndef ISX_PIXEL_STATISTICS_H
+#define ISX_PIXEL_STATISTICS_H
+
+#include "isxCore.h"
+
+#include <vector>
+
+namespace isx
+{
+
+/// Summary statistics of the pixel values of a frame or a whole movie.
+///
+/// The histogram has a fixed number of equally sized bins spanning
+/// [m_histogramMin, m_histogramMax]. Values outside of that range are
+/// accumulated into the first or last bin. NaN and infinite values are
+/// only counted, so that the other statistics stay finite and can always
+/// be written and read back. Because the binning is fixed
+/// up front, the statistics of individual frames can be merged to give
+/// the statistics of a whole movie without re-reading any pixels.
+struct PixelStatistics
+{
+    /// Empty constructor.
+    ///
+    /// This creates statistics without a histogram.
+    PixelStatistics();
+
+    /// Constructor.
+    ///
+    /// \param  inHistogramMin  The lower edge of the first histogram bin.
+    /// \param  inHistogramMax  The upper edge of the last histogram bin.
+    /// \param  inNumBins       The number of histogram bins. Use 0 to disable the histogram.
+    PixelStatistics(const float inHistogramMin, const float inHistogramMax, const isize_t inNumBins);
+
+    /// Make empty statistics with the default histogram binning for a pixel data type.
+    ///
+    /// Integer types are binned over their full value range. Float pixels have no
+    /// natural range, so no histogram is computed for them.
+    ///
+    /// \param  inDataType  The pixel data type.
+    /// \param  inNumBins   The number of histogram bins.
+    /// \return             The empty statistics.
+    static PixelStatistics makeForDataType(const DataType inDataType, const isize_t inNumBins = s_defaultNumBins);
+
+    /// Accumulate pixel values into these statistics.
+    ///
+    /// \param  inPixels    The pixel values.
+    /// \param  inNumPixels The number of pixel values.
+    void accumulate(const uint8_t * inPixels, const isize_t inNumPixels);
+
+    /// \copydoc accumulate(const uint8_t *, const isize_t)
+    void accumulate(const uint16_t * inPixels, const isize_t inNumPixels);
+
+    /// \copydoc accumulate(const uint8_t *, const isize_t)
+    void accumulate(const float * inPixels, const isize_t inNumPixels);
+
+    /// Accumulate raw pixel data of a given type into these statistics.
+    ///
+    /// \param  inPixels    The address of the first pixel.
+    /// \param  inDataType  The data type of the pixels.
+    /// \param  inNumValues The number of values (pixels times channels).
+    ///
+    /// \throw  isx::ExceptionDataIO    If the data type is not supported.
+    void accumulate(const char * inPixels, const DataType inDataType, const isize_t inNumValues);
+
+    /// Merge other statistics into these statistics.
+    ///
+    /// \param  inOther The statistics to merge, which must have the same histogram binning.
+    ///
+    /// \throw  isx::ExceptionUserInput If the histogram binning is different.
+    void merge(const PixelStatistics & inOther);
+
+    /// \return True if any finite pixels have been accumulated, false otherwise.
+    ///
+    bool isValid() const;
+
+    /// \return The mean pixel value, or 0 if no pixels have been accumulated.
+    ///
+    double getMean() const;
+
+    /// \return True if these statistics are equal to another.
+    /// \param  inOther The statistics with which to compare.
+    bool operator ==(const PixelStatistics & inOther) const;
+
+    /// The minimum finite pixel value.
+    float m_min;
+
+    /// The maximum finite pixel value.
+    float m_max;
+
+    /// The sum of all finite pixel values.
+    double m_sum = 0.0;
+
+    /// The number of finite pixel values accumulated.
+    isize_t m_numPixels = 0;
+
+    /// The number of NaN and infinite pixel values, which are not otherwise accumulated.
+    isize_t m_numNonFinitePixels = 0;
+
+    /// The lower edge of the first histogram bin.
+    float m_histogramMin = 0.f;
+
+    /// The upper edge of the last histogram bin.
+    float m_histogramMax = 0.f;
+
+    /// The number of pixel values in each histogram bin.
+    std::vector<uint64_t> m_histogram;
+
+    /// The default number of histogram bins.
+    static const isize_t s_defaultNumBins = 64;
+
+private:
+
+    /// Accumulate values of any supported pixel type.
+    template <typename T>
+    void accumulateInternal(const T * inPixels, const isize_t inNumPixels);
+};
+
+/// The pixel statistics of a whole movie and of each of its recorded frames.
+///
+struct MoviePixelStatistics
+{
+    /// The statistics over all recorded frames.
+    PixelStatistics m_overall;
+
+    /// The statistics of each recorded frame, in the order they were written.
+    /// Dropped, cropped and blank frames are never written so do not have an entry.
+    /// These only summarize each frame, so they do not have histograms.
+    std::vector<PixelStatistics> m_frames;
+};
+
+} // namespace isx
+
+#endif // ISX_PIXEL_STATISTICS_H
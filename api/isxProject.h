@@ -11,6 +11,8 @@
 namespace isx
 {
 
+class CoalescingJsonWriter;
+
 /// Encapsulates a mosaic project and all items associated with it.
 ///
 /// An item can either be a group, series or data set.
@@ -68,8 +70,16 @@ public:
     void save();
 
     /// Write filename.isxp.tmp to file
+    ///
+    /// The project is serialized on the calling thread, but the file is
+    /// written on a background thread at most once per second, so that
+    /// frequent edits of large projects are coalesced into fewer writes.
     void saveTmp();
 
+    /// Wait until the temporary project file reflects the last call to saveTmp.
+    ///
+    void flushTmp();
+
     /// Create a data set at the root of this project.
     ///
     /// \param  inName      The name of the DataSet to create
@@ -220,6 +230,9 @@ private:
     /// The file version
     const static size_t s_version = 0;
 
+    /// Writes the temporary project file in the background.
+    std::unique_ptr<CoalescingJsonWriter> m_tmpWriter;
+
     /// Read this project from its file.
     ///
     /// This requires the file name to already be set.
@@ -229,6 +242,11 @@ private:
     /// \param inFilename a filename other than m_fileName to be used. .
     void write(const std::string & inFilename) const;
 
+    /// \return The JSON tree of this project, which is what is written to its file.
+    ///
+    /// \throw  ExceptionDataIO If the project cannot be serialized.
+    nlohmann::json toJson() const;
+
     /// \return the temporary filename
     ///
     std::string getTmpFileName() const;
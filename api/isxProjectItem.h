@@ -4,6 +4,8 @@
 #include "isxCore.h"
 #include "isxCoreFwd.h"
 
+#include "json.hpp"
+
 #include <vector>
 #include <memory>
 #include <string>
@@ -77,7 +79,13 @@ public:
     /// \return             The serialized JSON string of the item.
     virtual std::string toJsonString(const bool inPretty = false, const std::string & inPathToOmit = std::string()) const = 0;
 
-    
+    /// Serialize the item and its children into one JSON tree, without
+    /// formatting and parsing the intermediate strings of the children.
+    ///
+    /// \param  inPathToOmit the path from filenames to omit for serialization (to obtain relative paths)
+    /// \return             The JSON tree of the item.
+    virtual nlohmann::json toJson(const std::string & inPathToOmit = std::string()) const = 0;
+
 
     /// Exact comparison.
     ///
@@ -218,6 +218,15 @@ public:
     /// \throw  ExceptionDataIO If the string cannot be parsed.
     static SpSeries_t fromJsonString(const std::string & inString, const std::string & inAbsolutePathToPrepend = std::string());
 
+    /// Create a series from a JSON tree.
+    ///
+    /// \param  inJson      The JSON tree.
+    /// \param  inAbsolutePathToPrepend The path the is preprended to any relative filenames in the series
+    /// \return             The deserialized series, or nullptr if the tree is an empty object.
+    ///
+    /// \throw  ExceptionDataIO If the tree does not represent a series.
+    static SpSeries_t fromJson(const nlohmann::json & inJson, const std::string & inAbsolutePathToPrepend = std::string());
+
     /// \return this Series' unique identifier
     /// Can be used with SeriesIdentifier::getSeries
     ///
@@ -266,6 +275,11 @@ public:
     const
     override;
 
+    nlohmann::json
+    toJson(const std::string & inPathToOmit = std::string())
+    const
+    override;
+
     // Overrides: see isxProjectItem.h for docs.
     ProjectItem::Type
     getItemType()
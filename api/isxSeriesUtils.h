@@ -4,6 +4,9 @@
 #include "isxTimingInfo.h"
 #include "isxDataSet.h"
 
+#include <functional>
+#include <vector>
+
 namespace isx
 {
 
@@ -128,6 +131,48 @@ checkSeriesMembers(const std::vector<std::shared_ptr<T>> & inMembers, std::strin
     return true;
 }
 
+/// \param  inFileNames The file names of the members of a series.
+/// \return             True if the members can be opened concurrently, which is only
+///                     the case if they are all .isxd files, as the readers and importers
+///                     of other formats (e.g. HDF5) are not thread-safe.
+bool canOpenSeriesMembersConcurrently(const std::vector<std::string> & inFileNames);
+
+/// Run a task for each member of a series on up to a maximum number of threads,
+/// including this one.
+///
+/// If the tasks of any members throw, the error of the first of those members
+/// is rethrown, which is the error that running the tasks one after another
+/// would throw.
+///
+/// \param  inNumMembers    The number of members.
+/// \param  inTask          The task to run with the index of each member.
+/// \param  inMaxNumThreads The maximum number of threads. If 0, this is the number
+///                         of hardware threads bounded by a small constant.
+void forEachSeriesMember(
+        const isize_t inNumMembers,
+        const std::function<void(const isize_t)> & inTask,
+        const isize_t inMaxNumThreads = 0);
+
+/// Open the members of a series, concurrently if they can be.
+///
+/// The members are returned in the order of their file names and the
+/// ordering and consistency checks of the series are left to the caller.
+///
+/// \param  inFileNames The file names of the members.
+/// \param  inOpen      The function that opens the member with a given index.
+/// \return             The opened members.
+template <typename T>
+std::vector<T>
+openSeriesMembers(const std::vector<std::string> & inFileNames, const std::function<T(const isize_t)> & inOpen)
+{
+    std::vector<T> members(inFileNames.size());
+    forEachSeriesMember(inFileNames.size(), [&members, &inOpen](const isize_t inIndex)
+    {
+        members[inIndex] = inOpen(inIndex);
+    }, canOpenSeriesMembersConcurrently(inFileNames) ? 0 : 1);
+    return members;
+}
+
 /// \return The timing info for series without gaps from many consistent
 ///         timing infos.
 TimingInfo makeGaplessTimingInfo(const TimingInfos_t & inTis);
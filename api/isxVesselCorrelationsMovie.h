@@ -4,10 +4,12 @@
 #include "isxMovie.h"
 #include "isxVesselSet.h"
 #include "isxDataSet.h"
+#include "isxMutex.h"
 
 namespace isx
 {
     template <typename T> class IoTaskTracker;
+    class VesselCorrelationsReader;
 
 /// Class for managing and interfacing with a vessel set correlation movie
 /// Used in the VesselImageVisualizer to display a vessel correlation movie in single vessel mode.
@@ -62,11 +64,19 @@ public:
     std::string getExtraProperties() const override;
 
 private:
+    /// Make a frame from the correlation triptych of a velocity measurement.
+    SpVideoFrame_t
+    makeFrame(VesselCorrelations & inCorrelations, const isize_t inFrameNumber) const;
+
     SpVesselSet_t           m_vesselSet;                ///< The vessel set containing the correlation movoie         
     size_t                  m_vesselId;                 ///< The vessel id to play
     TimingInfo              m_gaplessTimingInfo;        ///< Representation of vessel set series timing info as a single timeline
     TimingInfos_t           m_timingInfos;              ///< Timing info of each element in the vessel set series
     SpacingInfo             m_spacingInfo;              ///< Spacing info of the vessel correlation movie
+
+    /// Reads the triptychs for getFrame, which is created on first use.
+    std::shared_ptr<VesselCorrelationsReader> m_reader;
+    Mutex                   m_readerMutex;              ///< Serializes reads through m_reader
 };
 
 } // namespace isx
@@ -273,6 +273,24 @@ virtual
 void
 getCorrelationsAsync(isize_t inIndex, isize_t inFrameNumber, VesselSetGetCorrelationsCB_t inCallback) = 0;
 
+/// Get the correlation triptychs for a range of velocity measurements of a vessel synchronously.
+///
+/// The triptychs of each file are read with a single read, instead of one read
+/// per velocity measurement as with getCorrelations.
+/// They are written one after the other in the same layout as VesselCorrelations::getValues,
+/// so the buffer must have space for 3 * (inEndFrame - inBeginFrame) * getCorrelationSize(inIndex) values.
+///
+/// \param  inIndex         The index of the vessel
+/// \param  inBeginFrame    The index of the first velocity measurement
+/// \param  inEndFrame      One past the index of the last velocity measurement
+/// \param  outValues       The buffer to read into
+/// \return                 False if no correlation triptychs are saved, true otherwise.
+/// \throw  isx::ExceptionFileIO    If vessel does not exist or reading fails.
+/// \throw  isx::ExceptionDataIO    If the range of velocity measurements is invalid.
+virtual
+bool
+getCorrelationsRange(isize_t inIndex, isize_t inBeginFrame, isize_t inEndFrame, float * outValues) = 0;
+
 /// Get the center trace of a vessel from a diameter set synchronously
 /// Each value in the trace represents the position on the user drawn line of the model peak center for each mesurement
 ///
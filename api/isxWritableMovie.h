@@ -74,6 +74,25 @@ public:
     virtual
     void
     setExtraProperties(const std::string & inProperties) = 0;
+
+    /// Compute pixel statistics of each frame and the whole movie while writing,
+    /// to be stored with the movie and retrieved with getPixelStatistics.
+    ///
+    /// This must be called before writing any frames.
+    ///
+    /// \param  inNumHistogramBins  The number of histogram bins.
+    virtual
+    void
+    enablePixelStatistics(const isize_t inNumHistogramBins = PixelStatistics::s_defaultNumBins) = 0;
+
+    /// Store the timestamp of every frame with the movie, so that
+    /// getAllFrameTimestamps does not need to read all the frame headers.
+    ///
+    /// This must be called before writing any frames and only has an effect
+    /// if the frames are written with their headers and footers.
+    virtual
+    void
+    enableFooterFrameTimestamps() = 0;
 };
 
 } // namespace isx
@@ -0,0 +1,158 @@
+#include "isxBench.h"
+#include "isxStopWatch.h"
+#include "isxException.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+
+#if ISX_OS_WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace isx
+{
+
+namespace
+{
+
+double
+getMedian(std::vector<double> inValues)
+{
+    if (inValues.empty())
+    {
+        return 0.0;
+    }
+    std::sort(inValues.begin(), inValues.end());
+    const size_t mid = inValues.size() / 2;
+    if (inValues.size() % 2 == 0)
+    {
+        return 0.5 * (inValues[mid - 1] + inValues[mid]);
+    }
+    return inValues[mid];
+}
+
+} // namespace
+
+uint64_t
+getPeakRssBytes()
+{
+#if ISX_OS_WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return uint64_t(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if ISX_OS_MACOS
+    // macOS reports the maximum resident set size in bytes.
+    return uint64_t(usage.ru_maxrss);
+#else
+    // Linux reports the maximum resident set size in kilobytes.
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+std::vector<BenchResult>
+runBenchCases(const BenchConfig & inConfig, const std::vector<BenchCase> & inCases)
+{
+    std::vector<BenchResult> results;
+    for (const auto & benchCase : inCases)
+    {
+        if (!inConfig.m_filter.empty() && benchCase.m_name.find(inConfig.m_filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        BenchResult result;
+        result.m_name = benchCase.m_name;
+        result.m_itemName = benchCase.m_itemName;
+        try
+        {
+            if (benchCase.m_setup)
+            {
+                benchCase.m_setup(inConfig);
+            }
+            for (isize_t r = 0; r < inConfig.m_numRepeats; ++r)
+            {
+                StopWatch sw;
+                sw.start();
+                result.m_work = benchCase.m_run(inConfig);
+                sw.stop();
+                result.m_elapsedMs.push_back(double(sw.getElapsedMs()));
+            }
+        }
+        catch (const std::exception & error)
+        {
+            result.m_error = error.what();
+        }
+        result.m_peakRssBytes = getPeakRssBytes();
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::string
+formatBenchResults(const BenchConfig & inConfig, const std::vector<BenchResult> & inResults)
+{
+    using json = nlohmann::json;
+
+    json config;
+    config["numRepeats"] = inConfig.m_numRepeats;
+    config["numFrames"] = inConfig.m_numFrames;
+    config["numRows"] = inConfig.m_numRows;
+    config["numCols"] = inConfig.m_numCols;
+    config["numCells"] = inConfig.m_numCells;
+    config["numEventsPerCell"] = inConfig.m_numEventsPerCell;
+    config["numGpioChannels"] = inConfig.m_numGpioChannels;
+    config["numGpioPktsPerChannel"] = inConfig.m_numGpioPktsPerChannel;
+    config["numTimingLookups"] = inConfig.m_numTimingLookups;
+
+    json benchmarks = json::array();
+    for (const auto & result : inResults)
+    {
+        json benchmark;
+        benchmark["name"] = result.m_name;
+        benchmark["peakRssBytes"] = result.m_peakRssBytes;
+        if (!result.m_error.empty())
+        {
+            benchmark["error"] = result.m_error;
+            benchmarks.push_back(benchmark);
+            continue;
+        }
+
+        const double minMs = *std::min_element(result.m_elapsedMs.begin(), result.m_elapsedMs.end());
+        const double medianMs = getMedian(result.m_elapsedMs);
+        const double seconds = std::max(medianMs, 1e-3) / 1000.0;
+
+        benchmark["elapsedMs"] = result.m_elapsedMs;
+        benchmark["minMs"] = minMs;
+        benchmark["medianMs"] = medianMs;
+        benchmark["bytes"] = result.m_work.m_numBytes;
+        benchmark["items"] = result.m_work.m_numItems;
+        benchmark["itemName"] = result.m_itemName;
+        benchmark["megabytesPerSec"] = double(result.m_work.m_numBytes) / (1024.0 * 1024.0) / seconds;
+        benchmark["itemsPerSec"] = double(result.m_work.m_numItems) / seconds;
+        benchmarks.push_back(benchmark);
+    }
+
+    json root;
+    root["version"] = CoreVersionString();
+    root["config"] = config;
+    root["benchmarks"] = benchmarks;
+    return root.dump(4);
+}
+
+} // namespace isx
@@ -0,0 +1,85 @@
+#ifndef ISX_BENCH_H
+#define ISX_BENCH_H
+
+#include "isxCore.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace isx
+{
+
+/// The sizes of the synthetic data sets generated by the benchmarks.
+struct BenchConfig
+{
+    std::string m_outputDir;                ///< The directory in which to write synthetic and exported files.
+    std::string m_compressedMovie;          ///< The path of a compressed movie to decompress, or empty to skip.
+    std::string m_filter;                   ///< Only run benchmarks whose name contains this.
+    isize_t m_numRepeats = 3;               ///< The number of times each benchmark is timed.
+    isize_t m_numFrames = 1000;             ///< The number of frames of the synthetic movie.
+    isize_t m_numRows = 400;                ///< The number of rows of the synthetic movie.
+    isize_t m_numCols = 640;                ///< The number of columns of the synthetic movie.
+    isize_t m_numCells = 200;               ///< The number of cells of the synthetic cell set and events.
+    isize_t m_numEventsPerCell = 500;       ///< The number of events per cell.
+    isize_t m_numGpioChannels = 8;          ///< The number of channels of the synthetic GPIO capture.
+    isize_t m_numGpioPktsPerChannel = 200000; ///< The number of packets per GPIO channel.
+    isize_t m_numTimingLookups = 1000000;   ///< The number of TimingInfo lookups.
+    isize_t m_numProjectItems = 5000;       ///< The number of series in the synthetic project.
+    isize_t m_numProjectEdits = 100;        ///< The number of edits made to the synthetic project.
+};
+
+/// The amount of work done by one run of a benchmark, which is used to compute its throughput.
+struct BenchWork
+{
+    uint64_t m_numBytes = 0;                ///< The number of bytes read or written.
+    uint64_t m_numItems = 0;                ///< The number of items (e.g. frames or samples) processed.
+};
+
+/// A benchmark, which is set up once and then run several times.
+struct BenchCase
+{
+    std::string m_name;                     ///< The name of the benchmark.
+    std::string m_itemName;                 ///< What an item of work is (e.g. "frames").
+
+    /// Generate the input data of the benchmark, which is not timed.
+    std::function<void(const BenchConfig &)> m_setup;
+
+    /// Do the work to time.
+    std::function<BenchWork(const BenchConfig &)> m_run;
+};
+
+/// The results of a benchmark.
+struct BenchResult
+{
+    std::string m_name;                     ///< The name of the benchmark.
+    std::string m_itemName;                 ///< What an item of work is.
+    std::vector<double> m_elapsedMs;        ///< The elapsed time of each run.
+    BenchWork m_work;                       ///< The work done by one run.
+    uint64_t m_peakRssBytes = 0;            ///< The peak resident set size of the process after the runs.
+    std::string m_error;                    ///< The error message if the benchmark failed.
+};
+
+/// \return     The benchmarks of readers, writers and exporters.
+///
+std::vector<BenchCase> getBenchCases();
+
+/// \return     The peak resident set size of this process in bytes,
+///             or 0 if it cannot be determined.
+uint64_t getPeakRssBytes();
+
+/// Run benchmarks and time them.
+///
+/// \param  inConfig    The configuration of the benchmarks.
+/// \param  inCases     The benchmarks to run.
+/// \return             The results of the benchmarks that matched the filter.
+std::vector<BenchResult> runBenchCases(const BenchConfig & inConfig, const std::vector<BenchCase> & inCases);
+
+/// \param  inConfig    The configuration of the benchmarks.
+/// \param  inResults   The results of the benchmarks.
+/// \return             The results formatted as a JSON document.
+std::string formatBenchResults(const BenchConfig & inConfig, const std::vector<BenchResult> & inResults);
+
+} // namespace isx
+
+#endif // ISX_BENCH_H
@@ -0,0 +1,571 @@
+#include "isxBench.h"
+#include "isxBehavMovieFile.h"
+#include "isxCellSetFactory.h"
+#include "isxCellSetUtils.h"
+#include "isxDecompression.h"
+#include "isxEventBasedFileV2.h"
+#include "isxEventsExporter.h"
+#include "isxExport.h"
+#include "isxGpio.h"
+#include "isxGpioExporter.h"
+#include "isxImage.h"
+#include "isxImageKernels.h"
+#include "isxMosaicMovieFile.h"
+#include "isxMovieCompressedAviExporter.h"
+#include "isxMovieFactory.h"
+#include "isxMovieNWBExporter.h"
+#include "isxMovieTiffExporter.h"
+#include "isxJsonUtils.h"
+#include "isxPathUtils.h"
+#include "isxProject.h"
+#include "isxTrace.h"
+#include "isxWritableEvents.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace isx
+{
+
+namespace
+{
+
+const Time s_startTime(2020, 1, 1, 0, 0, 0, DurationInSeconds(0, 1));
+const DurationInSeconds s_movieStep(50, 1000);
+
+std::string
+getMovieFileName(const BenchConfig & inConfig)
+{
+    return inConfig.m_outputDir + "/bench_movie.isxd";
+}
+
+std::string
+getBehavMovieFileName(const BenchConfig & inConfig)
+{
+    return inConfig.m_outputDir + "/bench_behav.mp4";
+}
+
+std::string
+getCellSetFileName(const BenchConfig & inConfig)
+{
+    return inConfig.m_outputDir + "/bench_cellset.isxd";
+}
+
+std::string
+getEventsFileName(const BenchConfig & inConfig)
+{
+    return inConfig.m_outputDir + "/bench_events.isxd";
+}
+
+std::string
+getGpioFileName(const BenchConfig & inConfig)
+{
+    return inConfig.m_outputDir + "/bench_gpio.isxd";
+}
+
+std::string
+getProjectFileName(const BenchConfig & inConfig)
+{
+    return inConfig.m_outputDir + "/bench_project.isxp";
+}
+
+uint64_t
+getFileSize(const std::string & inFileName)
+{
+    std::ifstream file(inFileName, std::ios::binary | std::ios::ate);
+    if (!file.good())
+    {
+        return 0;
+    }
+    return uint64_t(file.tellg());
+}
+
+void
+checkStatus(const AsyncTaskStatus inStatus, const std::string & inOpName)
+{
+    if (inStatus != AsyncTaskStatus::COMPLETE)
+    {
+        ISX_THROW(ExceptionDataIO, inOpName, " did not complete.");
+    }
+}
+
+TimingInfo
+getMovieTimingInfo(const BenchConfig & inConfig)
+{
+    return TimingInfo(s_startTime, s_movieStep, inConfig.m_numFrames);
+}
+
+SpacingInfo
+getMovieSpacingInfo(const BenchConfig & inConfig)
+{
+    return SpacingInfo(SizeInPixels_t(inConfig.m_numCols, inConfig.m_numRows));
+}
+
+/// Writes a movie with a deterministic pattern of pixel values.
+BenchWork
+writeSyntheticMovie(const BenchConfig & inConfig)
+{
+    const std::string fileName = getMovieFileName(inConfig);
+    std::remove(fileName.c_str());
+
+    BenchWork work;
+    MosaicMovieFile file(fileName, getMovieTimingInfo(inConfig), getMovieSpacingInfo(inConfig), DataType::U16);
+    for (isize_t f = 0; f < inConfig.m_numFrames; ++f)
+    {
+        SpVideoFrame_t frame = file.makeVideoFrame(f);
+        uint16_t * pixels = frame->getPixelsAsU16();
+        const isize_t numPixels = frame->getImageSizeInBytes() / sizeof(uint16_t);
+        for (isize_t p = 0; p < numPixels; ++p)
+        {
+            pixels[p] = uint16_t((p * 7 + f * 13) % 4096);
+        }
+        file.writeFrame(frame);
+        work.m_numBytes += frame->getImageSizeInBytes();
+        ++work.m_numItems;
+    }
+    file.closeForWriting();
+    return work;
+}
+
+BenchWork
+readMovieFrames(const BenchConfig & inConfig)
+{
+    BenchWork work;
+    MosaicMovieFile file(getMovieFileName(inConfig));
+    const isize_t numFrames = file.getTimingInfo().getNumTimes();
+    for (isize_t f = 0; f < numFrames; ++f)
+    {
+        SpVideoFrame_t frame = file.readFrame(f);
+        work.m_numBytes += frame->getImageSizeInBytes();
+        ++work.m_numItems;
+    }
+    return work;
+}
+
+/// Exports the synthetic movie as an mp4, which is imported as a behavioral movie.
+void
+writeSyntheticBehavMovie(const BenchConfig & inConfig)
+{
+    if (!pathExists(getMovieFileName(inConfig)))
+    {
+        writeSyntheticMovie(inConfig);
+    }
+    const std::string fileName = getBehavMovieFileName(inConfig);
+    std::remove(fileName.c_str());
+    MovieCompressedAviExporterParams params({readMovie(getMovieFileName(inConfig))}, fileName, 0.1);
+    checkStatus(runMovieCompressedAviExporter(params), "Compressed AVI export");
+}
+
+BenchWork
+importBehavMovie(const BenchConfig & inConfig, const bool inUseStreamIndex)
+{
+    const std::string fileName = getBehavMovieFileName(inConfig);
+    DataSet::Properties properties;
+    if (!BehavMovieFile::getBehavMovieProperties(fileName, properties, nullptr, inUseStreamIndex))
+    {
+        ISX_THROW(ExceptionFileIO, "Failed to import behavioral movie: ", fileName);
+    }
+
+    BenchWork work;
+    work.m_numBytes = getFileSize(fileName);
+    work.m_numItems = isize_t(properties.at(DataSet::PROP_BEHAV_NUM_FRAMES).value<int64_t>());
+    return work;
+}
+
+/// Looks up times and indices in a timing info with dropped and cropped frames,
+/// which is what the readers and exporters do for every frame or sample.
+BenchWork
+lookUpTimingInfo(const BenchConfig & inConfig)
+{
+    const isize_t numTimes = std::max(inConfig.m_numFrames, isize_t(1000));
+    std::vector<isize_t> dropped;
+    for (isize_t i = 17; i < numTimes; i += 97)
+    {
+        dropped.push_back(i);
+    }
+    IndexRanges_t cropped;
+    for (isize_t i = 50; i + 5 < numTimes; i += 500)
+    {
+        cropped.push_back(IndexRange(i, i + 4));
+    }
+    const TimingInfo ti(s_startTime, s_movieStep, numTimes, dropped, cropped);
+
+    BenchWork work;
+    isize_t checksum = 0;
+    for (isize_t i = 0; i < inConfig.m_numTimingLookups; ++i)
+    {
+        const isize_t index = (i * 7919) % numTimes;
+        const Time time = ti.convertIndexToStartTime(index);
+        checksum += ti.convertTimeToIndex(time);
+        if (ti.isIndexValid(index))
+        {
+            checksum += ti.timeIdxToRecordedIdx(index);
+        }
+        ++work.m_numItems;
+    }
+    if (checksum == 0)
+    {
+        ISX_THROW(ExceptionDataIO, "Unexpected timing lookups.");
+    }
+    return work;
+}
+
+void
+writeSyntheticCellSet(const BenchConfig & inConfig)
+{
+    const std::string fileName = getCellSetFileName(inConfig);
+    std::remove(fileName.c_str());
+
+    const TimingInfo ti = getMovieTimingInfo(inConfig);
+    const SpacingInfo si = getMovieSpacingInfo(inConfig);
+    SpCellSet_t cellSet = isx::writeCellSet(fileName, ti, si);
+    for (isize_t c = 0; c < inConfig.m_numCells; ++c)
+    {
+        SpImage_t image = std::make_shared<Image>(si, si.getNumColumns() * sizeof(float), 1, DataType::F32);
+        float * pixels = image->getPixelsAsF32();
+        const isize_t numPixels = si.getTotalNumPixels();
+        for (isize_t p = 0; p < numPixels; ++p)
+        {
+            pixels[p] = ((p + c) % 1024 == 0) ? 1.f : 0.f;
+        }
+
+        SpFTrace_t trace = std::make_shared<FTrace_t>(ti);
+        float * values = trace->getValues();
+        for (isize_t t = 0; t < ti.getNumTimes(); ++t)
+        {
+            values[t] = float((t * 31 + c * 17) % 1000) / 100.f;
+        }
+        cellSet->writeImageAndTrace(c, image, trace);
+    }
+    cellSet->closeForWriting();
+}
+
+BenchWork
+readCellSetTraces(const BenchConfig & inConfig, std::vector<SpFTrace_t> & outTraces, std::vector<std::string> & outNames)
+{
+    BenchWork work;
+    SpCellSet_t cellSet = readCellSet(getCellSetFileName(inConfig));
+    const isize_t numCells = cellSet->getNumCells();
+    outTraces.clear();
+    outNames.clear();
+    for (isize_t c = 0; c < numCells; ++c)
+    {
+        outTraces.push_back(cellSet->getTrace(c));
+        outNames.push_back(cellSet->getCellName(c));
+        work.m_numBytes += outTraces.back()->getTimingInfo().getNumTimes() * sizeof(float);
+        work.m_numItems += outTraces.back()->getTimingInfo().getNumTimes();
+    }
+    return work;
+}
+
+/// Make the normalized cell map of the synthetic cell set, optionally
+/// with the scalar kernels on one thread to compare against.
+BenchWork
+makeCellMap(const BenchConfig & inConfig, const bool inScalar)
+{
+    SpCellSet_t cellSet = readCellSet(getCellSetFileName(inConfig));
+    const ImageKernelsIsa isa = getImageKernelsIsa();
+    if (inScalar)
+    {
+        setImageKernelsIsa(ImageKernelsIsa::SCALAR);
+    }
+
+    SpImage_t cellMap;
+    try
+    {
+        cellMap = cellSetToCellMap(cellSet, false, true, 0.5f, inScalar ? 1 : 0);
+    }
+    catch (...)
+    {
+        setImageKernelsIsa(isa);
+        throw;
+    }
+    setImageKernelsIsa(isa);
+
+    BenchWork work;
+    work.m_numItems = cellSet->getNumCells();
+    work.m_numBytes = work.m_numItems * cellMap->getImageSizeInBytes();
+    return work;
+}
+
+void
+writeSyntheticEvents(const BenchConfig & inConfig)
+{
+    const std::string fileName = getEventsFileName(inConfig);
+    std::remove(fileName.c_str());
+
+    const TimingInfo ti = getMovieTimingInfo(inConfig);
+    std::vector<std::string> names;
+    for (isize_t c = 0; c < inConfig.m_numCells; ++c)
+    {
+        names.push_back("C" + std::to_string(c));
+    }
+    const std::vector<DurationInSeconds> steps(names.size(), ti.getStep());
+    SpWritableEvents_t events = isx::writeEvents(fileName, names, steps);
+    events->setTimingInfo(ti);
+
+    const uint64_t durationUs = uint64_t(ti.getDuration().toDouble() * 1e6);
+    for (isize_t c = 0; c < inConfig.m_numCells; ++c)
+    {
+        for (isize_t e = 0; e < inConfig.m_numEventsPerCell; ++e)
+        {
+            const uint64_t offsetUs = ((e * durationUs) / inConfig.m_numEventsPerCell + c * 997) % durationUs;
+            const uint64_t timeUs = uint64_t(s_startTime.getSecsSinceEpoch().toDouble() * 1e6) + offsetUs;
+            events->writeDataPkt(c, timeUs, float((e + c) % 10) + 0.5f);
+        }
+    }
+    events->closeForWriting();
+}
+
+void
+writeSyntheticGpio(const BenchConfig & inConfig)
+{
+    const std::string fileName = getGpioFileName(inConfig);
+    std::remove(fileName.c_str());
+
+    std::vector<std::string> names;
+    for (isize_t c = 0; c < inConfig.m_numGpioChannels; ++c)
+    {
+        names.push_back("GPIO-" + std::to_string(c + 1));
+    }
+    const DurationInSeconds step(1, 1000);
+    const std::vector<DurationInSeconds> steps(names.size(), step);
+    const std::vector<SignalType> types(names.size(), SignalType::SPARSE);
+
+    EventBasedFileV2 file(fileName, DataSet::Type::GPIO, names, steps, types);
+    std::vector<EventBasedFileV2::DataPkt> pkts;
+    pkts.reserve(inConfig.m_numGpioChannels);
+    for (isize_t p = 0; p < inConfig.m_numGpioPktsPerChannel; ++p)
+    {
+        pkts.clear();
+        for (isize_t c = 0; c < inConfig.m_numGpioChannels; ++c)
+        {
+            pkts.emplace_back(uint64_t(p) * 1000, float((p + c) % 2), uint64_t(c));
+        }
+        file.writeDataPkts(pkts);
+    }
+    const Time endTime = s_startTime + DurationInSeconds::fromMilliseconds(inConfig.m_numGpioPktsPerChannel);
+    file.setTimingInfo(s_startTime, endTime);
+    file.closeFileForWriting();
+}
+
+/// Writes a project with one unitary series per item, whose data sets
+/// refer to files that do not exist, since they are never read.
+void
+writeSyntheticProject(const BenchConfig & inConfig)
+{
+    const std::string fileName = getProjectFileName(inConfig);
+    const std::string dataPath = inConfig.m_outputDir + "/bench_project_data";
+    makeDirectory(dataPath);
+
+    const HistoricalDetails history("isxbench", "");
+    auto root = std::make_shared<Group>("/");
+    for (isize_t i = 0; i < inConfig.m_numProjectItems; ++i)
+    {
+        const std::string name = "movie" + std::to_string(i);
+        auto series = std::make_shared<Series>(
+                name, DataSet::Type::MOVIE, dataPath + "/" + name + ".isxd", history, DataSet::Properties());
+        root->insertGroupMember(series, root->getNumGroupMembers());
+    }
+
+    json project;
+    project["name"] = "bench_project";
+    project["rootGroup"] = root->toJson(inConfig.m_outputDir);
+    project["fileVersion"] = 0;
+    std::ofstream file(fileName, std::ios::trunc);
+    writeJson(project, file);
+}
+
+/// Renames series of a synthetic project, which saves the temporary project after every edit.
+BenchWork
+editSyntheticProject(const BenchConfig & inConfig)
+{
+    Project project(getProjectFileName(inConfig));
+    Group * root = project.getRootGroup();
+    const isize_t numItems = root->getNumGroupMembers();
+    for (isize_t e = 0; e < inConfig.m_numProjectEdits; ++e)
+    {
+        ProjectItem * item = root->getGroupMember((e * 7919) % numItems);
+        item->setName("edited" + std::to_string(e));
+    }
+    project.flushTmp();
+
+    BenchWork work;
+    work.m_numBytes = getFileSize(getProjectFileName(inConfig) + ".tmp");
+    work.m_numItems = inConfig.m_numProjectEdits;
+    return work;
+}
+
+BenchCase
+makeCase(
+        const std::string & inName,
+        const std::string & inItemName,
+        std::function<void(const BenchConfig &)> inSetup,
+        std::function<BenchWork(const BenchConfig &)> inRun)
+{
+    BenchCase benchCase;
+    benchCase.m_name = inName;
+    benchCase.m_itemName = inItemName;
+    benchCase.m_setup = inSetup;
+    benchCase.m_run = inRun;
+    return benchCase;
+}
+
+} // namespace
+
+std::vector<BenchCase>
+getBenchCases()
+{
+    const auto setupMovie = [](const BenchConfig & inConfig)
+    {
+        if (!pathExists(getMovieFileName(inConfig)))
+        {
+            writeSyntheticMovie(inConfig);
+        }
+    };
+
+    std::vector<BenchCase> cases;
+
+    cases.push_back(makeCase("MosaicMovieFile-write", "frames", nullptr, writeSyntheticMovie));
+
+    cases.push_back(makeCase("MosaicMovieFile-read", "frames", setupMovie, readMovieFrames));
+
+    cases.push_back(makeCase("TimingInfo-lookups", "lookups", nullptr, lookUpTimingInfo));
+
+    cases.push_back(makeCase("CellSet-readAllTraces", "samples", writeSyntheticCellSet,
+        [](const BenchConfig & inConfig)
+        {
+            std::vector<SpFTrace_t> traces;
+            std::vector<std::string> names;
+            return readCellSetTraces(inConfig, traces, names);
+        }));
+
+    cases.push_back(makeCase("CellSet-exportCsv", "samples", writeSyntheticCellSet,
+        [](const BenchConfig & inConfig)
+        {
+            std::vector<SpFTrace_t> traces;
+            std::vector<std::string> names;
+            BenchWork work = readCellSetTraces(inConfig, traces, names);
+
+            const std::string fileName = inConfig.m_outputDir + "/bench_cellset.csv";
+            {
+                std::ofstream stream(fileName);
+                writeTraces(stream, {traces}, names, {}, s_startTime, DataSet::Type::CELLSET);
+            }
+            work.m_numBytes = getFileSize(fileName);
+            return work;
+        }));
+
+    cases.push_back(makeCase("CellSet-cellMap", "cells", writeSyntheticCellSet,
+        [](const BenchConfig & inConfig) { return makeCellMap(inConfig, false); }));
+
+    cases.push_back(makeCase("CellSet-cellMap-scalar", "cells", writeSyntheticCellSet,
+        [](const BenchConfig & inConfig) { return makeCellMap(inConfig, true); }));
+
+    cases.push_back(makeCase("EventBasedFileV2-readAllTraces", "packets", writeSyntheticGpio,
+        [](const BenchConfig & inConfig)
+        {
+            EventBasedFileV2 file(getGpioFileName(inConfig));
+            std::vector<SpFTrace_t> continuousTraces;
+            std::vector<SpLogicalTrace_t> logicalTraces;
+            file.readAllTraces(continuousTraces, logicalTraces);
+
+            BenchWork work;
+            work.m_numBytes = getFileSize(getGpioFileName(inConfig));
+            work.m_numItems = inConfig.m_numGpioChannels * inConfig.m_numGpioPktsPerChannel;
+            return work;
+        }));
+
+    cases.push_back(makeCase("Events-exportCsv", "events", writeSyntheticEvents,
+        [](const BenchConfig & inConfig)
+        {
+            const std::string fileName = inConfig.m_outputDir + "/bench_events.csv";
+            EventsExporterParams params({readEvents(getEventsFileName(inConfig))}, fileName,
+                    WriteTimeRelativeTo::FIRST_DATA_ITEM);
+            checkStatus(runEventsExporter(params), "Events export");
+
+            BenchWork work;
+            work.m_numBytes = getFileSize(fileName);
+            work.m_numItems = inConfig.m_numCells * inConfig.m_numEventsPerCell;
+            return work;
+        }));
+
+    cases.push_back(makeCase("Gpio-exportCsv", "packets", writeSyntheticGpio,
+        [](const BenchConfig & inConfig)
+        {
+            const std::string fileName = inConfig.m_outputDir + "/bench_gpio.csv";
+            GpioExporterParams params({readGpio(getGpioFileName(inConfig))}, fileName,
+                    WriteTimeRelativeTo::FIRST_DATA_ITEM);
+            checkStatus(runGpioExporter(params), "GPIO export");
+
+            BenchWork work;
+            work.m_numBytes = getFileSize(fileName);
+            work.m_numItems = inConfig.m_numGpioChannels * inConfig.m_numGpioPktsPerChannel;
+            return work;
+        }));
+
+    cases.push_back(makeCase("Movie-exportTiff", "frames", setupMovie,
+        [](const BenchConfig & inConfig)
+        {
+            const std::string fileName = inConfig.m_outputDir + "/bench_movie.tif";
+            MovieTiffExporterParams params({isx::readMovie(getMovieFileName(inConfig))}, fileName);
+            checkStatus(runMovieTiffExporter(params), "TIFF export");
+
+            BenchWork work;
+            work.m_numBytes = getFileSize(fileName);
+            work.m_numItems = inConfig.m_numFrames;
+            return work;
+        }));
+
+    cases.push_back(makeCase("Movie-exportNwb", "frames", setupMovie,
+        [](const BenchConfig & inConfig)
+        {
+            const std::string fileName = inConfig.m_outputDir + "/bench_movie.nwb";
+            std::remove(fileName.c_str());
+            MovieNWBExporterParams params({isx::readMovie(getMovieFileName(inConfig))}, fileName,
+                    "isxbench", "Synthetic movie exported by isxbench");
+            checkStatus(runMovieNWBExporter(params), "NWB export");
+
+            BenchWork work;
+            work.m_numBytes = getFileSize(fileName);
+            work.m_numItems = inConfig.m_numFrames;
+            return work;
+        }));
+
+    cases.push_back(makeCase("BehavMovie-importIndex", "frames", writeSyntheticBehavMovie,
+        [](const BenchConfig & inConfig) { return importBehavMovie(inConfig, true); }));
+
+    cases.push_back(makeCase("BehavMovie-importScan", "frames", writeSyntheticBehavMovie,
+        [](const BenchConfig & inConfig) { return importBehavMovie(inConfig, false); }));
+
+    cases.push_back(makeCase("Project-edit", "edits", writeSyntheticProject, editSyntheticProject));
+
+    // There is no writer for compressed movies, so this only runs on a file given on the command line.
+    cases.push_back(makeCase("CompressedMovie-decompress", "bytes",
+        [](const BenchConfig & inConfig)
+        {
+            if (inConfig.m_compressedMovie.empty())
+            {
+                ISX_THROW(ExceptionUserInput, "Skipped because no compressed movie was given with --compressed-movie.");
+            }
+        },
+        [](const BenchConfig & inConfig)
+        {
+            const std::string outputDir = inConfig.m_outputDir + "/decompressed";
+            removeDirectory(outputDir);
+            makeDirectory(outputDir);
+            auto outputParams = std::make_shared<DecompressOutputParams>();
+            checkStatus(runDecompression(DecompressParams(outputDir, inConfig.m_compressedMovie), outputParams,
+                    [](float) { return false; }), "Decompression");
+
+            BenchWork work;
+            work.m_numBytes = getFileSize(outputParams->filename);
+            work.m_numItems = getFileSize(inConfig.m_compressedMovie);
+            return work;
+        }));
+
+    return cases;
+}
+
+} // namespace isx
@@ -0,0 +1,194 @@
+#include "isxBench.h"
+#include "isxPathUtils.h"
+
+#include <QCoreApplication>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void
+usage()
+{
+    std::cout << "Usage: isxbench [options]\n"
+              << "Generates synthetic data sets and times the readers, writers and exporters.\n"
+              << "The results are written as JSON.\n\n"
+              << "  -o, --output <file>             write the results to a file instead of stdout\n"
+              << "  -d, --output-dir <dir>          directory for synthetic and exported files (default: isxbench_data)\n"
+              << "  -f, --filter <text>             only run benchmarks whose name contains the text\n"
+              << "  -r, --repeats <n>               number of timed runs per benchmark (default: 3)\n"
+              << "  --frames <n>                    number of movie frames (default: 1000)\n"
+              << "  --rows <n>                      number of movie rows (default: 400)\n"
+              << "  --cols <n>                      number of movie columns (default: 640)\n"
+              << "  --cells <n>                     number of cells (default: 200)\n"
+              << "  --events-per-cell <n>           number of events per cell (default: 500)\n"
+              << "  --gpio-channels <n>             number of GPIO channels (default: 8)\n"
+              << "  --gpio-packets-per-channel <n>  number of GPIO packets per channel (default: 200000)\n"
+              << "  --timing-lookups <n>            number of TimingInfo lookups (default: 1000000)\n"
+              << "  --project-items <n>             number of series in the project (default: 5000)\n"
+              << "  --project-edits <n>             number of edits made to the project (default: 100)\n"
+              << "  --compressed-movie <file>       compressed movie (.isxc) to decompress\n"
+              << "  --keep                          keep the output directory\n"
+              << "  -h, --help                      show this message\n";
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    isx::BenchConfig config;
+    config.m_outputDir = "isxbench_data";
+    std::string outputFile;
+    bool keep = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a(argv[i]);
+        if (a == "-h" || a == "--help")
+        {
+            usage();
+            return 0;
+        }
+        if (a == "--keep")
+        {
+            keep = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option: " << a << "\n";
+            usage();
+            return 1;
+        }
+        const std::string value(argv[++i]);
+        try
+        {
+            if (a == "-o" || a == "--output")
+            {
+                outputFile = value;
+            }
+            else if (a == "-d" || a == "--output-dir")
+            {
+                config.m_outputDir = value;
+            }
+            else if (a == "-f" || a == "--filter")
+            {
+                config.m_filter = value;
+            }
+            else if (a == "-r" || a == "--repeats")
+            {
+                config.m_numRepeats = std::stoull(value);
+            }
+            else if (a == "--frames")
+            {
+                config.m_numFrames = std::stoull(value);
+            }
+            else if (a == "--rows")
+            {
+                config.m_numRows = std::stoull(value);
+            }
+            else if (a == "--cols")
+            {
+                config.m_numCols = std::stoull(value);
+            }
+            else if (a == "--cells")
+            {
+                config.m_numCells = std::stoull(value);
+            }
+            else if (a == "--events-per-cell")
+            {
+                config.m_numEventsPerCell = std::stoull(value);
+            }
+            else if (a == "--gpio-channels")
+            {
+                config.m_numGpioChannels = std::stoull(value);
+            }
+            else if (a == "--gpio-packets-per-channel")
+            {
+                config.m_numGpioPktsPerChannel = std::stoull(value);
+            }
+            else if (a == "--timing-lookups")
+            {
+                config.m_numTimingLookups = std::stoull(value);
+            }
+            else if (a == "--project-items")
+            {
+                config.m_numProjectItems = std::stoull(value);
+            }
+            else if (a == "--project-edits")
+            {
+                config.m_numProjectEdits = std::stoull(value);
+            }
+            else if (a == "--compressed-movie")
+            {
+                config.m_compressedMovie = value;
+            }
+            else
+            {
+                std::cerr << "Unknown option: " << a << "\n";
+                usage();
+                return 1;
+            }
+        }
+        catch (const std::exception &)
+        {
+            std::cerr << "Invalid value for option " << a << ": " << value << "\n";
+            return 1;
+        }
+    }
+
+    if (config.m_numRepeats == 0 || config.m_numFrames == 0 || config.m_numRows == 0 || config.m_numCols == 0
+        || config.m_numCells == 0 || config.m_numEventsPerCell == 0 || config.m_numGpioChannels == 0
+        || config.m_numGpioPktsPerChannel == 0 || config.m_numProjectItems == 0 || config.m_numProjectEdits == 0)
+    {
+        std::cerr << "The number of repeats and the sizes of the data sets must be positive.\n";
+        return 1;
+    }
+
+    // needed for starting event loop on private threads (via QThread::exec)
+    int one = 1;
+    QCoreApplication app(one, argv);
+
+    isx::CoreInitialize();
+
+    const bool createdOutputDir = !isx::pathExists(config.m_outputDir);
+    isx::makeDirectory(config.m_outputDir);
+
+    const std::vector<isx::BenchResult> results = isx::runBenchCases(config, isx::getBenchCases());
+    const std::string json = isx::formatBenchResults(config, results);
+
+    if (createdOutputDir && !keep)
+    {
+        isx::removeDirectory(config.m_outputDir);
+    }
+
+    isx::CoreShutdown();
+
+    if (outputFile.empty())
+    {
+        std::cout << json << "\n";
+    }
+    else
+    {
+        std::ofstream stream(outputFile);
+        stream << json << "\n";
+        if (!stream.good())
+        {
+            std::cerr << "Failed to write results to " << outputFile << "\n";
+            return 1;
+        }
+    }
+
+    for (const auto & result : results)
+    {
+        if (!result.m_error.empty())
+        {
+            std::cerr << result.m_name << ": " << result.m_error << "\n";
+        }
+    }
+    return 0;
+}
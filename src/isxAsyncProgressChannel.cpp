@@ -0,0 +1,93 @@
+#include "isxAsyncProgressChannel.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace isx
+{
+
+const isize_t AsyncProgressChannel::s_defaultMaxPublishesPerSecond;
+constexpr float AsyncProgressChannel::s_defaultMinProgressDelta;
+
+AsyncProgressChannel::AsyncProgressChannel(
+        const isize_t inMaxPublishesPerSecond,
+        const float inMinProgressDelta)
+    : m_minPublishIntervalNs(inMaxPublishesPerSecond == 0 ? 0 : int64_t(1000000000 / inMaxPublishesPerSecond))
+    , m_minProgressDelta(inMinProgressDelta)
+    , m_latestProgress(0.0f)
+    , m_publishedProgress(-1.0f)
+    , m_publishedNs(0)
+    , m_publishPending(false)
+    , m_cancelPending(false)
+{
+}
+
+bool
+AsyncProgressChannel::update(const float inProgress)
+{
+    m_latestProgress.store(inProgress, std::memory_order_relaxed);
+
+    // A pending publication will take the latest progress, so this one is coalesced into it.
+    if (m_publishPending.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    const bool significant = (inProgress >= 1.0f)
+        || (std::abs(inProgress - m_publishedProgress.load(std::memory_order_relaxed)) >= m_minProgressDelta);
+    const int64_t nowNs = getNowNs();
+    if (!significant && (nowNs - m_publishedNs.load(std::memory_order_relaxed)) < m_minPublishIntervalNs)
+    {
+        return false;
+    }
+    return tryRequestPublish(nowNs, inProgress);
+}
+
+bool
+AsyncProgressChannel::flush()
+{
+    const float latest = m_latestProgress.load(std::memory_order_relaxed);
+    if (latest == m_publishedProgress.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+    return tryRequestPublish(getNowNs(), latest);
+}
+
+float
+AsyncProgressChannel::takeLatest()
+{
+    // Clear the pending flag before reading, so that a check-in made after
+    // the read requests another publication instead of being lost.
+    m_publishPending.store(false, std::memory_order_release);
+    const float latest = m_latestProgress.load(std::memory_order_relaxed);
+    m_publishedProgress.store(latest, std::memory_order_relaxed);
+    return latest;
+}
+
+void
+AsyncProgressChannel::cancel()
+{
+    m_cancelPending.store(true, std::memory_order_relaxed);
+}
+
+int64_t
+AsyncProgressChannel::getNowNs()
+{
+    return int64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool
+AsyncProgressChannel::tryRequestPublish(const int64_t inNowNs, const float inProgress)
+{
+    if (m_publishPending.exchange(true, std::memory_order_acq_rel))
+    {
+        return false;
+    }
+    m_publishedNs.store(inNowNs, std::memory_order_relaxed);
+    m_publishedProgress.store(inProgress, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace isx
@@ -0,0 +1,105 @@
+#ifndef ISX_ASYNC_PROGRESS_CHANNEL_H
+#define ISX_ASYNC_PROGRESS_CHANNEL_H
+
+#include "isxCore.h"
+
+#include <atomic>
+
+namespace isx
+{
+
+/// Coalesces the progress reported by an asynchronous task.
+///
+/// Tasks check in very frequently (e.g. for every row or frame that they export),
+/// so publishing every check-in would flood the thread that consumes progress.
+/// Instead, a check-in stores the latest progress and only requests that it be
+/// published if the previous publication has been consumed, and either enough
+/// time has passed since it or the progress has changed significantly.
+/// The consumer then takes the latest progress, so check-ins made while a
+/// publication is pending are coalesced into it.
+///
+/// All members are lock free, so that a check-in is cheap, and can be called
+/// from the task thread while the consumer runs on another thread.
+class AsyncProgressChannel
+{
+public:
+    /// The default maximum number of publications per second.
+    static const isize_t s_defaultMaxPublishesPerSecond = 20;
+
+    /// The default change in progress that is published regardless of time.
+    static constexpr float s_defaultMinProgressDelta = 0.01f;
+
+    /// Constructor.
+    ///
+    /// \param  inMaxPublishesPerSecond The maximum number of publications per second,
+    ///                                 except for significant changes and completion,
+    ///                                 or 0 for no limit.
+    /// \param  inMinProgressDelta      The change in progress since the last publication
+    ///                                 that is published regardless of time.
+    AsyncProgressChannel(
+            const isize_t inMaxPublishesPerSecond = s_defaultMaxPublishesPerSecond,
+            const float inMinProgressDelta = s_defaultMinProgressDelta);
+
+    /// Store the latest progress of the task.
+    ///
+    /// \param  inProgress  The progress of the task (0.0: not started, 1.0: complete).
+    /// \return             True if the caller should arrange for the progress to be
+    ///                     published by calling takeLatest, false otherwise.
+    bool update(const float inProgress);
+
+    /// Request to publish the latest progress if it has not been published yet,
+    /// regardless of time. This should be called when the task finishes.
+    ///
+    /// \return             True if the caller should arrange for the progress to be
+    ///                     published by calling takeLatest, false otherwise.
+    bool flush();
+
+    /// Take the latest progress to publish it.
+    ///
+    /// This must be called once after update or flush returned true.
+    ///
+    /// \return             The latest progress of the task.
+    float takeLatest();
+
+    /// Request the task to be cancelled.
+    void cancel();
+
+    /// \return             True if the task has been requested to be cancelled.
+    bool isCancelPending() const
+    {
+        return m_cancelPending.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// \return             The current time of a steady clock in nanoseconds.
+    static int64_t getNowNs();
+
+    /// \return             True if the caller may publish, false if a publication is pending.
+    bool tryRequestPublish(const int64_t inNowNs, const float inProgress);
+
+    /// The minimum time between publications that are not significant.
+    const int64_t m_minPublishIntervalNs;
+
+    /// The change in progress that is significant.
+    const float m_minProgressDelta;
+
+    /// The latest progress reported by the task.
+    std::atomic<float> m_latestProgress;
+
+    /// The last progress that was requested to be published or taken.
+    /// This is negative before the first publication, so the first check-in is significant.
+    std::atomic<float> m_publishedProgress;
+
+    /// The time of the last request to publish.
+    std::atomic<int64_t> m_publishedNs;
+
+    /// True if a publication has been requested, but the progress has not been taken yet.
+    std::atomic<bool> m_publishPending;
+
+    /// True if the task has been requested to be cancelled.
+    std::atomic<bool> m_cancelPending;
+};
+
+} // namespace isx
+
+#endif // ISX_ASYNC_PROGRESS_CHANNEL_H
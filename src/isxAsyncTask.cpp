@@ -23,36 +23,41 @@ AsyncTask::~AsyncTask() {}
 void 
 AsyncTask::cancel() 
 {
-    m_cancelPending = true;
+    m_progressChannel->cancel();
 }
 
 void 
 AsyncTask::schedule() 
 {
     WpAsyncTaskHandle_t weakThis = shared_from_this();
+    std::shared_ptr<AsyncProgressChannel> channel = m_progressChannel;
+    const bool hasProgressCB = bool(m_progressCB);
 
-    AsyncCheckInCB_t ci =[weakThis, this](float inProgress)
+    auto publishProgress = [weakThis, this, channel]()
     {
-        SpAsyncTaskHandle_t sharedThis = weakThis.lock();
-        if (!sharedThis)
-        {
-            return false;
-        }
-        if (m_progressCB)
+        DispatchQueue::mainQueue()->dispatch([weakThis, this, channel](){
+            const float progress = channel->takeLatest();
+            SpAsyncTaskHandle_t sharedThis = weakThis.lock();
+            if (!sharedThis)
+            {
+                return;
+            }
+            m_progressCB(progress);
+        });
+    };
+
+    // The check-in only touches the channel, which it shares, so it does not
+    // need to lock this task and only dispatches when progress is published.
+    AsyncCheckInCB_t ci = [channel, hasProgressCB, publishProgress](float inProgress)
+    {
+        if (hasProgressCB && channel->update(inProgress))
         {
-            DispatchQueue::mainQueue()->dispatch([weakThis, this, inProgress](){
-                SpAsyncTaskHandle_t sharedThis = weakThis.lock();
-                if (!sharedThis)
-                {
-                    return;
-                }
-                m_progressCB(inProgress);
-            });
+            publishProgress();
         }
-        return this->m_cancelPending;
+        return channel->isCancelPending();
     };
 
-    DispatchQueue::poolQueue()->dispatch([weakThis, this, ci](){
+    DispatchQueue::poolQueue()->dispatch([weakThis, this, ci, channel, hasProgressCB, publishProgress](){
         SpAsyncTaskHandle_t sharedThis = weakThis.lock();
         if (!sharedThis)
         {
@@ -65,6 +70,11 @@ AsyncTask::schedule()
             m_exception = std::current_exception();
             m_taskStatus = AsyncTaskStatus::ERROR_EXCEPTION;
         }
+        // Publish the last progress that may have been coalesced, before the task finishes.
+        if (hasProgressCB && channel->flush())
+        {
+            publishProgress();
+        }
         if (m_finishedCB)
         {
             if (m_threadForFinishedCB == AsyncTaskThreadForFinishedCB::USE_MAIN)
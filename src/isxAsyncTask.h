@@ -3,6 +3,7 @@
 
 #include "isxCore.h"
 #include "isxAsyncTaskHandle.h"
+#include "isxAsyncProgressChannel.h"
 #include <functional>
 #include <memory>
 
@@ -11,6 +12,9 @@ namespace isx
 /// A class providing an interface for dealing with running tasks asynchronously.
 /// Provided cancellation and progressr reporting.
 ///
+/// Progress is coalesced by an AsyncProgressChannel, so the progress callback
+/// is called on the main thread at a limited rate, however often the task checks in.
+///
 class AsyncTask 
 : public AsyncTaskHandle
 , public std::enable_shared_from_this<isx::AsyncTask>
@@ -55,7 +59,7 @@ public:
     getExceptionPtr() const override;
 
 private:
-    bool                            m_cancelPending = false;
+    std::shared_ptr<AsyncProgressChannel> m_progressChannel = std::make_shared<AsyncProgressChannel>();
     AsyncFunc_t                     m_task;
     AsyncProgressCB_t               m_progressCB;
     AsyncFinishedCB_t               m_finishedCB;
@@ -115,6 +115,29 @@ namespace
     }
 
     const char errorMessageUserManual[] = "Import of behavioral video failed. Please refer to the User Manual - Behavioral Movie section for help on supported video formats and how to convert your files.";
+
+    /// The number of video packets read between reports of progress when scanning all frames.
+    const int64_t s_numPacketsPerCheckIn = 64;
+
+    int
+    getNumIndexEntries(AVStream * inStream)
+    {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+        return avformat_index_get_entries_count(inStream);
+#else
+        return inStream->nb_index_entries;
+#endif
+    }
+
+    const AVIndexEntry *
+    getIndexEntry(AVStream * inStream, const int inIndex)
+    {
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+        return avformat_index_get_entry(inStream, inIndex);
+#else
+        return &inStream->index_entries[inIndex];
+#endif
+    }
 }
 
 namespace isx
@@ -552,6 +575,7 @@ BehavMovieFile::scanAllFrames(int64_t & outFrameCount, int64_t & outGopSize, Asy
     int64_t lastIFrame = -1;
     while (!(readRes = av_read_frame(m_formatCtx, m_pPacket.get())))
     {
+        bool checkIn = false;
         if (m_pPacket->stream_index == m_videoStreamIndex)
         {
             if (m_pPacket->pts == AV_NOPTS_VALUE)
@@ -567,10 +591,11 @@ BehavMovieFile::scanAllFrames(int64_t & outFrameCount, int64_t & outGopSize, Asy
                 }
                 lastIFrame = frameCount;
             }
+            checkIn = (frameCount % s_numPacketsPerCheckIn) == 0;
             ++frameCount;
         }
         av_packet_unref(m_pPacket.get());
-        if (inCheckInCB)
+        if (inCheckInCB && checkIn)
         {
             auto cancel = inCheckInCB(float(double(m_formatCtx->pb->pos) / double(fileLength)));
             if (cancel)
@@ -588,6 +613,67 @@ BehavMovieFile::scanAllFrames(int64_t & outFrameCount, int64_t & outGopSize, Asy
     return true;
 }
 
+bool
+BehavMovieFile::countFramesFromStreamIndex(int64_t & outFrameCount, int64_t & outGopSize)
+{
+    if (m_formatCtx->iformat == nullptr || m_formatCtx->iformat->name == nullptr
+        || std::strstr(m_formatCtx->iformat->name, "mov") == nullptr)
+    {
+        return false;
+    }
+
+    AVStream * stream = m_formatCtx->streams[m_videoStreamIndex];
+    const int numEntries = getNumIndexEntries(stream);
+
+    // The sample count of the stsz table is the number of frames of the stream,
+    // so an index with a different number of entries is incomplete (e.g. fragmented mp4).
+    if (numEntries <= 0 || stream->nb_frames != int64_t(numEntries))
+    {
+        return false;
+    }
+
+    int64_t frameCount = 0;
+    int64_t gopSize = 0;
+    int64_t lastIFrame = -1;
+    int64_t lastTimestamp = AV_NOPTS_VALUE;
+    for (int i = 0; i < numEntries; ++i)
+    {
+        const AVIndexEntry * entry = getIndexEntry(stream, i);
+
+        // Frames without time stamps, that are discarded by edit lists or that are empty
+        // may not be read as packets, so those are left to the packet scan, which also
+        // reports the errors of the frames it cannot import.
+        // The index stores decoding time stamps, which strictly increase even with
+        // bipredictive frames, so time stamps that do not increase only indicate a
+        // malformed index. Frames are counted in decoding order, like the packet scan.
+        if (entry == nullptr
+            || entry->timestamp == AV_NOPTS_VALUE
+            || entry->size <= 0
+#ifdef AVINDEX_DISCARD_FRAME
+            || (entry->flags & AVINDEX_DISCARD_FRAME)
+#endif
+            || (lastTimestamp != AV_NOPTS_VALUE && entry->timestamp <= lastTimestamp))
+        {
+            return false;
+        }
+        lastTimestamp = entry->timestamp;
+
+        if (entry->flags & AVINDEX_KEYFRAME)
+        {
+            if (lastIFrame != -1)
+            {
+                gopSize = std::max(gopSize, frameCount - lastIFrame);
+            }
+            lastIFrame = frameCount;
+        }
+        ++frameCount;
+    }
+
+    outFrameCount = frameCount;
+    outGopSize = gopSize;
+    return true;
+}
+
 bool
 BehavMovieFile::initializeFromStream(const Time & inStartTime, int64_t inGopSize, int64_t inNumFrames)
 {
@@ -721,12 +807,24 @@ bool
 BehavMovieFile::getBehavMovieProperties(
     const std::string & inFileName,
     DataSet::Properties & outProperties,
-    AsyncCheckInCB_t inCheckInCB)
+    AsyncCheckInCB_t inCheckInCB,
+    const bool inUseStreamIndex)
 {
     std::unique_ptr<BehavMovieFile> m(new BehavMovieFile(inFileName));
     int64_t gopSize = -1;
     int64_t numFrames = -1;
-    if (m->scanAllFrames(numFrames, gopSize, inCheckInCB))
+    bool counted = false;
+    if (inUseStreamIndex && m->countFramesFromStreamIndex(numFrames, gopSize))
+    {
+        counted = !(inCheckInCB && inCheckInCB(1.f));
+    }
+    else
+    {
+        ISX_LOG_DEBUG("Behavioral video import, scanning all packets: ", inFileName);
+        counted = m->scanAllFrames(numFrames, gopSize, inCheckInCB);
+    }
+
+    if (counted)
     {
         outProperties[DataSet::PROP_BEHAV_NUM_FRAMES] = Variant(numFrames);
         outProperties[DataSet::PROP_BEHAV_GOP_SIZE] = Variant(gopSize);
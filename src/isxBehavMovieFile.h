@@ -51,9 +51,15 @@ public:
     /// \param outProperties    Reference of a Properties object to fill with # frames and gopsize.
     /// \param inCheckInCB      Callback function to call periodically to report progress and check
     ///                         for cancellation.
+    /// \param inUseStreamIndex If true, the properties are derived from the stream index of the
+    ///                         container when it is complete, rather than by reading all packets.
     static
     bool
-    getBehavMovieProperties(const std::string & inFileName, DataSet::Properties & outProperties, AsyncCheckInCB_t inCheckInCB = nullptr);
+    getBehavMovieProperties(
+        const std::string & inFileName,
+        DataSet::Properties & outProperties,
+        AsyncCheckInCB_t inCheckInCB = nullptr,
+        const bool inUseStreamIndex = true);
     
     /// \return True if the movie file is valid, false otherwise.
     ///
@@ -113,6 +119,17 @@ private:
     bool
     scanAllFrames(int64_t & outFrameCount, int64_t & outGopSize, AsyncCheckInCB_t inCheckInCB);
 
+    /// Count the frames and find the max GOP size from the stream index of the container,
+    /// without reading any packets.
+    ///
+    /// Only the mov/mp4 demuxer indexes every sample with its key frame flag from the
+    /// stss and stsz tables when the file is opened, so other containers are not
+    /// supported. The index is also rejected if it is inconsistent with the stream.
+    ///
+    /// \return True if the index was used, false if all frames must be scanned instead.
+    bool
+    countFramesFromStreamIndex(int64_t & outFrameCount, int64_t & outGopSize);
+
     /// Initialize this instance from video stream in file.
     ///
     bool
@@ -1,4 +1,5 @@
 #include "isxCellSetFile.h"
+#include "isxMetadataProbe.h"
 #include "isxImage.h"
 #include "isxException.h"
 #include "isxAssert.h"
@@ -30,6 +31,11 @@ namespace isx
         readHeader();
         m_fileClosedForWriting = !enableWrite;
         m_valid = true;
+
+        if (!enableWrite)
+        {
+            m_fileHandle.manageStream(m_file, m_fileName, m_openmode);
+        }
     }
 
     CellSetFile::CellSetFile(const std::string & inFileName,
@@ -61,6 +67,7 @@ namespace isx
                 closeForWriting();
             }
 
+            m_fileHandle.unmanage();
             isx::closeFileStreamWithChecks(m_file, m_fileName);
         }
     }
@@ -122,6 +129,7 @@ namespace isx
     SpFTrace_t
     CellSetFile::readTrace(isize_t inCellId)
     {
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToCell(inCellId);
 
         // Calculate bytes till beginning of cell data
@@ -147,7 +155,7 @@ namespace isx
     SpImage_t
     CellSetFile::readSegmentationImage(isize_t inCellId)
     {
-
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToCell(inCellId);
 
         // "Calculate" bytes till beginning of the segmentation image
@@ -516,6 +524,50 @@ namespace isx
         }
     }
 
+    bool
+    CellSetFile::probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata)
+    {
+        std::ifstream file(inFileName, std::ios::binary);
+        if (!file.good() || !file.is_open())
+        {
+            ISX_THROW(isx::ExceptionFileIO,
+                "Failed to open cell set file for reading (", inFileName, ")", " with error: ", getSystemErrorString());
+        }
+        std::ios::pos_type headerOffset;
+        json j = readJsonHeaderAtEnd(file, headerOffset);
+
+        try
+        {
+            DataSet::Type type = DataSet::Type(size_t(j["type"]));
+            if (type != DataSet::Type::CELLSET)
+            {
+                ISX_THROW(isx::ExceptionDataIO,
+                        "Expected type to be CellSet. Instead got ", size_t(type), ".");
+            }
+
+            auto version = j["fileVersion"].get<size_t>();
+            outMetadata.m_timingInfo = convertJsonToTimingInfo(j["timingInfo"]);
+            outMetadata.m_spacingInfo = convertJsonToSpacingInfo(j["spacingInfo"]);
+            outMetadata.m_dataType = DataType::F32;
+
+            json extraProperties = nullptr;
+            if ((version >= 5) && j.find("extraProperties") != j.end())
+            {
+                extraProperties = j["extraProperties"];
+            }
+            outMetadata.m_extraProperties = extraProperties.dump();
+        }
+        catch (const std::exception & error)
+        {
+            ISX_THROW(isx::ExceptionDataIO, "Error parsing cell set header: ", error.what());
+        }
+        catch (...)
+        {
+            ISX_THROW(isx::ExceptionDataIO, "Unknown error while parsing cell set header.");
+        }
+        return true;
+    }
+
     void
     CellSetFile::writeHeader()
     {
@@ -9,11 +9,14 @@
 #include "isxTrace.h"
 #include "isxJsonUtils.h"
 #include "isxCellSet.h"
+#include "isxFileHandlePool.h"
 
 
 namespace isx
 {
 
+struct ProbedMetadata;
+
 /// A class for a file containing all cells extracted from a movie
 ///
 class CellSetFile
@@ -37,6 +40,16 @@ public:
     /// \throw  isx::ExceptionDataIO    If parsing the cell set file fails.
     CellSetFile(const std::string & inFileName, bool enableWrite = false);
 
+    /// Read the meta data of a cell set file from its header only.
+    ///
+    /// \param  inFileName  The name of the cell set file.
+    /// \param  outMetadata The meta data read from the header.
+    /// \return             True, as the meta data of a cell set is always in its header.
+    ///
+    /// \throw  isx::ExceptionFileIO    If reading the cell set file fails.
+    /// \throw  isx::ExceptionDataIO    If parsing the cell set file header fails.
+    static bool probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata);
+
     /// Write constructor.
     ///
     /// This opens a new file, writes header information.
@@ -262,6 +275,9 @@ private:
     /// The stream open mode
     std::ios_base::openmode m_openmode;
 
+    /// The pool entry of the file stream, which is only managed when reading.
+    PooledFileHandle m_fileHandle;
+
     bool m_fileClosedForWriting = false;
 
     const static size_t s_version = 5;
@@ -26,10 +26,10 @@ namespace isx
             return;
         }
 
-        for(const auto &fn : inFileNames)
+        m_cellSets = openSeriesMembers<SpCellSet_t>(inFileNames, [&inFileNames, enableWrite](const isize_t inIndex)
         {
-            m_cellSets.emplace_back(readCellSet(fn, enableWrite));
-        }
+            return readCellSet(inFileNames[inIndex], enableWrite);
+        });
 
         std::sort(m_cellSets.begin(), m_cellSets.end(), [](SpCellSet_t a, SpCellSet_t b)
         {
@@ -3,34 +3,27 @@
 #include "isxSpacingInfo.h"
 #include "isxCellSet.h"
 #include "isxImage.h"
+#include "isxImageKernels.h"
+#include "isxParallelFor.h"
 #include "isxLog.h"
 
 #include <cstring>
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 namespace {
 
-void
-addImages(
-    isx::SpImage_t inImage1,
-    isx::SpImage_t inImage2,
-    isx::SpImage_t outImage)
-{
-    ISX_ASSERT(inImage1->getDataType() == isx::DataType::F32 &&
-        inImage2->getDataType() == isx::DataType::F32 &&
-        outImage->getDataType() == isx::DataType::F32);
+/// The maximum number of bytes of the cell images that are read at once.
+const isx::isize_t s_maxNumBytesPerBatch = isx::isize_t(32) << 20;
 
-    float * pixels1 = inImage1->getPixelsAsF32();
-    float * pixels2 = inImage2->getPixelsAsF32();
-    float * outPixels = outImage->getPixelsAsF32();
+/// The maximum number of cell images that are read at once.
+const isx::isize_t s_maxNumImagesPerBatch = 64;
 
-    ISX_ASSERT(inImage1->getSpacingInfo().getTotalNumPixels() == inImage2->getSpacingInfo().getTotalNumPixels());
-
-    for (isx::isize_t i(0); i < inImage1->getSpacingInfo().getTotalNumPixels(); ++i)
-    {
-        outPixels[i] = pixels1[i] + pixels2[i];
-    }
-}
+/// The minimum number of pixels of the tile of a cell map accumulated by one thread.
+const isx::isize_t s_minNumPixelsPerTile = isx::isize_t(1) << 16;
 
 void
 initializeWithZeros(
@@ -43,6 +36,136 @@ initializeWithZeros(
     std::memset(pixels, 0, sizeof(float) * inImage->getSpacingInfo().getTotalNumPixels());    
 }
 
+/// The images of a batch of cells that are read on the IoQueue.
+///
+/// All the reads are requested on construction, so the next batch can be
+/// read while the images of the current one are accumulated.
+class CellImageBatch
+{
+public:
+
+    CellImageBatch(
+        const isx::SpCellSet_t & inCellSet,
+        std::vector<isx::isize_t>::const_iterator inBegin,
+        std::vector<isx::isize_t>::const_iterator inEnd)
+        : m_state(std::make_shared<State>())
+    {
+        m_state->m_results.resize(isx::isize_t(inEnd - inBegin));
+        std::shared_ptr<State> state = m_state;
+        for (auto it = inBegin; it != inEnd; ++it)
+        {
+            const isx::isize_t i = isx::isize_t(it - inBegin);
+            inCellSet->getImageAsync(*it,
+                [state, i](isx::AsyncTaskResult<isx::SpImage_t> inAsyncTaskResult)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(state->m_mutex);
+                        state->m_results[i] = inAsyncTaskResult;
+                        ++state->m_numRead;
+                    }
+                    state->m_condition.notify_one();
+                });
+        }
+    }
+
+    /// Wait until all the images of this batch are read.
+    ///
+    /// \return The images of this batch.
+    /// \throw  isx::ExceptionDataIO    If an image could not be read.
+    std::vector<isx::SpImage_t>
+    wait()
+    {
+        std::unique_lock<std::mutex> lock(m_state->m_mutex);
+        m_state->m_condition.wait(lock, [this]() { return m_state->m_numRead == m_state->m_results.size(); });
+
+        std::vector<isx::SpImage_t> images;
+        images.reserve(m_state->m_results.size());
+        for (const auto & result : m_state->m_results)
+        {
+            images.push_back(result.get());   // throws if the result contains an exception
+            if (images.back() == nullptr)
+            {
+                ISX_THROW(isx::ExceptionDataIO, "Failed to read a cell image.");
+            }
+        }
+        return images;
+    }
+
+private:
+
+    /// This is shared with the callbacks of the reads, so that they do not
+    /// outlive it if an error is thrown before this batch is waited for.
+    struct State
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::vector<isx::AsyncTaskResult<isx::SpImage_t>> m_results;
+        isx::isize_t m_numRead = 0;
+    };
+
+    std::shared_ptr<State> m_state;
+};
+
+/// Add a batch of cell images to a cell map in tiles of pixels on multiple threads.
+///
+/// Each pixel of the map is accumulated by one thread in the order of
+/// the cells, so the map does not depend on the number of threads.
+void
+addCellImages(
+    const std::vector<isx::SpImage_t> & inImages,
+    const bool inNormalizeImages,
+    const float inNormalizedThreshold,
+    const isx::isize_t inNumThreads,
+    isx::Image & inOutMap)
+{
+    const isx::isize_t numPixels = inOutMap.getSpacingInfo().getTotalNumPixels();
+    for (const auto & im : inImages)
+    {
+        ISX_ASSERT(im->getNumChannels() == 1);
+        ISX_ASSERT(im->getDataType() == isx::DataType::F32);
+        ISX_ASSERT(im->getSpacingInfo().getTotalNumPixels() == numPixels);
+    }
+
+    // Normalizing by the sum of the thresholded pixels of each image requires
+    // a pass over all of its pixels before the image can be accumulated.
+    std::vector<float> thresholds(inImages.size(), 0.f);
+    std::vector<float> sums(inImages.size(), 1.f);
+    if (inNormalizeImages)
+    {
+        isx::parallelFor(inImages.size(), [&](const isx::isize_t inIndex)
+        {
+            const float * pixels = inImages[inIndex]->getPixelsAsF32();
+            float minVal, maxVal;
+            isx::getMinMaxF32(pixels, numPixels, minVal, maxVal);
+            thresholds[inIndex] = inNormalizedThreshold * std::max(maxVal, 0.f);
+            sums[inIndex] = isx::sumThresholdedF32(pixels, numPixels, thresholds[inIndex]);
+        }, inNumThreads);
+    }
+
+    // Tiles are a multiple of 16 pixels to keep the vector kernels aligned with each other.
+    const isx::isize_t numPixelsPerThread = (numPixels + inNumThreads - 1) / inNumThreads;
+    const isx::isize_t numPixelsPerTile = std::max(s_minNumPixelsPerTile, (numPixelsPerThread + 15) & ~isx::isize_t(15));
+    const isx::isize_t numTiles = (numPixels + numPixelsPerTile - 1) / numPixelsPerTile;
+    float * mapPixels = inOutMap.getPixelsAsF32();
+    isx::parallelFor(numTiles, [&](const isx::isize_t inTile)
+    {
+        const isx::isize_t begin = inTile * numPixelsPerTile;
+        const isx::isize_t numTilePixels = std::min(numPixelsPerTile, numPixels - begin);
+        for (isx::isize_t i = 0; i < inImages.size(); ++i)
+        {
+            const float * pixels = inImages[i]->getPixelsAsF32() + begin;
+            if (inNormalizeImages)
+            {
+                isx::addThresholdedAndDividedF32(pixels, numTilePixels, thresholds[i], sums[i], mapPixels + begin);
+            }
+            else
+            {
+                isx::addF32(pixels, numTilePixels, mapPixels + begin);
+            }
+        }
+    }, inNumThreads);
+}
+
 }
 
 
@@ -55,42 +178,23 @@ normalizeAndThresholdImage(isx::SpImage_t inImage, float inNormalizedThreshold)
     ISX_ASSERT(inNormalizedThreshold >= 0.0);
     ISX_ASSERT(inNormalizedThreshold <= 1.0);
 
-    // copy image so the origin is not modified
-    isx::SpImage_t imgCopy(inImage);
-
-    float * pixels = imgCopy->getPixelsAsF32();
-    isx::isize_t numPixels = imgCopy->getSpacingInfo().getTotalNumPixels();
+    const isx::isize_t numPixels = inImage->getSpacingInfo().getTotalNumPixels();
+    const float * pixels = inImage->getPixelsAsF32();
 
     // identify image max
-    float maxVal = 0.0f;
-    for (isx::isize_t i(0); i < numPixels; ++i)
-    {
-        maxVal = std::max(maxVal, pixels[i]);
-    }
+    float minVal, maxVal;
+    isx::getMinMaxF32(pixels, numPixels, minVal, maxVal);
+    const float threshold = inNormalizedThreshold * std::max(maxVal, 0.0f);
 
-    // threshold the image
-    for (isx::isize_t i(0); i < numPixels; ++i)
-    {
-        if (pixels[i] < inNormalizedThreshold*maxVal)
-        {
-            pixels[i] = 0.0;
-        }        
-    }
-
-    // compute the image sum
-    float imgSum = 0.0f;
-    for (isx::isize_t i(0); i < numPixels; ++i)
-    {
-        imgSum += pixels[i];
-    }    
+    // threshold the image, then normalize by the sum of the thresholded image
+    const float imgSum = isx::sumThresholdedF32(pixels, numPixels, threshold);
 
-    // normalize by image sum
-    for (isx::isize_t i(0); i < numPixels; ++i)
-    {
-        pixels[i] /= imgSum;
-    }
+    // write to a new image so the origin is not modified
+    isx::SpImage_t outImage = std::make_shared<isx::Image>(
+            inImage->getSpacingInfo(), inImage->getRowBytes(), 1, isx::DataType::F32);
+    isx::thresholdAndDivideF32(pixels, numPixels, threshold, imgSum, outImage->getPixelsAsF32());
 
-    return imgCopy;
+    return outImage;
 }
 
 SpImage_t
@@ -98,11 +202,14 @@ cellSetToCellMap(
     const SpCellSet_t & inCellSet,
     bool inAcceptedCellsOnly,
     bool inNormalizeImages,
-    float inNormalizedThreshold)
+    float inNormalizedThreshold,
+    isize_t inMaxNumThreads)
 {
-    SpImage_t outImage(inCellSet->getImage(0));
+    const SpacingInfo spacingInfo = inCellSet->getSpacingInfo();
+    SpImage_t outImage = std::make_shared<Image>(spacingInfo, sizeof(float) * spacingInfo.getNumColumns(), 1, DataType::F32);
     initializeWithZeros(outImage);
 
+    std::vector<isize_t> cellIndices;
     for (isize_t i(0); i < inCellSet->getNumCells(); ++i)
     {
         CellSet::CellStatus status = inCellSet->getCellStatus(i);
@@ -112,19 +219,35 @@ cellSetToCellMap(
         {
             continue;
         }
+        cellIndices.push_back(i);
+    }
 
-        SpImage_t im = inCellSet->getImage(i);
-        ISX_ASSERT(im->getNumChannels() == 1);
+    const isize_t numThreads = (inMaxNumThreads > 0)
+        ? inMaxNumThreads : std::max(isize_t(1), isize_t(std::thread::hardware_concurrency()));
+    const isize_t numBytesPerImage = std::max(isize_t(1), sizeof(float) * spacingInfo.getTotalNumPixels());
+    const isize_t numImagesPerBatch = std::max(isize_t(1),
+            std::min(s_maxNumImagesPerBatch, s_maxNumBytesPerBatch / numBytesPerImage));
 
-        if (inNormalizeImages)
-        {            
-            SpImage_t threshImg = normalizeAndThresholdImage(im, inNormalizedThreshold);
-            addImages(outImage, threshImg, outImage);
-        }
-        else
-        {
-            addImages(outImage, im, outImage);
-        }
+    const auto requestBatch = [&](const isize_t inBegin)
+    {
+        const isize_t end = std::min(cellIndices.size(), inBegin + numImagesPerBatch);
+        return std::unique_ptr<CellImageBatch>(
+                new CellImageBatch(inCellSet, cellIndices.begin() + inBegin, cellIndices.begin() + end));
+    };
+
+    // The images of the next batch are read on the IoQueue while the current batch is accumulated.
+    std::unique_ptr<CellImageBatch> batch;
+    if (!cellIndices.empty())
+    {
+        batch = requestBatch(0);
+    }
+    for (isize_t begin = 0; begin < cellIndices.size(); begin += numImagesPerBatch)
+    {
+        const std::vector<SpImage_t> images = batch->wait();
+        const isize_t nextBegin = begin + numImagesPerBatch;
+        batch = (nextBegin < cellIndices.size()) ? requestBatch(nextBegin) : nullptr;
+
+        addCellImages(images, inNormalizeImages, inNormalizedThreshold, numThreads, *outImage);
     }
 
     return outImage;
@@ -136,18 +259,14 @@ getImageMinMaxInternal(
         const Image & inImage,
         const isize_t inNumChannels,
         const float inNormalizer,
+        void (*inGetMinMax)(const T *, isize_t, T &, T &),
         float & outMin,
         float & outMax)
 {
-    auto min = std::numeric_limits<T>::max();
-    auto max = std::numeric_limits<T>::lowest();
+    T min, max;
     auto pixels = reinterpret_cast<const T *>(inImage.getPixels());
     const isize_t numPixels = inNumChannels * inImage.getSpacingInfo().getTotalNumPixels();
-    for (isize_t i(0); i < numPixels; ++i)
-    {
-        min = std::min<T>(min, pixels[i]);
-        max = std::max<T>(max, pixels[i]);
-    }
+    inGetMinMax(pixels, numPixels, min, max);
     outMin = float(min) / inNormalizer;
     outMax = float(max) / inNormalizer;
 }
@@ -162,19 +281,19 @@ getImageMinMax(
     switch (dt)
     {
     case DataType::U16:
-        getImageMinMaxInternal<uint16_t>(inImage, 1, 1.0f, outMin, outMax);
+        getImageMinMaxInternal<uint16_t>(inImage, 1, 1.0f, getMinMaxU16, outMin, outMax);
         break;
 
     case DataType::F32:
-        getImageMinMaxInternal<float>(inImage, 1, 1.0f, outMin, outMax);
+        getImageMinMaxInternal<float>(inImage, 1, 1.0f, getMinMaxF32, outMin, outMax);
         break;
 
     case DataType::U8:
-        getImageMinMaxInternal<uint8_t>(inImage, 1, 255.f, outMin, outMax);
+        getImageMinMaxInternal<uint8_t>(inImage, 1, 255.f, getMinMaxU8, outMin, outMax);
         break;
 
     case DataType::RGB888:
-        getImageMinMaxInternal<uint8_t>(inImage, 3, 255.f, outMin, outMax);
+        getImageMinMaxInternal<uint8_t>(inImage, 3, 255.f, getMinMaxU8, outMin, outMax);
         break;
 
     default:
@@ -201,11 +320,8 @@ convertImageF32toU8(
 
     const float normalizationFactor = 255.f / (max - min);
 
-    for (isize_t i(0); i < inImage->getSpacingInfo().getTotalNumPixels(); ++i)
-    {
-        outPixels[i] = uint8_t((inPixels[i] - min) * normalizationFactor);
-    }
-        
+    convertF32toU8(inPixels, inImage->getSpacingInfo().getTotalNumPixels(), min, normalizationFactor, outPixels);
+
     return outImage;
 }
 
@@ -0,0 +1,125 @@
+#include "isxCoalescingJsonWriter.h"
+#include "isxJsonUtils.h"
+#include "isxLog.h"
+
+#include <exception>
+#include <fstream>
+
+namespace isx
+{
+
+CoalescingJsonWriter::CoalescingJsonWriter(const std::chrono::milliseconds inInterval)
+    : m_interval(inInterval)
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+CoalescingJsonWriter::~CoalescingJsonWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_one();
+    m_thread.join();
+}
+
+void
+CoalescingJsonWriter::write(const std::string & inFileName, nlohmann::json inJson)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingFileName = inFileName;
+        m_pendingJson = std::move(inJson);
+        m_hasPending = true;
+        ++m_stats.m_numRequests;
+    }
+    m_wakeCondition.notify_one();
+}
+
+void
+CoalescingJsonWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_hasPending && !m_writing)
+    {
+        return;
+    }
+    m_flushRequested = true;
+    m_wakeCondition.notify_one();
+    m_idleCondition.wait(lock, [this]() { return !m_hasPending && !m_writing; });
+}
+
+void
+CoalescingJsonWriter::cancel()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_hasPending = false;
+    m_flushRequested = false;
+    m_pendingJson = nlohmann::json();
+    m_idleCondition.wait(lock, [this]() { return !m_writing; });
+
+    // Wake up callers of flush that were waiting for the dropped tree.
+    m_idleCondition.notify_all();
+}
+
+CoalescingJsonWriterStats
+CoalescingJsonWriter::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void
+CoalescingJsonWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wakeCondition.wait(lock, [this]() { return m_hasPending || m_stop; });
+        if (!m_hasPending)
+        {
+            return;
+        }
+
+        // Trees requested while waiting out the interval replace this one.
+        m_wakeCondition.wait_until(lock, m_lastWriteTime + m_interval, [this]()
+        {
+            return m_flushRequested || m_stop || !m_hasPending;
+        });
+        if (!m_hasPending)
+        {
+            m_idleCondition.notify_all();
+            continue;
+        }
+
+        const std::string fileName = std::move(m_pendingFileName);
+        const nlohmann::json tree = std::move(m_pendingJson);
+        m_pendingJson = nlohmann::json();
+        m_hasPending = false;
+        m_writing = true;
+        lock.unlock();
+
+        try
+        {
+            std::ofstream file(fileName, std::ios::trunc);
+            writeJson(tree, file);
+        }
+        catch (const std::exception & error)
+        {
+            ISX_LOG_ERROR("Failed to write ", fileName, " with error: ", error.what());
+        }
+
+        lock.lock();
+        m_writing = false;
+        m_lastWriteTime = std::chrono::steady_clock::now();
+        ++m_stats.m_numWrites;
+        if (!m_hasPending)
+        {
+            m_flushRequested = false;
+            m_idleCondition.notify_all();
+        }
+    }
+}
+
+} // namespace isx
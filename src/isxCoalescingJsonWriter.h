@@ -0,0 +1,104 @@
+#ifndef ISX_COALESCING_JSON_WRITER_H
+#define ISX_COALESCING_JSON_WRITER_H
+
+#include "isxCore.h"
+
+#include "json.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace isx
+{
+
+/// The statistics of a coalescing JSON writer.
+///
+struct CoalescingJsonWriterStats
+{
+    /// The number of JSON trees that were requested to be written.
+    uint64_t m_numRequests = 0;
+
+    /// The number of JSON trees that were actually written.
+    uint64_t m_numWrites = 0;
+};
+
+/// Writes JSON trees to files on a background thread, at most once per interval.
+///
+/// The temporary project is saved after every edit, which used to format and
+/// write the whole project on the thread making the edit. Instead, the edit
+/// hands the JSON tree of the project to this writer, which replaces any tree
+/// that has not been written yet, so bursts of edits are coalesced into one
+/// write of the latest tree.
+///
+/// Errors are logged because there is no caller to report them to.
+class CoalescingJsonWriter
+{
+public:
+
+    /// The default minimum time between two writes.
+    static const int64_t s_defaultIntervalMs = 1000;
+
+    /// Constructor.
+    ///
+    /// \param  inInterval  The minimum time between two writes.
+    explicit CoalescingJsonWriter(
+            const std::chrono::milliseconds inInterval = std::chrono::milliseconds(s_defaultIntervalMs));
+
+    /// Write the pending tree, then stop the background thread.
+    ///
+    ~CoalescingJsonWriter();
+
+    CoalescingJsonWriter(const CoalescingJsonWriter &) = delete;
+    CoalescingJsonWriter & operator=(const CoalescingJsonWriter &) = delete;
+
+    /// Request to write a JSON tree to a file.
+    ///
+    /// The tree is written immediately if the interval has passed since the
+    /// last write, otherwise when it has passed, unless another tree is
+    /// requested in the meantime.
+    ///
+    /// \param  inFileName  The name of the file to overwrite.
+    /// \param  inJson      The tree to write.
+    void write(const std::string & inFileName, nlohmann::json inJson);
+
+    /// Write the pending tree now, regardless of the interval, and wait until it is written.
+    ///
+    void flush();
+
+    /// Drop the pending tree without writing it, and wait for a write in progress.
+    ///
+    void cancel();
+
+    /// \return The statistics of this writer.
+    ///
+    CoalescingJsonWriterStats getStats() const;
+
+private:
+
+    void run();
+
+    const std::chrono::milliseconds m_interval;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_idleCondition;
+
+    std::string m_pendingFileName;
+    nlohmann::json m_pendingJson;
+    bool m_hasPending = false;
+    bool m_writing = false;
+    bool m_flushRequested = false;
+    bool m_stop = false;
+    std::chrono::steady_clock::time_point m_lastWriteTime;
+
+    CoalescingJsonWriterStats m_stats;
+
+    std::thread m_thread;
+};
+
+} // namespace isx
+
+#endif // ISX_COALESCING_JSON_WRITER_H
@@ -1,5 +1,6 @@
 #include "isxCore.h"
 #include "isxDispatchQueue.h"
+#include "isxFrameBufferPool.h"
 #include "isxIoQueue.h"
 #include "isxException.h"
 #include "isxLogger.h"
@@ -166,8 +167,10 @@ namespace isx
     void CoreShutdown()
     {
         reportSessionEnd();
+        Logger::flush();
         IoQueue::destroy();
         DispatchQueue::destroyDefaultQueues();
+        FrameBufferPool::clear();
     }
 
     int CoreVersionMajor()
@@ -3,14 +3,198 @@
 #include "isxCore.h"
 #include "isxJsonUtils.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <cmath>
+#include <iterator>
 #include <limits>
 #include <cctype>
+#include <thread>
 
 namespace isx
 {
 
+namespace
+{
+
+/// Marks a column that is not imported.
+const size_t s_notImported = std::numeric_limits<size_t>::max();
+
+/// The minimum number of rows parsed by each thread.
+const size_t s_minNumRowsPerThread = 1 << 12;
+
+/// The number of packets written to the output file at a time.
+const size_t s_numPktsPerWrite = 1 << 16;
+
+/// \param  inBegin     The first character.
+/// \param  inEnd       One past the last character.
+/// \return             The characters with any carriage returns removed,
+///                     like isx::getLine does.
+std::string
+removeCarriageReturns(const char * inBegin, const char * inEnd)
+{
+    std::string str;
+    str.reserve(size_t(inEnd - inBegin));
+    std::remove_copy(inBegin, inEnd, std::back_inserter(str), '\r');
+    return str;
+}
+
+/// Parse a field as a double in the same way as std::stod, but without
+/// allocating a string or throwing for most fields.
+///
+/// \param  inBegin     The first character of the field.
+/// \param  inEnd       One past the last character of the field.
+/// \param  outValue    The parsed value, which is only set on success.
+/// \return             True if the field was parsed, false if std::stod would throw.
+bool
+parseDouble(const char * inBegin, const char * inEnd, double & outValue)
+{
+    char chars[64];
+    std::string longField;
+    const char * field = chars;
+    if (size_t(inEnd - inBegin) < sizeof(chars))
+    {
+        char * end = std::remove_copy(inBegin, inEnd, chars, '\r');
+        *end = '\0';
+    }
+    else
+    {
+        longField = removeCarriageReturns(inBegin, inEnd);
+        field = longField.c_str();
+    }
+
+    char * parseEnd = nullptr;
+    errno = 0;
+    const double value = std::strtod(field, &parseEnd);
+    if (parseEnd == field || errno == ERANGE)
+    {
+        return false;
+    }
+    outValue = value;
+    return true;
+}
+
+/// The text of a CSV file with the positions of its lines.
+///
+/// Lines are split in the same way as repeatedly calling isx::getLine,
+/// so a final newline does not start an empty line.
+class CsvText
+{
+public:
+    CsvText(std::ifstream & inStream, const std::string & inFileName)
+    {
+        inStream.seekg(0, std::ios_base::end);
+        const std::streamoff size = inStream.tellg();
+        inStream.seekg(0, std::ios_base::beg);
+        if (!inStream.good() || size < 0)
+        {
+            ISX_THROW(ExceptionFileIO, "Failed to read CSV file: ", inFileName);
+        }
+
+        m_text.resize(size_t(size));
+        if (!m_text.empty())
+        {
+            inStream.read(m_text.data(), size);
+            if (!inStream.good())
+            {
+                ISX_THROW(ExceptionFileIO, "Failed to read CSV file: ", inFileName);
+            }
+        }
+
+        m_lineStarts.push_back(0);
+        const char * const begin = m_text.data();
+        const char * const end = begin + m_text.size();
+        for (const char * c = begin; c != end; ++c)
+        {
+            c = static_cast<const char *>(std::memchr(c, '\n', size_t(end - c)));
+            if (c == nullptr)
+            {
+                break;
+            }
+            m_lineStarts.push_back(size_t(c - begin) + 1);
+        }
+
+        // The last start is one past the newline that ends the last line,
+        // so add one for a last line without a newline.
+        if (m_lineStarts.back() != m_text.size())
+        {
+            m_lineStarts.push_back(m_text.size() + 1);
+        }
+    }
+
+    size_t
+    getNumLines() const
+    {
+        return m_lineStarts.size() - 1;
+    }
+
+    const char *
+    getLineBegin(const size_t inIndex) const
+    {
+        return m_text.data() + m_lineStarts[inIndex];
+    }
+
+    const char *
+    getLineEnd(const size_t inIndex) const
+    {
+        return m_text.data() + m_lineStarts[inIndex + 1] - 1;
+    }
+
+    std::string
+    getLine(const size_t inIndex) const
+    {
+        return removeCarriageReturns(getLineBegin(inIndex), getLineEnd(inIndex));
+    }
+
+private:
+    std::vector<char> m_text;
+    std::vector<size_t> m_lineStarts;
+};
+
+/// Maps the index of a data row to the index of its line in a CSV file,
+/// skipping the lines before the start row and the title row.
+class DataRows
+{
+public:
+    DataRows(const size_t inNumLines, const size_t inTitleRow, const size_t inStartRow)
+        : m_startRow(inStartRow)
+        , m_titleRow(inTitleRow)
+    {
+        if (inNumLines > inStartRow)
+        {
+            m_numRows = inNumLines - inStartRow;
+            if (inTitleRow >= inStartRow && inTitleRow < inNumLines)
+            {
+                --m_numRows;
+            }
+        }
+    }
+
+    size_t
+    getNumRows() const
+    {
+        return m_numRows;
+    }
+
+    size_t
+    getLineIndex(const size_t inRow) const
+    {
+        const size_t line = m_startRow + inRow;
+        return (m_titleRow >= m_startRow && line >= m_titleRow) ? line + 1 : line;
+    }
+
+private:
+    size_t m_startRow;
+    size_t m_titleRow;
+    size_t m_numRows = 0;
+};
+
+} // namespace
+
 CsvTraceImporterParams::CsvTraceImporterParams()
     : m_timeUnit(1, 1)
 {
@@ -98,22 +282,19 @@ runCsvTraceImporter(
         ISX_THROW(ExceptionUserInput, outMessage);
     }
 
-    // First parse the CSV file to grab the titles, so we can do some initialization.
-    std::ifstream inputStream(inParams.m_inputFile);
+    // Read the whole file at once, then find the start of every line in one scan.
+    std::ifstream inputStream(inParams.m_inputFile, std::ios::binary);
     if (!inputStream.good())
     {
         ISX_THROW(ExceptionFileIO, "Error opening input CSV trace file ", inParams.m_inputFile);
     }
+    const CsvText text(inputStream, inParams.m_inputFile);
+    inputStream.close();
 
     std::vector<std::string> colNames;
-    std::string line;
-    for (size_t row = 0; isx::getLine(inputStream, line); ++row)
+    if (inParams.m_titleRow < text.getNumLines())
     {
-        if (row == inParams.m_titleRow)
-        {
-            colNames = splitString(line, ',');
-            break;
-        }
+        colNames = splitString(text.getLine(inParams.m_titleRow), ',');
     }
 
     // Check the number of columns and relevant column indices.
@@ -128,8 +309,6 @@ runCsvTraceImporter(
         ISX_THROW(ExceptionUserInput, "Time column ", inParams.m_timeCol, " exceeds last column ", numCols - 1, ".");
     }
 
-    // To simplify indexing, we always store all columns temporarily, but
-    // will only later write the columns we want.
     // The order here is important because an empty set of indices means
     // that all columns should be captured.
     if (inParams.m_colsToImport.empty())
@@ -172,97 +351,143 @@ runCsvTraceImporter(
         }
     }
 
-    // Go back to the beginning of the file and parse the data values.
-    // Clearing the error state flags in case the title was the last line.
-    inputStream.clear();
-    inputStream.seekg(0, std::ios_base::beg);
-    if (!inputStream.good())
-    {
-        ISX_THROW(ExceptionFileIO, "Failed to rewind to beginning of CSV file.");
-    }
-
-    std::vector<std::vector<double>> colValues(numCols);
-    for (size_t row = 0; isx::getLine(inputStream, line); ++row)
+    const size_t numColsToImport = inParams.m_colsToImport.size();
+    ISX_ASSERT(numColsToImport > 0);
+    const size_t numChannels = numColsToImport - 1;
+    std::vector<std::string> signalNames(numChannels);
+    std::vector<size_t> colChannels(numCols, s_notImported);
+    uint64_t colInd = 0;
+    for (const auto c : inParams.m_colsToImport)
     {
-        if (row == inParams.m_titleRow)
+        if (c != inParams.m_timeCol)
         {
-            continue;
+            signalNames.at(colInd) = colNames.at(c);
+            colChannels.at(c) = colInd;
+            colInd++;
         }
+    }
 
-        if (row < inParams.m_startRow)
-        {
-            continue;
-        }
+    // Parse the data rows in parallel, storing each imported column contiguously.
+    const DataRows dataRows(text.getNumLines(), inParams.m_titleRow, inParams.m_startRow);
+    const size_t numValues = dataRows.getNumRows();
+    if (numValues == 0)
+    {
+        ISX_THROW(ExceptionUserInput, "CSV file does not contain any data rows.");
+    }
 
-        const std::vector<std::string> rowValues = splitString(line, ',');
+    std::vector<uint64_t> timeStampsUSecs(numValues);
+    std::vector<std::vector<float>> channelValues(numChannels, std::vector<float>(numValues));
 
-        if (rowValues.size() != colNames.size())
+    const auto parseRows = [&](const size_t inFirst, const size_t inLast)
+    {
+        for (size_t r = inFirst; r < inLast; ++r)
         {
-            ISX_THROW(ExceptionUserInput, "Number of columns in row ", row, " (", rowValues.size(), ")",
-                    " does not match number of columns in title row (", colNames.size(), ").");
-        }
+            const size_t row = dataRows.getLineIndex(r);
+            const char * const lineBegin = text.getLineBegin(row);
+            const char * const lineEnd = text.getLineEnd(row);
 
-        for (size_t col = 0; col < rowValues.size(); ++col)
-        {
-            double value = std::numeric_limits<double>::quiet_NaN();
-            const std::string & valueStr = rowValues.at(col);
-            try
+            const size_t numRowValues = size_t(std::count(lineBegin, lineEnd, ',')) + 1;
+            if (numRowValues != numCols)
             {
-                value = std::stod(valueStr);
+                ISX_THROW(ExceptionUserInput, "Number of columns in row ", row, " (", numRowValues, ")",
+                        " does not match number of columns in title row (", numCols, ").");
             }
-            catch (const std::exception &)
+
+            const char * fieldBegin = lineBegin;
+            for (size_t col = 0; col < numCols; ++col)
             {
+                const char * fieldEnd = std::find(fieldBegin, lineEnd, ',');
                 if (col == inParams.m_timeCol)
                 {
-                    ISX_THROW(ExceptionDataIO, "All timestamps must be numeric. ",
-                            "Found a non-numeric timestamp on row ", row, " in column ",
-                            col, " (", valueStr, "). ");
+                    double value = 0.0;
+                    if (!parseDouble(fieldBegin, fieldEnd, value))
+                    {
+                        ISX_THROW(ExceptionDataIO, "All timestamps must be numeric. ",
+                                "Found a non-numeric timestamp on row ", row, " in column ",
+                                col, " (", removeCarriageReturns(fieldBegin, fieldEnd), "). ");
+                    }
+
+                    if (value < 0.0)
+                    {
+                        ISX_THROW(ExceptionDataIO, "All timestamps must be non-negative. ",
+                                "Found a negative timestamp on row ", row, " in column ",
+                                col, " (", removeCarriageReturns(fieldBegin, fieldEnd), "). ");
+                    }
+
+                    // Convert timestamps to microsecond precision
+                    const DurationInSeconds offset = DurationInSeconds(Ratio::fromDouble(value, 6)) * inParams.m_timeUnit;
+                    timeStampsUSecs[r] = uint64_t(std::round(offset.toDouble() * 1e6));
                 }
+                else if (colChannels[col] != s_notImported)
+                {
+                    double value = std::numeric_limits<double>::quiet_NaN();
+                    parseDouble(fieldBegin, fieldEnd, value);
+                    channelValues[colChannels[col]][r] = float(value);
+                }
+                fieldBegin = fieldEnd + 1;
             }
+        }
+    };
 
-            if ((col == inParams.m_timeCol) && (value < 0.0))
+    const size_t numThreads = std::max(size_t(1), std::min(
+            size_t(std::thread::hardware_concurrency()),
+            numValues / s_minNumRowsPerThread));
+    std::vector<std::exception_ptr> errors(numThreads);
+    {
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < numThreads; ++t)
+        {
+            threads.emplace_back([&parseRows, &errors, t, numThreads, numValues]()
             {
-                ISX_THROW(ExceptionDataIO, "All timestamps must be non-negative. ",
-                        "Found a negative timestamp on row ", row, " in column ",
-                        col, " (", valueStr, "). ");
-            }
-
-            colValues.at(col).push_back(value);
+                try
+                {
+                    parseRows((numValues * t) / numThreads, (numValues * (t + 1)) / numThreads);
+                }
+                catch (...)
+                {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+        try
+        {
+            parseRows(0, numValues / numThreads);
+        }
+        catch (...)
+        {
+            errors[0] = std::current_exception();
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
         }
     }
 
-    // Convert timestamps to microsecond precision
-    std::vector<uint64_t> timeStampsUSecs;
+    // Each thread parses a contiguous range of rows and stops at its first error,
+    // so the first error in thread order is the first error in the file.
+    for (const auto & error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
 
-    for (const auto timeValue : colValues.at(inParams.m_timeCol))
+    if (inCheckInCB(0.5f))
     {
-        const DurationInSeconds offset = DurationInSeconds(Ratio::fromDouble(double(timeValue), 6)) * inParams.m_timeUnit;
-        timeStampsUSecs.push_back(uint64_t(std::round(offset.toDouble() * 1e6)));
+        return AsyncTaskStatus::CANCELLED;
     }
-    const size_t numValues = timeStampsUSecs.size();
 
-    const size_t numColsToImport = inParams.m_colsToImport.size();
-    ISX_ASSERT(numColsToImport > 0);
-    const size_t numChannels = numColsToImport - 1;
-    std::vector<std::string> signalNames(numChannels);
-    std::vector<SignalType> types(numChannels);
-    uint64_t colInd = 0;
-    for (const auto c : inParams.m_colsToImport)
+    std::vector<SignalType> types(numChannels, SignalType::SPARSE);
+    for (size_t c = 0; c < numChannels; ++c)
     {
-        if (c != inParams.m_timeCol)
+        for (const float value : channelValues[c])
         {
-            SignalType t = SignalType::SPARSE;
-            for (size_t r = 0; r < numValues; ++r)
+            if ((value != 0.f) && (value != 1.f))
             {
-                const float value = float(colValues.at(c).at(r));
-                if ((t == SignalType::SPARSE) && (value != 0.f) && (value != 1.f))
-                {
-                    t = SignalType::DENSE;
-                }
+                types[c] = SignalType::DENSE;
+                break;
             }
-            types.at(colInd) = t;
-            signalNames.at(colInd) = colNames.at(c);
-            colInd++;
         }
     }
 
@@ -276,18 +501,27 @@ runCsvTraceImporter(
     const std::vector<DurationInSeconds> steps(signalNames.size(), stepDuration);
 
     EventBasedFileV2 outputFile(inParams.m_outputFile, DataSet::Type::GPIO, signalNames, steps, types);
-    colInd = 0;
-    for (const auto c : inParams.m_colsToImport)
+    std::vector<EventBasedFileV2::DataPkt> pkts;
+    pkts.reserve(std::min(numValues, s_numPktsPerWrite));
+    for (size_t c = 0; c < numChannels && !cancelled; ++c)
     {
-        if (c != inParams.m_timeCol)
+        const std::vector<float> & values = channelValues[c];
+        for (size_t r = 0; r < numValues; ++r)
         {
-            for (size_t r = 0; r < numValues; ++r)
+            pkts.emplace_back(timeStampsUSecs[r], values[r], c);
+            if (pkts.size() == s_numPktsPerWrite)
             {
-                EventBasedFileV2::DataPkt pkt(timeStampsUSecs.at(r), float(colValues.at(c).at(r)), colInd);
-                outputFile.writeDataPkt(pkt);
+                outputFile.writeDataPkts(pkts);
+                pkts.clear();
             }
-            ++colInd;
         }
+        outputFile.writeDataPkts(pkts);
+        pkts.clear();
+
+        // Release the memory of each column once it has been written.
+        std::vector<float>().swap(channelValues[c]);
+
+        cancelled = inCheckInCB(0.5f + 0.5f * float(c + 1) / float(numChannels));
     }
 
     // We might consider asking for a specific end-time, but for now
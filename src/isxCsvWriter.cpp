@@ -0,0 +1,491 @@
+#include "isxCsvWriter.h"
+#include "isxException.h"
+#include "isxParallelFor.h"
+
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace
+{
+
+/// The approximate number of values formatted by a thread at a time.
+const size_t s_numValuesPerBlock = 1 << 16;
+
+const uint64_t s_powersOfTen[] =
+{
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull,
+};
+
+/// The maximum number of characters written by printf("%.*f") with a
+/// precision of at most s_maxFixedPrecision, which is required for the
+/// largest finite doubles.
+const int s_maxFixedPrecision = 17;
+const size_t s_maxFixedLength = 2 + std::numeric_limits<double>::max_exponent10 + 1 + s_maxFixedPrecision + 1;
+
+/// Format a value with printf("%.*g") or another floating point conversion.
+///
+/// This is how the standard library implements operator<< for floating point
+/// values, except that it always uses the "C" locale, which may not be the
+/// current C locale (e.g. Qt sets it from the environment), so the decimal
+/// point is fixed up afterwards.
+size_t
+formatWithPrintf(
+        const double inValue,
+        const int inPrecision,
+        char * outChars,
+        const char * inFormat = "%.*g",
+        const size_t inMaxLength = isx::s_maxFormattedNumberLength)
+{
+    const int numChars = std::snprintf(outChars, inMaxLength, inFormat, inPrecision, inValue);
+    if (numChars <= 0)
+    {
+        return 0;
+    }
+    size_t length = std::min(size_t(numChars), inMaxLength - 1);
+
+    const char * decimalPoint = std::localeconv()->decimal_point;
+    if (decimalPoint != nullptr && std::strcmp(decimalPoint, ".") != 0)
+    {
+        const size_t decimalPointLength = std::strlen(decimalPoint);
+        char * pos = std::strstr(outChars, decimalPoint);
+        if (decimalPointLength > 0 && pos != nullptr)
+        {
+            *pos = '.';
+            char * rest = pos + decimalPointLength;
+            std::memmove(pos + 1, rest, size_t(outChars + length - rest) + 1);
+            length -= decimalPointLength - 1;
+        }
+    }
+    return length;
+}
+
+/// Compute the value m * 2^e * 10^k rounded to the nearest integer (with ties
+/// to even, like printf) using exact integer arithmetic.
+///
+/// \param  inMantissa  The integer mantissa m, which must be less than 2^24.
+/// \param  inExp2      The binary exponent e.
+/// \param  inExp10     The decimal exponent k.
+/// \param  outDigits   The rounded value.
+/// \return             False if the computation would overflow, true otherwise.
+bool
+roundScaledValue(const uint32_t inMantissa, const int inExp2, const int inExp10, uint64_t & outDigits)
+{
+    if (inExp10 >= 0)
+    {
+        // 10^12 * 2^24 < 2^64
+        if (inExp10 > 12)
+        {
+            return false;
+        }
+        const uint64_t scaled = uint64_t(inMantissa) * s_powersOfTen[inExp10];
+        if (inExp2 >= 0)
+        {
+            if (inExp2 > 0 && (inExp2 >= 64 || (scaled >> (64 - inExp2)) != 0))
+            {
+                return false;
+            }
+            outDigits = scaled << inExp2;
+            return true;
+        }
+
+        const int shift = -inExp2;
+        if (shift >= 64)
+        {
+            return false;
+        }
+        uint64_t quotient = scaled >> shift;
+        const uint64_t remainder = scaled & ((uint64_t(1) << shift) - 1);
+        const uint64_t half = uint64_t(1) << (shift - 1);
+        if (remainder > half || (remainder == half && (quotient & 1) != 0))
+        {
+            ++quotient;
+        }
+        outDigits = quotient;
+        return true;
+    }
+
+    // A float with a fractional part is less than 2^24, so never needs
+    // to be divided by a power of ten to get 7 digits.
+    const int divisorExp10 = -inExp10;
+    if (inExp2 < 0 || inExp2 > 39 || divisorExp10 > 19)
+    {
+        return false;
+    }
+    const uint64_t value = uint64_t(inMantissa) << inExp2;
+    const uint64_t divisor = s_powersOfTen[divisorExp10];
+    uint64_t quotient = value / divisor;
+    const uint64_t remainder = value % divisor;
+    const uint64_t rest = divisor - remainder;
+    if (remainder > rest || (remainder == rest && (quotient & 1) != 0))
+    {
+        ++quotient;
+    }
+    outDigits = quotient;
+    return true;
+}
+
+} // namespace
+
+namespace isx
+{
+
+size_t
+formatFloatForCsv(const float inValue, char * outChars)
+{
+    const int precision = std::numeric_limits<float>::digits10 + 1;
+
+    if (!std::isfinite(inValue))
+    {
+        return formatWithPrintf(double(inValue), precision, outChars);
+    }
+
+    char * out = outChars;
+    if (std::signbit(inValue))
+    {
+        *out++ = '-';
+    }
+
+    const float absValue = std::fabs(inValue);
+    if (absValue == 0.f)
+    {
+        *out++ = '0';
+        return size_t(out - outChars);
+    }
+
+    // absValue = mantissa * 2^exp2 exactly
+    int exp2 = 0;
+    const float fraction = std::frexp(absValue, &exp2);
+    const uint32_t mantissa = uint32_t(std::ldexp(fraction, std::numeric_limits<float>::digits));
+    exp2 -= std::numeric_limits<float>::digits;
+
+    // The estimate of the decimal exponent may be off by one, which is detected
+    // by the number of digits after rounding. Rounding up to the next power of ten
+    // also increases the exponent, which is what printf does.
+    int exp10 = int(std::floor(std::log10(double(absValue))));
+    uint64_t digits = 0;
+    bool found = false;
+    for (int attempt = 0; attempt < 3 && !found; ++attempt)
+    {
+        if (!roundScaledValue(mantissa, exp2, precision - 1 - exp10, digits))
+        {
+            return formatWithPrintf(double(inValue), precision, outChars);
+        }
+
+        if (digits >= s_powersOfTen[precision])
+        {
+            ++exp10;
+        }
+        else if (digits < s_powersOfTen[precision - 1])
+        {
+            --exp10;
+        }
+        else
+        {
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        return formatWithPrintf(double(inValue), precision, outChars);
+    }
+
+    char digitChars[std::numeric_limits<float>::digits10 + 1];
+    for (int i = precision - 1; i >= 0; --i)
+    {
+        digitChars[i] = char('0' + (digits % 10));
+        digits /= 10;
+    }
+
+    // %g removes trailing zeros from the fractional part.
+    int numDigits = precision;
+    while (numDigits > 1 && digitChars[numDigits - 1] == '0')
+    {
+        --numDigits;
+    }
+
+    if (exp10 < -4 || exp10 >= precision)
+    {
+        *out++ = digitChars[0];
+        if (numDigits > 1)
+        {
+            *out++ = '.';
+            std::memcpy(out, digitChars + 1, size_t(numDigits - 1));
+            out += numDigits - 1;
+        }
+        *out++ = 'e';
+        *out++ = (exp10 < 0) ? '-' : '+';
+        int absExp10 = std::abs(exp10);
+        if (absExp10 >= 100)
+        {
+            *out++ = char('0' + (absExp10 / 100));
+            absExp10 %= 100;
+        }
+        *out++ = char('0' + (absExp10 / 10));
+        *out++ = char('0' + (absExp10 % 10));
+    }
+    else if (exp10 >= 0)
+    {
+        const int numIntegerDigits = exp10 + 1;
+        std::memcpy(out, digitChars, size_t(numIntegerDigits));
+        out += numIntegerDigits;
+        if (numDigits > numIntegerDigits)
+        {
+            *out++ = '.';
+            std::memcpy(out, digitChars + numIntegerDigits, size_t(numDigits - numIntegerDigits));
+            out += numDigits - numIntegerDigits;
+        }
+    }
+    else
+    {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = 0; i < -exp10 - 1; ++i)
+        {
+            *out++ = '0';
+        }
+        std::memcpy(out, digitChars, size_t(numDigits));
+        out += numDigits;
+    }
+
+    return size_t(out - outChars);
+}
+
+size_t
+formatDoubleForCsv(const double inValue, char * outChars)
+{
+    return formatWithPrintf(inValue, std::numeric_limits<double>::digits10 + 1, outChars);
+}
+
+CsvWriter::CsvWriter(std::ostream & inStream, const size_t inBufferSize)
+    : m_stream(&inStream)
+    , m_buffer(std::max(inBufferSize, 2 * s_maxFormattedNumberLength))
+{
+}
+
+CsvWriter::CsvWriter(const size_t inBufferSize)
+    : m_stream(nullptr)
+    , m_buffer(std::max(inBufferSize, 2 * s_maxFormattedNumberLength))
+{
+}
+
+CsvWriter::~CsvWriter()
+{
+    if (m_stream != nullptr && m_size > 0)
+    {
+        m_stream->write(m_buffer.data(), std::streamsize(m_size));
+    }
+}
+
+void
+CsvWriter::reserve(const size_t inLength)
+{
+    if (m_size + inLength > m_buffer.size())
+    {
+        flush();
+        if (m_size + inLength > m_buffer.size())
+        {
+            m_buffer.resize(std::max(2 * m_buffer.size(), m_size + inLength));
+        }
+    }
+}
+
+void
+CsvWriter::appendChars(const char * inChars, const size_t inLength)
+{
+    if (m_stream != nullptr && inLength > m_buffer.size())
+    {
+        flush();
+        m_stream->write(inChars, std::streamsize(inLength));
+        return;
+    }
+    reserve(inLength);
+    std::memcpy(m_buffer.data() + m_size, inChars, inLength);
+    m_size += inLength;
+}
+
+void
+CsvWriter::appendString(const std::string & inString)
+{
+    appendChars(inString.data(), inString.size());
+}
+
+void
+CsvWriter::appendChar(const char inChar)
+{
+    reserve(1);
+    m_buffer[m_size++] = inChar;
+}
+
+void
+CsvWriter::appendSeparator()
+{
+    reserve(2);
+    m_buffer[m_size++] = ',';
+    m_buffer[m_size++] = ' ';
+}
+
+void
+CsvWriter::appendFloat(const float inValue)
+{
+    reserve(s_maxFormattedNumberLength);
+    m_size += formatFloatForCsv(inValue, m_buffer.data() + m_size);
+}
+
+void
+CsvWriter::appendDouble(const double inValue)
+{
+    reserve(s_maxFormattedNumberLength);
+    m_size += formatDoubleForCsv(inValue, m_buffer.data() + m_size);
+}
+
+void
+CsvWriter::appendFixed(const double inValue, const int inPrecision)
+{
+    const int precision = std::min(std::max(inPrecision, 0), s_maxFixedPrecision);
+    char chars[s_maxFixedLength];
+    const size_t length = formatWithPrintf(inValue, precision, chars, "%.*f", s_maxFixedLength);
+    appendChars(chars, length);
+}
+
+void
+CsvWriter::appendUnsigned(const uint64_t inValue)
+{
+    char digits[20];
+    size_t numDigits = 0;
+    uint64_t value = inValue;
+    do
+    {
+        digits[sizeof(digits) - 1 - numDigits++] = char('0' + value % 10);
+        value /= 10;
+    }
+    while (value > 0);
+    appendChars(digits + sizeof(digits) - numDigits, numDigits);
+}
+
+void
+CsvWriter::appendText(const CsvWriter & inOther)
+{
+    appendChars(inOther.m_buffer.data(), inOther.m_size);
+}
+
+void
+CsvWriter::clear()
+{
+    m_size = 0;
+}
+
+void
+CsvWriter::flush()
+{
+    if (m_stream == nullptr)
+    {
+        return;
+    }
+
+    if (m_size > 0)
+    {
+        m_stream->write(m_buffer.data(), std::streamsize(m_size));
+        m_size = 0;
+    }
+
+    if (!m_stream->good())
+    {
+        ISX_THROW(ExceptionFileIO, "Error writing to output file.");
+    }
+}
+
+bool
+writeCsvRows(
+        CsvWriter & inWriter,
+        const size_t inNumRows,
+        const size_t inNumValuesPerRow,
+        const CsvFormatRowCB_t & inFormatRow,
+        const CsvRowsCheckInCB_t & inCheckInCB,
+        const size_t inMaxNumThreads)
+{
+    const size_t numRowsPerBlock = std::max(size_t(1), s_numValuesPerBlock / std::max(size_t(1), inNumValuesPerRow));
+    const size_t numBlocks = (inNumRows + numRowsPerBlock - 1) / numRowsPerBlock;
+    const size_t maxNumThreads = (inMaxNumThreads > 0)
+        ? inMaxNumThreads : std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+    const size_t numThreads = std::min(maxNumThreads, numBlocks);
+
+    if (numThreads <= 1)
+    {
+        for (size_t b = 0; b < numBlocks; ++b)
+        {
+            const size_t endRow = std::min(inNumRows, (b + 1) * numRowsPerBlock);
+            for (size_t r = b * numRowsPerBlock; r < endRow; ++r)
+            {
+                inFormatRow(inWriter, r);
+            }
+            if (inCheckInCB && inCheckInCB(endRow))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<CsvWriter>> blockWriters(numThreads);
+    for (auto & w : blockWriters)
+    {
+        w.reset(new CsvWriter(numRowsPerBlock * std::max(size_t(1), inNumValuesPerRow) * 16));
+    }
+
+    for (size_t firstBlock = 0; firstBlock < numBlocks; firstBlock += numThreads)
+    {
+        const size_t numRoundBlocks = std::min(numThreads, numBlocks - firstBlock);
+        parallelFor(numRoundBlocks, [&](const isize_t inIndex)
+        {
+            CsvWriter & writer = *blockWriters[inIndex];
+            writer.clear();
+            const size_t block = firstBlock + inIndex;
+            const size_t endRow = std::min(inNumRows, (block + 1) * numRowsPerBlock);
+            for (size_t r = block * numRowsPerBlock; r < endRow; ++r)
+            {
+                inFormatRow(writer, r);
+            }
+        }, numThreads);
+
+        for (size_t i = 0; i < numRoundBlocks; ++i)
+        {
+            inWriter.appendText(*blockWriters[i]);
+        }
+
+        const size_t numRowsWritten = std::min(inNumRows, (firstBlock + numRoundBlocks) * numRowsPerBlock);
+        if (inCheckInCB && inCheckInCB(numRowsWritten))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace isx
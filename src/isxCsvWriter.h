@@ -0,0 +1,180 @@
+#ifndef ISX_CSV_WRITER_H
+#define ISX_CSV_WRITER_H
+
+#include "isxCore.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace isx
+{
+
+/// The maximum number of characters written by formatFloatForCsv or formatDoubleForCsv.
+const size_t s_maxFormattedNumberLength = 32;
+
+/// Format a float in the same way as an std::ostream in the classic locale
+/// with std::setprecision(std::numeric_limits<float>::digits10 + 1).
+///
+/// This is equivalent to printf("%.7g") of the value, but most values are
+/// formatted with exact integer arithmetic instead of going through the
+/// C library.
+///
+/// \param  inValue     The value to format.
+/// \param  outChars    The buffer to write to, which must have space for
+///                     at least s_maxFormattedNumberLength characters.
+/// \return             The number of characters written, not including
+///                     any null terminator.
+size_t formatFloatForCsv(const float inValue, char * outChars);
+
+/// Format a double in the same way as an std::ostream in the classic locale
+/// with std::setprecision(std::numeric_limits<double>::digits10 + 1).
+///
+/// \param  inValue     The value to format.
+/// \param  outChars    The buffer to write to, which must have space for
+///                     at least s_maxFormattedNumberLength characters.
+/// \return             The number of characters written, not including
+///                     any null terminator.
+size_t formatDoubleForCsv(const double inValue, char * outChars);
+
+/// Writes CSV text to an output stream through a large buffer.
+///
+/// This avoids the per-value overhead of formatting numbers with
+/// operator<< and checking the stream state after every value.
+/// Numbers are formatted exactly like the stream would with the
+/// precision used by the exporters, so the output is unchanged.
+///
+/// Any buffered text is written when the buffer is full, when flush
+/// is called, or when the writer is destroyed.
+///
+/// A writer can also be constructed without a stream, in which case it
+/// keeps all its text in memory, so that it can be formatted on one thread
+/// and appended to another writer with appendText.
+class CsvWriter
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param  inStream        The stream to write to.
+    /// \param  inBufferSize    The size of the buffer in bytes.
+    CsvWriter(std::ostream & inStream, const size_t inBufferSize = s_defaultBufferSize);
+
+    /// Constructor for a writer that keeps its text in memory.
+    ///
+    /// \param  inBufferSize    The initial size of the buffer in bytes.
+    explicit CsvWriter(const size_t inBufferSize = s_defaultBufferSize);
+
+    CsvWriter(const CsvWriter &) = delete;
+
+    CsvWriter & operator=(const CsvWriter &) = delete;
+
+    /// Destructor.
+    ///
+    /// This writes any buffered text, but does not throw if that fails.
+    ~CsvWriter();
+
+    /// \param  inChars     The characters to append.
+    /// \param  inLength    The number of characters to append.
+    void appendChars(const char * inChars, const size_t inLength);
+
+    /// \param  inString    The string to append.
+    ///
+    void appendString(const std::string & inString);
+
+    /// \param  inChar      The character to append.
+    ///
+    void appendChar(const char inChar);
+
+    /// Append the value separator, which is a comma followed by a space.
+    ///
+    void appendSeparator();
+
+    /// \param  inValue     The value to append, formatted with formatFloatForCsv.
+    ///
+    void appendFloat(const float inValue);
+
+    /// \param  inValue     The value to append, formatted with formatDoubleForCsv.
+    ///
+    void appendDouble(const double inValue);
+
+    /// Append a value in the same way as an std::ostream in the classic locale
+    /// with std::fixed and std::setprecision(inPrecision).
+    ///
+    /// \param  inValue     The value to append.
+    /// \param  inPrecision The number of digits after the decimal point, which is at most 17.
+    void appendFixed(const double inValue, const int inPrecision);
+
+    /// \param  inValue     The value to append in decimal.
+    ///
+    void appendUnsigned(const uint64_t inValue);
+
+    /// \param  inOther     The writer whose buffered text to append.
+    ///
+    void appendText(const CsvWriter & inOther);
+
+    /// Discard all buffered text without writing it.
+    ///
+    void clear();
+
+    /// Write all buffered text to the stream.
+    ///
+    /// This does nothing for a writer without a stream.
+    ///
+    /// \throw  isx::ExceptionFileIO    If writing to the stream fails.
+    void flush();
+
+    /// The default size of the buffer in bytes.
+    static const size_t s_defaultBufferSize = 1 << 20;
+
+private:
+
+    /// Make sure there is space for a number of characters in the buffer,
+    /// flushing it if required.
+    void reserve(const size_t inLength);
+
+    /// The stream to write to, or nullptr to keep all text in memory.
+    std::ostream * m_stream;
+
+    /// The buffer of text that has not been written yet.
+    std::vector<char> m_buffer;
+
+    /// The number of characters in the buffer.
+    size_t m_size = 0;
+};
+
+/// The callback used to format one row of CSV text.
+typedef std::function<void(CsvWriter & outWriter, const size_t inRow)> CsvFormatRowCB_t;
+
+/// The callback invoked with the number of rows written so far, which
+/// returns true to cancel.
+typedef std::function<bool(const size_t inNumRowsWritten)> CsvRowsCheckInCB_t;
+
+/// Format rows of CSV text in parallel and append them to a writer in order.
+///
+/// Rows are divided into blocks that are formatted into separate buffers
+/// on the thread pool dispatch queue, then appended in order, so the text is the same
+/// as formatting each row sequentially. The row formatter must therefore
+/// be safe to call concurrently for different rows.
+///
+/// \param  inWriter            The writer to append to.
+/// \param  inNumRows           The number of rows.
+/// \param  inNumValuesPerRow   The approximate number of values in a row,
+///                             which is used to size the blocks.
+/// \param  inFormatRow         Formats one row.
+/// \param  inCheckInCB         Invoked after each group of blocks has been appended.
+/// \param  inMaxNumThreads     The maximum number of threads to use, or 0 to use
+///                             the number of hardware threads.
+/// \return                     True if cancelled.
+bool writeCsvRows(
+        CsvWriter & inWriter,
+        const size_t inNumRows,
+        const size_t inNumValuesPerRow,
+        const CsvFormatRowCB_t & inFormatRow,
+        const CsvRowsCheckInCB_t & inCheckInCB,
+        const size_t inMaxNumThreads = 0);
+
+} // namespace isx
+
+#endif // ISX_CSV_WRITER_H
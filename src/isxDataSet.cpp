@@ -13,6 +13,7 @@
 #include "isxMetadata.h"
 #include "isxMosaicMovie.h"
 #include "isxNVisionMovie.h"
+#include "isxMetadataProbe.h"
 
 #include "json.hpp"
 
@@ -148,6 +149,7 @@ void
 DataSet::setFileName(const std::string & inFileName)
 {
     m_fileName = inFileName;
+    invalidateMetaDataCache();
     setModified();
 }
 
@@ -169,6 +171,7 @@ DataSet::setProperties(const SpDataSetProperties_t & inDataSetProperties)
     if (inDataSetProperties)
     {
         m_properties = *inDataSetProperties;
+        invalidateMetaDataCache();
         setModified();
     }
 }
@@ -202,6 +205,10 @@ DataSet::setPropertyValue(const std::string & inPropertyName, Variant inValue)
         m_properties[inPropertyName] = inValue;
         setModified();
 
+        // Properties can change the meta data of some formats (e.g. TIFF movies),
+        // so the cached meta data is no longer valid.
+        invalidateMetaDataCache();
+
         if (inPropertyName == PROP_MOVIE_START_TIME ||
             inPropertyName == PROP_MOVIE_FRAME_RATE)
         {
@@ -506,6 +513,7 @@ DataSet::locateFile(const std::string & inDirectory)
             if (m_type == readDataSetType(newFilePath, props))
             {
                 m_fileName = newFilePath;
+                invalidateMetaDataCache();
                 located = true;
                 setModified();
             }
@@ -520,6 +528,16 @@ DataSet::locateFile(const std::string & inDirectory)
 
 std::string
 DataSet::toJsonString(const bool inPretty, const std::string & inPathToOmit) const
+{
+    if (inPretty)
+    {
+        return toJson(inPathToOmit).dump(4);
+    }
+    return toJson(inPathToOmit).dump();
+}
+
+json
+DataSet::toJson(const std::string & inPathToOmit) const
 {
     json outJson;
     outJson["name"] = m_name;
@@ -541,11 +559,20 @@ DataSet::toJsonString(const bool inPretty, const std::string & inPathToOmit) con
     outJson["properties"] = convertPropertiesToJson(m_properties);
     outJson["imported"] = m_imported;
 
-    if (inPretty)
+    if (m_hasMetaData && m_metaDataFileSize >= 0)
     {
-        return outJson.dump(4);
+        json metaData;
+        metaData["fileSize"] = m_metaDataFileSize;
+        metaData["modifiedTime"] = m_metaDataFileModifiedMs;
+        metaData["timingInfo"] = convertTimingInfoToJson(m_timingInfo);
+        metaData["secondaryTimingInfo"] = convertTimingInfoToJson(m_secondaryTimingInfo);
+        metaData["spacingInfo"] = convertSpacingInfoToJson(m_spacingInfo);
+        metaData["dataType"] = isize_t(m_dataType);
+        metaData["extraProperties"] = m_extraProps;
+        metaData["readOnlyProperties"] = convertPropertiesToJson(m_readOnlyProperties);
+        outJson["metaDataCache"] = std::move(metaData);
     }
-    return outJson.dump();
+    return outJson;
 }
 
 /*static*/
@@ -579,26 +606,54 @@ DataSet::getTypeString(Type inType)
 std::shared_ptr<DataSet>
 DataSet::fromJsonString(const std::string & inString, const std::string & inAbsolutePathToPrepend)
 {
-    if (inString == json::object().dump())
+    return fromJson(json::parse(inString), inAbsolutePathToPrepend);
+}
+
+std::shared_ptr<DataSet>
+DataSet::fromJson(const json & inJson, const std::string & inAbsolutePathToPrepend)
+{
+    if (inJson.is_object() && inJson.empty())
     {
         return std::shared_ptr<DataSet>();
     }
 
-    const json jsonObj = json::parse(inString);
-    const std::string name = jsonObj.at("name");
-    const DataSet::Type dataSetType = DataSet::Type(size_t(jsonObj.at("dataSetType")));
+    const std::string name = inJson.at("name");
+    const DataSet::Type dataSetType = DataSet::Type(size_t(inJson.at("dataSetType")));
 
-    std::string fileName = jsonObj.at("fileName");
+    std::string fileName = inJson.at("fileName");
     if(isRelative(fileName) && !inAbsolutePathToPrepend.empty())
     {
         fileName = inAbsolutePathToPrepend + "/" + fileName;
     }
 
-    const HistoricalDetails hd = convertJsonToHistory(jsonObj.at("history"));
-    const DataSet::Properties properties = convertJsonToProperties(jsonObj.at("properties"));
-    const bool imported = jsonObj.at("imported");
+    const HistoricalDetails hd = convertJsonToHistory(inJson.at("history"));
+    const DataSet::Properties properties = convertJsonToProperties(inJson.at("properties"));
+    const bool imported = inJson.at("imported");
 
     auto outDataSet = std::make_shared<DataSet>(name, dataSetType, fileName, hd, properties, imported);
+
+    // The cached meta data is only used once readMetaData has checked that
+    // the file has not changed, so a cache that cannot be parsed is ignored.
+    if (inJson.find("metaDataCache") != inJson.end())
+    {
+        try
+        {
+            const json & metaData = inJson.at("metaDataCache");
+            outDataSet->m_timingInfo = convertJsonToTimingInfo(metaData.at("timingInfo"));
+            outDataSet->m_secondaryTimingInfo = convertJsonToTimingInfo(metaData.at("secondaryTimingInfo"));
+            outDataSet->m_spacingInfo = convertJsonToSpacingInfo(metaData.at("spacingInfo"));
+            outDataSet->m_dataType = DataType(isize_t(metaData.at("dataType")));
+            outDataSet->m_extraProps = metaData.at("extraProperties").get<std::string>();
+            outDataSet->m_readOnlyProperties = convertJsonToProperties(metaData.at("readOnlyProperties"));
+            outDataSet->m_metaDataFileModifiedMs = metaData.at("modifiedTime").get<int64_t>();
+            outDataSet->m_metaDataFileSize = metaData.at("fileSize").get<int64_t>();
+        }
+        catch (const std::exception & error)
+        {
+            ISX_LOG_WARNING("Ignoring cached meta data of ", fileName, " that failed to parse with error: ", error.what());
+            outDataSet->invalidateMetaDataCache();
+        }
+    }
     return outDataSet;
 }
 
@@ -645,16 +700,43 @@ DataSet::getDataType()
     return m_dataType;
 }
 
+void
+DataSet::invalidateMetaDataCache()
+{
+    m_metaDataFileSize = -1;
+    m_metaDataFileModifiedMs = 0;
+}
+
 void
 DataSet::readMetaData()
 {
-    if (!fileExists())
+    int64_t fileSize = 0;
+    int64_t fileModifiedMs = 0;
+    if (!getFileStamp(m_fileName, fileSize, fileModifiedMs))
     {
         ISX_LOG_ERROR("Tried to read metadata from dataset with missing file: ", m_fileName);
         return;
     }
 
-    if (m_type == Type::MOVIE || m_type == Type::IMAGE)
+    if (m_metaDataFileSize >= 0
+        && fileSize == m_metaDataFileSize
+        && fileModifiedMs == m_metaDataFileModifiedMs)
+    {
+        m_hasMetaData = true;
+        return;
+    }
+    invalidateMetaDataCache();
+
+    ProbedMetadata probed;
+    if (probeMetadata(m_fileName, m_type, probed))
+    {
+        m_timingInfo = probed.m_timingInfo;
+        m_spacingInfo = probed.m_spacingInfo;
+        m_dataType = probed.m_dataType;
+        m_extraProps = probed.m_extraProperties;
+        m_hasMetaData = true;
+    }
+    else if (m_type == Type::MOVIE || m_type == Type::IMAGE)
     {
         const SpMovie_t movie = readMovie(m_fileName, getProperties());
         m_timingInfo = movie->getTimingInfo();
@@ -749,6 +831,14 @@ DataSet::readMetaData()
         m_extraProps = events->getExtraProperties();
         m_hasMetaData = true;
     }
+
+    // The stamp is taken before reading, so a file that changes while it
+    // is being read will be read again next time.
+    if (m_hasMetaData)
+    {
+        m_metaDataFileSize = fileSize;
+        m_metaDataFileModifiedMs = fileModifiedMs;
+    }
 }
 
 void
@@ -776,6 +866,10 @@ DataSet::setExtraProperties(const std::string & inProperties)
         movie->setExtraProperties(inProperties);
         movie->closeForWriting();
     }
+
+    // The file may have been rewritten without changing its size within the
+    // resolution of its modification time, so always read it again.
+    invalidateMetaDataCache();
 }
 
 std::string
@@ -1,10 +1,41 @@
 #include "isxEventBasedFileV2.h"
+#include <algorithm>
 #include <string>
+#include <limits>
 #include "isxLogicalTrace.h"
 
 namespace isx
 {
 
+namespace
+{
+
+/// \return    The smallest whole number of microseconds after a start time
+///             that is not before a time.
+int64_t
+getCeilMicroSecsSince(const Time & inStartTime, const Time & inTime)
+{
+    const Ratio duration = inTime - inStartTime;
+    Ratio::intBig_t num = duration.getNum() * 1000000;
+    Ratio::intBig_t den = duration.getDen();
+    if (den < 0)
+    {
+        num = -num;
+        den = -den;
+    }
+    Ratio::intBig_t micro = num / den;
+    if (num > 0 && num % den != 0)
+    {
+        micro += 1;
+    }
+
+    const Ratio::intBig_t maxMicro = std::numeric_limits<int64_t>::max();
+    const Ratio::intBig_t minMicro = std::numeric_limits<int64_t>::min();
+    return static_cast<int64_t>(std::max(minMicro, std::min(maxMicro, micro)));
+}
+
+} // namespace
+
 EventBasedFileV2::EventBasedFileV2()
 {
 }
@@ -21,6 +52,7 @@ EventBasedFileV2::EventBasedFileV2(const std::string & inFileName)
     readFileFooter();
 
     m_valid = true;
+    m_fileHandle.manageStream(m_file, m_fileName, std::ios::binary | std::ios_base::in);
 }
 
 EventBasedFileV2::EventBasedFileV2(
@@ -64,6 +96,7 @@ EventBasedFileV2::EventBasedFileV2(
 EventBasedFileV2::~EventBasedFileV2()
 {
     closeFileForWriting();
+    m_fileHandle.unmanage();
     closeFileStreamWithChecks(m_file, m_fileName);
 }
 
@@ -126,6 +159,7 @@ EventBasedFileV2::readAllTraces(std::vector<SpFTrace_t> & inContinuousTraces, st
         }
     }
 
+    PooledFileHandle::Lease lease(m_fileHandle);
     size_t pos = 0;
     m_file.seekg(pos, std::ios_base::beg);
     if (!m_file.good())
@@ -180,6 +214,221 @@ EventBasedFileV2::readAllTraces(std::vector<SpFTrace_t> & inContinuousTraces, st
     }
 }
 
+LogicalTraceTable
+EventBasedFileV2::readLogicalTraceTable(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs)
+{
+    const size_t numChannels = m_channelList.size();
+    std::vector<std::vector<std::pair<int64_t, float>>> channelValues(numChannels);
+
+    if (!m_openForWrite)
+    {
+        readPktsInRange(inStartMicroSecs, inEndMicroSecs,
+            [&channelValues, numChannels, inStartMicroSecs, inEndMicroSecs](const DataPkt * inPkts, const size_t inNumPkts)
+            {
+                for (size_t p = 0; p < inNumPkts; ++p)
+                {
+                    const DataPkt & pkt = inPkts[p];
+                    ISX_ASSERT(pkt.signal < numChannels);
+                    const int64_t offset = int64_t(pkt.offsetMicroSecs);
+                    if (offset >= inStartMicroSecs && offset < inEndMicroSecs)
+                    {
+                        channelValues[pkt.signal].emplace_back(offset, pkt.value);
+                    }
+                }
+            });
+    }
+
+    LogicalTraceTable table;
+    size_t numValues = 0;
+    for (const auto & values : channelValues)
+    {
+        numValues += values.size();
+    }
+    table.m_offsetsMicroSecs.reserve(numValues);
+    table.m_values.reserve(numValues);
+    table.m_traceStarts.reserve(numChannels + 1);
+
+    const auto compareOffsets = [](const std::pair<int64_t, float> & inA, const std::pair<int64_t, float> & inB)
+    {
+        return inA.first < inB.first;
+    };
+    for (auto & values : channelValues)
+    {
+        // Packets are usually written in time order for each channel, so this rarely sorts.
+        // A logical trace keeps the last value written at a time, hence the stable sort.
+        if (!std::is_sorted(values.begin(), values.end(), compareOffsets))
+        {
+            std::stable_sort(values.begin(), values.end(), compareOffsets);
+        }
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i + 1 < values.size() && values[i + 1].first == values[i].first)
+            {
+                continue;
+            }
+            table.m_offsetsMicroSecs.push_back(values[i].first);
+            table.m_values.push_back(values[i].second);
+        }
+        table.m_traceStarts.push_back(table.m_values.size());
+        std::vector<std::pair<int64_t, float>>().swap(values);
+    }
+    return table;
+}
+
+SpLogicalTrace_t
+EventBasedFileV2::getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime)
+{
+    auto search = std::find(m_channelList.begin(), m_channelList.end(), inChannelName);
+    if (search == m_channelList.end() || m_openForWrite)
+    {
+        return nullptr;
+    }
+
+    const uint64_t signal = uint64_t(search - m_channelList.begin());
+    auto trace = std::make_shared<LogicalTrace>(getTimingInfo(inChannelName), inChannelName);
+    const int64_t startMicroSecs = getCeilMicroSecsSince(m_startTime, inStartTime);
+    const int64_t endMicroSecs = getCeilMicroSecsSince(m_startTime, inEndTime);
+    if (startMicroSecs >= endMicroSecs)
+    {
+        return trace;
+    }
+
+    readPktsInRange(startMicroSecs, endMicroSecs,
+        [this, &trace, signal, startMicroSecs, endMicroSecs](const DataPkt * inPkts, const size_t inNumPkts)
+        {
+            for (size_t p = 0; p < inNumPkts; ++p)
+            {
+                const DataPkt & pkt = inPkts[p];
+                const int64_t offset = int64_t(pkt.offsetMicroSecs);
+                if (pkt.signal == signal && offset >= startMicroSecs && offset < endMicroSecs)
+                {
+                    trace->addValue(m_startTime + DurationInSeconds(isize_t(pkt.offsetMicroSecs), isize_t(1E6)), pkt.value);
+                }
+            }
+        });
+    return trace;
+}
+
+uint64_t
+EventBasedFileV2::getNumPktsReadInRange() const
+{
+    return m_numPktsReadInRange;
+}
+
+void
+EventBasedFileV2::readPktsInRange(
+        const int64_t inStartMicroSecs,
+        const int64_t inEndMicroSecs,
+        const std::function<void(const DataPkt *, size_t)> & inFn)
+{
+    if (!m_hasPktIndex)
+    {
+        readAllPktsAndIndex(inStartMicroSecs, inEndMicroSecs, inFn);
+        return;
+    }
+
+    PooledFileHandle::Lease lease(m_fileHandle);
+    const size_t numPkts = size_t(m_headerOffset) / sizeof(DataPkt);
+    std::vector<DataPkt> pkts;
+    size_t nextPos = std::numeric_limits<size_t>::max();
+    for (size_t b = 0; b < m_pktBlockMinOffsets.size(); ++b)
+    {
+        if (int64_t(m_pktBlockMaxOffsets[b]) < inStartMicroSecs || int64_t(m_pktBlockMinOffsets[b]) >= inEndMicroSecs)
+        {
+            continue;
+        }
+
+        const size_t firstPkt = b * s_numPktsPerIndexBlock;
+        const size_t numBlockPkts = std::min(s_numPktsPerIndexBlock, numPkts - firstPkt);
+        const size_t pos = firstPkt * sizeof(DataPkt);
+
+        // Consecutive blocks are read without seeking.
+        if (pos != nextPos)
+        {
+            m_file.seekg(std::streamoff(pos), std::ios_base::beg);
+            if (!m_file.good())
+            {
+                ISX_THROW(ExceptionFileIO, "Error seeking to packets in file: ", m_fileName);
+            }
+        }
+
+        pkts.resize(numBlockPkts);
+        m_file.read(reinterpret_cast<char *>(pkts.data()), std::streamsize(numBlockPkts * sizeof(DataPkt)));
+        if (!m_file.good())
+        {
+            ISX_THROW(ExceptionFileIO, "Error reading file: ", m_fileName);
+        }
+        nextPos = pos + numBlockPkts * sizeof(DataPkt);
+        m_numPktsReadInRange += numBlockPkts;
+
+        inFn(pkts.data(), numBlockPkts);
+    }
+}
+
+void
+EventBasedFileV2::readAllPktsAndIndex(
+        const int64_t inStartMicroSecs,
+        const int64_t inEndMicroSecs,
+        const std::function<void(const DataPkt *, size_t)> & inFn)
+{
+    m_pktBlockMinOffsets.clear();
+    m_pktBlockMaxOffsets.clear();
+
+    PooledFileHandle::Lease lease(m_fileHandle);
+    m_file.seekg(0, std::ios_base::beg);
+    if (!m_file.good())
+    {
+        ISX_THROW(ExceptionFileIO, "Error seeking to packets in file: ", m_fileName);
+    }
+
+    std::vector<DataPkt> pkts(s_numPktsPerIndexBlock);
+    size_t numPktsLeft = size_t(m_headerOffset) / sizeof(DataPkt);
+    while (numPktsLeft > 0)
+    {
+        const size_t numPkts = std::min(numPktsLeft, s_numPktsPerIndexBlock);
+        m_file.read(reinterpret_cast<char *>(pkts.data()), std::streamsize(numPkts * sizeof(DataPkt)));
+        if (!m_file.good())
+        {
+            ISX_THROW(ExceptionFileIO, "Error reading file: ", m_fileName);
+        }
+        numPktsLeft -= numPkts;
+
+        uint64_t minOffset = pkts[0].offsetMicroSecs;
+        uint64_t maxOffset = pkts[0].offsetMicroSecs;
+        for (size_t p = 1; p < numPkts; ++p)
+        {
+            minOffset = std::min(minOffset, pkts[p].offsetMicroSecs);
+            maxOffset = std::max(maxOffset, pkts[p].offsetMicroSecs);
+        }
+        m_pktBlockMinOffsets.push_back(minOffset);
+        m_pktBlockMaxOffsets.push_back(maxOffset);
+
+        if (int64_t(maxOffset) >= inStartMicroSecs && int64_t(minOffset) < inEndMicroSecs)
+        {
+            m_numPktsReadInRange += numPkts;
+            inFn(pkts.data(), numPkts);
+        }
+    }
+    m_hasPktIndex = true;
+}
+
+void
+EventBasedFileV2::indexPkt(const DataPkt & inPkt)
+{
+    if (m_numPktsWritten % s_numPktsPerIndexBlock == 0)
+    {
+        m_pktBlockMinOffsets.push_back(inPkt.offsetMicroSecs);
+        m_pktBlockMaxOffsets.push_back(inPkt.offsetMicroSecs);
+    }
+    else
+    {
+        m_pktBlockMinOffsets.back() = std::min(m_pktBlockMinOffsets.back(), inPkt.offsetMicroSecs);
+        m_pktBlockMaxOffsets.back() = std::max(m_pktBlockMaxOffsets.back(), inPkt.offsetMicroSecs);
+    }
+    ++m_numPktsWritten;
+}
+
 SpLogicalTrace_t
 EventBasedFileV2::getLogicalData(const std::string & inChannelName)
 {
@@ -291,9 +540,65 @@ void EventBasedFileV2::writeDataPkt(const DataPkt & inData)
             m_startOffsets.at(inData.signal) = inData.offsetMicroSecs;
         }
         ++m_numSamples[inData.signal];
+        indexPkt(inData);
     }
 }
 
+void EventBasedFileV2::writeDataPkts(const std::vector<DataPkt> & inData)
+{
+    if (m_openForWrite && !m_closedForWriting && !inData.empty())
+    {
+        for (const auto & pkt : inData)
+        {
+            if (m_numSamples.at(pkt.signal) == 0)
+            {
+                m_startOffsets.at(pkt.signal) = pkt.offsetMicroSecs;
+            }
+            ++m_numSamples[pkt.signal];
+            indexPkt(pkt);
+        }
+
+        m_file.write(reinterpret_cast<const char *>(inData.data()), std::streamsize(inData.size() * sizeof(DataPkt)));
+
+        if (!m_file.good())
+        {
+            ISX_THROW(ExceptionFileIO, "Error writing output data file: ", m_fileName);
+        }
+    }
+}
+
+void
+EventBasedFileV2::setChannels(
+        const std::vector<std::string> & inChannelNames,
+        const std::vector<DurationInSeconds> & inChannelSteps,
+        const std::vector<SignalType> & inChannelTypes)
+{
+    const size_t numChannels = inChannelNames.size();
+    if (inChannelSteps.size() != numChannels)
+    {
+        ISX_THROW(ExceptionUserInput, "Number of steps (", inChannelSteps.size(),
+                ") must be the same as the number of channels (", numChannels, ").");
+    }
+    if (inChannelTypes.size() != numChannels)
+    {
+        ISX_THROW(ExceptionUserInput, "Number of signal types (", inChannelTypes.size(),
+                ") must be the same as the number of channels (", numChannels, ").");
+    }
+    for (size_t i = numChannels; i < m_numSamples.size(); ++i)
+    {
+        if (m_numSamples[i] > 0)
+        {
+            ISX_THROW(ExceptionUserInput, "Cannot remove channel ", i, " because packets have been written for it.");
+        }
+    }
+
+    m_channelList = inChannelNames;
+    m_steps = inChannelSteps;
+    m_signalTypes = inChannelTypes;
+    m_startOffsets.resize(numChannels, 0);
+    m_numSamples.resize(numChannels, 0);
+}
+
 void EventBasedFileV2::closeFileForWriting()
 {
     if (m_openForWrite && !m_closedForWriting)
@@ -356,6 +661,22 @@ EventBasedFileV2::readFileFooter()
             {
                 m_extraProperties = j["extraProperties"];
             }
+
+            // Files written before the packet index was added, or with a different
+            // block size, compute it when it is first needed.
+            if (j.find("pktIndex") != j.end())
+            {
+                const json & index = j["pktIndex"];
+                const size_t numPkts = size_t(m_headerOffset) / sizeof(DataPkt);
+                const size_t numBlocks = (numPkts + s_numPktsPerIndexBlock - 1) / s_numPktsPerIndexBlock;
+                if (index.at("numPktsPerBlock").get<size_t>() == s_numPktsPerIndexBlock)
+                {
+                    m_pktBlockMinOffsets = index.at("minOffsets").get<std::vector<uint64_t>>();
+                    m_pktBlockMaxOffsets = index.at("maxOffsets").get<std::vector<uint64_t>>();
+                    m_hasPktIndex = (m_pktBlockMinOffsets.size() == numBlocks)
+                        && (m_pktBlockMaxOffsets.size() == numBlocks);
+                }
+            }
         }
         catch (const std::exception & error)
         {
@@ -399,6 +720,12 @@ EventBasedFileV2::writeFileFooter()
         j["numSamples"] = m_numSamples;
         j["metrics"] = convertEventMetricsToJson(m_traceMetrics);
         j["extraProperties"] = m_extraProperties;
+
+        json index;
+        index["numPktsPerBlock"] = s_numPktsPerIndexBlock;
+        index["minOffsets"] = m_pktBlockMinOffsets;
+        index["maxOffsets"] = m_pktBlockMaxOffsets;
+        j["pktIndex"] = index;
     }
     catch (...)
     {
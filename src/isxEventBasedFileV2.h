@@ -3,11 +3,13 @@
 
 #include <fstream>
 #include <cstring>
+#include <functional>
 #include "isxDataSet.h"
 #include "isxEventBasedFile.h"
 #include "isxFileTypes.h"
 #include "isxEvents.h"
 #include "isxJsonUtils.h"
+#include "isxFileHandlePool.h"
 
 namespace isx
 {
@@ -46,6 +48,9 @@ public:
     };
     #pragma pack(pop)
 
+    /// The number of consecutive packets whose range of times is stored in the packet index.
+    static const size_t s_numPktsPerIndexBlock = 4096;
+
     /// Read constructor.
     EventBasedFileV2(const std::string & inFileName);
 
@@ -64,6 +69,42 @@ public:
     void
     readAllTraces(std::vector<SpFTrace_t> & inContinuousTraces, std::vector<SpLogicalTrace_t> & inLogicalTraces);
 
+    /// Read the logical traces of all channels within a time window with a single
+    /// pass over the file.
+    ///
+    /// This gives the same values as getLogicalData for each channel, but
+    /// keeps the offsets of the packets instead of converting them to times.
+    ///
+    /// \param  inStartMicroSecs    The start of the time window as an offset from the start time.
+    /// \param  inEndMicroSecs      The end of the time window, which is excluded.
+    /// \return                     The values of each channel in the order of getChannelList.
+    /// \throw  isx::ExceptionFileIO    If reading the file fails.
+    LogicalTraceTable
+    readLogicalTraceTable(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs);
+
+    /// Read the logical trace of a channel within a time window.
+    ///
+    /// Packets are not sorted by time (e.g. events are written one cell after
+    /// another), so the file footer stores the range of times of each block of
+    /// s_numPktsPerIndexBlock packets and only the blocks that overlap the window
+    /// are read. For files written without this index, it is computed by reading
+    /// all packets once.
+    ///
+    /// \param  inChannelName   The name of the requested channel (as returned by getChannelList()).
+    /// \param  inStartTime     The start of the time window.
+    /// \param  inEndTime       The end of the time window, which is excluded.
+    /// \return                 The logical trace of the channel within the time window, or nullptr
+    ///                         if the file doesn't contain data for that channel.
+    /// \throw  isx::ExceptionFileIO    If reading the file fails.
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime);
+
+    /// \return The number of packets in the blocks that overlapped the time windows
+    ///         of the queries since this was opened. The packets outside of those blocks
+    ///         that are read once to compute a missing packet index are excluded.
+    uint64_t
+    getNumPktsReadInRange() const;
+
     SignalType getSignalType(const std::string & inChannelName);
 
     bool
@@ -103,6 +144,30 @@ public:
     ///
     void writeDataPkt(const DataPkt & inData);
 
+    /// Writes data packets to the file with one write.
+    ///
+    /// \param  inData  The packets to write.
+    /// \throw  isx::ExceptionFileIO    If writing to the file fails.
+    void writeDataPkts(const std::vector<DataPkt> & inData);
+
+    /// Replace the channels given on construction.
+    ///
+    /// This allows channels to be discovered while writing packets, in which
+    /// case the file should be constructed with enough channels to index all
+    /// packets, then this should be called with the actual channels before
+    /// closing the file.
+    ///
+    /// \param  inChannelNames  The names of the channels.
+    /// \param  inChannelSteps  The sampling period of each channel.
+    /// \param  inChannelTypes  The signal type of each channel.
+    /// \throw  isx::ExceptionUserInput If the number of steps or types does not match
+    ///                                 the number of channels, or if packets have been
+    ///                                 written for a channel that would be removed.
+    void setChannels(
+        const std::vector<std::string> & inChannelNames,
+        const std::vector<DurationInSeconds> & inChannelSteps,
+        const std::vector<SignalType> & inChannelTypes);
+
     /// Write file footer and close the file
     ///
     void closeFileForWriting();
@@ -136,6 +201,34 @@ private:
     void
     updateGeneralTimingInfo();
 
+    /// Call a function with the blocks of packets whose range of times overlaps a time window.
+    ///
+    /// The packets passed to the function may be outside the window.
+    ///
+    /// \param  inStartMicroSecs    The start of the time window as an offset from the start time.
+    /// \param  inEndMicroSecs      The end of the time window, which is excluded.
+    /// \param  inFn                The function that is called with each block and its number of packets.
+    void
+    readPktsInRange(
+        const int64_t inStartMicroSecs,
+        const int64_t inEndMicroSecs,
+        const std::function<void(const DataPkt *, size_t)> & inFn);
+
+    /// Like readPktsInRange, but for files whose footer did not contain the packet index.
+    ///
+    /// This reads all the packets in one pass, computing the packet index from them,
+    /// so that later calls of readPktsInRange only read the blocks they need.
+    void
+    readAllPktsAndIndex(
+        const int64_t inStartMicroSecs,
+        const int64_t inEndMicroSecs,
+        const std::function<void(const DataPkt *, size_t)> & inFn);
+
+    /// Add a packet that is written to the packet index.
+    ///
+    void
+    indexPkt(const DataPkt & inPkt);
+
     std::string                     m_fileName;
 
     std::vector<std::string>        m_channelList;
@@ -169,6 +262,9 @@ private:
 
     std::fstream                    m_file;
 
+    // The pool entry of the file stream, which is only managed when reading.
+    PooledFileHandle                m_fileHandle;
+
     std::ios::pos_type              m_headerOffset;
 
     bool                            m_valid = false;
@@ -180,6 +276,15 @@ private:
 
     EventMetrics_t                  m_traceMetrics;
 
+    // The smallest and largest offset of the packets in each block of
+    // s_numPktsPerIndexBlock packets, in the order they were written.
+    std::vector<uint64_t>           m_pktBlockMinOffsets;
+    std::vector<uint64_t>           m_pktBlockMaxOffsets;
+    bool                            m_hasPktIndex = false;
+
+    uint64_t                        m_numPktsWritten = 0;
+    uint64_t                        m_numPktsReadInRange = 0;
+
     /// The extra properties to write in the JSON footer.
     json m_extraProperties;
 
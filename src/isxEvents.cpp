@@ -5,6 +5,24 @@
 namespace isx
 {
 
+LogicalTraceTable
+Events::getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs)
+{
+    const Time start = getTimingInfo().getStart();
+    LogicalTraceTable table;
+    for (const auto & cellName : getCellNamesList())
+    {
+        appendToLogicalTraceTable(getLogicalData(cellName), start, inStartMicroSecs, inEndMicroSecs, table);
+    }
+    return table;
+}
+
+SpLogicalTrace_t
+Events::getLogicalDataInRange(const std::string & inCellName, const Time & inStartTime, const Time & inEndTime)
+{
+    return getLogicalTraceInRange(getLogicalData(inCellName), inStartTime, inEndTime);
+}
+
 SpEvents_t
 readEvents(const std::string & inFileName)
 {
@@ -74,6 +74,7 @@ EventsExporterParams::toString() const
     using json = nlohmann::json;
     json j;
     j["writeTimeRelativeTo"] = int(m_writeTimeRelativeTo);
+    j["traceFileFormat"] = int(m_traceFileFormat);
     return j.dump(4);
 }
 
@@ -91,9 +92,23 @@ EventsExporterParams::getInputFilePaths() const
 std::vector<std::string>
 EventsExporterParams::getOutputFilePaths() const
 {
+    if (m_traceFileFormat == TraceFileFormat::CSV_AND_NPY)
+    {
+        return {m_fileName, getNpyFilePath()};
+    }
     return {m_fileName};
 }
 
+std::string
+EventsExporterParams::getNpyFilePath() const
+{
+    if (m_traceFileFormat == TraceFileFormat::NPY)
+    {
+        return m_fileName;
+    }
+    return makeOutputFilePath(m_fileName, ".npy");
+}
+
 AsyncTaskStatus
 runEventsExporter(
         EventsExporterParams inParams,
@@ -134,10 +149,21 @@ runEventsExporter(
         inParams.m_propertiesFilename = makeOutputFilePath(inParams.m_fileName, "-props.csv");
     }
 
-    std::ofstream strm(inParams.m_fileName, std::ios::trunc);
-    if (!strm.good())
+    const bool writeCsv = inParams.m_traceFileFormat != TraceFileFormat::NPY;
+    const bool writeNpy = inParams.m_traceFileFormat != TraceFileFormat::CSV;
+    if (writeNpy && !inParams.m_writeSparseOutput)
     {
-        ISX_THROW(ExceptionFileIO, "Error writing to output file.");
+        ISX_THROW(ExceptionUserInput, "Exporting events to a .npy file requires sparse output.");
+    }
+
+    std::ofstream strm;
+    if (writeCsv)
+    {
+        strm.open(inParams.m_fileName, std::ios::trunc);
+        if (!strm.good())
+        {
+            ISX_THROW(ExceptionFileIO, "Error writing to output file.");
+        }
     }
 
     const bool outputProps = !inParams.m_propertiesFilename.empty();
@@ -148,7 +174,7 @@ runEventsExporter(
     const size_t numSegments = events.size();
 
     AsyncCheckInCB_t tracesCheckInCB = rescaleCheckInCB(inCheckInCB, 0.f, outputProps ? 0.8f : 1.f);
-    std::vector<std::string> filesToCleanUp = {inParams.m_fileName};
+    std::vector<std::string> filesToCleanUp = inParams.getOutputFilePaths();
 
     if (inParams.m_writeSparseOutput)
     {
@@ -189,7 +215,16 @@ runEventsExporter(
 
         try
         {
-            cancelled = writeTraces(strm, traces, cellNames, {}, baseTime, DataSet::Type::EVENTS, tracesCheckInCB);
+            if (writeCsv)
+            {
+                cancelled = writeTraces(strm, traces, cellNames, {}, baseTime, DataSet::Type::EVENTS,
+                        rescaleCheckInCB(tracesCheckInCB, 0.f, writeNpy ? 0.5f : 1.f));
+            }
+            if (writeNpy && !cancelled)
+            {
+                cancelled = writeTracesNpy(inParams.getNpyFilePath(), traces, cellNames, baseTime,
+                        rescaleCheckInCB(tracesCheckInCB, writeCsv ? 0.5f : 0.f, writeCsv ? 0.5f : 1.f));
+            }
         }
         catch (...)
         {
@@ -24,10 +24,10 @@ EventsSeries::EventsSeries(const std::vector<std::string> & inFileNames)
         return;
     }
 
-    for (const auto & fn : inFileNames)
+    m_events = openSeriesMembers<SpEvents_t>(inFileNames, [&inFileNames](const isize_t inIndex)
     {
-        m_events.emplace_back(readEvents(fn));
-    }
+        return readEvents(inFileNames[inIndex]);
+    });
 
     std::sort(m_events.begin(), m_events.end(), [](SpEvents_t a, SpEvents_t b)
     {
@@ -100,6 +100,31 @@ EventsSeries::getLogicalData(const std::string & inCellName)
     return trace;
 }
 
+SpLogicalTrace_t
+EventsSeries::getLogicalDataInRange(const std::string & inCellName, const Time & inStartTime, const Time & inEndTime)
+{
+    SpLogicalTrace_t trace = std::make_shared<LogicalTrace>(m_gaplessTimingInfo, inCellName);
+    for (const auto & e : m_events)
+    {
+        // Members that end before or start after the window are not read at all.
+        const TimingInfo ti = e->getTimingInfo();
+        if (ti.getEnd() < inStartTime || ti.getStart() >= inEndTime)
+        {
+            continue;
+        }
+
+        const SpLogicalTrace_t eTrace = e->getLogicalDataInRange(inCellName, inStartTime, inEndTime);
+        if (eTrace != nullptr)
+        {
+            for (const auto & kv : eTrace->getValues())
+            {
+                trace->addValue(kv.first, kv.second);
+            }
+        }
+    }
+    return trace;
+}
+
 void
 EventsSeries::getLogicalDataAsync(const std::string & inCellName, EventsGetLogicalDataCB_t inCallback)
 {
@@ -58,6 +58,9 @@ public:
     void
     getLogicalDataAsync(const std::string & inCellName, EventsGetLogicalDataCB_t inCallback) override;
 
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inCellName, const Time & inStartTime, const Time & inEndTime) override;
+
     isx::TimingInfo 
     getTimingInfo() const override;
 
@@ -9,12 +9,15 @@
 #include "isxMovie.h"
 #include "isxPathUtils.h"
 #include "isxExportTiff.h"
+#include "isxCsvWriter.h"
+#include "isxRelativeSampleTimes.h"
 
 #include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <limits>
 #include <cmath>
+#include <set>
 #include <qglobal.h>
 
 
@@ -25,6 +28,28 @@
 #include <unistd.h>
 #endif
 
+namespace
+{
+
+/// Quote a string as a Python string literal for a .npy header.
+std::string
+quoteForNpyHeader(const std::string & inString)
+{
+    std::string quoted = "'";
+    for (const char c : inString)
+    {
+        if (c == '\\' || c == '\'')
+        {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    quoted += "'";
+    return quoted;
+}
+
+} // namespace
+
 namespace isx {
 
 bool
@@ -161,9 +186,6 @@ writeLogicalTraces(
     const size_t numSegments = inTraces.front().size();
     ISX_ASSERT(numSegments > 0);
 
-    const int32_t maxDecimalsForDouble = std::numeric_limits<double>::digits10 + 1;
-    const int32_t maxDecimalsForFloat = std::numeric_limits<float>::digits10 + 1;
-
     // we write all time/value pairs of each channel sequentially, so
     // we need a channel name column (which will be sorted)
     inStream << "Time (s), " << inNameHeader;
@@ -188,39 +210,47 @@ writeLogicalTraces(
         }
     }
 
-    isize_t numLinesWritten = 0;
-    float progress = 0.f;
-    bool cancelled = false;
+    // flatten the rows, so they can be formatted in parallel
+    struct Row
+    {
+        const std::string * m_name;
+        const Time * m_time;
+        float m_value;
+    };
+    std::vector<Row> rows;
+    rows.reserve(numLinesTotal);
     for (size_t t = 0; t < numTraces; ++t)
     {
-        const std::string & name = inNames[t];
         for (size_t s = 0; s < numSegments; ++s)
         {
             for (const auto & tv : inTraces[t][s]->getValues())
             {
-                inStream << std::setprecision(maxDecimalsForDouble) << (tv.first - inBaseTime).toDouble() << ", " << name;
-                if (inWriteValue)
-                {
-                    inStream << ", " << std::setprecision(maxDecimalsForFloat) << tv.second;
-                }
-                inStream << "\n";
-
-                if (!inStream.good())
-                {
-                    ISX_THROW(ExceptionFileIO, "Error writing to output file.");
-                }
-
-                ++numLinesWritten;
-                progress = float(numLinesWritten) / float(numLinesTotal);
-                cancelled = inCheckInCB(progress);
-                if (cancelled)
-                {
-                    break;
-                }
+                rows.push_back({&inNames[t], &tv.first, tv.second});
             }
         }
     }
 
+    CsvWriter writer(inStream);
+    const bool cancelled = writeCsvRows(writer, rows.size(), inWriteValue ? 3 : 2,
+        [&rows, &inBaseTime, inWriteValue](CsvWriter & outWriter, const size_t inRow)
+        {
+            const Row & row = rows[inRow];
+            outWriter.appendDouble((*row.m_time - inBaseTime).toDouble());
+            outWriter.appendSeparator();
+            outWriter.appendString(*row.m_name);
+            if (inWriteValue)
+            {
+                outWriter.appendSeparator();
+                outWriter.appendFloat(row.m_value);
+            }
+            outWriter.appendChar('\n');
+        },
+        [&inCheckInCB, numLinesTotal](const size_t inNumRowsWritten)
+        {
+            return inCheckInCB(float(inNumRowsWritten) / float(numLinesTotal));
+        });
+    writer.flush();
+
     return cancelled;
 }
 
@@ -239,9 +269,6 @@ bool writeTraces(
     ISX_ASSERT(numTraces > 0);
     ISX_ASSERT(inNames.size() == numTraces);
 
-    const int32_t maxDecimalsForDouble = std::numeric_limits<double>::digits10 + 1;
-    const int32_t maxDecimalsForFloat = std::numeric_limits<float>::digits10 + 1;
-
     if (inStatuses.empty())
     {
         inStream << "Time (s)";
@@ -287,41 +314,153 @@ bool writeTraces(
         numLinesTotal += segment.front()->getTimingInfo().getNumTimes();
     }
 
-    float progress = 0.f;
     isize_t numLinesWritten = 0;
     bool cancelled = false;
+    CsvWriter writer(inStream);
 
     for (const auto & segment : inTraces)
     {
         const SpFTrace_t & refTrace = segment.front();
         const TimingInfo & ti = refTrace->getTimingInfo();
         const isize_t numSamples = ti.getNumTimes();
+        const isx::RelativeSampleTimes times(ti, inBaseTime);
 
-        for (isize_t s = 0; s < numSamples; ++s)
+        std::vector<const float *> values(numTraces);
+        for (isize_t t = 0; t < numTraces; ++t)
         {
-            const Time time = ti.convertIndexToStartTime(s);
-            inStream << std::setprecision(maxDecimalsForDouble) << (time - inBaseTime).toDouble();
+            values[t] = segment[t]->getValues();
+        }
 
-            for (isize_t t = 0; t < numTraces; ++t)
+        cancelled = writeCsvRows(writer, numSamples, numTraces + 1,
+            [&times, &values](CsvWriter & outWriter, const size_t inSample)
+            {
+                outWriter.appendDouble(times.get(inSample));
+                for (const float * traceValues : values)
+                {
+                    outWriter.appendSeparator();
+                    outWriter.appendFloat(traceValues[inSample]);
+                }
+                outWriter.appendChar('\n');
+            },
+            [&inCheckInCB, numLinesWritten, numLinesTotal](const size_t inNumRowsWritten)
             {
-                inStream << ", " << std::setprecision(maxDecimalsForFloat) << segment[t]->getValue(s);
+                return inCheckInCB(float(numLinesWritten + inNumRowsWritten) / float(numLinesTotal));
+            });
+        numLinesWritten += numSamples;
 
-                if (!inStream.good())
+        if (cancelled)
+        {
+            break;
+        }
+    }
+    writer.flush();
+
+    return cancelled;
+}
+
+bool writeTracesNpy(
+        const std::string & inFileName,
+        const std::vector<std::vector<SpFTrace_t>> & inTraces,
+        const std::vector<std::string> & inNames,
+        const Time & inBaseTime,
+        AsyncCheckInCB_t inCheckInCB)
+{
+    const size_t numSegments = inTraces.size();
+    ISX_ASSERT(numSegments > 0);
+    const size_t numTraces = inTraces.front().size();
+    ISX_ASSERT(numTraces > 0);
+    ISX_ASSERT(inNames.size() == numTraces);
+
+    const std::set<std::string> uniqueNames(inNames.begin(), inNames.end());
+    if (uniqueNames.size() != inNames.size() || uniqueNames.count("Time (s)") > 0)
+    {
+        ISX_THROW(ExceptionUserInput, "Trace names must be unique to export to a .npy file.");
+    }
+
+    isize_t numRows = 0;
+    for (const auto & segment : inTraces)
+    {
+        numRows += segment.front()->getTimingInfo().getNumTimes();
+    }
+
+    // The header is a Python dictionary literal padded with spaces and
+    // terminated by a newline, so that the data is aligned to 64 bytes.
+    std::string header = "{'descr': [('Time (s)', '<f8')";
+    for (const auto & name : inNames)
+    {
+        header += ", (" + quoteForNpyHeader(name) + ", '<f4')";
+    }
+    header += "], 'fortran_order': False, 'shape': (" + std::to_string(numRows) + ",), }";
+
+    // Version 1.0 stores the header length in 2 bytes, version 2.0 in 4 bytes.
+    const bool useVersion2 = (header.size() + 1 + 64) > std::numeric_limits<uint16_t>::max();
+    const size_t preambleSize = 8 + (useVersion2 ? 4 : 2);
+    const size_t paddedSize = ((preambleSize + header.size() + 1 + 63) / 64) * 64;
+    header.append(paddedSize - preambleSize - header.size() - 1, ' ');
+    header += '\n';
+
+    std::ofstream strm(inFileName, std::ios::binary | std::ios::trunc);
+    if (!strm.good())
+    {
+        ISX_THROW(ExceptionFileIO, "Error writing to output file.");
+    }
+
+    const char magic[] = {char(0x93), 'N', 'U', 'M', 'P', 'Y', char(useVersion2 ? 2 : 1), 0};
+    strm.write(magic, sizeof(magic));
+    const uint32_t headerSize = uint32_t(header.size());
+    const uint8_t headerSizeBytes[] =
+    {
+        uint8_t(headerSize), uint8_t(headerSize >> 8), uint8_t(headerSize >> 16), uint8_t(headerSize >> 24)
+    };
+    strm.write(reinterpret_cast<const char *>(headerSizeBytes), useVersion2 ? 4 : 2);
+    strm.write(header.data(), std::streamsize(header.size()));
+
+    // Rows are packed, so are written through a buffer of a whole number of rows.
+    const size_t rowSize = sizeof(double) + numTraces * sizeof(float);
+    const size_t numRowsPerBlock = std::max(size_t(1), size_t(1 << 20) / rowSize);
+    std::vector<char> block(numRowsPerBlock * rowSize);
+
+    isize_t numRowsWritten = 0;
+    bool cancelled = false;
+    for (const auto & segment : inTraces)
+    {
+        const TimingInfo & ti = segment.front()->getTimingInfo();
+        const isize_t numSamples = ti.getNumTimes();
+        const isx::RelativeSampleTimes times(ti, inBaseTime);
+
+        for (isize_t firstSample = 0; firstSample < numSamples && !cancelled; firstSample += numRowsPerBlock)
+        {
+            const isize_t numBlockRows = std::min(isize_t(numRowsPerBlock), numSamples - firstSample);
+            char * row = block.data();
+            for (isize_t s = firstSample; s < firstSample + numBlockRows; ++s)
+            {
+                const double time = times.get(s);
+                std::memcpy(row, &time, sizeof(time));
+                row += sizeof(time);
+                for (isize_t t = 0; t < numTraces; ++t)
                 {
-                    ISX_THROW(ExceptionFileIO, "Error writing to output file.");
+                    const float value = segment[t]->getValues()[s];
+                    std::memcpy(row, &value, sizeof(value));
+                    row += sizeof(value);
                 }
             }
-            inStream << "\n";
+            strm.write(block.data(), std::streamsize(numBlockRows * rowSize));
 
-            ++numLinesWritten;
-            progress = float(numLinesWritten) / float(numLinesTotal);
-            cancelled = inCheckInCB(progress);
-            if (cancelled)
+            if (!strm.good())
             {
-                break;
+                ISX_THROW(ExceptionFileIO, "Error writing to output file.");
             }
+
+            numRowsWritten += numBlockRows;
+            cancelled = inCheckInCB(float(numRowsWritten) / float(numRows));
+        }
+
+        if (cancelled)
+        {
+            break;
         }
     }
+
     return cancelled;
 }
 
@@ -0,0 +1,258 @@
+#include "isxFileHandlePool.h"
+#include "isxAssert.h"
+#include "isxException.h"
+#include "isxLog.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+namespace isx
+{
+
+namespace
+{
+
+struct PoolState
+{
+    std::mutex m_mutex;
+
+    /// The open pooled files from the most to the least recently used.
+    std::list<PooledFileHandle *> m_lru;
+
+    isize_t m_maxOpenHandles = FileHandlePool::s_defaultMaxOpenHandles;
+
+    FileHandlePoolStats m_stats;
+};
+
+/// The pool is never destroyed, so that readers that are destroyed
+/// during static destruction can still remove their files.
+PoolState &
+getPoolState()
+{
+    static PoolState * state = new PoolState();
+    return *state;
+}
+
+} // namespace
+
+FileHandlePoolStats
+FileHandlePool::getStats()
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    FileHandlePoolStats stats = state.m_stats;
+    stats.m_numOpenHandles = isize_t(state.m_lru.size());
+    return stats;
+}
+
+void
+FileHandlePool::resetStats()
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    state.m_stats.m_numOpens = 0;
+    state.m_stats.m_numEvictions = 0;
+}
+
+isize_t
+FileHandlePool::getMaxOpenHandles()
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    return state.m_maxOpenHandles;
+}
+
+void
+FileHandlePool::setMaxOpenHandles(const isize_t inMaxOpenHandles)
+{
+    ISX_ASSERT(inMaxOpenHandles > 0);
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    state.m_maxOpenHandles = std::max(inMaxOpenHandles, isize_t(1));
+    evictIdle(state.m_maxOpenHandles);
+}
+
+void
+FileHandlePool::acquire(PooledFileHandle * inHandle)
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if (!inHandle->m_managed)
+    {
+        return;
+    }
+
+    ++inHandle->m_numLeases;
+    if (inHandle->m_isOpen)
+    {
+        state.m_lru.splice(state.m_lru.begin(), state.m_lru, inHandle->m_lruPos);
+        return;
+    }
+
+    evictIdle(state.m_maxOpenHandles - 1);
+    try
+    {
+        inHandle->m_openFn();
+    }
+    catch (...)
+    {
+        --inHandle->m_numLeases;
+        throw;
+    }
+    inHandle->m_isOpen = true;
+    inHandle->m_lruPos = state.m_lru.insert(state.m_lru.begin(), inHandle);
+    ++state.m_stats.m_numOpens;
+}
+
+void
+FileHandlePool::release(PooledFileHandle * inHandle)
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if (!inHandle->m_managed)
+    {
+        return;
+    }
+
+    ISX_ASSERT(inHandle->m_numLeases > 0);
+    --inHandle->m_numLeases;
+
+    // Files that could not be closed while they were accessed are closed now.
+    evictIdle(state.m_maxOpenHandles);
+}
+
+void
+FileHandlePool::add(PooledFileHandle * inHandle, const bool inIsOpen)
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    ISX_ASSERT(!inHandle->m_managed);
+    inHandle->m_managed = true;
+    inHandle->m_isOpen = inIsOpen;
+    inHandle->m_numLeases = 0;
+    if (inIsOpen)
+    {
+        evictIdle(state.m_maxOpenHandles - 1);
+        inHandle->m_lruPos = state.m_lru.insert(state.m_lru.begin(), inHandle);
+        ++state.m_stats.m_numOpens;
+    }
+}
+
+void
+FileHandlePool::remove(PooledFileHandle * inHandle)
+{
+    PoolState & state = getPoolState();
+    std::lock_guard<std::mutex> lock(state.m_mutex);
+    if (!inHandle->m_managed)
+    {
+        return;
+    }
+
+    ISX_ASSERT(inHandle->m_numLeases == 0);
+    if (inHandle->m_isOpen)
+    {
+        state.m_lru.erase(inHandle->m_lruPos);
+    }
+    inHandle->m_managed = false;
+    inHandle->m_isOpen = false;
+}
+
+void
+FileHandlePool::evictIdle(const isize_t inMaxOpenHandles)
+{
+    // Only called with the pool mutex held.
+    PoolState & state = getPoolState();
+    auto it = state.m_lru.end();
+    while (isize_t(state.m_lru.size()) > inMaxOpenHandles && it != state.m_lru.begin())
+    {
+        --it;
+        PooledFileHandle * handle = *it;
+        if (handle->m_numLeases > 0)
+        {
+            continue;
+        }
+
+        try
+        {
+            handle->m_closeFn();
+        }
+        catch (const std::exception & error)
+        {
+            ISX_LOG_ERROR("Exception closing pooled file: ", error.what());
+        }
+        handle->m_isOpen = false;
+        it = state.m_lru.erase(it);
+        ++state.m_stats.m_numEvictions;
+    }
+}
+
+PooledFileHandle::Lease::Lease(PooledFileHandle & inHandle)
+    : m_handle(inHandle)
+{
+    FileHandlePool::acquire(&m_handle);
+}
+
+PooledFileHandle::Lease::~Lease()
+{
+    FileHandlePool::release(&m_handle);
+}
+
+PooledFileHandle::PooledFileHandle()
+{
+}
+
+PooledFileHandle::~PooledFileHandle()
+{
+    unmanage();
+}
+
+void
+PooledFileHandle::manage(OpenFn_t inOpen, CloseFn_t inClose, const bool inIsOpen)
+{
+    m_openFn = std::move(inOpen);
+    m_closeFn = std::move(inClose);
+    FileHandlePool::add(this, inIsOpen);
+}
+
+void
+PooledFileHandle::manageStream(std::fstream & inFile, const std::string & inFileName, const std::ios_base::openmode inOpenMode)
+{
+    if (inFile.is_open())
+    {
+        inFile.close();
+    }
+    manage(
+        [&inFile, &inFileName, inOpenMode]()
+        {
+            inFile.clear();
+            inFile.open(inFileName, inOpenMode);
+            if (!inFile.good() || !inFile.is_open())
+            {
+                ISX_THROW(isx::ExceptionFileIO,
+                    "Failed to reopen file for reading (", inFileName, ")", " with error: ", getSystemErrorString());
+            }
+        },
+        [&inFile]()
+        {
+            if (inFile.is_open())
+            {
+                inFile.close();
+            }
+        },
+        false);
+}
+
+void
+PooledFileHandle::unmanage()
+{
+    FileHandlePool::remove(this);
+}
+
+bool
+PooledFileHandle::isManaged() const
+{
+    return m_managed;
+}
+
+} // namespace isx
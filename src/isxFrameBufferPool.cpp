@@ -0,0 +1,232 @@
+#include "isxFrameBufferPool.h"
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if ISX_OS_WIN32
+#include <malloc.h>
+#endif
+
+namespace isx
+{
+
+namespace
+{
+
+/// Round a size up so that buffers of nearly the same size share a bucket.
+isize_t
+getBucketSize(const isize_t inSizeInBytes)
+{
+    const isize_t granularity = (inSizeInBytes > 4096) ? 4096 : FrameBufferPool::s_alignment;
+    const isize_t size = (inSizeInBytes == 0) ? 1 : inSizeInBytes;
+    return ((size + granularity - 1) / granularity) * granularity;
+}
+
+char *
+allocateAligned(const isize_t inSizeInBytes)
+{
+    void * buffer = nullptr;
+#if ISX_OS_WIN32
+    buffer = _aligned_malloc(inSizeInBytes, FrameBufferPool::s_alignment);
+#else
+    if (posix_memalign(&buffer, FrameBufferPool::s_alignment, inSizeInBytes) != 0)
+    {
+        buffer = nullptr;
+    }
+#endif
+    if (buffer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return static_cast<char *>(buffer);
+}
+
+void
+freeAligned(char * inBuffer)
+{
+#if ISX_OS_WIN32
+    _aligned_free(inBuffer);
+#else
+    std::free(inBuffer);
+#endif
+}
+
+class Pool
+{
+public:
+
+    char *
+    allocate(const isize_t inSizeInBytes)
+    {
+        const isize_t bucketSize = getBucketSize(inSizeInBytes);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_buckets.find(bucketSize);
+            if (it != m_buckets.end() && !it->second.empty())
+            {
+                char * buffer = it->second.back();
+                it->second.pop_back();
+                m_stats.m_numCachedBytes -= bucketSize;
+                --m_stats.m_numCachedBuffers;
+                ++m_stats.m_numHits;
+                return buffer;
+            }
+            ++m_stats.m_numMisses;
+        }
+        return allocateAligned(bucketSize);
+    }
+
+    void
+    release(char * inBuffer, const isize_t inSizeInBytes)
+    {
+        if (inBuffer == nullptr)
+        {
+            return;
+        }
+        const isize_t bucketSize = getBucketSize(inSizeInBytes);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stats.m_numCachedBytes + bucketSize <= m_maxCachedBytes)
+            {
+                m_buckets[bucketSize].push_back(inBuffer);
+                m_stats.m_numCachedBytes += bucketSize;
+                ++m_stats.m_numCachedBuffers;
+                return;
+            }
+            ++m_stats.m_numDiscarded;
+        }
+        freeAligned(inBuffer);
+    }
+
+    FrameBufferPoolStats
+    getStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void
+    resetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.m_numHits = 0;
+        m_stats.m_numMisses = 0;
+        m_stats.m_numDiscarded = 0;
+    }
+
+    void
+    setMaxCachedBytes(const isize_t inMaxCachedBytes)
+    {
+        std::vector<char *> toFree;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_maxCachedBytes = inMaxCachedBytes;
+
+            // Free the largest buffers first, since they are least likely to be reused.
+            for (auto it = m_buckets.rbegin(); it != m_buckets.rend(); ++it)
+            {
+                while (m_stats.m_numCachedBytes > m_maxCachedBytes && !it->second.empty())
+                {
+                    toFree.push_back(it->second.back());
+                    it->second.pop_back();
+                    m_stats.m_numCachedBytes -= it->first;
+                    --m_stats.m_numCachedBuffers;
+                }
+            }
+        }
+        for (char * buffer : toFree)
+        {
+            freeAligned(buffer);
+        }
+    }
+
+    void
+    clear()
+    {
+        std::map<isize_t, std::vector<char *>> buckets;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            buckets.swap(m_buckets);
+            m_stats.m_numCachedBytes = 0;
+            m_stats.m_numCachedBuffers = 0;
+        }
+        for (auto & bucket : buckets)
+        {
+            for (char * buffer : bucket.second)
+            {
+                freeAligned(buffer);
+            }
+        }
+    }
+
+private:
+
+    std::mutex m_mutex;
+
+    /// The cached buffers by their bucket size.
+    std::map<isize_t, std::vector<char *>> m_buckets;
+
+    isize_t m_maxCachedBytes = FrameBufferPool::s_defaultMaxCachedBytes;
+
+    FrameBufferPoolStats m_stats;
+};
+
+/// The pool is never destroyed, so that images that are destroyed
+/// during static destruction can still release their buffers.
+Pool &
+getPool()
+{
+    static Pool * pool = new Pool();
+    return *pool;
+}
+
+} // namespace
+
+char *
+FrameBufferPool::allocate(const isize_t inSizeInBytes)
+{
+    return getPool().allocate(inSizeInBytes);
+}
+
+void
+FrameBufferPool::release(char * inBuffer, const isize_t inSizeInBytes)
+{
+    getPool().release(inBuffer, inSizeInBytes);
+}
+
+FrameBufferPoolStats
+FrameBufferPool::getStats()
+{
+    return getPool().getStats();
+}
+
+void
+FrameBufferPool::resetStats()
+{
+    getPool().resetStats();
+}
+
+void
+FrameBufferPool::clear()
+{
+    getPool().clear();
+}
+
+void
+FrameBufferPool::setMaxCachedBytes(const isize_t inMaxCachedBytes)
+{
+    getPool().setMaxCachedBytes(inMaxCachedBytes);
+}
+
+UpFrameBuffer_t
+makeFrameBuffer(const isize_t inSizeInBytes)
+{
+    FrameBufferDeleter deleter;
+    deleter.m_sizeInBytes = inSizeInBytes;
+    return UpFrameBuffer_t(FrameBufferPool::allocate(inSizeInBytes), deleter);
+}
+
+} // namespace isx
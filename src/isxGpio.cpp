@@ -15,6 +15,24 @@ Gpio::getExtraProperties() const
     return "null";
 }
 
+LogicalTraceTable
+Gpio::getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs)
+{
+    const Time start = getTimingInfo().getStart();
+    LogicalTraceTable table;
+    for (const auto & channelName : getChannelList())
+    {
+        appendToLogicalTraceTable(getLogicalData(channelName), start, inStartMicroSecs, inEndMicroSecs, table);
+    }
+    return table;
+}
+
+SpLogicalTrace_t
+Gpio::getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime)
+{
+    return getLogicalTraceInRange(getLogicalData(inChannelName), inStartTime, inEndTime);
+}
+
 isx::DataSet::Type
 Gpio::getEventBasedFileType() const
 {
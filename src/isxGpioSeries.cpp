@@ -24,10 +24,10 @@ GpioSeries::GpioSeries(const std::vector<std::string> & inFileNames)
         return;
     }
 
-    for (const auto & fn : inFileNames)
+    m_gpios = openSeriesMembers<SpGpio_t>(inFileNames, [&inFileNames](const isize_t inIndex)
     {
-        m_gpios.emplace_back(readGpio(fn));
-    }
+        return readGpio(inFileNames[inIndex]);
+    });
 
     std::string errorMessage;
     for (isize_t i = 1; i < m_gpios.size(); ++i)
@@ -248,6 +248,31 @@ GpioSeries::getLogicalData(const std::string & inChannelName)
     return trace;
 }
 
+SpLogicalTrace_t
+GpioSeries::getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime)
+{
+    SpLogicalTrace_t trace = std::make_shared<LogicalTrace>(m_gaplessTimingInfo[inChannelName], inChannelName);
+    for (const auto & g : m_gpios)
+    {
+        // Members that end before or start after the window are not read at all.
+        const TimingInfo ti = g->getTimingInfo();
+        if (ti.getEnd() < inStartTime || ti.getStart() >= inEndTime)
+        {
+            continue;
+        }
+
+        const SpLogicalTrace_t gTrace = g->getLogicalDataInRange(inChannelName, inStartTime, inEndTime);
+        if (gTrace != nullptr)
+        {
+            for (const auto & kv : gTrace->getValues())
+            {
+                trace->addValue(kv.first, kv.second);
+            }
+        }
+    }
+    return trace;
+}
+
 void
 GpioSeries::getLogicalDataAsync(const std::string & inChannelName, GpioGetLogicalDataCB_t inCallback)
 {
@@ -70,6 +70,9 @@ public:
     void
     getLogicalDataAsync(const std::string & inChannelName, GpioGetLogicalDataCB_t inCallback) override;
 
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime) override;
+
     isx::TimingInfo 
     getTimingInfo(const std::string & inChannelName) const override;
 
@@ -3,6 +3,18 @@
 namespace isx
 {
 
+TimingInfo
+makeGpioTimingInfo(
+        const Time & inStartTime,
+        const DurationInSeconds & inSamplePeriod,
+        const uint64_t inFirstMicrosecondOffset,
+        const uint64_t inLastMicrosecondOffset)
+{
+    const auto duration = DurationInSeconds::fromMicroseconds(inLastMicrosecondOffset - inFirstMicrosecondOffset + 1);
+    const isize_t numTimes = isize_t(std::ceil(duration.toDouble() / inSamplePeriod.toDouble()));
+    return TimingInfo(inStartTime, inSamplePeriod, numTimes);
+}
+
 void
 writePktsToEventBasedFile(
         const std::string & inOutputFilePath,
@@ -15,9 +27,7 @@ writePktsToEventBasedFile(
         const uint64_t inLastMicrosecondOffset,
         const std::string & inExtraProps)
 {
-    const auto duration = DurationInSeconds::fromMicroseconds(inLastMicrosecondOffset - inFirstMicrosecondOffset + 1);
-    const isize_t numTimes = isize_t(std::ceil(duration.toDouble() / inSamplePeriod.toDouble()));
-    const TimingInfo timing(inStartTime, inSamplePeriod, numTimes);
+    const TimingInfo timing = makeGpioTimingInfo(inStartTime, inSamplePeriod, inFirstMicrosecondOffset, inLastMicrosecondOffset);
 
     ISX_ASSERT(inChannels.size() == inTypes.size());
     const std::vector<DurationInSeconds> steps(inChannels.size(), inSamplePeriod);
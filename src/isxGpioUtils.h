@@ -9,6 +9,20 @@
 namespace isx
 {
 
+/// Make the timing info of a GPIO file from the offsets of its first and last packets.
+///
+/// \param  inStartTime                 The start time of the file.
+/// \param  inSamplePeriod              The sample period of the file.
+/// \param  inFirstMicrosecondOffset    The offset of the first packet.
+/// \param  inLastMicrosecondOffset     The offset of the last packet.
+/// \return                             The timing info covering all packets.
+TimingInfo
+makeGpioTimingInfo(
+        const Time & inStartTime,
+        const DurationInSeconds & inSamplePeriod,
+        const uint64_t inFirstMicrosecondOffset,
+        const uint64_t inLastMicrosecondOffset);
+
 /// This is currently used when writing nVoke 1 and nVista 3
 /// GPIO data, so they they do things fairly consistently.
 void
@@ -247,31 +247,43 @@ Group::setUnmodified()
     
 std::string
 Group::toJsonString(const bool inPretty, const std::string & inPathToOmit) const
+{
+    if (inPretty)
+    {
+        return toJson(inPathToOmit).dump(4);
+    }
+    return toJson(inPathToOmit).dump();
+}
+
+json
+Group::toJson(const std::string & inPathToOmit) const
 {
     json jsonObj;
     jsonObj["itemType"] = size_t(getItemType());
     jsonObj["name"] = m_name;
-    jsonObj["items"] = json::array();
+    json items = json::array();
     for (const auto & item : m_items)
     {
-        jsonObj["items"].push_back(json::parse(item->toJsonString(inPretty, inPathToOmit)));
+        items.push_back(item->toJson(inPathToOmit));
     }
-    if (inPretty)
-    {
-        return jsonObj.dump(4);
-    }
-    return jsonObj.dump();
+    jsonObj["items"] = std::move(items);
+    return jsonObj;
 }
 
 std::shared_ptr<Group>
 Group::fromJsonString(const std::string & inString, const std::string & inAbsolutePathToPrepend)
 {
-    const json jsonObj = json::parse(inString);
-    const ProjectItem::Type itemType = ProjectItem::Type(size_t(jsonObj.at("itemType")));
+    return fromJson(json::parse(inString), inAbsolutePathToPrepend);
+}
+
+std::shared_ptr<Group>
+Group::fromJson(const json & inJson, const std::string & inAbsolutePathToPrepend)
+{
+    const ProjectItem::Type itemType = ProjectItem::Type(size_t(inJson.at("itemType")));
     ISX_ASSERT(itemType == ProjectItem::Type::GROUP);
-    const std::string name = jsonObj.at("name");
+    const std::string name = inJson.at("name");
     auto ret = std::make_shared<Group>(name);
-    for (const auto & jsonItem : jsonObj.at("items"))
+    for (const auto & jsonItem : inJson.at("items"))
     {
         std::shared_ptr<ProjectItem> item;
         const ProjectItem::Type itemType = ProjectItem::Type(isize_t(jsonItem.at("itemType")));
@@ -279,12 +291,12 @@ Group::fromJsonString(const std::string & inString, const std::string & inAbsolu
         {
             case ProjectItem::Type::GROUP:
             {
-                item = Group::fromJsonString(jsonItem.dump(), inAbsolutePathToPrepend);
+                item = Group::fromJson(jsonItem, inAbsolutePathToPrepend);
                 break;
             }
             case ProjectItem::Type::SERIES:
             {
-                item = Series::fromJsonString(jsonItem.dump(), inAbsolutePathToPrepend);
+                item = Series::fromJson(jsonItem, inAbsolutePathToPrepend);
                 break;
             }
             default:
@@ -5,10 +5,95 @@
 #include "isxGpioUtils.h"
 #include "isxJsonUtils.h"
 #include "isxPathUtils.h"
+#include "isxRelativeSampleTimes.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace isx
 {
 
+namespace
+{
+
+/// The offset of each sample of an IMU stream from the start of the recording,
+/// and the index of the recorded packet of each sample.
+///
+/// The offsets are the same as converting the start time of each sample
+/// to microseconds, but are computed with integer arithmetic where possible.
+struct StreamSamples
+{
+    StreamSamples(const TimingInfo & inTimingInfo, const Time & inStart)
+    {
+        const Time epoch;
+        const RelativeSampleTimes times(inTimingInfo, epoch);
+        const uint64_t startMicroSecs = inStart.getSecsSinceEpoch().toMicroseconds();
+        const std::vector<isize_t> & dropped = inTimingInfo.getDroppedFrames();
+        auto droppedIt = dropped.begin();
+
+        const isize_t numTimes = inTimingInfo.getNumTimes();
+        m_offsetsMicroSecs.resize(numTimes);
+        m_recordedIndices.resize(numTimes);
+        for (isize_t i = 0; i < numTimes; ++i)
+        {
+            m_offsetsMicroSecs[i] = uint64_t(times.get(i) * 1E6) - startMicroSecs;
+
+            while (droppedIt != dropped.end() && *droppedIt < i)
+            {
+                ++droppedIt;
+            }
+            if (droppedIt != dropped.end() && *droppedIt == i)
+            {
+                m_recordedIndices[i] = s_droppedIndex;
+            }
+            else
+            {
+                m_recordedIndices[i] = i - isize_t(droppedIt - dropped.begin());
+            }
+        }
+    }
+
+    /// The recorded index of a dropped sample.
+    static const isize_t s_droppedIndex = ~isize_t(0);
+
+    std::vector<uint64_t> m_offsetsMicroSecs;
+    std::vector<isize_t> m_recordedIndices;
+};
+
+/// Write all samples of one channel of an IMU stream to the output file in batches.
+///
+/// Dropped samples, and samples without a recorded packet, are written as NaN.
+template <typename Payload, typename GetValue>
+void
+writeStreamChannel(
+        EventBasedFileV2 & inOutputFile,
+        const uint64_t inSignal,
+        const StreamSamples & inSamples,
+        const std::vector<Payload> & inPkts,
+        GetValue inGetValue,
+        std::vector<EventBasedFileV2::DataPkt> & inBuffer)
+{
+    const size_t numTimes = inSamples.m_offsetsMicroSecs.size();
+    for (size_t i = 0; i < numTimes; ++i)
+    {
+        const isize_t recordedIndex = inSamples.m_recordedIndices[i];
+        const float value = (recordedIndex < inPkts.size())
+            ? inGetValue(inPkts[recordedIndex])
+            : std::numeric_limits<float>::quiet_NaN();
+        inBuffer.emplace_back(inSamples.m_offsetsMicroSecs[i], value, inSignal);
+
+        if (inBuffer.size() == IMUFile::s_numPktsPerWrite)
+        {
+            inOutputFile.writeDataPkts(inBuffer);
+            inBuffer.clear();
+        }
+    }
+    inOutputFile.writeDataPkts(inBuffer);
+    inBuffer.clear();
+}
+
+} // namespace
+
 IMUFile::IMUFile(const std::string & inFileName, const std::string & inOutputDir)
     : m_fileName(inFileName)
     , m_outputDir(inOutputDir)
@@ -55,6 +140,40 @@ IMUFile::setCheckInCallback(AsyncCheckInCB_t inCheckInCB)
     m_checkInCB = inCheckInCB;
 }
 
+template <typename Payload>
+bool
+IMUFile::readPayloads(
+        const uint64_t inOffset,
+        const uint64_t inCount,
+        std::vector<Payload> & outPayloads,
+        const double inProgressMultiplier,
+        size_t & ioProgress)
+{
+    outPayloads.resize(inCount);
+    m_file.clear();
+    m_file.seekg(std::streamoff(inOffset), std::fstream::beg);
+    for (uint64_t i = 0; i < inCount; i += s_numPktsPerRead)
+    {
+        const uint64_t numPkts = std::min(inCount - i, uint64_t(s_numPktsPerRead));
+        m_file.read(reinterpret_cast<char *>(&outPayloads[i]), std::streamsize(numPkts * sizeof(Payload)));
+        if (!m_file.good())
+        {
+            ISX_THROW(ExceptionFileIO, "Failed to read IMU data packets from file: ", m_fileName);
+        }
+
+        const auto newProgress = size_t(inProgressMultiplier * double(inOffset + (i + numPkts) * sizeof(Payload)));
+        if (newProgress != ioProgress)
+        {
+            ioProgress = newProgress;
+            if (m_checkInCB && m_checkInCB(float(ioProgress / 100.0)))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 AsyncTaskStatus
 IMUFile::parse()
 {
@@ -74,80 +193,30 @@ IMUFile::parse()
 
     // This is kept separate here in case payload size/field differs from each other in the future
     // accelerometer
-    auto accPkts = new AccPayload[header.accCount];
-    m_file.seekg(header.accOffset, std::fstream::beg);
+    std::vector<AccPayload> accPkts;
     ISX_ASSERT(header.accSize == sizeof(AccPayload) * header.accCount);
-    for (isize_t i = 0; i < header.accCount; ++i)
+    if (readPayloads(header.accOffset, header.accCount, accPkts, progressMultiplier, progress))
     {
-        AccPayload accPkt{};
-        m_file.read((char *)&accPkt, sizeof(accPkt));
-        accPkts[i] = accPkt;
-        // Report the progress for every 100 packet
-        if ((i % 100) == 0)
-        {
-            const auto newProgress = size_t(progressMultiplier * m_file.tellg());
-            if (newProgress != progress)
-            {
-                progress = newProgress;
-                if (m_checkInCB && m_checkInCB(float(progress / 100.0)))
-                {
-                    return AsyncTaskStatus::CANCELLED;
-                }
-            }
-        }
+        return AsyncTaskStatus::CANCELLED;
     }
     ISX_LOG_DEBUG("All acc read: ", header.accCount);
 
     // magnetometer
-    auto magPkts = new MagPayload[header.magCount];
-    m_file.seekg(header.magOffset, std::fstream::beg);
+    std::vector<MagPayload> magPkts;
     ISX_ASSERT(header.magSize == sizeof(MagPayload) * header.magCount);
-    for (isize_t i = 0; i < header.magCount; ++i)
+    if (readPayloads(header.magOffset, header.magCount, magPkts, progressMultiplier, progress))
     {
-        MagPayload magPkt{};
-        m_file.read((char *) &magPkt, sizeof(magPkt));
-        magPkts[i] = magPkt;
-
-        // Report the progress for every 100 packet
-        if ((i % 100) == 0)
-        {
-            const auto newProgress = size_t(progressMultiplier * m_file.tellg());
-            if (newProgress != progress)
-            {
-                progress = newProgress;
-                if (m_checkInCB && m_checkInCB(float(progress / 100.0)))
-                {
-                    return AsyncTaskStatus::CANCELLED;
-                }
-            }
-        }
+        return AsyncTaskStatus::CANCELLED;
     }
     ISX_LOG_DEBUG("All mag read: ", header.magCount);
 
     // orientation
-    auto oriPkts = new OriPayload[header.oriCount];
-    m_file.seekg(header.oriOffset, std::fstream::beg);
+    // step for ori is not calculated as it suppose to be synced with acc
+    std::vector<OriPayload> oriPkts;
     ISX_ASSERT(header.oriSize == sizeof(OriPayload) * header.oriCount);
-    for (isize_t i = 0; i < header.oriCount; ++i)
+    if (readPayloads(header.oriOffset, header.oriCount, oriPkts, progressMultiplier, progress))
     {
-        OriPayload oriPkt{};
-        m_file.read((char *)&oriPkt, sizeof(oriPkt));
-        oriPkts[i] = oriPkt;
-        // step for ori is not calculated as it suppose to be synced with acc
-
-        // Report the progress for every 100 packet
-        if ((i % 100) == 0)
-        {
-            const auto newProgress = size_t(progressMultiplier * m_file.tellg());
-            if (newProgress != progress)
-            {
-                progress = newProgress;
-                if (m_checkInCB && m_checkInCB(float(progress / 100.0)))
-                {
-                    return AsyncTaskStatus::CANCELLED;
-                }
-            }
-        }
+        return AsyncTaskStatus::CANCELLED;
     }
     ISX_LOG_DEBUG("All ori read: ", header.oriCount);
 
@@ -216,90 +285,30 @@ IMUFile::parse()
 
     EventBasedFileV2 outputFile(m_outputFileName, DataSet::Type::IMU, m_channels, steps, types);
 
-    std::vector<IMUSignalType> channelList;
-    channelList.insert(channelList.end(), s_maxAccArrSize, IMUSignalType::ACC);
-    channelList.insert(channelList.end(), s_maxOriArrSize, IMUSignalType::ORI);
-    channelList.insert(channelList.end(), s_maxMagArrSize, IMUSignalType::MAG);
+    const StreamSamples accOriSamples(accOriTimingInfo, start);
+    const StreamSamples magSamples(magTimingInfo, start);
+    std::vector<EventBasedFileV2::DataPkt> pkts;
+    pkts.reserve(s_numPktsPerWrite);
 
-    for (isize_t i = 0; i < channelList.size(); ++i)
+    uint64_t signal = 0;
+    for (uint8_t a = 0; a < s_maxAccArrSize; ++a, ++signal)
     {
-        switch (channelList[i])
-        {
-            case IMUSignalType::ACC:
-            {
-                for (isize_t j = 0; j < accOriTimingInfo.getNumTimes(); ++j)
-                {
-                    EventBasedFileV2::DataPkt pkt;
-                    pkt.signal = i;
-                    pkt.offsetMicroSecs =
-                        accOriTimingInfo.convertIndexToStartTime(j).getSecsSinceEpoch().toMicroseconds()
-                            -
-                                start.getSecsSinceEpoch().toMicroseconds();
-                    if (!accOriTimingInfo.isDropped(j))
-                    {
-                        pkt.value = accPkts[accOriTimingInfo.timeIdxToRecordedIdx(j)].accData[i];
-                    }
-                    else
-                    {
-                        pkt.value = std::numeric_limits<float>::quiet_NaN();
-                    }
-                    outputFile.writeDataPkt(pkt);
-                }
-                break;
-            }
-            case IMUSignalType::ORI:
-            {
-                for (isize_t j = 0; j < accOriTimingInfo.getNumTimes(); ++j)
-                {
-                    EventBasedFileV2::DataPkt pkt;
-                    pkt.signal = i;
-                    pkt.offsetMicroSecs =
-                        accOriTimingInfo.convertIndexToStartTime(j).getSecsSinceEpoch().toMicroseconds()
-                            -
-                                start.getSecsSinceEpoch().toMicroseconds();
-                    if (!accOriTimingInfo.isDropped(j))
-                    {
-                        pkt.value =
-                            float(oriPkts[accOriTimingInfo.timeIdxToRecordedIdx(j)].oriData[i-s_maxAccArrSize])
-                            / float(2048); // S4.11
-                    }
-                    else
-                    {
-                        pkt.value = std::numeric_limits<float>::quiet_NaN();
-                    }
-                    outputFile.writeDataPkt(pkt);
-                }
-                break;
-            }
-            case IMUSignalType::MAG:
-            {
-                for (isize_t j = 0; j < magTimingInfo.getNumTimes(); ++j)
-                {
-                    EventBasedFileV2::DataPkt pkt;
-                    pkt.signal = i;
-                    pkt.offsetMicroSecs =
-                        magTimingInfo.convertIndexToStartTime(j).getSecsSinceEpoch().toMicroseconds()
-                            -
-                                start.getSecsSinceEpoch().toMicroseconds();
-
-                    if (!magTimingInfo.isDropped(j))
-                    {
-                        pkt.value = magPkts[magTimingInfo.timeIdxToRecordedIdx(j)].magData[i-s_maxAccArrSize-s_maxOriArrSize];
-                    }
-                    else
-                    {
-                        pkt.value = std::numeric_limits<float>::quiet_NaN();
-                    }
-                    outputFile.writeDataPkt(pkt);
-                }
-                break;
-            }
-        }
+        writeStreamChannel(outputFile, signal, accOriSamples, accPkts,
+            [a](const AccPayload & inPkt) { return float(inPkt.accData[a]); },
+            pkts);
+    }
+    for (uint8_t a = 0; a < s_maxOriArrSize; ++a, ++signal)
+    {
+        writeStreamChannel(outputFile, signal, accOriSamples, oriPkts,
+            [a](const OriPayload & inPkt) { return float(inPkt.oriData[a]) / float(2048); }, // S4.11
+            pkts);
+    }
+    for (uint8_t a = 0; a < s_maxMagArrSize; ++a, ++signal)
+    {
+        writeStreamChannel(outputFile, signal, magSamples, magPkts,
+            [a](const MagPayload & inPkt) { return float(inPkt.magData[a]); },
+            pkts);
     }
-
-    delete[] accPkts;
-    delete[] magPkts;
-    delete[] oriPkts;
 
     outputFile.setExtraProperties(m_sessionStr);
     outputFile.setSmallStep(true);
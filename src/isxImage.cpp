@@ -22,7 +22,7 @@ Image::Image(  const SpacingInfo & inSpacingInfo,
     ISX_ASSERT(inRowBytes > 0);
     ISX_ASSERT(inNumChannels > 0);
     ISX_ASSERT(m_rowBytes >= getWidth() * getPixelSizeInBytes());
-    m_pixels.reset(new char[getImageSizeInBytes()]);
+    m_pixels = makeFrameBuffer(getImageSizeInBytes());
 }
 
 Image::Image(Image && inOther)
@@ -107,7 +107,7 @@ Image::getPixels() const
 {
     if (m_pixels)
     {
-        return &(m_pixels[0]);
+        return m_pixels.get();
     }
     return 0;
 }
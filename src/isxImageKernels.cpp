@@ -0,0 +1,840 @@
+#include "isxImageKernels.h"
+#include "isxException.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ISX_IMAGE_KERNELS_SSE2 1
+#include <emmintrin.h>
+#else
+#define ISX_IMAGE_KERNELS_SSE2 0
+#endif
+
+// AVX2 is not part of the x86-64 baseline, so its kernels are compiled for it
+// without compiling the rest of the library for it, and are only selected
+// when the CPU supports it. MSVC emits AVX2 intrinsics without any flags.
+#if ISX_IMAGE_KERNELS_SSE2 && (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+#define ISX_IMAGE_KERNELS_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ISX_IMAGE_KERNELS_AVX2_TARGET
+#else
+#define ISX_IMAGE_KERNELS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#else
+#define ISX_IMAGE_KERNELS_AVX2 0
+#endif
+
+// Division of float vectors is only part of NEON on AArch64.
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define ISX_IMAGE_KERNELS_NEON 1
+#include <arm_neon.h>
+#else
+#define ISX_IMAGE_KERNELS_NEON 0
+#endif
+
+namespace isx
+{
+
+namespace
+{
+
+/// The implementations of the kernels for one instruction set.
+struct ImageKernels
+{
+    ImageKernelsIsa m_isa;
+    void (*m_getMinMaxF32)(const float *, isize_t, float &, float &);
+    void (*m_getMinMaxU16)(const uint16_t *, isize_t, uint16_t &, uint16_t &);
+    void (*m_getMinMaxU8)(const uint8_t *, isize_t, uint8_t &, uint8_t &);
+    void (*m_addF32)(const float *, isize_t, float *);
+    float (*m_sumThresholdedF32)(const float *, isize_t, float);
+    void (*m_thresholdAndDivideF32)(const float *, isize_t, float, float, float *);
+    void (*m_addThresholdedAndDividedF32)(const float *, isize_t, float, float, float *);
+    void (*m_convertF32toU8)(const float *, isize_t, float, float, uint8_t *);
+};
+
+// Scalar kernels, which are also used for the values that do not fill a vector.
+
+template <typename T>
+void
+getMinMaxScalar(const T * inValues, const isize_t inNumValues, T & outMin, T & outMax)
+{
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    for (isize_t i = 0; i < inNumValues; ++i)
+    {
+        min = std::min<T>(min, inValues[i]);
+        max = std::max<T>(max, inValues[i]);
+    }
+    outMin = min;
+    outMax = max;
+}
+
+void
+addF32Scalar(const float * inValues, const isize_t inNumValues, float * inOutSums)
+{
+    for (isize_t i = 0; i < inNumValues; ++i)
+    {
+        inOutSums[i] += inValues[i];
+    }
+}
+
+float
+sumThresholdedF32Scalar(const float * inValues, const isize_t inNumValues, const float inThreshold)
+{
+    float sum = 0.f;
+    for (isize_t i = 0; i < inNumValues; ++i)
+    {
+        sum += (inValues[i] < inThreshold) ? 0.f : inValues[i];
+    }
+    return sum;
+}
+
+void
+thresholdAndDivideF32Scalar(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * outValues)
+{
+    for (isize_t i = 0; i < inNumValues; ++i)
+    {
+        outValues[i] = (inValues[i] < inThreshold) ? 0.f : inValues[i] / inDivisor;
+    }
+}
+
+void
+addThresholdedAndDividedF32Scalar(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * inOutSums)
+{
+    for (isize_t i = 0; i < inNumValues; ++i)
+    {
+        inOutSums[i] += (inValues[i] < inThreshold) ? 0.f : inValues[i] / inDivisor;
+    }
+}
+
+void
+convertF32toU8Scalar(
+        const float * inValues, const isize_t inNumValues, const float inOffset, const float inFactor, uint8_t * outValues)
+{
+    for (isize_t i = 0; i < inNumValues; ++i)
+    {
+        outValues[i] = uint8_t((inValues[i] - inOffset) * inFactor);
+    }
+}
+
+const ImageKernels s_scalarKernels =
+{
+    ImageKernelsIsa::SCALAR,
+    getMinMaxScalar<float>,
+    getMinMaxScalar<uint16_t>,
+    getMinMaxScalar<uint8_t>,
+    addF32Scalar,
+    sumThresholdedF32Scalar,
+    thresholdAndDivideF32Scalar,
+    addThresholdedAndDividedF32Scalar,
+    convertF32toU8Scalar,
+};
+
+#if ISX_IMAGE_KERNELS_SSE2
+
+void
+getMinMaxF32Sse2(const float * inValues, const isize_t inNumValues, float & outMin, float & outMax)
+{
+    __m128 min = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128 max = _mm_set1_ps(std::numeric_limits<float>::lowest());
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(inValues + i);
+        // Like std::min and std::max, this ignores NaN values, which are the first operand.
+        min = _mm_min_ps(v, min);
+        max = _mm_max_ps(v, max);
+    }
+
+    float mins[4];
+    float maxs[4];
+    _mm_storeu_ps(mins, min);
+    _mm_storeu_ps(maxs, max);
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    outMin = std::min({outMin, mins[0], mins[1], mins[2], mins[3]});
+    outMax = std::max({outMax, maxs[0], maxs[1], maxs[2], maxs[3]});
+}
+
+void
+getMinMaxU16Sse2(const uint16_t * inValues, const isize_t inNumValues, uint16_t & outMin, uint16_t & outMax)
+{
+    // SSE2 only compares signed 16-bit integers, so the sign bit is flipped
+    // to map unsigned values to signed ones with the same order.
+    const __m128i signBit = _mm_set1_epi16(int16_t(0x8000));
+    __m128i min = _mm_set1_epi16(std::numeric_limits<int16_t>::max());
+    __m128i max = _mm_set1_epi16(std::numeric_limits<int16_t>::lowest());
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(inValues + i)), signBit);
+        min = _mm_min_epi16(min, v);
+        max = _mm_max_epi16(max, v);
+    }
+
+    uint16_t mins[8];
+    uint16_t maxs[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(mins), _mm_xor_si128(min, signBit));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxs), _mm_xor_si128(max, signBit));
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    for (size_t j = 0; j < 8; ++j)
+    {
+        outMin = std::min(outMin, mins[j]);
+        outMax = std::max(outMax, maxs[j]);
+    }
+}
+
+void
+getMinMaxU8Sse2(const uint8_t * inValues, const isize_t inNumValues, uint8_t & outMin, uint8_t & outMax)
+{
+    __m128i min = _mm_set1_epi8(char(0xFF));
+    __m128i max = _mm_setzero_si128();
+    isize_t i = 0;
+    for (; i + 16 <= inNumValues; i += 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inValues + i));
+        min = _mm_min_epu8(min, v);
+        max = _mm_max_epu8(max, v);
+    }
+
+    uint8_t mins[16];
+    uint8_t maxs[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(mins), min);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(maxs), max);
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    for (size_t j = 0; j < 16; ++j)
+    {
+        outMin = std::min(outMin, mins[j]);
+        outMax = std::max(outMax, maxs[j]);
+    }
+}
+
+void
+addF32Sse2(const float * inValues, const isize_t inNumValues, float * inOutSums)
+{
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        _mm_storeu_ps(inOutSums + i, _mm_add_ps(_mm_loadu_ps(inOutSums + i), _mm_loadu_ps(inValues + i)));
+    }
+    addF32Scalar(inValues + i, inNumValues - i, inOutSums + i);
+}
+
+/// \return The values that are not less than a threshold, with the others zeroed.
+inline __m128
+thresholdSse2(const __m128 inValues, const __m128 inThreshold)
+{
+    return _mm_andnot_ps(_mm_cmplt_ps(inValues, inThreshold), inValues);
+}
+
+float
+sumThresholdedF32Sse2(const float * inValues, const isize_t inNumValues, const float inThreshold)
+{
+    const __m128 threshold = _mm_set1_ps(inThreshold);
+    __m128 sum = _mm_setzero_ps();
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        sum = _mm_add_ps(sum, thresholdSse2(_mm_loadu_ps(inValues + i), threshold));
+    }
+
+    float sums[4];
+    _mm_storeu_ps(sums, sum);
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]) + sumThresholdedF32Scalar(inValues + i, inNumValues - i, inThreshold);
+}
+
+void
+thresholdAndDivideF32Sse2(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * outValues)
+{
+    const __m128 threshold = _mm_set1_ps(inThreshold);
+    const __m128 divisor = _mm_set1_ps(inDivisor);
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(inValues + i);
+        _mm_storeu_ps(outValues + i, _mm_andnot_ps(_mm_cmplt_ps(v, threshold), _mm_div_ps(v, divisor)));
+    }
+    thresholdAndDivideF32Scalar(inValues + i, inNumValues - i, inThreshold, inDivisor, outValues + i);
+}
+
+void
+addThresholdedAndDividedF32Sse2(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * inOutSums)
+{
+    const __m128 threshold = _mm_set1_ps(inThreshold);
+    const __m128 divisor = _mm_set1_ps(inDivisor);
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const __m128 v = _mm_loadu_ps(inValues + i);
+        const __m128 thresholded = _mm_andnot_ps(_mm_cmplt_ps(v, threshold), _mm_div_ps(v, divisor));
+        _mm_storeu_ps(inOutSums + i, _mm_add_ps(_mm_loadu_ps(inOutSums + i), thresholded));
+    }
+    addThresholdedAndDividedF32Scalar(inValues + i, inNumValues - i, inThreshold, inDivisor, inOutSums + i);
+}
+
+void
+convertF32toU8Sse2(
+        const float * inValues, const isize_t inNumValues, const float inOffset, const float inFactor, uint8_t * outValues)
+{
+    const __m128 offset = _mm_set1_ps(inOffset);
+    const __m128 factor = _mm_set1_ps(inFactor);
+    isize_t i = 0;
+    for (; i + 16 <= inNumValues; i += 16)
+    {
+        __m128i ints[4];
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const __m128 v = _mm_loadu_ps(inValues + i + 4 * j);
+            ints[j] = _mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(v, offset), factor));
+        }
+        const __m128i shorts0 = _mm_packs_epi32(ints[0], ints[1]);
+        const __m128i shorts1 = _mm_packs_epi32(ints[2], ints[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(outValues + i), _mm_packus_epi16(shorts0, shorts1));
+    }
+    convertF32toU8Scalar(inValues + i, inNumValues - i, inOffset, inFactor, outValues + i);
+}
+
+const ImageKernels s_sse2Kernels =
+{
+    ImageKernelsIsa::SSE2,
+    getMinMaxF32Sse2,
+    getMinMaxU16Sse2,
+    getMinMaxU8Sse2,
+    addF32Sse2,
+    sumThresholdedF32Sse2,
+    thresholdAndDivideF32Sse2,
+    addThresholdedAndDividedF32Sse2,
+    convertF32toU8Sse2,
+};
+
+#endif // ISX_IMAGE_KERNELS_SSE2
+
+#if ISX_IMAGE_KERNELS_AVX2
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+getMinMaxF32Avx2(const float * inValues, const isize_t inNumValues, float & outMin, float & outMax)
+{
+    __m256 min = _mm256_set1_ps(std::numeric_limits<float>::max());
+    __m256 max = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(inValues + i);
+        // Like std::min and std::max, this ignores NaN values, which are the first operand.
+        min = _mm256_min_ps(v, min);
+        max = _mm256_max_ps(v, max);
+    }
+
+    float mins[8];
+    float maxs[8];
+    _mm256_storeu_ps(mins, min);
+    _mm256_storeu_ps(maxs, max);
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    for (size_t j = 0; j < 8; ++j)
+    {
+        outMin = std::min(outMin, mins[j]);
+        outMax = std::max(outMax, maxs[j]);
+    }
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+getMinMaxU16Avx2(const uint16_t * inValues, const isize_t inNumValues, uint16_t & outMin, uint16_t & outMax)
+{
+    __m256i min = _mm256_set1_epi16(int16_t(0xFFFF));
+    __m256i max = _mm256_setzero_si256();
+    isize_t i = 0;
+    for (; i + 16 <= inNumValues; i += 16)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(inValues + i));
+        min = _mm256_min_epu16(min, v);
+        max = _mm256_max_epu16(max, v);
+    }
+
+    uint16_t mins[16];
+    uint16_t maxs[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(mins), min);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(maxs), max);
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    for (size_t j = 0; j < 16; ++j)
+    {
+        outMin = std::min(outMin, mins[j]);
+        outMax = std::max(outMax, maxs[j]);
+    }
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+getMinMaxU8Avx2(const uint8_t * inValues, const isize_t inNumValues, uint8_t & outMin, uint8_t & outMax)
+{
+    __m256i min = _mm256_set1_epi8(char(0xFF));
+    __m256i max = _mm256_setzero_si256();
+    isize_t i = 0;
+    for (; i + 32 <= inNumValues; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(inValues + i));
+        min = _mm256_min_epu8(min, v);
+        max = _mm256_max_epu8(max, v);
+    }
+
+    uint8_t mins[32];
+    uint8_t maxs[32];
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(mins), min);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(maxs), max);
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    for (size_t j = 0; j < 32; ++j)
+    {
+        outMin = std::min(outMin, mins[j]);
+        outMax = std::max(outMax, maxs[j]);
+    }
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+addF32Avx2(const float * inValues, const isize_t inNumValues, float * inOutSums)
+{
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        _mm256_storeu_ps(inOutSums + i, _mm256_add_ps(_mm256_loadu_ps(inOutSums + i), _mm256_loadu_ps(inValues + i)));
+    }
+    addF32Scalar(inValues + i, inNumValues - i, inOutSums + i);
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+float
+sumThresholdedF32Avx2(const float * inValues, const isize_t inNumValues, const float inThreshold)
+{
+    const __m256 threshold = _mm256_set1_ps(inThreshold);
+    __m256 sum = _mm256_setzero_ps();
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(inValues + i);
+        sum = _mm256_add_ps(sum, _mm256_andnot_ps(_mm256_cmp_ps(v, threshold, _CMP_LT_OQ), v));
+    }
+
+    float sums[8];
+    _mm256_storeu_ps(sums, sum);
+    return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]))
+        + sumThresholdedF32Scalar(inValues + i, inNumValues - i, inThreshold);
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+thresholdAndDivideF32Avx2(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * outValues)
+{
+    const __m256 threshold = _mm256_set1_ps(inThreshold);
+    const __m256 divisor = _mm256_set1_ps(inDivisor);
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(inValues + i);
+        _mm256_storeu_ps(outValues + i, _mm256_andnot_ps(_mm256_cmp_ps(v, threshold, _CMP_LT_OQ), _mm256_div_ps(v, divisor)));
+    }
+    thresholdAndDivideF32Scalar(inValues + i, inNumValues - i, inThreshold, inDivisor, outValues + i);
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+addThresholdedAndDividedF32Avx2(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * inOutSums)
+{
+    const __m256 threshold = _mm256_set1_ps(inThreshold);
+    const __m256 divisor = _mm256_set1_ps(inDivisor);
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(inValues + i);
+        const __m256 thresholded = _mm256_andnot_ps(_mm256_cmp_ps(v, threshold, _CMP_LT_OQ), _mm256_div_ps(v, divisor));
+        _mm256_storeu_ps(inOutSums + i, _mm256_add_ps(_mm256_loadu_ps(inOutSums + i), thresholded));
+    }
+    addThresholdedAndDividedF32Scalar(inValues + i, inNumValues - i, inThreshold, inDivisor, inOutSums + i);
+}
+
+ISX_IMAGE_KERNELS_AVX2_TARGET
+void
+convertF32toU8Avx2(
+        const float * inValues, const isize_t inNumValues, const float inOffset, const float inFactor, uint8_t * outValues)
+{
+    const __m256 offset = _mm256_set1_ps(inOffset);
+    const __m256 factor = _mm256_set1_ps(inFactor);
+    // The packs work within 128-bit lanes, so this puts the groups of 4 bytes back in order.
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    isize_t i = 0;
+    for (; i + 32 <= inNumValues; i += 32)
+    {
+        __m256i ints[4];
+        for (size_t j = 0; j < 4; ++j)
+        {
+            const __m256 v = _mm256_loadu_ps(inValues + i + 8 * j);
+            ints[j] = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(v, offset), factor));
+        }
+        const __m256i shorts0 = _mm256_packs_epi32(ints[0], ints[1]);
+        const __m256i shorts1 = _mm256_packs_epi32(ints[2], ints[3]);
+        const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(shorts0, shorts1), order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(outValues + i), bytes);
+    }
+    convertF32toU8Scalar(inValues + i, inNumValues - i, inOffset, inFactor, outValues + i);
+}
+
+const ImageKernels s_avx2Kernels =
+{
+    ImageKernelsIsa::AVX2,
+    getMinMaxF32Avx2,
+    getMinMaxU16Avx2,
+    getMinMaxU8Avx2,
+    addF32Avx2,
+    sumThresholdedF32Avx2,
+    thresholdAndDivideF32Avx2,
+    addThresholdedAndDividedF32Avx2,
+    convertF32toU8Avx2,
+};
+
+/// \return True if the CPU and the OS support AVX2.
+bool
+isAvx2Supported()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    // The OS must save the AVX registers, which is checked with OSXSAVE and XGETBV.
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    // This may run during static initialization, before the CPU model is.
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // ISX_IMAGE_KERNELS_AVX2
+
+#if ISX_IMAGE_KERNELS_NEON
+
+void
+getMinMaxF32Neon(const float * inValues, const isize_t inNumValues, float & outMin, float & outMax)
+{
+    float32x4_t min = vdupq_n_f32(std::numeric_limits<float>::max());
+    float32x4_t max = vdupq_n_f32(std::numeric_limits<float>::lowest());
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(inValues + i);
+        // Like std::min and std::max, this ignores NaN values.
+        min = vminnmq_f32(min, v);
+        max = vmaxnmq_f32(max, v);
+    }
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    outMin = std::min(outMin, vminvq_f32(min));
+    outMax = std::max(outMax, vmaxvq_f32(max));
+}
+
+void
+getMinMaxU16Neon(const uint16_t * inValues, const isize_t inNumValues, uint16_t & outMin, uint16_t & outMax)
+{
+    uint16x8_t min = vdupq_n_u16(std::numeric_limits<uint16_t>::max());
+    uint16x8_t max = vdupq_n_u16(0);
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const uint16x8_t v = vld1q_u16(inValues + i);
+        min = vminq_u16(min, v);
+        max = vmaxq_u16(max, v);
+    }
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    outMin = std::min(outMin, vminvq_u16(min));
+    outMax = std::max(outMax, vmaxvq_u16(max));
+}
+
+void
+getMinMaxU8Neon(const uint8_t * inValues, const isize_t inNumValues, uint8_t & outMin, uint8_t & outMax)
+{
+    uint8x16_t min = vdupq_n_u8(std::numeric_limits<uint8_t>::max());
+    uint8x16_t max = vdupq_n_u8(0);
+    isize_t i = 0;
+    for (; i + 16 <= inNumValues; i += 16)
+    {
+        const uint8x16_t v = vld1q_u8(inValues + i);
+        min = vminq_u8(min, v);
+        max = vmaxq_u8(max, v);
+    }
+    getMinMaxScalar(inValues + i, inNumValues - i, outMin, outMax);
+    outMin = std::min(outMin, vminvq_u8(min));
+    outMax = std::max(outMax, vmaxvq_u8(max));
+}
+
+void
+addF32Neon(const float * inValues, const isize_t inNumValues, float * inOutSums)
+{
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        vst1q_f32(inOutSums + i, vaddq_f32(vld1q_f32(inOutSums + i), vld1q_f32(inValues + i)));
+    }
+    addF32Scalar(inValues + i, inNumValues - i, inOutSums + i);
+}
+
+float
+sumThresholdedF32Neon(const float * inValues, const isize_t inNumValues, const float inThreshold)
+{
+    const float32x4_t threshold = vdupq_n_f32(inThreshold);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    float32x4_t sum = zero;
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(inValues + i);
+        sum = vaddq_f32(sum, vbslq_f32(vcltq_f32(v, threshold), zero, v));
+    }
+    return vaddvq_f32(sum) + sumThresholdedF32Scalar(inValues + i, inNumValues - i, inThreshold);
+}
+
+void
+thresholdAndDivideF32Neon(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * outValues)
+{
+    const float32x4_t threshold = vdupq_n_f32(inThreshold);
+    const float32x4_t divisor = vdupq_n_f32(inDivisor);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(inValues + i);
+        vst1q_f32(outValues + i, vbslq_f32(vcltq_f32(v, threshold), zero, vdivq_f32(v, divisor)));
+    }
+    thresholdAndDivideF32Scalar(inValues + i, inNumValues - i, inThreshold, inDivisor, outValues + i);
+}
+
+void
+addThresholdedAndDividedF32Neon(
+        const float * inValues, const isize_t inNumValues, const float inThreshold, const float inDivisor, float * inOutSums)
+{
+    const float32x4_t threshold = vdupq_n_f32(inThreshold);
+    const float32x4_t divisor = vdupq_n_f32(inDivisor);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    isize_t i = 0;
+    for (; i + 4 <= inNumValues; i += 4)
+    {
+        const float32x4_t v = vld1q_f32(inValues + i);
+        const float32x4_t thresholded = vbslq_f32(vcltq_f32(v, threshold), zero, vdivq_f32(v, divisor));
+        vst1q_f32(inOutSums + i, vaddq_f32(vld1q_f32(inOutSums + i), thresholded));
+    }
+    addThresholdedAndDividedF32Scalar(inValues + i, inNumValues - i, inThreshold, inDivisor, inOutSums + i);
+}
+
+void
+convertF32toU8Neon(
+        const float * inValues, const isize_t inNumValues, const float inOffset, const float inFactor, uint8_t * outValues)
+{
+    const float32x4_t offset = vdupq_n_f32(inOffset);
+    const float32x4_t factor = vdupq_n_f32(inFactor);
+    isize_t i = 0;
+    for (; i + 8 <= inNumValues; i += 8)
+    {
+        const int32x4_t ints0 = vcvtq_s32_f32(vmulq_f32(vsubq_f32(vld1q_f32(inValues + i), offset), factor));
+        const int32x4_t ints1 = vcvtq_s32_f32(vmulq_f32(vsubq_f32(vld1q_f32(inValues + i + 4), offset), factor));
+        const uint16x8_t shorts = vcombine_u16(vqmovun_s32(ints0), vqmovun_s32(ints1));
+        vst1_u8(outValues + i, vqmovn_u16(shorts));
+    }
+    convertF32toU8Scalar(inValues + i, inNumValues - i, inOffset, inFactor, outValues + i);
+}
+
+const ImageKernels s_neonKernels =
+{
+    ImageKernelsIsa::NEON,
+    getMinMaxF32Neon,
+    getMinMaxU16Neon,
+    getMinMaxU8Neon,
+    addF32Neon,
+    sumThresholdedF32Neon,
+    thresholdAndDivideF32Neon,
+    addThresholdedAndDividedF32Neon,
+    convertF32toU8Neon,
+};
+
+#endif // ISX_IMAGE_KERNELS_NEON
+
+/// \return The kernels of an instruction set, or nullptr if it is not supported
+///         by this build or this CPU.
+const ImageKernels *
+getSupportedImageKernels(const ImageKernelsIsa inIsa)
+{
+    switch (inIsa)
+    {
+        case ImageKernelsIsa::SCALAR:
+            return &s_scalarKernels;
+#if ISX_IMAGE_KERNELS_SSE2
+        case ImageKernelsIsa::SSE2:
+            return &s_sse2Kernels;
+#endif
+#if ISX_IMAGE_KERNELS_AVX2
+        case ImageKernelsIsa::AVX2:
+        {
+            static const bool s_isAvx2Supported = isAvx2Supported();
+            return s_isAvx2Supported ? &s_avx2Kernels : nullptr;
+        }
+#endif
+#if ISX_IMAGE_KERNELS_NEON
+        case ImageKernelsIsa::NEON:
+            return &s_neonKernels;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+const ImageKernels *
+getBestImageKernels()
+{
+    for (const ImageKernelsIsa isa : {ImageKernelsIsa::AVX2, ImageKernelsIsa::SSE2, ImageKernelsIsa::NEON})
+    {
+        if (const ImageKernels * kernels = getSupportedImageKernels(isa))
+        {
+            return kernels;
+        }
+    }
+    return &s_scalarKernels;
+}
+
+std::atomic<const ImageKernels *> g_imageKernels(getBestImageKernels());
+
+const ImageKernels &
+getImageKernels()
+{
+    return *g_imageKernels.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+std::string
+getImageKernelsIsaName(const ImageKernelsIsa inIsa)
+{
+    switch (inIsa)
+    {
+        case ImageKernelsIsa::SCALAR:
+            return "scalar";
+        case ImageKernelsIsa::SSE2:
+            return "SSE2";
+        case ImageKernelsIsa::NEON:
+            return "NEON";
+        case ImageKernelsIsa::AVX2:
+            return "AVX2";
+    }
+    return "unknown";
+}
+
+ImageKernelsIsa
+getBestImageKernelsIsa()
+{
+    return getBestImageKernels()->m_isa;
+}
+
+ImageKernelsIsa
+getImageKernelsIsa()
+{
+    return getImageKernels().m_isa;
+}
+
+bool
+isImageKernelsIsaSupported(const ImageKernelsIsa inIsa)
+{
+    return getSupportedImageKernels(inIsa) != nullptr;
+}
+
+void
+setImageKernelsIsa(const ImageKernelsIsa inIsa)
+{
+    const ImageKernels * kernels = getSupportedImageKernels(inIsa);
+    if (kernels == nullptr)
+    {
+        ISX_THROW(ExceptionUserInput, "The ", getImageKernelsIsaName(inIsa),
+                " image kernels are not supported by this build or CPU.");
+    }
+    g_imageKernels = kernels;
+}
+
+void
+getMinMaxF32(const float * inValues, const isize_t inNumValues, float & outMin, float & outMax)
+{
+    getImageKernels().m_getMinMaxF32(inValues, inNumValues, outMin, outMax);
+}
+
+void
+getMinMaxU16(const uint16_t * inValues, const isize_t inNumValues, uint16_t & outMin, uint16_t & outMax)
+{
+    getImageKernels().m_getMinMaxU16(inValues, inNumValues, outMin, outMax);
+}
+
+void
+getMinMaxU8(const uint8_t * inValues, const isize_t inNumValues, uint8_t & outMin, uint8_t & outMax)
+{
+    getImageKernels().m_getMinMaxU8(inValues, inNumValues, outMin, outMax);
+}
+
+void
+addF32(const float * inValues, const isize_t inNumValues, float * inOutSums)
+{
+    getImageKernels().m_addF32(inValues, inNumValues, inOutSums);
+}
+
+float
+sumThresholdedF32(const float * inValues, const isize_t inNumValues, const float inThreshold)
+{
+    return getImageKernels().m_sumThresholdedF32(inValues, inNumValues, inThreshold);
+}
+
+void
+thresholdAndDivideF32(
+        const float * inValues,
+        const isize_t inNumValues,
+        const float inThreshold,
+        const float inDivisor,
+        float * outValues)
+{
+    getImageKernels().m_thresholdAndDivideF32(inValues, inNumValues, inThreshold, inDivisor, outValues);
+}
+
+void
+addThresholdedAndDividedF32(
+        const float * inValues,
+        const isize_t inNumValues,
+        const float inThreshold,
+        const float inDivisor,
+        float * inOutSums)
+{
+    getImageKernels().m_addThresholdedAndDividedF32(inValues, inNumValues, inThreshold, inDivisor, inOutSums);
+}
+
+void
+convertF32toU8(
+        const float * inValues,
+        const isize_t inNumValues,
+        const float inOffset,
+        const float inFactor,
+        uint8_t * outValues)
+{
+    getImageKernels().m_convertF32toU8(inValues, inNumValues, inOffset, inFactor, outValues);
+}
+
+} // namespace isx
@@ -0,0 +1,126 @@
+#ifndef ISX_IMAGE_KERNELS_H
+#define ISX_IMAGE_KERNELS_H
+
+#include "isxCore.h"
+
+#include <string>
+
+namespace isx
+{
+
+/// The instruction sets that the image kernels can be implemented with.
+///
+/// SSE2 and NEON are part of the x86-64 and AArch64 baselines, so they are
+/// available whenever they are compiled. AVX2 kernels are compiled on x86-64
+/// and are the best ones when the CPU supports them, which is checked at runtime.
+/// The scalar kernels are always available and can be selected at runtime,
+/// which is used to test and benchmark the vector kernels against them.
+enum class ImageKernelsIsa
+{
+    SCALAR = 0,
+    SSE2,
+    NEON,
+    AVX2
+};
+
+/// \return The name of an instruction set.
+///
+std::string getImageKernelsIsaName(const ImageKernelsIsa inIsa);
+
+/// \return The best instruction set supported by this build and CPU.
+///
+ImageKernelsIsa getBestImageKernelsIsa();
+
+/// \param  inIsa   The instruction set.
+/// \return         True if the instruction set is supported by this build and CPU.
+bool isImageKernelsIsaSupported(const ImageKernelsIsa inIsa);
+
+/// \return The instruction set that the image kernels currently use.
+///
+ImageKernelsIsa getImageKernelsIsa();
+
+/// Set the instruction set that the image kernels use.
+///
+/// \param  inIsa   The instruction set to use.
+/// \throw  isx::ExceptionUserInput If the instruction set is not supported by this build or CPU.
+void setImageKernelsIsa(const ImageKernelsIsa inIsa);
+
+/// Get the min and max of an array.
+///
+/// The min and max of an empty array are the largest and lowest
+/// values of the type respectively.
+///
+/// \param  inValues    The values.
+/// \param  inNumValues The number of values.
+/// \param  outMin      The min value.
+/// \param  outMax      The max value.
+void getMinMaxF32(const float * inValues, const isize_t inNumValues, float & outMin, float & outMax);
+
+/// \copydoc getMinMaxF32
+void getMinMaxU16(const uint16_t * inValues, const isize_t inNumValues, uint16_t & outMin, uint16_t & outMax);
+
+/// \copydoc getMinMaxF32
+void getMinMaxU8(const uint8_t * inValues, const isize_t inNumValues, uint8_t & outMin, uint8_t & outMax);
+
+/// Add an array to another one.
+///
+/// \param  inValues    The values to add.
+/// \param  inNumValues The number of values.
+/// \param  inOutSums   The sums to add the values to.
+void addF32(const float * inValues, const isize_t inNumValues, float * inOutSums);
+
+/// Sum the values of an array that are not less than a threshold.
+///
+/// \param  inValues    The values.
+/// \param  inNumValues The number of values.
+/// \param  inThreshold The values less than this are not summed.
+/// \return             The sum.
+float sumThresholdedF32(const float * inValues, const isize_t inNumValues, const float inThreshold);
+
+/// Zero the values of an array that are less than a threshold and divide the others.
+///
+/// \param  inValues    The values.
+/// \param  inNumValues The number of values.
+/// \param  inThreshold The values less than this are zeroed.
+/// \param  inDivisor   The divisor of the other values.
+/// \param  outValues   The thresholded values, which can be the input values.
+void thresholdAndDivideF32(
+        const float * inValues,
+        const isize_t inNumValues,
+        const float inThreshold,
+        const float inDivisor,
+        float * outValues);
+
+/// Like thresholdAndDivideF32, but adds the thresholded values to sums.
+///
+/// \param  inValues    The values.
+/// \param  inNumValues The number of values.
+/// \param  inThreshold The values less than this are not added.
+/// \param  inDivisor   The divisor of the other values.
+/// \param  inOutSums   The sums to add the thresholded values to.
+void addThresholdedAndDividedF32(
+        const float * inValues,
+        const isize_t inNumValues,
+        const float inThreshold,
+        const float inDivisor,
+        float * inOutSums);
+
+/// Convert floats to bytes after subtracting an offset and multiplying by a factor.
+///
+/// The converted values are truncated and must be between 0 and 255.
+///
+/// \param  inValues    The values.
+/// \param  inNumValues The number of values.
+/// \param  inOffset    The offset to subtract from each value.
+/// \param  inFactor    The factor to multiply each offset value by.
+/// \param  outValues   The converted values.
+void convertF32toU8(
+        const float * inValues,
+        const isize_t inNumValues,
+        const float inOffset,
+        const float inFactor,
+        uint8_t * outValues);
+
+} // namespace isx
+
+#endif // ISX_IMAGE_KERNELS_H
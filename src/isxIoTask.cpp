@@ -2,6 +2,8 @@
 #include "isxAsync.h"
 #include "isxIoTask.h"
 #include "isxDispatchQueue.h"
+#include "isxMutex.h"
+#include "isxConditionVariable.h"
 
 namespace isx
 {
@@ -71,5 +73,30 @@ IoTask::setExceptionPtr(std::exception_ptr inExceptionPtr)
 {
     m_exception = inExceptionPtr;
 }
+
+void
+readOnIoQueue(const Task_t & inRead, const std::string & inOwner)
+{
+    Mutex mutex;
+    ConditionVariable cv;
+    mutex.lock(inOwner + "::readOnIoQueue");
+    auto readIoTask = std::make_shared<IoTask>(
+        inRead,
+        [&cv, &mutex, &inOwner](AsyncTaskStatus)
+        {
+            // will only be able to take lock when client reaches cv.wait
+            mutex.lock(inOwner + "::readOnIoQueue finished");
+            mutex.unlock();
+            cv.notifyOne();
+        });
+    readIoTask->schedule();
+    cv.wait(mutex);
+    mutex.unlock();
+
+    if (readIoTask->getTaskStatus() == AsyncTaskStatus::ERROR_EXCEPTION)
+    {
+        std::rethrow_exception(readIoTask->getExceptionPtr());
+    }
+}
     
 } // namespace isx
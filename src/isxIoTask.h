@@ -81,6 +81,15 @@ private:
 };
     
 typedef std::shared_ptr<IoTask> SpIoTask_t;
+
+/// Run a read on the IoQueue and wait for it to finish, so that it does not race
+/// with asynchronous reads of the same file.
+///
+/// \param  inRead      The read to run.
+/// \param  inOwner     The name of the caller, which identifies the lock that is held while waiting.
+/// \throw  Any exception thrown by the read.
+void
+readOnIoQueue(const Task_t & inRead, const std::string & inOwner);
     
 } // namespace isx
 
@@ -197,6 +197,108 @@ convertJsonToSpacingInfo(const json & j)
     return SpacingInfo(numPixels, pixelSize, topLeft);
 }
 
+json
+convertPixelStatisticsToJson(const PixelStatistics & inStats)
+{
+    json j;
+    j["min"] = inStats.m_min;
+    j["max"] = inStats.m_max;
+    j["mean"] = inStats.getMean();
+    j["numPixels"] = inStats.m_numPixels;
+    j["numNonFinitePixels"] = inStats.m_numNonFinitePixels;
+    j["histogramMin"] = inStats.m_histogramMin;
+    j["histogramMax"] = inStats.m_histogramMax;
+    j["histogram"] = inStats.m_histogram;
+    return j;
+}
+
+PixelStatistics
+convertJsonToPixelStatistics(const json & j)
+{
+    const std::vector<uint64_t> histogram = j.at("histogram");
+    PixelStatistics stats(j.at("histogramMin"), j.at("histogramMax"), histogram.size());
+    stats.m_histogram = histogram;
+    stats.m_min = j.at("min");
+    stats.m_max = j.at("max");
+    stats.m_numPixels = j.at("numPixels");
+    if (j.find("numNonFinitePixels") != j.end())
+    {
+        stats.m_numNonFinitePixels = j.at("numNonFinitePixels");
+    }
+    stats.m_sum = double(j.at("mean")) * double(stats.m_numPixels);
+    return stats;
+}
+
+json
+convertMoviePixelStatisticsToJson(const MoviePixelStatistics & inStats)
+{
+    const size_t numFrames = inStats.m_frames.size();
+    std::vector<float> mins(numFrames);
+    std::vector<float> maxs(numFrames);
+    std::vector<double> means(numFrames);
+    std::vector<isize_t> numNonFinites(numFrames);
+    bool hasNonFinite = false;
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        const PixelStatistics & fs = inStats.m_frames[f];
+        mins[f] = fs.m_min;
+        maxs[f] = fs.m_max;
+        means[f] = fs.getMean();
+        numNonFinites[f] = fs.m_numNonFinitePixels;
+        hasNonFinite = hasNonFinite || (fs.m_numNonFinitePixels > 0);
+    }
+
+    // Every frame has the same number of values, of which only the non-finite ones
+    // differ, and those are only written if there are any.
+    json frames;
+    frames["numPixels"] = (numFrames > 0)
+            ? (inStats.m_frames.front().m_numPixels + inStats.m_frames.front().m_numNonFinitePixels)
+            : isize_t(0);
+    frames["min"] = mins;
+    frames["max"] = maxs;
+    frames["mean"] = means;
+    if (hasNonFinite)
+    {
+        frames["numNonFinitePixels"] = numNonFinites;
+    }
+
+    json j;
+    j["overall"] = convertPixelStatisticsToJson(inStats.m_overall);
+    j["frames"] = frames;
+    return j;
+}
+
+std::vector<PixelStatistics>
+convertJsonToFramePixelStatistics(const json & j)
+{
+    const isize_t numPixels = j.at("numPixels");
+    const std::vector<float> mins = j.at("min");
+    const std::vector<float> maxs = j.at("max");
+    const std::vector<double> means = j.at("mean");
+    const size_t numFrames = mins.size();
+    std::vector<isize_t> numNonFinites(numFrames, 0);
+    if (j.find("numNonFinitePixels") != j.end())
+    {
+        numNonFinites = j.at("numNonFinitePixels").get<std::vector<isize_t>>();
+    }
+    if (maxs.size() != numFrames || means.size() != numFrames || numNonFinites.size() != numFrames)
+    {
+        ISX_THROW(ExceptionDataIO, "Inconsistent number of frames in pixel statistics.");
+    }
+
+    std::vector<PixelStatistics> frames(numFrames);
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        PixelStatistics & fs = frames[f];
+        fs.m_min = mins[f];
+        fs.m_max = maxs[f];
+        fs.m_numPixels = numPixels - numNonFinites[f];
+        fs.m_numNonFinitePixels = numNonFinites[f];
+        fs.m_sum = means[f] * double(fs.m_numPixels);
+    }
+    return frames;
+}
+
 json 
 convertHistoryToJson(const HistoricalDetails & inHistory)
 {
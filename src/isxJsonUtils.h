@@ -8,6 +8,7 @@
 #include "isxCellSet.h"
 #include "isxEvents.h"
 #include "isxVesselSet.h"
+#include "isxPixelStatistics.h"
 
 #include "json.hpp"
 
@@ -64,6 +65,13 @@ HistoricalDetails convertJsonToHistory(const json & j);
 json convertPropertiesToJson(const DataSet::Properties & inProperties);
 DataSet::Properties convertJsonToProperties(const json & j);
 
+json convertPixelStatisticsToJson(const PixelStatistics & inStats);
+PixelStatistics convertJsonToPixelStatistics(const json & j);
+
+/// Per-frame statistics are stored column-wise without histograms to keep the footer compact.
+json convertMoviePixelStatisticsToJson(const MoviePixelStatistics & inStats);
+std::vector<PixelStatistics> convertJsonToFramePixelStatistics(const json & j);
+
 json getProducerAsJson();
 
 /// Reads a JSON header from an input stream.
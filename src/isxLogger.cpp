@@ -3,15 +3,49 @@
 #include "isxPathUtils.h"
 
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
 #include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <QString>
 #include <QDir>
+#include <QDateTime>
 
 namespace isx {
 
 std::unique_ptr<Logger> Logger::s_instance;
 
+namespace
+{
+
+std::atomic<int> s_minLevel(int(LogLevel::DEBUG_LEVEL));
+
+std::terminate_handler s_previousTerminateHandler = nullptr;
+
+/// The maximum time to wait for the log to be flushed when terminating.
+const uint32_t s_terminateFlushTimeoutMs = 2000;
+
+/// The log is only flushed on a best effort basis, because this may run on the
+/// thread that writes the log file, or while another thread holds the lock of
+/// the log, in which case waiting for the flush would hang instead of aborting.
+void
+flushLogOnTerminate()
+{
+    Logger::tryFlush(s_terminateFlushTimeoutMs);
+    if (s_previousTerminateHandler != nullptr)
+    {
+        s_previousTerminateHandler();
+    }
+    std::abort();
+}
+
+} // namespace
+
 class Logger::Impl : public std::enable_shared_from_this<Logger::Impl>
 {
     typedef std::weak_ptr<Impl>     WpImpl_t;
@@ -19,6 +53,7 @@ class Logger::Impl : public std::enable_shared_from_this<Logger::Impl>
 
 public:
     Impl(const std::string & inLogFileName)
+        : m_slots(s_numSlots)
     {
         m_filename = inLogFileName;
         std::string path = getDirName(m_filename);
@@ -31,31 +66,213 @@ public:
         }
 
         std::remove(m_filename.c_str());
+
+        for (size_t i = 0; i < s_numSlots; ++i)
+        {
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /// Note, there are no checks on the file stream on purpose.
+        /// Even if we get a bad stream, we can't "log" it and I don't think we
+        /// we should throw an exception (which also tries to log).
+        /// By default, streams don't throw exceptions so in the worst case-scenario
+        /// it will fail silently.
+        m_file.open(m_filename, std::ios::out | std::ios::app);
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeCondition.notify_one();
+        m_thread.join();
+        m_file.close();
     }
 
     void log(const std::string & inText)
     {
-        /// Note, there are no checks here (i.e. good()) on purpose. 
-        /// Even if we get a bad stream, we can't "log" it and I don't think we 
-        /// we should throw an exception (which also tries to log). 
-        /// By default, streams don't throw exceptions so in the worst case-scenario 
-        /// it will fail silently.
-        std::ofstream file(m_filename, std::ios::out | std::ios::app);
-        file << inText;
-        file.flush();
-        file.close();
+        const int64_t msSinceEpoch = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+
+        // Wait for the writer thread to make space if the buffer is full,
+        // rather than dropping lines.
+        while (!tryPush(msSinceEpoch, inText))
+        {
+            m_wakeCondition.notify_one();
+            std::this_thread::yield();
+        }
+        m_numPushed.fetch_add(1, std::memory_order_release);
+
+        if (m_writerWaiting.load(std::memory_order_acquire))
+        {
+            m_wakeCondition.notify_one();
+        }
+    }
+
+    void flush()
+    {
+        const uint64_t numPushed = m_numPushed.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeCondition.notify_one();
+        m_flushedCondition.wait(lock, [this, numPushed]()
+        {
+            return m_numWritten >= numPushed || m_stop;
+        });
     }
-    
+
+    bool tryFlush(const std::chrono::milliseconds inTimeout)
+    {
+        if (std::this_thread::get_id() == m_thread.get_id())
+        {
+            return false;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + inTimeout;
+        const uint64_t numPushed = m_numPushed.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        while (!lock.try_lock())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_wakeCondition.notify_one();
+        return m_flushedCondition.wait_until(lock, deadline, [this, numPushed]()
+        {
+            return m_numWritten >= numPushed || m_stop;
+        });
+    }
+
     const std::string &
     getLogFileName() const
     {
         return m_filename;
     }
-    
-private: 
+
+private:
+
+    /// A slot of the ring buffer.
+    ///
+    /// The sequence number tells producers and the consumer whose turn it
+    /// is to use the slot, so that no lock is needed to push or pop.
+    struct Slot
+    {
+        std::atomic<uint64_t>           m_sequence;
+        int64_t                         m_msSinceEpoch = 0;
+        std::string                     m_text;
+    };
+
+    /// The number of slots in the ring buffer, which must be a power of two.
+    static const size_t s_numSlots = 1 << 12;
+
+    bool tryPush(const int64_t inMsSinceEpoch, const std::string & inText)
+    {
+        uint64_t pos = m_pushPos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot & slot = m_slots[pos & (s_numSlots - 1)];
+            const uint64_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+            if (sequence == pos)
+            {
+                if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.m_msSinceEpoch = inMsSinceEpoch;
+                    slot.m_text = inText;
+                    slot.m_sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (sequence < pos)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_pushPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Only called by the writer thread, so there is a single consumer.
+    bool tryPop(int64_t & outMsSinceEpoch, std::string & outText)
+    {
+        Slot & slot = m_slots[m_popPos & (s_numSlots - 1)];
+        if (slot.m_sequence.load(std::memory_order_acquire) != m_popPos + 1)
+        {
+            return false;
+        }
+        outMsSinceEpoch = slot.m_msSinceEpoch;
+        outText.swap(slot.m_text);
+        slot.m_text.clear();
+        slot.m_sequence.store(m_popPos + s_numSlots, std::memory_order_release);
+        ++m_popPos;
+        return true;
+    }
+
+    /// Formats a timestamp in the same way as Time::now().toString().
+    static std::string formatTime(const int64_t inMsSinceEpoch)
+    {
+        const int32_t utcOffset = QDateTime::fromMSecsSinceEpoch(inMsSinceEpoch).offsetFromUtc();
+        const int64_t localMs = inMsSinceEpoch + int64_t(utcOffset) * 1000;
+        return Time(DurationInSeconds::fromMilliseconds(uint64_t(localMs)), utcOffset).toString();
+    }
+
+    void run()
+    {
+        int64_t msSinceEpoch = 0;
+        std::string text;
+        while (true)
+        {
+            uint64_t numWritten = 0;
+            while (tryPop(msSinceEpoch, text))
+            {
+                m_file << formatTime(msSinceEpoch) << ": " << text;
+                ++numWritten;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (numWritten > 0)
+            {
+                m_file.flush();
+                m_numWritten += numWritten;
+                m_flushedCondition.notify_all();
+                continue;
+            }
+            if (m_stop)
+            {
+                m_flushedCondition.notify_all();
+                return;
+            }
+
+            // A producer may push between the last pop and setting this flag,
+            // so the wait has a timeout instead of relying only on notifications.
+            m_writerWaiting.store(true, std::memory_order_release);
+            m_wakeCondition.wait_for(lock, std::chrono::milliseconds(20));
+            m_writerWaiting.store(false, std::memory_order_release);
+        }
+    }
 
     std::string                         m_filename;
+    std::ofstream                       m_file;
+
+    std::vector<Slot>                   m_slots;
+    std::atomic<uint64_t>               m_pushPos{0};
+    uint64_t                            m_popPos = 0;
+    std::atomic<uint64_t>               m_numPushed{0};
+    std::atomic<bool>                   m_writerWaiting{false};
 
+    std::mutex                          m_mutex;
+    std::condition_variable             m_wakeCondition;
+    std::condition_variable             m_flushedCondition;
+    uint64_t                            m_numWritten = 0;
+    bool                                m_stop = false;
+
+    std::thread                         m_thread;
 };
 
 Logger::Logger(const std::string & inLogFileName)
@@ -78,10 +295,11 @@ Logger::initialize(const std::string & inLogFileName)
     if (!isInitialized())
     {
         s_instance.reset(new Logger(inLogFileName));
+        s_previousTerminateHandler = std::set_terminate(flushLogOnTerminate);
     }
 }
 
-bool 
+bool
 Logger::isInitialized()
 {
     return (s_instance != nullptr);
@@ -102,12 +320,45 @@ Logger::log(const std::string & text)
 {
     if (isInitialized())
     {
-        Time now = Time::now();
-        const std::string strNow = now.toString();
-        const std::string total = strNow + ": " + text;
+        instance()->m_pImpl->log(text);
+    }
+}
 
-        instance()->m_pImpl->log(total);
+void
+Logger::flush()
+{
+    if (isInitialized())
+    {
+        instance()->m_pImpl->flush();
+    }
+}
+
+bool
+Logger::tryFlush(const uint32_t inTimeoutMs)
+{
+    if (isInitialized())
+    {
+        return instance()->m_pImpl->tryFlush(std::chrono::milliseconds(inTimeoutMs));
     }
+    return true;
+}
+
+void
+Logger::setMinLevel(const LogLevel inLevel)
+{
+    s_minLevel.store(int(inLevel), std::memory_order_relaxed);
+}
+
+LogLevel
+Logger::getMinLevel()
+{
+    return LogLevel(s_minLevel.load(std::memory_order_relaxed));
+}
+
+bool
+Logger::isLevelEnabled(const LogLevel inLevel)
+{
+    return int(inLevel) >= s_minLevel.load(std::memory_order_relaxed);
 }
 
 const std::string &
@@ -117,9 +368,9 @@ Logger::getLogFileName()
     {
         return instance()->m_pImpl->getLogFileName();
     }
-    
+
     static std::string emptyString;
     return emptyString;
 }
-    
-}
\ No newline at end of file
+
+}
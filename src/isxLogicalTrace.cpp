@@ -19,11 +19,68 @@ addXCoordinate(std::vector<double> & inCoords, const double inX)
     inCoords.push_back(toMicrosecondPrecision(inX));
 }
 
+/// Convert a duration to the nearest whole number of microseconds with exact arithmetic.
+int64_t
+toNearestMicroseconds(const isx::DurationInSeconds & inDuration)
+{
+    const isx::Ratio::intBig_t num = inDuration.getNum() * 2000000;
+    const isx::Ratio::intBig_t den = inDuration.getDen() * 2;
+    if (num >= 0)
+    {
+        return static_cast<int64_t>((num + inDuration.getDen()) / den);
+    }
+    return -static_cast<int64_t>((inDuration.getDen() - num) / den);
+}
+
 } // namespace
 
 namespace isx
 {
 
+void
+appendToLogicalTraceTable(
+        const SpLogicalTrace_t & inTrace,
+        const Time & inStartTime,
+        const int64_t inStartMicroSecs,
+        const int64_t inEndMicroSecs,
+        LogicalTraceTable & outTable)
+{
+    if (inTrace)
+    {
+        for (const auto & value : inTrace->getValues())
+        {
+            const int64_t offset = toNearestMicroseconds(value.first - inStartTime);
+            if (offset >= inStartMicroSecs && offset < inEndMicroSecs)
+            {
+                outTable.m_offsetsMicroSecs.push_back(offset);
+                outTable.m_values.push_back(value.second);
+            }
+        }
+    }
+    outTable.m_traceStarts.push_back(outTable.m_values.size());
+}
+
+SpLogicalTrace_t
+getLogicalTraceInRange(const SpLogicalTrace_t & inTrace, const Time & inStartTime, const Time & inEndTime)
+{
+    if (!inTrace)
+    {
+        return inTrace;
+    }
+
+    auto trace = std::make_shared<LogicalTrace>(inTrace->getTimingInfo(), inTrace->getName());
+    if (inStartTime < inEndTime)
+    {
+        const auto & values = inTrace->getValues();
+        const auto end = values.lower_bound(inEndTime);
+        for (auto it = values.lower_bound(inStartTime); it != end; ++it)
+        {
+            trace->addValue(it->first, it->second);
+        }
+    }
+    return trace;
+}
+
 void
 getCoordinatesFromLogicalTrace(
         const SpLogicalTrace_t & inTrace,
@@ -0,0 +1,47 @@
+#include "isxMetadataProbe.h"
+#include "isxMosaicMovieFile.h"
+#include "isxCellSetFile.h"
+#include "isxVesselSetFile.h"
+#include "isxNVisionMovieFile.h"
+#include "isxPathUtils.h"
+
+#include <algorithm>
+
+namespace isx
+{
+
+bool
+probeMetadata(const std::string & inFileName, const DataSet::Type inType, ProbedMetadata & outMetadata)
+{
+    std::string extension = getExtension(inFileName);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    switch (inType)
+    {
+    case DataSet::Type::MOVIE:
+    case DataSet::Type::IMAGE:
+        if (extension == "isxd")
+        {
+            return MosaicMovieFile::probeMetadata(inFileName, outMetadata);
+        }
+        else if (extension == "isxb")
+        {
+            return NVisionMovieFile::probeMetadata(inFileName, outMetadata);
+        }
+        // nVista TIFF and HDF5 movies depend on the data set properties,
+        // so they are read by a full reader.
+        return false;
+    case DataSet::Type::CELLSET:
+        return CellSetFile::probeMetadata(inFileName, outMetadata);
+    case DataSet::Type::VESSELSET:
+        return VesselSetFile::probeMetadata(inFileName, outMetadata);
+    case DataSet::Type::NVISION_MOVIE:
+        return NVisionMovieFile::probeMetadata(inFileName, outMetadata);
+    default:
+        // Behavioral movies, GPIO, IMU and events do not store all their
+        // meta data in a header, so they are read by a full reader.
+        return false;
+    }
+}
+
+} // namespace isx
@@ -0,0 +1,42 @@
+#ifndef ISX_METADATA_PROBE_H
+#define ISX_METADATA_PROBE_H
+
+#include "isxCore.h"
+#include "isxDataSet.h"
+#include "isxTimingInfo.h"
+#include "isxSpacingInfo.h"
+
+#include <string>
+
+namespace isx
+{
+
+/// The meta data of a data set file that is displayed and cached by a project.
+struct ProbedMetadata
+{
+    TimingInfo m_timingInfo;                    ///< The timing info of the data.
+    SpacingInfo m_spacingInfo;                  ///< The spacing info of the data.
+    DataType m_dataType = DataType::U16;        ///< The data type of the pixel or trace values.
+    std::string m_extraProperties;              ///< The extra properties formatted as a JSON string.
+};
+
+/// Read the meta data of a data set file without creating a reader for it.
+///
+/// This only reads the header or footer of the file, so it does not
+/// start any IO tasks and does not read any frame or trace data.
+/// Not all formats can be probed like this, in which case this returns
+/// false and the caller should read the meta data from a full reader instead.
+///
+/// \param  inFileName  The name of the data set file.
+/// \param  inType      The type of the data set.
+/// \param  outMetadata The meta data read from the file.
+/// \return             True if the meta data was read, false if the format
+///                     cannot be probed.
+///
+/// \throw  isx::ExceptionFileIO    If reading the file fails.
+/// \throw  isx::ExceptionDataIO    If parsing the file header fails.
+bool probeMetadata(const std::string & inFileName, const DataSet::Type inType, ProbedMetadata & outMetadata);
+
+} // namespace isx
+
+#endif // ISX_METADATA_PROBE_H
@@ -111,6 +111,40 @@ MosaicEvents::getLogicalDataAsync(const std::string & inCellName, EventsGetLogic
     m_logicalIoTaskTracker->schedule(getLogicalCB, inCallback);
 }
 
+LogicalTraceTable
+MosaicEvents::getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs)
+{
+    if (m_type != FileType::V2)
+    {
+        return Events::getAllLogicalData(inStartMicroSecs, inEndMicroSecs);
+    }
+
+    auto file = std::static_pointer_cast<isx::EventBasedFileV2>(m_file);
+    LogicalTraceTable table;
+    readOnIoQueue([file, inStartMicroSecs, inEndMicroSecs, &table]()
+    {
+        table = file->readLogicalTraceTable(inStartMicroSecs, inEndMicroSecs);
+    }, "MosaicEvents");
+    return table;
+}
+
+SpLogicalTrace_t
+MosaicEvents::getLogicalDataInRange(const std::string & inCellName, const Time & inStartTime, const Time & inEndTime)
+{
+    if (m_type != FileType::V2)
+    {
+        return Events::getLogicalDataInRange(inCellName, inStartTime, inEndTime);
+    }
+
+    auto file = std::static_pointer_cast<isx::EventBasedFileV2>(m_file);
+    SpLogicalTrace_t trace;
+    readOnIoQueue([file, &inCellName, &inStartTime, &inEndTime, &trace]()
+    {
+        trace = file->getLogicalDataInRange(inCellName, inStartTime, inEndTime);
+    }, "MosaicEvents");
+    return trace;
+}
+
 isx::TimingInfo
 MosaicEvents::getTimingInfo() const
 {
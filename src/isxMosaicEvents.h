@@ -60,6 +60,12 @@ public:
     void
     getLogicalDataAsync(const std::string & inCellName, EventsGetLogicalDataCB_t inCallback) override;
 
+    LogicalTraceTable
+    getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs) override;
+
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inCellName, const Time & inStartTime, const Time & inEndTime) override;
+
     isx::TimingInfo
     getTimingInfo() const override;
 
@@ -193,6 +193,40 @@ MosaicGpio::getLogicalDataAsync(const std::string & inChannelName, GpioGetLogica
     m_logicalIoTaskTracker->schedule(getLogicalCB, inCallback);
 }
 
+LogicalTraceTable
+MosaicGpio::getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs)
+{
+    if (m_type != FileType::V2)
+    {
+        return Gpio::getAllLogicalData(inStartMicroSecs, inEndMicroSecs);
+    }
+
+    auto file = std::static_pointer_cast<isx::EventBasedFileV2>(m_file);
+    LogicalTraceTable table;
+    readOnIoQueue([file, inStartMicroSecs, inEndMicroSecs, &table]()
+    {
+        table = file->readLogicalTraceTable(inStartMicroSecs, inEndMicroSecs);
+    }, "MosaicGpio");
+    return table;
+}
+
+SpLogicalTrace_t
+MosaicGpio::getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime)
+{
+    if (m_type != FileType::V2)
+    {
+        return Gpio::getLogicalDataInRange(inChannelName, inStartTime, inEndTime);
+    }
+
+    auto file = std::static_pointer_cast<isx::EventBasedFileV2>(m_file);
+    SpLogicalTrace_t trace;
+    readOnIoQueue([file, &inChannelName, &inStartTime, &inEndTime, &trace]()
+    {
+        trace = file->getLogicalDataInRange(inChannelName, inStartTime, inEndTime);
+    }, "MosaicGpio");
+    return trace;
+}
+
 isx::TimingInfo 
 MosaicGpio::getTimingInfo(const std::string & inChannelName) const
 {
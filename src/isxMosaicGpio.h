@@ -64,6 +64,12 @@ public:
     void
     getLogicalDataAsync(const std::string & inChannelName, GpioGetLogicalDataCB_t inCallback) override;
 
+    LogicalTraceTable
+    getAllLogicalData(const int64_t inStartMicroSecs, const int64_t inEndMicroSecs) override;
+
+    SpLogicalTrace_t
+    getLogicalDataInRange(const std::string & inChannelName, const Time & inStartTime, const Time & inEndTime) override;
+
     isx::TimingInfo 
     getTimingInfo(const std::string & inChannelName) const override;
 
@@ -7,6 +7,7 @@
 #include "isxIoQueue.h"
 #include "isxConditionVariable.h"
 #include "isxIoTaskTracker.h"
+#include "isxIoTask.h"
 
 #include <fstream>
 
@@ -98,19 +99,70 @@ MosaicMovie::getFrameAsync(isize_t inFrameNumber, MovieGetFrameCB_t inCallback)
 std::vector<uint16_t>
 MosaicMovie::getFrameHeader(const size_t inFrameNumber)
 {
+#if ISX_ASYNC_API
+    std::shared_ptr<MosaicMovieFile> file = m_file;
+    std::vector<uint16_t> out;
+    readOnIoQueue([file, inFrameNumber, &out]()
+    {
+        out = file->readFrameHeader(inFrameNumber);
+    }, "MosaicMovie::getFrameHeader");
+    return out;
+#else
     return m_file->readFrameHeader(inFrameNumber);
+#endif
 }
 
 std::string
 MosaicMovie::getFrameMetadata(const size_t inFrameNumber)
 {
+#if ISX_ASYNC_API
+    std::shared_ptr<MosaicMovieFile> file = m_file;
+    std::string out;
+    readOnIoQueue([file, inFrameNumber, &out]()
+    {
+        out = file->readFrameMetadata(inFrameNumber);
+    }, "MosaicMovie::getFrameMetadata");
+    return out;
+#else
     return m_file->readFrameMetadata(inFrameNumber);
+#endif
 }
 
 std::vector<uint16_t>
 MosaicMovie::getFrameFooter(const size_t inFrameNumber)
 {
+#if ISX_ASYNC_API
+    std::shared_ptr<MosaicMovieFile> file = m_file;
+    std::vector<uint16_t> out;
+    readOnIoQueue([file, inFrameNumber, &out]()
+    {
+        out = file->readFrameFooter(inFrameNumber);
+    }, "MosaicMovie::getFrameFooter");
+    return out;
+#else
     return m_file->readFrameFooter(inFrameNumber);
+#endif
+}
+
+void
+MosaicMovie::getRawFrame(const size_t inFrameNumber, char * outBuffer)
+{
+#if ISX_ASYNC_API
+    // Get a new shared pointer to the file, so we can guarantee the read.
+    std::shared_ptr<MosaicMovieFile> file = m_file;
+    readOnIoQueue([file, inFrameNumber, outBuffer]()
+    {
+        file->readRawFrame(inFrameNumber, outBuffer);
+    }, "MosaicMovie::getRawFrame");
+#else
+    m_file->readRawFrame(inFrameNumber, outBuffer);
+#endif
+}
+
+isize_t
+MosaicMovie::getRawFrameSizeInBytes() const
+{
+    return m_file->getRawFrameSizeInBytes();
 }
 
 void
@@ -279,6 +331,58 @@ MosaicMovie::getFrameTimestamp(const isize_t inIndex)
     return m_file->readFrameTimestamp(inIndex);
 }
 
+std::vector<uint64_t>
+MosaicMovie::getFrameTimestamps(const isize_t inFirstIndex, const isize_t inNumFrames)
+{
+#if ISX_ASYNC_API
+    std::shared_ptr<MosaicMovieFile> file = m_file;
+    std::vector<uint64_t> timestamps;
+    readOnIoQueue([file, inFirstIndex, inNumFrames, &timestamps]()
+    {
+        timestamps = file->readFrameTimestamps(inFirstIndex, inNumFrames);
+    }, "MosaicMovie::getFrameTimestamps");
+    return timestamps;
+#else
+    return m_file->readFrameTimestamps(inFirstIndex, inNumFrames);
+#endif
+}
+
+std::vector<uint64_t>
+MosaicMovie::getAllFrameTimestamps()
+{
+    return m_file->getAllFrameTimestamps();
+}
+
+void
+MosaicMovie::enablePixelStatistics(const isize_t inNumHistogramBins)
+{
+    m_file->enablePixelStatistics(inNumHistogramBins);
+}
+
+void
+MosaicMovie::enableFooterFrameTimestamps()
+{
+    m_file->enableFooterFrameTimestamps();
+}
+
+bool
+MosaicMovie::hasPixelStatistics() const
+{
+    return m_file->hasPixelStatistics();
+}
+
+PixelStatistics
+MosaicMovie::getPixelStatistics() const
+{
+    return m_file->getPixelStatistics();
+}
+
+PixelStatistics
+MosaicMovie::getFramePixelStatistics(const isize_t inFrameNumber) const
+{
+    return m_file->getFramePixelStatistics(inFrameNumber);
+}
+
 void
 MosaicMovie::closeFileStream()
 {
@@ -69,6 +69,10 @@ public:
 
     std::vector<uint16_t> getFrameFooter(const size_t inFrameNumber) override;
 
+    void getRawFrame(const size_t inFrameNumber, char * outBuffer) override;
+
+    isize_t getRawFrameSizeInBytes() const override;
+
     void cancelPendingReads() override;
 
     void writeFrame(const SpVideoFrame_t & inVideoFrame) override;
@@ -105,6 +109,20 @@ public:
 
     uint64_t getFrameTimestamp(const isize_t inIndex) override;
 
+    std::vector<uint64_t> getFrameTimestamps(const isize_t inFirstIndex, const isize_t inNumFrames) override;
+
+    std::vector<uint64_t> getAllFrameTimestamps() override;
+
+    void enablePixelStatistics(const isize_t inNumHistogramBins = PixelStatistics::s_defaultNumBins) override;
+
+    void enableFooterFrameTimestamps() override;
+
+    bool hasPixelStatistics() const override;
+
+    PixelStatistics getPixelStatistics() const override;
+
+    PixelStatistics getFramePixelStatistics(const isize_t inFrameNumber) const override;
+
     void closeFileStream() override;
 
 private:
@@ -1,10 +1,12 @@
 #include "isxMosaicMovieFile.h"
+#include "isxMetadataProbe.h"
 #include "isxException.h"
 #include "isxStopWatch.h"
 #include "isxCore.h"
 
 #include <sys/stat.h>
 
+#include <array>
 #include <cstring>
 
 #define ISX_DEBUG_FRAME_TIME 0
@@ -17,6 +19,36 @@
 namespace isx
 {
 
+namespace
+{
+
+/// Stitch together the 64-bit TSC from the 8 header pixels it is spread across.
+///
+/// \param  inTscPixels     The header pixels containing the TSC.
+/// \return                 The TSC.
+uint64_t
+decodeTsc(const uint16_t * inTscPixels)
+{
+    // We convert them to 4 roomy 64-bit components so that they can shifted and stitched
+    // together into the final 64-bit TSC.
+    std::array<uint64_t, 4> tscComps;
+
+    // Deal with the 16bit->12bit->16bit encoding from register->sensor->file.
+    for (size_t j = 0; j < tscComps.size(); ++j)
+    {
+        ISX_LOG_DEBUG_FRAME_TIME("Read TSC pixels ", 2*j, ", ", 2*j + 1, ": ", inTscPixels[2*j], ", ", inTscPixels[2*j + 1]);
+        tscComps[j] = uint64_t((inTscPixels[2*j + 1] << 4) | (inTscPixels[2*j] >> 4));
+        ISX_LOG_DEBUG_FRAME_TIME("Recovered TSC comp ", j, ": ", tscComps[j]);
+    }
+
+    // Shift and stitch the 16-bit components of the 64-bit timestamp together.
+    const uint64_t tsc = (tscComps[3] << 48) | (tscComps[2] << 32) | (tscComps[1] << 16) | tscComps[0];
+    ISX_LOG_DEBUG_FRAME_TIME("Recovered TSC ", tsc);
+    return tsc;
+}
+
+} // namespace
+
 MosaicMovieFile::MosaicMovieFile()
     : m_valid(false)
 {
@@ -49,6 +81,7 @@ MosaicMovieFile::~MosaicMovieFile()
             closeForWriting();
         }
 
+        m_fileHandle.unmanage();
         isx::closeFileStreamWithChecks(m_file, m_fileName);
     }
 }
@@ -119,6 +152,11 @@ MosaicMovieFile::initialize(const std::string & inFileName, bool enableWrite)
             }
         }
     }
+
+    if (!enableWrite)
+    {
+        m_fileHandle.manageStream(m_file, m_fileName, m_openmode);
+    }
 }
 
 void
@@ -183,6 +221,7 @@ void
 MosaicMovieFile::setTimingInfo(const TimingInfo & inTimingInfo)
 {
     m_timingInfos = {inTimingInfo};
+    m_frameTimestamps.clear();
 }
 
 bool
@@ -218,6 +257,7 @@ MosaicMovieFile::readFrame(isize_t inFrameNumber)
     }
 
     // The frame was not dropped, shift frame numbers and proceed to read
+    PooledFileHandle::Lease lease(m_fileHandle);
     seekForReadFrame(ti.timeIdxToRecordedIdx(inFrameNumber), true, false);
 
     m_file.read(outFrame->getPixels(), outFrame->getImageSizeInBytes());
@@ -230,6 +270,7 @@ MosaicMovieFile::readFrame(isize_t inFrameNumber)
 std::vector<uint16_t>
 MosaicMovieFile::readFrameHeader(const isize_t inFrameNumber)
 {
+    PooledFileHandle::Lease lease(m_fileHandle);
     std::vector<uint16_t> header;
     const TimingInfo & ti = getTimingInfo();
     if (ti.isIndexValid(inFrameNumber))
@@ -299,6 +340,7 @@ MosaicMovieFile::readFrameMetadata(const isize_t inFrameNumber)
 std::vector<uint16_t>
 MosaicMovieFile::readFrameFooter(const isize_t inFrameNumber)
 {
+    PooledFileHandle::Lease lease(m_fileHandle);
     std::vector<uint16_t> footer;
     const TimingInfo & ti = getTimingInfo();
     if (ti.isIndexValid(inFrameNumber))
@@ -311,6 +353,29 @@ MosaicMovieFile::readFrameFooter(const isize_t inFrameNumber)
     return footer;
 }
 
+void
+MosaicMovieFile::readRawFrame(const isize_t inFrameNumber, char * outBuffer)
+{
+    const TimingInfo & ti = getTimingInfo();
+    const isize_t rawFrameSizeInBytes = getFrameStrideInBytes();
+    if (!ti.isIndexValid(inFrameNumber))
+    {
+        std::memset(outBuffer, 0, rawFrameSizeInBytes);
+        return;
+    }
+
+    PooledFileHandle::Lease lease(m_fileHandle);
+    seekForReadFrame(ti.timeIdxToRecordedIdx(inFrameNumber), false, false);
+    m_file.read(outBuffer, rawFrameSizeInBytes);
+    checkFileGood("Error reading raw movie frame");
+}
+
+isize_t
+MosaicMovieFile::getRawFrameSizeInBytes() const
+{
+    return getFrameStrideInBytes();
+}
+
 void
 MosaicMovieFile::writeFrame(const SpVideoFrame_t & inVideoFrame)
 {
@@ -319,6 +384,7 @@ MosaicMovieFile::writeFrame(const SpVideoFrame_t & inVideoFrame)
 
     m_file.write(inVideoFrame->getPixels(), getFrameSizeInBytes());
     m_headerOffset = m_file.tellp();
+    accumulatePixelStatistics(inVideoFrame->getPixels());
 
     checkFileGood("Error writing movie frame");
     flush();
@@ -334,6 +400,8 @@ MosaicMovieFile::writeFrameWithHeaderFooter(const uint16_t * inHeader, const uin
     m_file.write(reinterpret_cast<const char *>(inPixels), getFrameSizeInBytes());
     m_file.write(reinterpret_cast<const char *>(inFooter), s_headerFooterSizeInBytes);
     m_headerOffset = m_file.tellp();
+    accumulatePixelStatistics(reinterpret_cast<const char *>(inPixels));
+    captureFrameTimestamp(inHeader);
 
     checkFileGood("Error writing movie frame");
     flush();
@@ -347,6 +415,8 @@ MosaicMovieFile::writeFrameWithHeaderFooter(const uint16_t * inBuffer)
 
     m_file.write(reinterpret_cast<const char *>(inBuffer), (2 * s_headerFooterSizeInBytes) + getFrameSizeInBytes());
     m_headerOffset = m_file.tellp();
+    accumulatePixelStatistics(reinterpret_cast<const char *>(inBuffer + s_numHeaderFooterValues));
+    captureFrameTimestamp(inBuffer);
 
     checkFileGood("Error writing movie frame. " + m_fileName);
     flush();
@@ -452,6 +522,33 @@ MosaicMovieFile::readHeader()
         {
             m_extraProperties = j["extraProperties"];
         }
+        if (j.find("pixelStatistics") != j.end())
+        {
+            // Older writers wrote NaN and infinite statistics of float movies as null.
+            // Statistics that cannot be read are treated as if there were none,
+            // so that they never prevent the movie from being opened.
+            // The statistics of the frames are only converted when first requested.
+            try
+            {
+                json & pixelStatistics = j["pixelStatistics"];
+                m_pixelStatistics.reset(new MoviePixelStatistics());
+                m_pixelStatistics->m_overall = convertJsonToPixelStatistics(pixelStatistics.at("overall"));
+                m_framePixelStatisticsJson.reset(new json(std::move(pixelStatistics.at("frames"))));
+            }
+            catch (const std::exception & error)
+            {
+                ISX_LOG_WARNING("Ignoring invalid pixel statistics of movie ", m_fileName, ": ", error.what());
+                m_pixelStatistics.reset();
+            }
+        }
+        if (m_hasFrameHeaderFooter && j.find("frameTimestamps") != j.end())
+        {
+            m_recordedFrameTimestamps = j["frameTimestamps"].get<std::vector<uint64_t>>();
+            if (std::streamoff(m_recordedFrameTimestamps.size() * getFrameStrideInBytes()) != std::streamoff(m_headerOffset))
+            {
+                m_recordedFrameTimestamps.clear();
+            }
+        }
     }
     catch (const std::exception & error)
     {
@@ -463,6 +560,55 @@ MosaicMovieFile::readHeader()
     }
 }
 
+bool
+MosaicMovieFile::probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata)
+{
+    std::ifstream file(inFileName, std::ios::binary);
+    if (!file.good() || !file.is_open())
+    {
+        ISX_THROW(isx::ExceptionFileIO,
+            "Failed to open movie file for reading (", inFileName, ")", " with error: ", getSystemErrorString());
+    }
+    std::ios::pos_type headerOffset;
+    json j = readJsonHeaderAtEnd(file, headerOffset);
+
+    try
+    {
+        DataSet::Type type = DataSet::Type(size_t(j["type"]));
+        if (!(type == DataSet::Type::MOVIE || type == DataSet::Type::IMAGE))
+        {
+            ISX_THROW(ExceptionDataIO, "Expected type to be Movie or Image. Instead got ", size_t(type), ".");
+        }
+        size_t version = 0;
+        if (j.find("fileVersion") != j.end())
+        {
+            version = size_t(j["fileVersion"]);
+        }
+        if (version > 0 && bool(j["hasFrameHeaderFooter"]))
+        {
+            return false;
+        }
+        outMetadata.m_dataType = DataType(isize_t(j["dataType"]));
+        outMetadata.m_timingInfo = convertJsonToTimingInfo(j["timingInfo"]);
+        outMetadata.m_spacingInfo = convertJsonToSpacingInfo(j["spacingInfo"]);
+        json extraProperties = nullptr;
+        if (j.find("extraProperties") != j.end())
+        {
+            extraProperties = j["extraProperties"];
+        }
+        outMetadata.m_extraProperties = extraProperties.dump();
+    }
+    catch (const std::exception & error)
+    {
+        ISX_THROW(isx::ExceptionDataIO, "Error parsing movie header: ", error.what());
+    }
+    catch (...)
+    {
+        ISX_THROW(isx::ExceptionDataIO, "Unknown error while parsing movie header.");
+    }
+    return true;
+}
+
 void
 MosaicMovieFile::writeHeader()
 {
@@ -485,6 +631,16 @@ MosaicMovieFile::writeHeader()
         j["fileVersion"] = s_version;
         j["hasFrameHeaderFooter"] = m_hasFrameHeaderFooter;
         j["extraProperties"] = m_extraProperties;
+        if (m_pixelStatistics)
+        {
+            j["pixelStatistics"] = convertMoviePixelStatisticsToJson(*m_pixelStatistics);
+        }
+        // Only store the timestamps if they were captured for every frame in the file.
+        if (m_storeFrameTimestamps && m_hasFrameHeaderFooter && !m_recordedFrameTimestamps.empty()
+            && std::streamoff(m_recordedFrameTimestamps.size() * getFrameStrideInBytes()) == std::streamoff(m_headerOffset))
+        {
+            j["frameTimestamps"] = m_recordedFrameTimestamps;
+        }
     }
     catch (const std::exception & error)
     {
@@ -543,13 +699,7 @@ MosaicMovieFile::seekForReadFrame(isize_t inFrameNumber, const bool inSkipHeader
     }
 
     const size_t frameSizeInBytes = getFrameSizeInBytes();
-    size_t frameHeaderFooterSizeInBytes = frameSizeInBytes;
-    if (m_hasFrameHeaderFooter)
-    {
-        frameHeaderFooterSizeInBytes += 2 * s_headerFooterSizeInBytes;
-    }
-
-    std::ios::pos_type offsetInBytes = inFrameNumber * frameHeaderFooterSizeInBytes;
+    std::ios::pos_type offsetInBytes = inFrameNumber * getFrameStrideInBytes();
 
     if (inSkipHeader && m_hasFrameHeaderFooter)
     {
@@ -577,6 +727,26 @@ MosaicMovieFile::flush()
     checkFileGood("Error flushing the file stream");
 }
 
+isize_t
+MosaicMovieFile::getFrameStrideInBytes() const
+{
+    isize_t frameStrideInBytes = getFrameSizeInBytes();
+    if (m_hasFrameHeaderFooter)
+    {
+        frameStrideInBytes += 2 * s_headerFooterSizeInBytes;
+    }
+    return frameStrideInBytes;
+}
+
+void
+MosaicMovieFile::captureFrameTimestamp(const uint16_t * inHeader)
+{
+    if (m_storeFrameTimestamps)
+    {
+        m_recordedFrameTimestamps.push_back(decodeTsc(inHeader + FRAME_META_TSC));
+    }
+}
+
 void
 MosaicMovieFile::checkFileNotClosedForWriting() const
 {
@@ -612,6 +782,7 @@ MosaicMovieFile::closeFileStream()
     {
         m_fileClosedForWriting = true;
 
+        m_fileHandle.unmanage();
         isx::closeFileStreamWithChecks(m_file, m_fileName);
 
         m_valid = false;
@@ -625,6 +796,22 @@ MosaicMovieFile::readFrameTimestamp(const isize_t inIndex)
 
     if (hasFrameTimestamps() && ti.isIndexValid(inIndex))
     {
+        if (inIndex < m_frameTimestamps.size())
+        {
+            return m_frameTimestamps[inIndex];
+        }
+
+        if (!m_recordedFrameTimestamps.empty())
+        {
+            const isize_t recordedIndex = ti.timeIdxToRecordedIdx(inIndex);
+            if (recordedIndex < m_recordedFrameTimestamps.size())
+            {
+                return m_recordedFrameTimestamps[recordedIndex];
+            }
+        }
+
+        PooledFileHandle::Lease lease(m_fileHandle);
+
         // The first pixel of the header should evaluate to 0x0A0 according
         // to the sensor spec, so check that in debug mode for sanity.
 #ifndef NDEBUG
@@ -639,13 +826,9 @@ MosaicMovieFile::readFrameTimestamp(const isize_t inIndex)
 
         // The TSC bytes are spread across the last 8 pixels of the first line.
         // See sensor spec for more details.
-        constexpr size_t tscOffset = 1272 * sizeof(uint16_t);
+        constexpr size_t tscOffset = FRAME_META_TSC * sizeof(uint16_t);
         std::array<uint16_t, 8> tscPixels;
 
-        // We convert them to 4 roomy 64-bit components so that they can shifted and stitched
-        // together into the final 64-bit TSC.
-        std::array<uint64_t, 4> tscComps;
-
         seekForReadFrame(ti.timeIdxToRecordedIdx(inIndex), false, false);
         m_file.seekg(tscOffset, m_file.cur);
         ISX_LOG_DEBUG_FRAME_TIME("Reading TSC bytes from file location ", m_file.tellg());
@@ -654,22 +837,181 @@ MosaicMovieFile::readFrameTimestamp(const isize_t inIndex)
         {
             ISX_THROW(ExceptionFileIO, "Error reading TSC ", inIndex);
         }
+        return decodeTsc(tscPixels.data());
+    }
+
+    return 0;
+}
 
-        // Deal with the 16bit->12bit->16bit encoding from register->sensor->file.
-        for (size_t j = 0; j < tscComps.size(); ++j)
+std::vector<uint64_t>
+MosaicMovieFile::readFrameTimestamps(const isize_t inFirstIndex, const isize_t inNumFrames)
+{
+    const TimingInfo & ti = getTimingInfo();
+    const isize_t numFrames = ti.getNumTimes();
+    if (inFirstIndex > numFrames || inNumFrames > numFrames - inFirstIndex)
+    {
+        ISX_THROW(ExceptionUserInput, "Frame timestamp range [", inFirstIndex, ", ", inFirstIndex + inNumFrames,
+                ") is out of bounds: ", m_fileName);
+    }
+
+    const isize_t endIndex = inFirstIndex + inNumFrames;
+    if (m_frameTimestamps.size() == numFrames)
+    {
+        return std::vector<uint64_t>(m_frameTimestamps.begin() + inFirstIndex, m_frameTimestamps.begin() + endIndex);
+    }
+
+    std::vector<uint64_t> timestamps(inNumFrames, 0);
+    if (hasFrameTimestamps())
+    {
+        bool fromFooter = !m_recordedFrameTimestamps.empty();
+        for (isize_t f = inFirstIndex; fromFooter && f < endIndex; ++f)
         {
-            ISX_LOG_DEBUG_FRAME_TIME("Read TSC pixels ", 2*j, ", ", 2*j + 1, ": ", tscPixels[2*j], ", ", tscPixels[2*j + 1]);
-            tscComps[j] = uint64_t((tscPixels[2*j + 1] << 4) | (tscPixels[2*j] >> 4));
-            ISX_LOG_DEBUG_FRAME_TIME("Recovered TSC comp ", j, ": ", tscComps[j]);
+            if (ti.isIndexValid(f))
+            {
+                const isize_t recordedIndex = ti.timeIdxToRecordedIdx(f);
+                fromFooter = recordedIndex < m_recordedFrameTimestamps.size();
+                if (fromFooter)
+                {
+                    timestamps[f - inFirstIndex] = m_recordedFrameTimestamps[recordedIndex];
+                }
+            }
         }
 
-        // Shift and stitch the 16-bit components of the 64-bit timestamp together.
-        const uint64_t tsc = (tscComps[3] << 48) | (tscComps[2] << 32) | (tscComps[1] << 16) | tscComps[0];
-        ISX_LOG_DEBUG_FRAME_TIME("Recovered TSC ", tsc);
-        return tsc;
+        if (!fromFooter)
+        {
+            // Read the start of each frame header up to and including the TSC,
+            // so that each frame takes one read in a single forward pass over
+            // the file instead of several seeks.
+            std::array<uint16_t, FRAME_META_TSC + 8> headerPixels;
+            const isize_t frameStrideInBytes = getFrameStrideInBytes();
+            PooledFileHandle::Lease lease(m_fileHandle);
+            checkFileGood("Movie file is bad before reading frame timestamps");
+            for (isize_t f = inFirstIndex; f < endIndex; ++f)
+            {
+                if (!ti.isIndexValid(f))
+                {
+                    timestamps[f - inFirstIndex] = 0;
+                    continue;
+                }
+
+                const std::streamoff offsetInBytes = std::streamoff(ti.timeIdxToRecordedIdx(f) * frameStrideInBytes);
+                if (offsetInBytes + std::streamoff(sizeof(headerPixels)) > std::streamoff(m_headerOffset))
+                {
+                    ISX_THROW(ExceptionFileIO, "Error reading TSC ", f);
+                }
+                m_file.seekg(offsetInBytes);
+                m_file.read(reinterpret_cast<char *>(headerPixels.data()), sizeof(headerPixels));
+                if (!m_file.good())
+                {
+                    ISX_THROW(ExceptionFileIO, "Error reading TSC ", f);
+                }
+
+#ifndef NDEBUG
+                if (headerPixels[0] != 0x0A0)
+                {
+                    ISX_LOG_WARNING("First pixel value of the header=", headerPixels[0], " != 0x0A0");
+                }
+#endif
+                timestamps[f - inFirstIndex] = decodeTsc(&headerPixels[FRAME_META_TSC]);
+            }
+        }
     }
+    return timestamps;
+}
 
-    return 0;
+const std::vector<uint64_t> &
+MosaicMovieFile::getAllFrameTimestamps()
+{
+    const isize_t numFrames = getTimingInfo().getNumTimes();
+    if (m_frameTimestamps.size() != numFrames)
+    {
+        m_frameTimestamps = readFrameTimestamps(0, numFrames);
+    }
+    return m_frameTimestamps;
+}
+
+void
+MosaicMovieFile::enablePixelStatistics(const isize_t inNumHistogramBins)
+{
+    checkFileNotClosedForWriting();
+    if (m_headerOffset != std::ios::pos_type(0))
+    {
+        ISX_THROW(ExceptionFileIO, "Pixel statistics must be enabled before writing frames: ", m_fileName);
+    }
+    m_pixelStatistics.reset(new MoviePixelStatistics());
+    m_pixelStatistics->m_overall = PixelStatistics::makeForDataType(m_dataType, inNumHistogramBins);
+}
+
+void
+MosaicMovieFile::enableFooterFrameTimestamps()
+{
+    checkFileNotClosedForWriting();
+    if (m_headerOffset != std::ios::pos_type(0))
+    {
+        ISX_THROW(ExceptionFileIO, "Footer frame timestamps must be enabled before writing frames: ", m_fileName);
+    }
+    m_storeFrameTimestamps = true;
+}
+
+bool
+MosaicMovieFile::hasPixelStatistics() const
+{
+    return bool(m_pixelStatistics);
+}
+
+PixelStatistics
+MosaicMovieFile::getPixelStatistics() const
+{
+    if (m_pixelStatistics)
+    {
+        return m_pixelStatistics->m_overall;
+    }
+    return PixelStatistics();
+}
+
+PixelStatistics
+MosaicMovieFile::getFramePixelStatistics(const isize_t inFrameNumber) const
+{
+    const TimingInfo & ti = getTimingInfo();
+    if (m_pixelStatistics && ti.isIndexValid(inFrameNumber))
+    {
+        std::lock_guard<std::mutex> lock(m_framePixelStatisticsMutex);
+        if (m_framePixelStatisticsJson)
+        {
+            try
+            {
+                m_pixelStatistics->m_frames = convertJsonToFramePixelStatistics(*m_framePixelStatisticsJson);
+            }
+            catch (const std::exception & error)
+            {
+                ISX_LOG_WARNING("Ignoring invalid frame pixel statistics of movie ", m_fileName, ": ", error.what());
+            }
+            m_framePixelStatisticsJson.reset();
+        }
+
+        const isize_t recordedIndex = ti.timeIdxToRecordedIdx(inFrameNumber);
+        if (recordedIndex < m_pixelStatistics->m_frames.size())
+        {
+            return m_pixelStatistics->m_frames[recordedIndex];
+        }
+    }
+    return PixelStatistics();
+}
+
+void
+MosaicMovieFile::accumulatePixelStatistics(const char * inPixels)
+{
+    if (!m_pixelStatistics)
+    {
+        return;
+    }
+
+    const PixelStatistics & overall = m_pixelStatistics->m_overall;
+    PixelStatistics frameStats(overall.m_histogramMin, overall.m_histogramMax, overall.m_histogram.size());
+    frameStats.accumulate(inPixels, m_dataType, getFrameSizeInBytes() / getDataTypeSizeInBytes(m_dataType));
+    m_pixelStatistics->m_overall.merge(frameStats);
+    frameStats.m_histogram = std::vector<uint64_t>();
+    m_pixelStatistics->m_frames.push_back(std::move(frameStats));
 }
 
 bool
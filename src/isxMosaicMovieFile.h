@@ -7,14 +7,20 @@
 #include "isxTimingInfo.h"
 #include "isxSpacingInfo.h"
 #include "isxJsonUtils.h"
+#include "isxPixelStatistics.h"
+#include "isxFileHandlePool.h"
 
 #include <ios>
 #include <fstream>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace isx
 {
 
+struct ProbedMetadata;
+
 /// Encapsulates movie information and data in a file.
 ///
 /// All information is read from and written to one file.
@@ -43,6 +49,20 @@ public:
     /// \throw  isx::ExceptionDataIO    If parsing the movie file fails.
     MosaicMovieFile(const std::string & inFileName, bool enableWrite = false);
 
+    /// Read the meta data of a movie file from its header only.
+    ///
+    /// Movies with frame headers and footers derive their frame rate from
+    /// the frame timestamps, so those cannot be probed from the header.
+    ///
+    /// \param  inFileName  The name of the movie file.
+    /// \param  outMetadata The meta data read from the header.
+    /// \return             True if the meta data was read, false if the
+    ///                     movie must be opened to get its meta data.
+    ///
+    /// \throw  isx::ExceptionFileIO    If reading the movie file fails.
+    /// \throw  isx::ExceptionDataIO    If parsing the movie header fails.
+    static bool probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata);
+
     /// Write constructor.
     ///
     /// This opens a new file, writes header information and initializes the
@@ -100,6 +120,24 @@ public:
     /// \return                 The frame footer.
     std::vector<uint16_t> readFrameFooter(const isize_t inFrameNumber);
 
+    /// Read a frame including its header and footer with one read into a buffer.
+    ///
+    /// The header, pixels and footer of a frame are contiguous in the file,
+    /// so this avoids seeking and reading each separately.
+    /// Frames that were not recorded are zeroed.
+    ///
+    /// \param  inFrameNumber   The index of the frame.
+    /// \param  outBuffer       The buffer to read into, which must be of at least
+    ///                         getRawFrameSizeInBytes bytes.
+    ///
+    /// \throw  isx::ExceptionFileIO    If reading the movie file fails.
+    /// \throw  isx::ExceptionDataIO    If inFrameNumber is out of range.
+    void readRawFrame(const isize_t inFrameNumber, char * outBuffer);
+
+    /// \return     The size of a frame including any header and footer in bytes.
+    ///
+    isize_t getRawFrameSizeInBytes() const;
+
     /// Write a frame to the file.
     ///
     /// \param  inVideoFrame    The frame to write to the file.
@@ -184,9 +222,70 @@ public:
     ///                     or 0 if it does not have one.
     uint64_t readFrameTimestamp(const isize_t inIndex);
 
+    /// Read the timestamps of a range of frames on the calling thread.
+    ///
+    /// The timestamps are taken from the footer or the cache of getAllFrameTimestamps
+    /// if possible. Otherwise they are read from the frame headers in one sequential
+    /// pass over the range, without caching them.
+    ///
+    /// \param  inFirstIndex    The index of the first frame in this movie.
+    /// \param  inNumFrames     The number of frames.
+    /// \return                 The timestamp of each frame in the range, which is 0 for
+    ///                         frames that do not have one.
+    ///
+    /// \throw  isx::ExceptionUserInput If the range goes past the last frame.
+    /// \throw  isx::ExceptionFileIO    If reading the movie file fails.
+    std::vector<uint64_t> readFrameTimestamps(const isize_t inFirstIndex, const isize_t inNumFrames);
+
+    /// Get the timestamps of all frames on the calling thread.
+    ///
+    /// The first call reads the timestamps from the frame headers in one
+    /// sequential pass over the file, unless they were stored in the footer,
+    /// and caches them so that later calls and readFrameTimestamp do not
+    /// read the file again.
+    ///
+    /// \return     The timestamp of each frame in this movie, which is 0 for
+    ///             frames that do not have one.
+    ///
+    /// \throw  isx::ExceptionFileIO    If reading the movie file fails.
+    const std::vector<uint64_t> & getAllFrameTimestamps();
+
     /// Aggressively close the file stream.
     void closeFileStream();
 
+    /// Compute pixel statistics of each frame and the whole movie while writing.
+    ///
+    /// The statistics are stored in the JSON footer when closing for writing,
+    /// so readers can get the range or histogram of the movie without scanning
+    /// all of its frames.
+    ///
+    /// \param  inNumHistogramBins  The number of histogram bins.
+    ///
+    /// \throw  isx::ExceptionFileIO    If called after writing frames or after closing for writing.
+    void enablePixelStatistics(const isize_t inNumHistogramBins = PixelStatistics::s_defaultNumBins);
+
+    /// Store the timestamp of every frame in the JSON footer when closing for writing,
+    /// so getAllFrameTimestamps does not need to read all the frame headers.
+    ///
+    /// The timestamps are captured from the frame headers, so this has no effect
+    /// unless the frames are written with their headers and footers.
+    ///
+    /// \throw  isx::ExceptionFileIO    If called after writing frames or after closing for writing.
+    void enableFooterFrameTimestamps();
+
+    /// \return     True if the movie has precomputed pixel statistics, false otherwise.
+    ///
+    bool hasPixelStatistics() const;
+
+    /// \return     The pixel statistics over all frames of the movie,
+    ///             or empty statistics if the movie does not have any.
+    PixelStatistics getPixelStatistics() const;
+
+    /// \param  inFrameNumber   The index of the frame.
+    /// \return                 The pixel statistics of the frame without a histogram, or empty
+    ///                         statistics if the movie does not have any or the frame is not valid.
+    PixelStatistics getFramePixelStatistics(const isize_t inFrameNumber) const;
+
 private:
     /// True if the movie file is valid, false otherwise.
     bool m_valid;
@@ -212,6 +311,9 @@ private:
     /// The stream open mode
     std::ios_base::openmode m_openmode;
 
+    /// The pool entry of the file stream, which is only managed when reading.
+    PooledFileHandle m_fileHandle;
+
     bool m_fileClosedForWriting = false;
 
     /// The version of this file format.
@@ -232,6 +334,30 @@ private:
     /// The extra properties to write in the JSON footer.
     json m_extraProperties = nullptr;
 
+    /// The pixel statistics computed while writing or read from the footer.
+    /// This is null if the movie has no pixel statistics.
+    std::unique_ptr<MoviePixelStatistics> m_pixelStatistics;
+
+    /// The statistics of the frames read from the footer, which are only
+    /// converted into m_pixelStatistics when first requested.
+    mutable std::unique_ptr<json> m_framePixelStatisticsJson;
+
+    /// Guards the conversion of the statistics of the frames.
+    mutable std::mutex m_framePixelStatisticsMutex;
+
+    /// True if the timestamps of the frames are captured while writing
+    /// and stored in the JSON footer.
+    bool m_storeFrameTimestamps = false;
+
+    /// The timestamp of each recorded frame, which is captured from the frame headers
+    /// while writing and stored in the JSON footer, or read from the JSON footer.
+    /// This is empty if the timestamps are not known for every recorded frame.
+    std::vector<uint64_t> m_recordedFrameTimestamps;
+
+    /// The timestamp of each frame cached by getAllFrameTimestamps,
+    /// or empty if they have not been cached yet.
+    std::vector<uint64_t> m_frameTimestamps;
+
     /// The integrated base plate name
     std::string m_integratedBasePlate;
 
@@ -309,6 +435,21 @@ private:
     ///
     void flush();
 
+    /// \return     The size of a frame including any header and footer in bytes.
+    ///
+    isize_t getFrameStrideInBytes() const;
+
+    /// Capture the timestamp of a frame that is being written,
+    /// if they are stored in the footer.
+    ///
+    /// \param  inHeader    The header of the frame.
+    void captureFrameTimestamp(const uint16_t * inHeader);
+
+    /// Accumulate the pixel statistics of a frame that is being written.
+    ///
+    /// \param  inPixels    The pixel data of the frame, excluding any header or footer.
+    void accumulatePixelStatistics(const char * inPixels);
+
     /// Set a new timing info
     /// Notice that is only called from closeForWriting() as it is 
     /// intended to be used during data acquisition, when the client has 
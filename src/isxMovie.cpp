@@ -1,4 +1,7 @@
 #include "isxMovie.h"
+#include "isxNVisionTracking.h"
+
+#include <cstring>
 
 namespace isx
 {
@@ -15,12 +18,31 @@ Movie::getFrameMetadata(const size_t inFrameNumber)
     return "null";
 }
 
+BoundingBox
+Movie::getFrameBoundingBox(const size_t inFrameNumber)
+{
+    return BoundingBox::fromMetadata(getFrameMetadata(inFrameNumber));
+}
+
 std::vector<uint16_t>
 Movie::getFrameFooter(const size_t inFrameNumber)
 {
     return std::vector<uint16_t>();
 }
 
+void
+Movie::getRawFrame(const size_t inFrameNumber, char * outBuffer)
+{
+    const SpVideoFrame_t frame = getFrame(inFrameNumber);
+    std::memcpy(outBuffer, frame->getPixels(), frame->getImageSizeInBytes());
+}
+
+isize_t
+Movie::getRawFrameSizeInBytes() const
+{
+    return getSpacingInfo().getTotalNumPixels() * getDataTypeSizeInBytes(getDataType());
+}
+
 std::string
 Movie::getExtraProperties() const
 {
@@ -46,6 +68,42 @@ Movie::getFrameTimestamp(const isize_t inIndex)
     return 0;
 }
 
+std::vector<uint64_t>
+Movie::getFrameTimestamps(const isize_t inFirstIndex, const isize_t inNumFrames)
+{
+    std::vector<uint64_t> timestamps(inNumFrames);
+    for (isize_t i = 0; i < inNumFrames; ++i)
+    {
+        timestamps[i] = getFrameTimestamp(inFirstIndex + i);
+    }
+    return timestamps;
+}
+
+std::vector<uint64_t>
+Movie::getAllFrameTimestamps()
+{
+    return getFrameTimestamps(0, getTimingInfo().getNumTimes());
+}
+
+bool
+Movie::hasPixelStatistics() const
+{
+    return false;
+}
+
+PixelStatistics
+Movie::getPixelStatistics() const
+{
+    return PixelStatistics();
+}
+
+PixelStatistics
+Movie::getFramePixelStatistics(const isize_t inFrameNumber) const
+{
+    (void)inFrameNumber;
+    return PixelStatistics();
+}
+
 void
 Movie::closeFileStream()
 {
@@ -365,6 +365,29 @@ compressedAVIFindMinMax(const std::string & inFileName, const std::vector<isx::S
     outMinVal = std::numeric_limits<float>::max();
     outMaxVal = -std::numeric_limits<float>::max();
 
+    // Movies that were written with pixel statistics already know their range,
+    // so only fall back to scanning every frame if one of them does not.
+    const bool haveAllPixelStatistics = std::all_of(inMovies.begin(), inMovies.end(),
+        [](const isx::SpMovie_t & m) { return m->hasPixelStatistics(); });
+    if (haveAllPixelStatistics)
+    {
+        for (auto m : inMovies)
+        {
+            const isx::PixelStatistics stats = m->getPixelStatistics();
+            if (!stats.isValid())
+            {
+                continue;
+            }
+
+            // Match the normalization of getImageMinMax.
+            const isx::DataType dt = m->getDataType();
+            const float normalizer = (dt == isx::DataType::U8 || dt == isx::DataType::RGB888) ? 255.f : 1.f;
+            outMinVal = std::min(outMinVal, stats.m_min / normalizer);
+            outMaxVal = std::max(outMaxVal, stats.m_max / normalizer);
+        }
+        return inCheckInCB(inProgressStart + inProgressAllocation);
+    }
+
     bool cancelled = false;
     isx::isize_t writtenFrames = 0;
     isx::isize_t numFrames = 0;
@@ -422,9 +445,7 @@ void drawTrackingData(
     const auto dataType = CV_8U; // constant for nVision movies
     auto mat = cv::Mat(size, dataType, inImage.getPixels());
 
-    const auto boundingBox = isx::BoundingBox::fromMetadata(
-        inMovie->getFrameMetadata(inFrameIndex)
-    );
+    const auto boundingBox = inMovie->getFrameBoundingBox(inFrameIndex);
     const auto rect = boundingBox.isValid() ?
         cv::Rect(
             cv::Point(
@@ -388,12 +388,13 @@ runMovieTimestampExport(const MovieTimestampExporterParams inParams, AsyncCheckI
     {
         const auto & movie = inParams.m_srcs[movieNumber];
         const auto & timingInfo = movie->getTimingInfo();
+        const auto timestamps = movie->getAllFrameTimestamps();
         for (size_t localFrameNumber = 0; localFrameNumber < timingInfo.getNumTimes(); localFrameNumber++)
         {
             csv << globalFrameNumber << "," << movieNumber << "," << localFrameNumber << ",";
             if (timingInfo.isIndexValid(localFrameNumber))
             {
-                const auto tsc = movie->getFrameTimestamp(localFrameNumber);
+                const auto tsc = timestamps[localFrameNumber];
                 if (inParams.m_format == WriteTimeRelativeTo::FIRST_DATA_ITEM)
                 {
                     const auto timestamp = double(tsc - firstTsc) / 1e6;
@@ -489,9 +490,7 @@ writeNVisionTrackingBoundingBoxToCsv(
             }
             csv << ",";
 
-            const auto boundingBox = BoundingBox::fromMetadata(
-                movie->getFrameMetadata(localFrameNumber)
-            );
+            const auto boundingBox = movie->getFrameBoundingBox(localFrameNumber);
 
             if (!boundingBox.isValid())
             {
@@ -5,6 +5,7 @@
 #include "isxSeries.h"
 #include "isxIoTaskTracker.h"
 #include "isxSeriesUtils.h"
+#include "isxNVisionTracking.h"
 
 #include <algorithm>
 #include <functional>
@@ -48,17 +49,14 @@ MovieSeries::MovieSeries(const std::vector<std::string> & inFileNames, const std
             ISX_ASSERT(inFileNames.size() == inProperties.size());
         }
 
-        for (isize_t i(0); i < inFileNames.size(); ++i)
+        m_movies = openSeriesMembers<SpMovie_t>(inFileNames, [&inFileNames, &inProperties](const isize_t inIndex)
         {
             if (!inProperties.empty())
             {
-                m_movies.emplace_back(readMovie(inFileNames.at(i), inProperties.at(i)));
+                return readMovie(inFileNames.at(inIndex), inProperties.at(inIndex));
             }
-            else
-            {
-                m_movies.emplace_back(readMovie(inFileNames.at(i)));
-            }
-        }
+            return readMovie(inFileNames.at(inIndex));
+        });
     }
 
     std::sort(m_movies.begin(), m_movies.end(), [](SpMovie_t a, SpMovie_t b)
@@ -176,6 +174,22 @@ MovieSeries::getFrameMetadata(const isize_t inFrameNumber)
     return m_movies[movieIndex]->getFrameMetadata(frameIndex);
 }
 
+BoundingBox
+MovieSeries::getFrameBoundingBox(const isize_t inFrameNumber)
+{
+    if (inFrameNumber >= m_gaplessTimingInfo.getNumTimes())
+    {
+        ISX_THROW(ExceptionDataIO, "The index of the frame (", inFrameNumber,
+                ") is out of range (0-", m_gaplessTimingInfo.getNumTimes(), ").");
+    }
+
+    size_t movieIndex = 0;
+    size_t frameIndex = 0;
+    std::tie(movieIndex, frameIndex) = getSegmentAndLocalIndex(m_timingInfos, inFrameNumber);
+
+    return m_movies[movieIndex]->getFrameBoundingBox(frameIndex);
+}
+
 uint64_t
 MovieSeries::getFrameTimestamp(const isize_t inFrameNumber)
 {
@@ -192,6 +206,28 @@ MovieSeries::getFrameTimestamp(const isize_t inFrameNumber)
     return m_movies[movieIndex]->getFrameTimestamp(frameIndex);
 }
 
+std::vector<uint64_t>
+MovieSeries::getAllFrameTimestamps()
+{
+    std::vector<std::vector<uint64_t>> movieTimestamps;
+    movieTimestamps.reserve(m_movies.size());
+    for (const auto & m : m_movies)
+    {
+        movieTimestamps.push_back(m->getAllFrameTimestamps());
+    }
+
+    const isize_t numFrames = m_gaplessTimingInfo.getNumTimes();
+    std::vector<uint64_t> timestamps(numFrames);
+    for (isize_t i = 0; i < numFrames; ++i)
+    {
+        size_t movieIndex = 0;
+        size_t frameIndex = 0;
+        std::tie(movieIndex, frameIndex) = getSegmentAndLocalIndex(m_timingInfos, i);
+        timestamps[i] = movieTimestamps[movieIndex][frameIndex];
+    }
+    return timestamps;
+}
+
 void
 MovieSeries::cancelPendingReads()
 {
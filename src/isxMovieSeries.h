@@ -89,8 +89,14 @@ public:
     std::string
     getFrameMetadata(const size_t inFrameNumber) override;
 
+    BoundingBox
+    getFrameBoundingBox(const size_t inFrameNumber) override;
+
     uint64_t
     getFrameTimestamp(const isize_t inFrameNumber) override;
+
+    std::vector<uint64_t>
+    getAllFrameTimestamps() override;
     
     void cancelPendingReads() override;
 
@@ -0,0 +1,445 @@
+#include "isxNVisionFrameMetadata.h"
+#include "isxException.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace isx
+{
+
+namespace
+{
+
+/// Identifies a binary sidecar file of nVision per-frame metadata.
+const char s_sidecarMagic[8] = {'I', 'S', 'X', 'B', 'M', 'E', 'T', 'A'};
+
+/// The version of the binary sidecar file format.
+const uint64_t s_sidecarVersion = 1;
+
+template <typename T>
+void
+writeValue(std::ofstream & inStream, const T & inValue)
+{
+    inStream.write(reinterpret_cast<const char *>(&inValue), sizeof(T));
+}
+
+template <typename T>
+void
+writeColumn(std::ofstream & inStream, const std::vector<T> & inColumn)
+{
+    writeValue(inStream, uint64_t(inColumn.size()));
+    if (!inColumn.empty())
+    {
+        inStream.write(reinterpret_cast<const char *>(inColumn.data()), std::streamsize(inColumn.size() * sizeof(T)));
+    }
+}
+
+template <typename T>
+void
+readValue(std::ifstream & inStream, T & outValue)
+{
+    inStream.read(reinterpret_cast<char *>(&outValue), sizeof(T));
+}
+
+template <typename T>
+void
+readColumn(std::ifstream & inStream, const uint64_t inMaxSize, std::vector<T> & outColumn)
+{
+    uint64_t size = 0;
+    readValue(inStream, size);
+    if (!inStream.good() || size > inMaxSize)
+    {
+        inStream.setstate(std::ios::failbit);
+        return;
+    }
+    outColumn.resize(size_t(size));
+    if (!outColumn.empty())
+    {
+        inStream.read(reinterpret_cast<char *>(outColumn.data()), std::streamsize(outColumn.size() * sizeof(T)));
+    }
+}
+
+} // namespace
+
+NVisionFrameMetadataTable::NVisionFrameMetadataTable()
+    : m_zoneEventOffsets(1, 0)
+{
+}
+
+NVisionFrameMetadataTable
+NVisionFrameMetadataTable::fromJson(const json & inSamples)
+{
+    NVisionFrameMetadataTable table;
+    const size_t numFrames = inSamples.size();
+    table.m_flags.reserve(numFrames);
+    table.m_timestamps.reserve(numFrames);
+    table.m_tops.reserve(numFrames);
+    table.m_lefts.reserve(numFrames);
+    table.m_bottoms.reserve(numFrames);
+    table.m_rights.reserve(numFrames);
+    table.m_confidences.reserve(numFrames);
+    table.m_zoneEventOffsets.reserve(numFrames + 1);
+
+    for (const auto & frameMetadata : inSamples)
+    {
+        uint8_t flags = 0;
+        uint64_t timestamp = 0;
+        if (frameMetadata.is_object() && frameMetadata.find("tsc") != frameMetadata.end())
+        {
+            try
+            {
+                timestamp = frameMetadata.at("tsc").get<uint64_t>();
+                flags |= s_hasTimestamp;
+            }
+            catch (const std::exception &)
+            {
+                timestamp = 0;
+            }
+        }
+        table.m_timestamps.push_back(timestamp);
+
+        if (table.appendTracker(frameMetadata))
+        {
+            flags |= s_hasBoundingBox;
+        }
+        else
+        {
+            table.appendEmptyTracker();
+        }
+        table.m_flags.push_back(flags);
+    }
+    return table;
+}
+
+bool
+NVisionFrameMetadataTable::appendTracker(const json & inFrameMetadata)
+{
+    // This must decode exactly what BoundingBox::fromMetadata does.
+    // Anything that would make that throw leaves the frame undecoded.
+    if (!inFrameMetadata.is_object() || inFrameMetadata.find("tracker") == inFrameMetadata.end())
+    {
+        appendEmptyTracker();
+        return true;
+    }
+
+    float top = 0.f, left = 0.f, bottom = 0.f, right = 0.f, confidence = 0.f;
+    std::vector<ZoneEvent> zoneEvents;
+    try
+    {
+        const auto & trackerMetadata = inFrameMetadata.at("tracker");
+        if (!trackerMetadata.is_object() || trackerMetadata.find("box") == trackerMetadata.end())
+        {
+            appendEmptyTracker();
+            return true;
+        }
+
+        const auto & trackerBoxMetadata = trackerMetadata.at("box");
+        if (!trackerBoxMetadata.is_array() || trackerBoxMetadata.size() < 4)
+        {
+            return false;
+        }
+
+        if (trackerMetadata.find("zones") != trackerMetadata.end())
+        {
+            const auto & zoneMetadata = trackerMetadata.at("zones");
+            std::vector<const json *> zones;
+            if (zoneMetadata.is_array())
+            {
+                for (const auto & zone : zoneMetadata)
+                {
+                    zones.push_back(&zone);
+                }
+            }
+            else
+            {
+                zones.push_back(&zoneMetadata);
+            }
+
+            for (const json * zone : zones)
+            {
+                const auto zoneId = zone->at("id").get<int64_t>();
+                const auto zoneName = zone->at("name").get<std::string>();
+
+                auto type = ZoneEvent::Type::NONE;
+                if (zone->find("event") != zone->end())
+                {
+                    type = ZoneEvent::strToType(zone->at("event").get<std::string>());
+                }
+
+                auto trigger = ZoneEvent::Trigger::NONE;
+                if (zone->find("trig") != zone->end())
+                {
+                    trigger = ZoneEvent::strToTrigger(zone->at("trig").get<std::string>());
+                }
+                zoneEvents.push_back(ZoneEvent(zoneId, zoneName, type, trigger));
+            }
+        }
+
+        top = trackerBoxMetadata.at(1).get<float>();
+        left = trackerBoxMetadata.at(0).get<float>();
+        bottom = trackerBoxMetadata.at(3).get<float>();
+        right = trackerBoxMetadata.at(2).get<float>();
+        confidence = trackerMetadata.at("conf").get<float>();
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    m_tops.push_back(top);
+    m_lefts.push_back(left);
+    m_bottoms.push_back(bottom);
+    m_rights.push_back(right);
+    m_confidences.push_back(confidence);
+
+    for (const auto & zoneEvent : zoneEvents)
+    {
+        // Zone names are repeated for every frame, so store each once.
+        size_t nameIndex = 0;
+        while (nameIndex < m_zoneNames.size() && m_zoneNames[nameIndex] != zoneEvent.getZoneName())
+        {
+            ++nameIndex;
+        }
+        if (nameIndex == m_zoneNames.size())
+        {
+            m_zoneNames.push_back(zoneEvent.getZoneName());
+        }
+
+        m_zoneIds.push_back(zoneEvent.getZoneId());
+        m_zoneNameIndices.push_back(uint32_t(nameIndex));
+        m_zoneEventTypes.push_back(zoneEvent.getType());
+        m_zoneEventTriggers.push_back(zoneEvent.getTrigger());
+    }
+    m_zoneEventOffsets.push_back(m_zoneIds.size());
+    return true;
+}
+
+void
+NVisionFrameMetadataTable::appendEmptyTracker()
+{
+    m_tops.push_back(0.f);
+    m_lefts.push_back(0.f);
+    m_bottoms.push_back(0.f);
+    m_rights.push_back(0.f);
+    m_confidences.push_back(0.f);
+    m_zoneEventOffsets.push_back(m_zoneIds.size());
+}
+
+NVisionFrameMetadataTable
+NVisionFrameMetadataTable::load(const std::string & inFileName)
+{
+    std::ifstream stream(inFileName, std::ios::binary);
+    if (!stream.good())
+    {
+        ISX_THROW(ExceptionFileIO, "Failed to open nVision frame metadata file for reading: ", inFileName);
+    }
+
+    char magic[sizeof(s_sidecarMagic)] = {};
+    uint64_t version = 0;
+    uint64_t numFrames = 0;
+    readValue(stream, magic);
+    readValue(stream, version);
+    readValue(stream, numFrames);
+    if (!stream.good()
+        || !std::equal(std::begin(magic), std::end(magic), std::begin(s_sidecarMagic))
+        || version != s_sidecarVersion)
+    {
+        ISX_THROW(ExceptionFileIO, "Invalid nVision frame metadata file: ", inFileName);
+    }
+
+    NVisionFrameMetadataTable table;
+    const uint64_t maxSize = std::numeric_limits<uint32_t>::max();
+    readColumn(stream, numFrames, table.m_flags);
+    readColumn(stream, numFrames, table.m_timestamps);
+    readColumn(stream, numFrames, table.m_tops);
+    readColumn(stream, numFrames, table.m_lefts);
+    readColumn(stream, numFrames, table.m_bottoms);
+    readColumn(stream, numFrames, table.m_rights);
+    readColumn(stream, numFrames, table.m_confidences);
+    readColumn(stream, numFrames + 1, table.m_zoneEventOffsets);
+    readColumn(stream, maxSize, table.m_zoneIds);
+    readColumn(stream, maxSize, table.m_zoneNameIndices);
+    readColumn(stream, maxSize, table.m_zoneEventTypes);
+    readColumn(stream, maxSize, table.m_zoneEventTriggers);
+
+    uint64_t numZoneNames = 0;
+    readValue(stream, numZoneNames);
+    for (uint64_t i = 0; stream.good() && i < numZoneNames; ++i)
+    {
+        std::vector<char> name;
+        readColumn(stream, maxSize, name);
+        table.m_zoneNames.emplace_back(name.begin(), name.end());
+    }
+
+    const size_t numZoneEvents = table.m_zoneIds.size();
+    bool valid = stream.good()
+        && table.m_flags.size() == numFrames
+        && table.m_timestamps.size() == numFrames
+        && table.m_tops.size() == numFrames
+        && table.m_lefts.size() == numFrames
+        && table.m_bottoms.size() == numFrames
+        && table.m_rights.size() == numFrames
+        && table.m_confidences.size() == numFrames
+        && table.m_zoneEventOffsets.size() == numFrames + 1
+        && table.m_zoneEventOffsets.front() == 0
+        && table.m_zoneEventOffsets.back() == numZoneEvents
+        && table.m_zoneNameIndices.size() == numZoneEvents
+        && table.m_zoneEventTypes.size() == numZoneEvents
+        && table.m_zoneEventTriggers.size() == numZoneEvents;
+    for (size_t i = 0; valid && i < numFrames; ++i)
+    {
+        valid = table.m_zoneEventOffsets[i] <= table.m_zoneEventOffsets[i + 1];
+    }
+    for (size_t i = 0; valid && i < numZoneEvents; ++i)
+    {
+        valid = table.m_zoneNameIndices[i] < table.m_zoneNames.size();
+    }
+    if (!valid)
+    {
+        ISX_THROW(ExceptionFileIO, "Invalid nVision frame metadata file: ", inFileName);
+    }
+    return table;
+}
+
+void
+NVisionFrameMetadataTable::save(const std::string & inFileName) const
+{
+    std::ofstream stream(inFileName, std::ios::binary | std::ios::trunc);
+    if (!stream.good())
+    {
+        ISX_THROW(ExceptionFileIO, "Failed to open nVision frame metadata file for writing: ", inFileName);
+    }
+
+    writeValue(stream, s_sidecarMagic);
+    writeValue(stream, s_sidecarVersion);
+    writeValue(stream, uint64_t(getNumFrames()));
+    writeColumn(stream, m_flags);
+    writeColumn(stream, m_timestamps);
+    writeColumn(stream, m_tops);
+    writeColumn(stream, m_lefts);
+    writeColumn(stream, m_bottoms);
+    writeColumn(stream, m_rights);
+    writeColumn(stream, m_confidences);
+    writeColumn(stream, m_zoneEventOffsets);
+    writeColumn(stream, m_zoneIds);
+    writeColumn(stream, m_zoneNameIndices);
+    writeColumn(stream, m_zoneEventTypes);
+    writeColumn(stream, m_zoneEventTriggers);
+    writeValue(stream, uint64_t(m_zoneNames.size()));
+    for (const auto & name : m_zoneNames)
+    {
+        writeColumn(stream, std::vector<char>(name.begin(), name.end()));
+    }
+
+    stream.flush();
+    if (!stream.good())
+    {
+        ISX_THROW(ExceptionFileIO, "Failed to write nVision frame metadata file: ", inFileName);
+    }
+}
+
+size_t
+NVisionFrameMetadataTable::getNumFrames() const
+{
+    return m_flags.size();
+}
+
+bool
+NVisionFrameMetadataTable::hasTimestamp(const size_t inFrameNumber) const
+{
+    return (inFrameNumber < m_flags.size()) && (m_flags[inFrameNumber] & s_hasTimestamp);
+}
+
+bool
+NVisionFrameMetadataTable::hasBoundingBox(const size_t inFrameNumber) const
+{
+    return (inFrameNumber < m_flags.size()) && (m_flags[inFrameNumber] & s_hasBoundingBox);
+}
+
+const std::vector<uint64_t> &
+NVisionFrameMetadataTable::getTimestamps() const
+{
+    return m_timestamps;
+}
+
+const std::vector<float> &
+NVisionFrameMetadataTable::getTops() const
+{
+    return m_tops;
+}
+
+const std::vector<float> &
+NVisionFrameMetadataTable::getLefts() const
+{
+    return m_lefts;
+}
+
+const std::vector<float> &
+NVisionFrameMetadataTable::getBottoms() const
+{
+    return m_bottoms;
+}
+
+const std::vector<float> &
+NVisionFrameMetadataTable::getRights() const
+{
+    return m_rights;
+}
+
+const std::vector<float> &
+NVisionFrameMetadataTable::getConfidences() const
+{
+    return m_confidences;
+}
+
+const std::vector<size_t> &
+NVisionFrameMetadataTable::getZoneEventOffsets() const
+{
+    return m_zoneEventOffsets;
+}
+
+const std::vector<int64_t> &
+NVisionFrameMetadataTable::getZoneIds() const
+{
+    return m_zoneIds;
+}
+
+const std::vector<ZoneEvent::Type> &
+NVisionFrameMetadataTable::getZoneEventTypes() const
+{
+    return m_zoneEventTypes;
+}
+
+const std::vector<ZoneEvent::Trigger> &
+NVisionFrameMetadataTable::getZoneEventTriggers() const
+{
+    return m_zoneEventTriggers;
+}
+
+const std::string &
+NVisionFrameMetadataTable::getZoneName(const size_t inZoneEventIndex) const
+{
+    return m_zoneNames.at(m_zoneNameIndices.at(inZoneEventIndex));
+}
+
+BoundingBox
+NVisionFrameMetadataTable::getBoundingBox(const size_t inFrameNumber) const
+{
+    ISX_ASSERT(hasBoundingBox(inFrameNumber));
+    std::vector<ZoneEvent> zoneEvents;
+    for (size_t e = m_zoneEventOffsets[inFrameNumber]; e < m_zoneEventOffsets[inFrameNumber + 1]; ++e)
+    {
+        zoneEvents.push_back(ZoneEvent(m_zoneIds[e], getZoneName(e), m_zoneEventTypes[e], m_zoneEventTriggers[e]));
+    }
+    return BoundingBox(
+        m_tops[inFrameNumber],
+        m_lefts[inFrameNumber],
+        m_bottoms[inFrameNumber],
+        m_rights[inFrameNumber],
+        m_confidences[inFrameNumber],
+        zoneEvents
+    );
+}
+
+} // namespace isx
@@ -0,0 +1,176 @@
+#ifndef ISX_NVISION_FRAME_METADATA_H
+#define ISX_NVISION_FRAME_METADATA_H
+
+#include "isxCore.h"
+#include "isxNVisionTracking.h"
+#include "isxJsonUtils.h"
+
+#include <string>
+#include <vector>
+
+namespace isx
+{
+
+/// The per-frame metadata of an nVision movie decoded into typed columns.
+///
+/// The per-frame metadata of an nVision movie is stored as JSON.
+/// This decodes the fields that are frequently queried (the TSC timestamp
+/// and the tracked bounding box with its zone events) once, so that
+/// looking them up for a frame is an array lookup instead of a JSON parse.
+///
+/// Frames are indexed by their recorded index, so dropped frames are not included.
+/// If a field of a frame cannot be decoded (e.g. because it is missing or
+/// malformed) the frame is marked as such, so that callers can fall back
+/// to parsing the JSON and report the same error as before.
+///
+/// The columns can also be saved to and loaded from a binary sidecar file.
+class NVisionFrameMetadataTable
+{
+public:
+
+    /// Constructs an empty table.
+    ///
+    NVisionFrameMetadataTable();
+
+    /// Decode the per-frame metadata of a movie.
+    ///
+    /// \param  inSamples   The JSON array of per-frame metadata.
+    /// \return             The decoded table.
+    static
+    NVisionFrameMetadataTable
+    fromJson(const json & inSamples);
+
+    /// Load a table that was saved with save.
+    ///
+    /// \param  inFileName  The name of the sidecar file.
+    /// \return             The loaded table.
+    ///
+    /// \throw  isx::ExceptionFileIO    If the file cannot be read or is not a valid sidecar file.
+    static
+    NVisionFrameMetadataTable
+    load(const std::string & inFileName);
+
+    /// Save this table to a binary sidecar file.
+    ///
+    /// \param  inFileName  The name of the sidecar file.
+    ///
+    /// \throw  isx::ExceptionFileIO    If the file cannot be written.
+    void
+    save(const std::string & inFileName) const;
+
+    /// \return The number of frames in this table.
+    ///
+    size_t
+    getNumFrames() const;
+
+    /// \param  inFrameNumber   The recorded index of a frame.
+    /// \return                 True if the TSC timestamp of the frame was decoded.
+    bool
+    hasTimestamp(const size_t inFrameNumber) const;
+
+    /// \param  inFrameNumber   The recorded index of a frame.
+    /// \return                 True if the tracking data of the frame was decoded.
+    bool
+    hasBoundingBox(const size_t inFrameNumber) const;
+
+    /// \return The TSC timestamp of each frame, which is 0 if not decoded.
+    ///
+    const std::vector<uint64_t> &
+    getTimestamps() const;
+
+    /// \return The top pixel coordinate of the bounding box of each frame.
+    ///
+    const std::vector<float> &
+    getTops() const;
+
+    /// \return The left pixel coordinate of the bounding box of each frame.
+    ///
+    const std::vector<float> &
+    getLefts() const;
+
+    /// \return The bottom pixel coordinate of the bounding box of each frame.
+    ///
+    const std::vector<float> &
+    getBottoms() const;
+
+    /// \return The right pixel coordinate of the bounding box of each frame.
+    ///
+    const std::vector<float> &
+    getRights() const;
+
+    /// \return The model confidence of each frame.
+    ///
+    const std::vector<float> &
+    getConfidences() const;
+
+    /// The zone events of frame i are at the indices [offsets[i], offsets[i + 1])
+    /// of the zone event columns.
+    ///
+    /// \return The offsets of the zone events of each frame plus one past the last.
+    const std::vector<size_t> &
+    getZoneEventOffsets() const;
+
+    /// \return The zone id of each zone event.
+    ///
+    const std::vector<int64_t> &
+    getZoneIds() const;
+
+    /// \return The type of each zone event.
+    ///
+    const std::vector<ZoneEvent::Type> &
+    getZoneEventTypes() const;
+
+    /// \return The trigger of each zone event.
+    ///
+    const std::vector<ZoneEvent::Trigger> &
+    getZoneEventTriggers() const;
+
+    /// \param  inZoneEventIndex    The index of a zone event.
+    /// \return                     The zone name of the zone event.
+    const std::string &
+    getZoneName(const size_t inZoneEventIndex) const;
+
+    /// \param  inFrameNumber   The recorded index of a frame, which must have a decoded bounding box.
+    /// \return                 The bounding box of the frame with its zone events.
+    BoundingBox
+    getBoundingBox(const size_t inFrameNumber) const;
+
+private:
+
+    /// Decode the tracking data of a frame and append it to the columns.
+    ///
+    /// \return False if the data could not be decoded, in which case
+    ///         the columns are unchanged.
+    bool
+    appendTracker(const json & inFrameMetadata);
+
+    /// Append the columns of a frame without tracking data.
+    ///
+    void
+    appendEmptyTracker();
+
+    /// Bits of m_flags.
+    static const uint8_t s_hasTimestamp = 1 << 0;
+    static const uint8_t s_hasBoundingBox = 1 << 1;
+
+    std::vector<uint8_t> m_flags;
+    std::vector<uint64_t> m_timestamps;
+    std::vector<float> m_tops;
+    std::vector<float> m_lefts;
+    std::vector<float> m_bottoms;
+    std::vector<float> m_rights;
+    std::vector<float> m_confidences;
+
+    std::vector<size_t> m_zoneEventOffsets;
+    std::vector<int64_t> m_zoneIds;
+    std::vector<uint32_t> m_zoneNameIndices;
+    std::vector<ZoneEvent::Type> m_zoneEventTypes;
+    std::vector<ZoneEvent::Trigger> m_zoneEventTriggers;
+
+    /// The distinct zone names, which are indexed by m_zoneNameIndices.
+    std::vector<std::string> m_zoneNames;
+};
+
+} // namespace isx
+
+#endif // ISX_NVISION_FRAME_METADATA_H
@@ -76,6 +76,12 @@ NVisionMovie::getFrameMetadata(const size_t inFrameNumber)
     return m_file->readFrameMetadata(inFrameNumber);
 }
 
+BoundingBox
+NVisionMovie::getFrameBoundingBox(const size_t inFrameNumber)
+{
+    return m_file->readBoundingBox(inFrameNumber);
+}
+
 void
 NVisionMovie::cancelPendingReads()
 {
@@ -41,6 +41,8 @@ public:
 
     std::string getFrameMetadata(const size_t inFrameNumber) override;
 
+    BoundingBox getFrameBoundingBox(const size_t inFrameNumber) override;
+
     void cancelPendingReads() override;
 
     const isx::TimingInfo & getTimingInfo() const override;
@@ -1,5 +1,6 @@
 
 #include "isxNVisionMovieFile.h"
+#include "isxMetadataProbe.h"
 #include "isxJsonUtils.h"
 #include "isxMovie.h"
 
@@ -67,6 +68,47 @@ std::ostream& operator<<(std::ostream& os, const NVisionMovieFile::Header & head
 	return os;
 }
 
+namespace
+{
+
+/// Construct the spacing info of a movie from its session metadata.
+///
+/// If there is a spacing info key it is read directly and removed from the
+/// session metadata, otherwise the spacing info is constructed from the keys
+/// in the processing interface of the session metadata.
+SpacingInfo
+readSessionSpacingInfo(json & ioSessionMetadata)
+{
+	if (ioSessionMetadata.find("spacingInfo") == ioSessionMetadata.end())
+	{
+		ISX_NVISION_MOVIE_LOG_DEBUG("Constructing spacing info from processing interface key in session metadata");
+		verifyJsonKey(ioSessionMetadata, "cameraName");
+		verifyJsonKey(ioSessionMetadata, "processingInterface");
+
+		const std::string cameraName = ioSessionMetadata["cameraName"];
+		verifyJsonKey(ioSessionMetadata["processingInterface"], cameraName);
+		verifyJsonKey(ioSessionMetadata["processingInterface"][cameraName], "recordFov");
+		verifyJsonKey(ioSessionMetadata["processingInterface"][cameraName]["recordFov"], "width");
+		verifyJsonKey(ioSessionMetadata["processingInterface"][cameraName]["recordFov"], "height");
+		verifyJsonKey(ioSessionMetadata["processingInterface"][cameraName]["recordFov"], "originx");
+		verifyJsonKey(ioSessionMetadata["processingInterface"][cameraName]["recordFov"], "originy");
+
+		json recordFov = ioSessionMetadata["processingInterface"][cameraName]["recordFov"];
+		return SpacingInfo(
+			SizeInPixels_t(recordFov["width"].get<uint64_t>(), recordFov["height"].get<uint64_t>()),
+			SizeInMicrons_t(DEFAULT_PIXEL_SIZE, DEFAULT_PIXEL_SIZE),
+			PointInMicrons_t(recordFov["originx"].get<uint64_t>(), recordFov["originy"].get<uint64_t>())
+		);
+	}
+
+	ISX_NVISION_MOVIE_LOG_DEBUG("Constructing spacing info from spacing info key in session metadata");
+	const SpacingInfo spacingInfo = convertJsonToSpacingInfo(ioSessionMetadata["spacingInfo"]);
+	ioSessionMetadata.erase("spacingInfo");
+	return spacingInfo;
+}
+
+} // namespace
+
 NVisionMovieFile::NVisionMovieFile(
 	const std::string & inFileName,
 	const bool inEnableWrite)
@@ -326,6 +368,60 @@ NVisionMovieFile::writeHeader()
 	ISX_NVISION_MOVIE_LOG_DEBUG("Header written.");
 }
 
+bool
+NVisionMovieFile::probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata)
+{
+	std::ifstream file(inFileName, std::ios::binary);
+	if (!file.good() || !file.is_open())
+	{
+		ISX_THROW(isx::ExceptionFileIO,
+			"Failed to open movie file for reading (", inFileName, ")", " with error: ", getSystemErrorString());
+	}
+
+	Header header;
+	file.read(reinterpret_cast<char *>(&header), sizeof(header));
+	if (!file.good())
+	{
+		ISX_THROW(isx::ExceptionFileIO, "Failed to read header: ", inFileName);
+	}
+	if (header.m_sessionSize == 0)
+	{
+		return false;
+	}
+
+	std::string sessionMetadataStr(header.m_sessionSize, '\0');
+	file.seekg(header.m_sessionOffset, std::ios_base::beg);
+	file.read(&(sessionMetadataStr[0]), header.m_sessionSize);
+	if (!file.good())
+	{
+		ISX_THROW(isx::ExceptionFileIO, "Failed to read session metadata: ", inFileName);
+	}
+
+	json sessionMetadata;
+	try
+	{
+		sessionMetadata = json::parse(sessionMetadataStr.c_str());
+	}
+	catch (...)
+	{
+		ISX_THROW(isx::ExceptionUserInput, "Failed to parse json session metadata for reading: ", sessionMetadataStr);
+	}
+
+	// Without a timing info key, the timing info is computed from the
+	// per-frame metadata, which is too large to read just for probing.
+	if (sessionMetadata.find("timingInfo") == sessionMetadata.end())
+	{
+		return false;
+	}
+
+	outMetadata.m_timingInfo = convertJsonToTimingInfo(sessionMetadata.at("timingInfo"));
+	sessionMetadata.erase("timingInfo");
+	outMetadata.m_spacingInfo = readSessionSpacingInfo(sessionMetadata);
+	outMetadata.m_dataType = DataType::U8;
+	outMetadata.m_extraProperties = sessionMetadata.dump();
+	return true;
+}
+
 void
 NVisionMovieFile::readMetadata()
 {
@@ -398,6 +494,7 @@ NVisionMovieFile::readMetadata()
 		{
 			m_frameMetadatas[i] = frameMetadata["samples"][i].dump();
 		}
+		m_frameMetadataTable = NVisionFrameMetadataTable::fromJson(frameMetadata["samples"]);
 	}
 	
 	// Construct timing info based on per-frame metadata
@@ -449,36 +546,7 @@ NVisionMovieFile::readMetadata()
 
 	ISX_NVISION_MOVIE_LOG_DEBUG("nVision movie timing info: ", m_timingInfos[0]);
 
-	// Construct spacing info based on session metadata
-	// Check to see if there's a spacing info key that can be read directly,
-	// otherwise construct spacing info based on keys in processing interface of session metadata.
-	if (sessionMetadata.find("spacingInfo") == sessionMetadata.end())
-	{
-		ISX_NVISION_MOVIE_LOG_DEBUG("Constructing spacing info from processing interface key in session metadata");
-		verifyJsonKey(sessionMetadata, "cameraName");
-		verifyJsonKey(sessionMetadata, "processingInterface");
-
-		const std::string cameraName = sessionMetadata["cameraName"];
-		verifyJsonKey(sessionMetadata["processingInterface"], cameraName);
-		verifyJsonKey(sessionMetadata["processingInterface"][cameraName], "recordFov");
-		verifyJsonKey(sessionMetadata["processingInterface"][cameraName]["recordFov"], "width");
-		verifyJsonKey(sessionMetadata["processingInterface"][cameraName]["recordFov"], "height");
-		verifyJsonKey(sessionMetadata["processingInterface"][cameraName]["recordFov"], "originx");
-		verifyJsonKey(sessionMetadata["processingInterface"][cameraName]["recordFov"], "originy");
-
-		json recordFov = sessionMetadata["processingInterface"][cameraName]["recordFov"];
-		m_spacingInfo = SpacingInfo(
-			SizeInPixels_t(recordFov["width"].get<uint64_t>(), recordFov["height"].get<uint64_t>()),
-			SizeInMicrons_t(DEFAULT_PIXEL_SIZE, DEFAULT_PIXEL_SIZE),
-			PointInMicrons_t(recordFov["originx"].get<uint64_t>(), recordFov["originy"].get<uint64_t>())
-		);
-	}
-	else
-	{
-		ISX_NVISION_MOVIE_LOG_DEBUG("Constructing spacing info from spacing info key in session metadata");
-		m_spacingInfo = convertJsonToSpacingInfo(sessionMetadata["spacingInfo"]);
-		sessionMetadata.erase("spacingInfo");
-	}
+	m_spacingInfo = readSessionSpacingInfo(sessionMetadata);
 
 	ISX_NVISION_MOVIE_LOG_DEBUG("nVision movie spacing info: ", m_spacingInfo);
 
@@ -778,6 +846,11 @@ NVisionMovieFile::readFrameTimestamp(const isize_t inFrameNumber)
 	if (hasFrameTimestamps() && ti.isIndexValid(inFrameNumber))
 	{
 		const size_t frameNumber = ti.timeIdxToRecordedIdx(inFrameNumber);
+		if (m_frameMetadataTable.hasTimestamp(frameNumber))
+		{
+			return m_frameMetadataTable.getTimestamps()[frameNumber];
+		}
+
 		const auto frameMetadata = json::parse(m_frameMetadatas[frameNumber]);
 		verifyJsonKey(frameMetadata, "tsc");
 		return frameMetadata.at("tsc").get<uint64_t>();
@@ -786,6 +859,35 @@ NVisionMovieFile::readFrameTimestamp(const isize_t inFrameNumber)
 	return 0;
 }
 
+BoundingBox
+NVisionMovieFile::readBoundingBox(const isize_t inFrameNumber)
+{
+	const TimingInfo & ti = getTimingInfo();
+
+	if (inFrameNumber >= ti.getNumTimes())
+	{
+		ISX_THROW(ExceptionUserInput, "Failed to read frame metadata from file. Index is out of bounds.");
+	}
+
+	if (!ti.isIndexValid(inFrameNumber))
+	{
+		return BoundingBox();
+	}
+
+	const size_t frameNumber = ti.timeIdxToRecordedIdx(inFrameNumber);
+	if (m_frameMetadataTable.hasBoundingBox(frameNumber))
+	{
+		return m_frameMetadataTable.getBoundingBox(frameNumber);
+	}
+	return BoundingBox::fromMetadata(m_frameMetadatas[frameNumber]);
+}
+
+const NVisionFrameMetadataTable &
+NVisionMovieFile::getFrameMetadataTable() const
+{
+	return m_frameMetadataTable;
+}
+
 SpVideoFrame_t
 NVisionMovieFile::decodePacket(size_t inFrameNumber, AVPacket * pPacket)
 {
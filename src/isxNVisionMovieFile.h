@@ -6,6 +6,7 @@
 #include "isxVideoFrame.h"
 #include "isxTimingInfo.h"
 #include "isxSpacingInfo.h"
+#include "isxNVisionFrameMetadata.h"
 #include <fstream>
 
 // ffmpeg forwards
@@ -17,6 +18,8 @@ struct AVFrame;
 namespace isx
 {
 
+struct ProbedMetadata;
+
 /// Object representing the file format of nVision behavioural movies
 /// nVision movies have an .isxb extension
 /// The file format specification is available here: https://inscopix.atlassian.net/l/c/1CaeAXiX
@@ -70,6 +73,20 @@ public:
     ///
     static bool isResolutionSupported(const SpacingInfo & inSpacingInfo);
 
+    /// Read the meta data of a movie file from its header and session metadata only.
+    ///
+    /// Movies whose session metadata has no timing info key derive their
+    /// timing info from the per-frame metadata, so those cannot be probed.
+    ///
+    /// \param  inFileName  The name of the movie file.
+    /// \param  outMetadata The meta data read from the file.
+    /// \return             True if the meta data was read, false if the
+    ///                     movie must be opened to get its meta data.
+    ///
+    /// \throw  isx::ExceptionFileIO    If reading the movie file fails.
+    /// \throw  isx::ExceptionUserInput If parsing the session metadata fails.
+    static bool probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata);
+
     /// \return True if the movie file is valid, false otherwise.
     ///
     bool
@@ -126,6 +143,21 @@ public:
     ///                     or 0 if it does not have one.
     uint64_t readFrameTimestamp(const isize_t inFrameNumber);
 
+    /// Read the tracked bounding box of a frame.
+    ///
+    /// This is the same as BoundingBox::fromMetadata(readFrameMetadata(inFrameNumber)),
+    /// but uses the decoded per-frame metadata table when possible.
+    ///
+    /// \param  inFrameNumber   The index of the frame.
+    /// \return                 The bounding box of the frame.
+    ///
+    /// \throw  isx::ExceptionUserInput    If inFrameNumber is out of range.
+    BoundingBox readBoundingBox(const isize_t inFrameNumber);
+
+    /// \return     The per-frame metadata decoded when the file was read.
+    ///
+    const NVisionFrameMetadataTable & getFrameMetadataTable() const;
+
     /// \return     The name of the file.
     ///
     const
@@ -293,6 +325,9 @@ private:
     // /// Vector of frame metadata extracted from the per-frame metadata section of the file
     std::vector<std::string> m_frameMetadatas;
 
+    /// The frequently queried fields of the per-frame metadata read from the file, decoded once.
+    NVisionFrameMetadataTable m_frameMetadataTable;
+
     /// Index of the previous frame that was read from the file
     size_t m_previousFrameNumber = 0;
 
@@ -162,10 +162,59 @@ NVista3GpioFile::setCheckInCallback(AsyncCheckInCB_t inCheckInCB)
     m_checkInCB = inCheckInCB;
 }
 
+bool
+NVista3GpioFile::fillReadBuffer(const size_t inMinNumBytes)
+{
+    if (m_readBuffer.size() < s_readBufferSize)
+    {
+        m_readBuffer.resize(s_readBufferSize);
+    }
+
+    const size_t numUnreadBytes = m_readBufferSize - m_readBufferPos;
+    if (numUnreadBytes > 0 && m_readBufferPos > 0)
+    {
+        std::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readBufferPos, numUnreadBytes);
+    }
+    m_readBufferOffset += m_readBufferPos;
+    m_readBufferPos = 0;
+    m_readBufferSize = numUnreadBytes;
+
+    if (m_file.good())
+    {
+        m_file.read(m_readBuffer.data() + m_readBufferSize, std::streamsize(m_readBuffer.size() - m_readBufferSize));
+        m_readBufferSize += size_t(m_file.gcount());
+    }
+    return m_readBufferSize >= inMinNumBytes;
+}
+
+void
+NVista3GpioFile::seekRead(const uint64_t inOffset)
+{
+    m_file.clear();
+    m_file.seekg(std::streamoff(inOffset), m_file.beg);
+    m_readBufferOffset = inOffset;
+    m_readBufferPos = 0;
+    m_readBufferSize = 0;
+    m_readFailed = false;
+}
+
+uint64_t
+NVista3GpioFile::tellRead() const
+{
+    return m_readBufferOffset + m_readBufferPos;
+}
+
 void
 NVista3GpioFile::skipBytes(const size_t inNumBytes)
 {
-    m_file.ignore(inNumBytes);
+    if (m_readBufferSize - m_readBufferPos >= inNumBytes)
+    {
+        m_readBufferPos += inNumBytes;
+    }
+    else
+    {
+        seekRead(tellRead() + inNumBytes);
+    }
 }
 
 void
@@ -182,36 +231,67 @@ NVista3GpioFile::addPkt(const Channel inChannel, const uint64_t inTimeStamp, con
     {
         m_lastTimeStamp = inTimeStamp;
     }
-    if (m_indices.find(inChannel) == m_indices.end())
+    const size_t c = size_t(inChannel);
+    if (m_indices[c] == s_noIndex)
     {
-        // This used to be one line, but on Linux the first index was 1 instead of 0.
-        // I guess that is because the LHS is evaluated before the RHS.
-        const size_t numChannels = m_indices.size();
-        m_indices[inChannel] = numChannels;
+        m_indices[c] = m_numIndices++;
     }
     bool valueChanged = true;
-    if (m_lastValues.find(inChannel) != m_lastValues.end())
+    if (m_hasLastValues[c])
     {
         // Right now, there is no way I know to add two NaN values in
         // succession, so this is not strictly needed, but leaving in
         // for clarity and for future-proofing.
         if (isNan)
         {
-            valueChanged = !std::isnan(m_lastValues.at(inChannel));
+            valueChanged = !std::isnan(m_lastValues[c]);
         }
         else
         {
-            valueChanged = m_lastValues.at(inChannel) != inValue;
+            valueChanged = m_lastValues[c] != inValue;
         }
     }
-    m_lastValues[inChannel] = inValue;
+    m_lastValues[c] = inValue;
+    m_hasLastValues[c] = true;
     if (valueChanged)
     {
-        const EventBasedFileV2::DataPkt pkt(inTimeStamp, inValue, m_indices[inChannel]);
-        m_packets.push_back(pkt);
+        writePkt(inTimeStamp, inValue, m_indices[c]);
     }
 }
 
+void
+NVista3GpioFile::writePkt(const uint64_t inTimeStamp, const float inValue, const uint64_t inSignal)
+{
+    if (!m_firstTimeStampSet)
+    {
+        m_firstTimeStamp = inTimeStamp;
+        m_firstTimeStampSet = true;
+    }
+    m_lastPktTimeStamp = inTimeStamp;
+
+    if (inTimeStamp < m_firstTimeStamp)
+    {
+        ISX_LOG_ERROR("Tried to write packet with negative offset. Skipping.");
+        return;
+    }
+
+    m_pendingPackets.emplace_back(inTimeStamp - m_firstTimeStamp, inValue, inSignal);
+    if (m_pendingPackets.size() >= s_maxNumPendingPackets)
+    {
+        flushPkts();
+    }
+}
+
+void
+NVista3GpioFile::flushPkts()
+{
+    if (m_outputFile)
+    {
+        m_outputFile->writeDataPkts(m_pendingPackets);
+    }
+    m_pendingPackets.clear();
+}
+
 void
 NVista3GpioFile::addDigitalGpiPkts(const uint64_t inTsc, uint16_t inDigitalGpi)
 {
@@ -413,48 +493,20 @@ NVista3GpioFile::readParseAddPayload(const PktHeader & inHeader)
 }
 
 AsyncTaskStatus
-NVista3GpioFile::parse()
+NVista3GpioFile::parsePkts(const size_t inEventDataOffset)
 {
-    m_packets.clear();
-    m_indices.clear();
-    m_lastSequence = 0;
-    m_lastSequenceSet = false;
-
-    // All official releases of nVista3 with GPIO data should have a header
-    // that contains the start time.
-    // In order to continue to read files acquired in alpha testing, we
-    // check to see if the first word is a sync packet which indicates that
-    // the header is missing.
-    m_file.seekg(0, m_file.beg);
-    isx::Time startTime;
-    size_t eventDataOffset = 0;
-    size_t sessionDataOffset = 0;
-    if (readAndRewind<uint32_t>() != s_syncWord)
-    {
-        const auto fileHeader = read<AdpDumpHeader>();
-        startTime = Time(DurationInSeconds(fileHeader.secsSinceEpochNum, fileHeader.secsSinceEpochDen), fileHeader.utcOffset);
-        eventDataOffset = size_t(fileHeader.eventDataOffset);
-
-        if (readAndRewind<uint32_t>() != s_syncWord)
-        {
-            const auto fileHeaderExtras = read<AdpDumpHeaderExtras>();
-            m_fileFormat = fileHeaderExtras.fileFormat;
-            ISX_LOG_DEBUG_NV3_GPIO("Found header extras with fileFormat ", m_fileFormat);
-            sessionDataOffset = fileHeaderExtras.sessionDataOffset;
-        }
-    }
-
     // We keep track of progress as an integer to avoid too many updates.
+    m_file.clear();
     m_file.seekg(0, m_file.end);
     const double progressMultiplier = 100.0 / double(m_file.tellg());
 
-    m_file.seekg(eventDataOffset, m_file.beg);
+    seekRead(inEventDataOffset);
     size_t progress = 0;
     size_t syncCount = 0;
-    while (m_file.good())
+    while (!m_readFailed)
     {
         const auto sync = read<uint32_t>();
-        if (!m_file.good())
+        if (m_readFailed)
         {
             break;
         }
@@ -465,10 +517,10 @@ NVista3GpioFile::parse()
         }
         ++syncCount;
 
-        // Only call tellg every 100 sync packets for efficiency reasons.
+        // Only check progress every 100 sync packets for efficiency reasons.
         if ((syncCount % 100) == 0)
         {
-            const size_t newProgress = size_t(progressMultiplier * m_file.tellg());
+            const size_t newProgress = size_t(progressMultiplier * double(tellRead()));
             if (newProgress != progress)
             {
                 progress = newProgress;
@@ -479,10 +531,10 @@ NVista3GpioFile::parse()
             }
         }
 
-        ISX_LOG_DEBUG_NV3_GPIO("Found sync at byte ", m_file.tellg());
+        ISX_LOG_DEBUG_NV3_GPIO("Found sync at byte ", tellRead());
 
         const auto header = read<PktHeader>();
-        if (!m_file.good())
+        if (m_readFailed)
         {
             break;
         }
@@ -494,13 +546,14 @@ NVista3GpioFile::parse()
             continue;
         }
 
+        ++m_numPktsRead;
         try
         {
             readParseAddPayload(header);
         }
         catch (const BadGpioPacket &)
         {
-            ISX_LOG_ERROR("Skipping bad GPIO packet at byte ", m_file.tellg(), " with header (",
+            ISX_LOG_ERROR("Skipping bad GPIO packet at byte ", tellRead(), " with header (",
                     header.type, ", ", header.sequence, ", ", header.payloadSize, ").");
         }
     }
@@ -514,106 +567,190 @@ NVista3GpioFile::parse()
 
     // Add all the last values with the last time stamp.
     // This fixes MOS-1674.
-    for (const auto & p : m_lastValues)
+    for (size_t c = 0; c < s_numChannels; ++c)
     {
-        if (m_indices.find(p.first) != m_indices.end())
+        if (!m_hasLastValues[c])
         {
-            const EventBasedFileV2::DataPkt pkt(m_lastTimeStamp, p.second, m_indices.at(p.first));
-            m_packets.push_back(pkt);
+            continue;
+        }
+
+        if (m_indices[c] != s_noIndex)
+        {
+            writePkt(m_lastTimeStamp, m_lastValues[c], m_indices[c]);
         }
         else
         {
             ISX_ASSERT(false, "Tried to write last value without an index.");
         }
     }
+    flushPkts();
 
-    m_outputFileName = m_outputDir + "/" + isx::getBaseName(m_fileName) + "_gpio.isxd";
+    return AsyncTaskStatus::COMPLETE;
+}
+
+AsyncTaskStatus
+NVista3GpioFile::parse()
+{
+    m_pendingPackets.clear();
+    m_indices.fill(s_noIndex);
+    m_numIndices = 0;
+    m_hasLastValues.fill(false);
+    m_numPktsRead = 0;
+    m_lastSequence = 0;
+    m_lastSequenceSet = false;
+    m_firstTimeStampSet = false;
+    m_firstTimeStamp = 0;
+    m_lastPktTimeStamp = 0;
 
-    const size_t numChannels = m_indices.size();
-    std::vector<std::string> channels(numChannels);
-    std::vector<isx::SignalType> types(numChannels, isx::SignalType::SPARSE);
-    for (auto & index : m_indices)
+    // All official releases of nVista3 with GPIO data should have a header
+    // that contains the start time.
+    // In order to continue to read files acquired in alpha testing, we
+    // check to see if the first word is a sync packet which indicates that
+    // the header is missing.
+    seekRead(0);
+    isx::Time startTime;
+    size_t eventDataOffset = 0;
+    size_t sessionDataOffset = 0;
+    if (readAndRewind<uint32_t>() != s_syncWord)
     {
-        channels.at(index.second) = s_channelNames.at(index.first);
-        types.at(index.second) = s_channelTypes.at(index.first);
+        const auto fileHeader = read<AdpDumpHeader>();
+        startTime = Time(DurationInSeconds(fileHeader.secsSinceEpochNum, fileHeader.secsSinceEpochDen), fileHeader.utcOffset);
+        eventDataOffset = size_t(fileHeader.eventDataOffset);
+
+        if (readAndRewind<uint32_t>() != s_syncWord)
+        {
+            const auto fileHeaderExtras = read<AdpDumpHeaderExtras>();
+            m_fileFormat = fileHeaderExtras.fileFormat;
+            ISX_LOG_DEBUG_NV3_GPIO("Found header extras with fileFormat ", m_fileFormat);
+            sessionDataOffset = fileHeaderExtras.sessionDataOffset;
+        }
     }
 
-    uint64_t firstTime = 0;
-    uint64_t lastTime = 0;
-    if (!m_packets.empty())
+    m_outputFileName = m_outputDir + "/" + isx::getBaseName(m_fileName) + "_gpio.isxd";
+
+    // Packets are written while parsing, but the channels are only known
+    // at the end, so start with all possible channels and replace them
+    // before closing the file.
     {
-        firstTime = m_packets.front().offsetMicroSecs;
-        lastTime = m_packets.back().offsetMicroSecs;
+        std::vector<std::string> allChannels;
+        std::vector<isx::SignalType> allTypes;
+        for (const auto & c : s_channelNames)
+        {
+            allChannels.push_back(c.second);
+            allTypes.push_back(s_channelTypes.at(c.first));
+        }
+        const std::vector<DurationInSeconds> allSteps(allChannels.size(), DurationInSeconds(1, 1000));
+        m_outputFile.reset(new EventBasedFileV2(m_outputFileName, DataSet::Type::GPIO, allChannels, allSteps, allTypes));
     }
 
-    size_t adClockInHz = 1000;
-    std::string extraPropsStr;
-    if (sessionDataOffset > 0)
+    try
     {
-        try
+        if (parsePkts(eventDataOffset) == AsyncTaskStatus::CANCELLED)
         {
-            m_file.clear();
-            m_file.seekg(sessionDataOffset, m_file.beg);
-            json extraProps;
-            m_file >> extraProps;
-
-            // save first tsc value in metadata, which can be used
-            // for synchronization purposes in downstream analysis
-            extraProps["firstTsc"] = firstTime; 
-            
-            extraPropsStr = extraProps.dump();
-            adClockInHz = getAdClockInHz(extraProps);
-
-            // update LED channel names if file is from dual color miniscope
-            json dualColor = extraProps["microscope"]["dualColor"];
-            if (!dualColor.is_null() && dualColor["enabled"].get<bool>())
+            m_outputFile.reset();
+            m_pendingPackets.clear();
+            removeFiles({m_outputFileName});
+            return AsyncTaskStatus::CANCELLED;
+        }
+
+        const size_t numChannels = m_numIndices;
+        std::vector<std::string> channels(numChannels);
+        std::vector<isx::SignalType> types(numChannels, isx::SignalType::SPARSE);
+        for (size_t c = 0; c < s_numChannels; ++c)
+        {
+            if (m_indices[c] != s_noIndex)
             {
-                for (std::string &s : channels)
-                {
-                    if (s == s_channelNames.at(NVista3GpioFile::Channel::EX_LED))
-                    {
-                        s = "EX-LED1";
-                    }
-                    else if (s == s_channelNames.at(NVista3GpioFile::Channel::OG_LED))
-                    {
-                        s = "EX-LED2";
-                    }
-                }
+                channels.at(m_indices[c]) = s_channelNames.at(Channel(c));
+                types.at(m_indices[c]) = s_channelTypes.at(Channel(c));
             }
+        }
 
-            // For closed-loop systems, rename channels GPI-4 - GPI-7 to SoftTrig-1 - SoftTrig-4
-            if (m_fileFormat == GPIO_FILE_FORMAT_CLOSED_LOOP)
+        const uint64_t firstTime = m_firstTimeStamp;
+        const uint64_t lastTime = m_lastPktTimeStamp;
+
+        size_t adClockInHz = 1000;
+        std::string extraPropsStr;
+        if (sessionDataOffset > 0)
+        {
+            try
             {
-                for (std::string &s : channels)
+                m_file.clear();
+                m_file.seekg(sessionDataOffset, m_file.beg);
+                json extraProps;
+                m_file >> extraProps;
+
+                // save first tsc value in metadata, which can be used
+                // for synchronization purposes in downstream analysis
+                extraProps["firstTsc"] = firstTime; 
+                
+                extraPropsStr = extraProps.dump();
+                adClockInHz = getAdClockInHz(extraProps);
+
+                // update LED channel names if file is from dual color miniscope
+                json dualColor = extraProps["microscope"]["dualColor"];
+                if (!dualColor.is_null() && dualColor["enabled"].get<bool>())
                 {
-                    if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_4))
+                    for (std::string &s : channels)
                     {
-                        s = "SoftTrig-1";
+                        if (s == s_channelNames.at(NVista3GpioFile::Channel::EX_LED))
+                        {
+                            s = "EX-LED1";
+                        }
+                        else if (s == s_channelNames.at(NVista3GpioFile::Channel::OG_LED))
+                        {
+                            s = "EX-LED2";
+                        }
                     }
-                    else if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_5))
-                    {
-                        s = "SoftTrig-2";
-                    }
-                    else if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_6))
-                    {
-                        s = "SoftTrig-3";
-                    }
-                    else if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_7))
+                }
+
+                // For closed-loop systems, rename channels GPI-4 - GPI-7 to SoftTrig-1 - SoftTrig-4
+                if (m_fileFormat == GPIO_FILE_FORMAT_CLOSED_LOOP)
+                {
+                    for (std::string &s : channels)
                     {
-                        s = "SoftTrig-4";
+                        if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_4))
+                        {
+                            s = "SoftTrig-1";
+                        }
+                        else if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_5))
+                        {
+                            s = "SoftTrig-2";
+                        }
+                        else if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_6))
+                        {
+                            s = "SoftTrig-3";
+                        }
+                        else if (s == s_channelNames.at(NVista3GpioFile::Channel::DIGITAL_GPI_7))
+                        {
+                            s = "SoftTrig-4";
+                        }
                     }
                 }
             }
+            catch (const std::exception & inError)
+            {
+                ISX_LOG_WARNING("Failed to read extra properties from nVista 3 GPIO file with error: ", inError.what());
+            }
         }
-        catch (const std::exception & inError)
+        const DurationInSeconds period(1, adClockInHz);
+
+        m_outputFile->setChannels(channels, std::vector<DurationInSeconds>(numChannels, period), types);
+        if (!extraPropsStr.empty())
         {
-            ISX_LOG_WARNING("Failed to read extra properties from nVista 3 GPIO file with error: ", inError.what());
+            m_outputFile->setExtraProperties(extraPropsStr);
         }
+        const TimingInfo timing = makeGpioTimingInfo(startTime, period, firstTime, lastTime);
+        m_outputFile->setTimingInfo(timing.getStart(), timing.getEnd());
+        m_outputFile->closeFileForWriting();
+        m_outputFile.reset();
+    }
+    catch (...)
+    {
+        m_outputFile.reset();
+        m_pendingPackets.clear();
+        removeFiles({m_outputFileName});
+        throw;
     }
-    const DurationInSeconds period(1, adClockInHz);
-
-    writePktsToEventBasedFile(m_outputFileName, m_packets, channels, types,
-            startTime, period, firstTime, lastTime, extraPropsStr);
 
     return isx::AsyncTaskStatus::COMPLETE;
 }
@@ -624,4 +761,10 @@ NVista3GpioFile::getOutputFileName() const
     return m_outputFileName;
 }
 
+uint64_t
+NVista3GpioFile::getNumPktsRead() const
+{
+    return m_numPktsRead;
+}
+
 } // namespace isx
@@ -5,6 +5,8 @@
 #include "isxAsync.h"
 #include "isxTimingInfo.h"
 #include "isxEventBasedFileV2.h"
+#include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <fstream>
@@ -195,6 +197,10 @@ public:
     /// Get a list of all the output files this object produces when parsing the original one
     const std::string & getOutputFileName() const;
 
+    /// \return the number of event packets read by the last call to parse
+    ///
+    uint64_t getNumPktsRead() const;
+
 private:
 
     /// Possible channels to write.
@@ -229,6 +235,15 @@ private:
         BNC_SYNC,
     };
 
+    /// The number of possible channels.
+    const static size_t s_numChannels = size_t(Channel::BNC_SYNC) + 1;
+
+    /// The index of a channel that has not been written yet.
+    const static uint64_t s_noIndex = ~uint64_t(0);
+
+    /// The size of the blocks read from the file.
+    const static size_t s_readBufferSize = 1 << 22;
+
     const static std::map<Channel, std::string> s_channelNames;
 
     const static std::map<Channel, SignalType> s_channelTypes;
@@ -257,15 +272,56 @@ private:
     /// Check in callback for reporting progress
     AsyncCheckInCB_t m_checkInCB;
 
-    /// The packets captured so far.
-    std::vector<EventBasedFileV2::DataPkt> m_packets;
+    /// The maximum number of packets to keep in memory before writing them.
+    const static size_t s_maxNumPendingPackets = 1 << 16;
+
+    /// The output file, which is only open while parsing.
+    std::unique_ptr<EventBasedFileV2> m_outputFile;
+
+    /// The packets that have not been written to the output file yet.
+    std::vector<EventBasedFileV2::DataPkt> m_pendingPackets;
+
+    /// True if a packet has been captured, false otherwise.
+    bool m_firstTimeStampSet = false;
+
+    /// The time stamp of the first packet captured. The offsets of
+    /// all packets written to the output file are relative to this.
+    uint64_t m_firstTimeStamp = 0;
+
+    /// The time stamp of the last packet captured.
+    uint64_t m_lastPktTimeStamp = 0;
 
-    /// The channel indices to provide to the output file.
-    std::map<Channel, uint64_t> m_indices;
+    /// The channel indices to provide to the output file, indexed by channel,
+    /// or s_noIndex for channels that have not been written yet.
+    std::array<uint64_t, s_numChannels> m_indices;
+
+    /// The number of channels that have been written.
+    size_t m_numIndices = 0;
 
     /// The last values of each channel are stored so that
     /// we only captured changes in value.
-    std::map<Channel, float> m_lastValues;
+    std::array<float, s_numChannels> m_lastValues;
+
+    /// True for each channel that has a last value, false otherwise.
+    std::array<bool, s_numChannels> m_hasLastValues;
+
+    /// A block of the file being parsed.
+    std::vector<char> m_readBuffer;
+
+    /// The position of the next byte to read in the block.
+    size_t m_readBufferPos = 0;
+
+    /// The number of bytes in the block.
+    size_t m_readBufferSize = 0;
+
+    /// The offset of the block in the file.
+    uint64_t m_readBufferOffset = 0;
+
+    /// True if a read went past the end of the file, false otherwise.
+    bool m_readFailed = false;
+
+    /// The number of event packets read.
+    uint64_t m_numPktsRead = 0;
 
     /// The last sequence number read.
     uint32_t m_lastSequence = 0;
@@ -277,12 +333,36 @@ private:
     /// to associated with dropped packets.
     uint64_t m_lastTimeStamp = 0;
 
+    /// Read bytes from the file through the block buffer.
+    ///
+    /// If there are not enough bytes left in the file, this sets m_readFailed.
+    void readBytes(char * outBytes, const size_t inNumBytes)
+    {
+        if (m_readBufferSize - m_readBufferPos < inNumBytes && !fillReadBuffer(inNumBytes))
+        {
+            m_readFailed = true;
+            return;
+        }
+        std::memcpy(outBytes, m_readBuffer.data() + m_readBufferPos, inNumBytes);
+        m_readBufferPos += inNumBytes;
+    }
+
+    /// Read more of the file into the block buffer, keeping any unread bytes.
+    /// \return true if there are at least the given number of unread bytes.
+    bool fillReadBuffer(const size_t inMinNumBytes);
+
+    /// Move to a position in the file, discarding the block buffer.
+    void seekRead(const uint64_t inOffset);
+
+    /// \return the position in the file of the next byte to read.
+    uint64_t tellRead() const;
+
     /// Read a value of arbitrary size from the file.
     template <typename T>
     T read()
     {
-        T output;
-        m_file.read(reinterpret_cast<char *>(&output), sizeof(output));
+        T output = T();
+        readBytes(reinterpret_cast<char *>(&output), sizeof(output));
         return output;
     }
 
@@ -297,16 +377,28 @@ private:
             ISX_THROW(BadGpioPacket, "Expected to read ", expectedSize, " bytes, ",
                     "but actual payload is ", actualSize, " bytes.");
         }
-        return read<T>();
+        const T output = read<T>();
+        if (m_readFailed)
+        {
+            ISX_THROW(BadGpioPacket, "Reached the end of the file while reading a ", expectedSize, " byte payload.");
+        }
+        return output;
     }
 
     /// Read a valuue from the file, and rewind to the position before the read.
     template <typename T>
     T readAndRewind()
     {
-        auto pos = m_file.tellg();
+        const uint64_t pos = tellRead();
         const T value = read<T>();
-        m_file.seekg(pos);
+        if (m_readFailed)
+        {
+            seekRead(pos);
+        }
+        else
+        {
+            m_readBufferPos -= sizeof(T);
+        }
         return value;
     }
 
@@ -316,6 +408,17 @@ private:
     /// Add a packet to the output file.
     void addPkt(const Channel inChannel, const uint64_t inTimeStamp, const float inValue);
 
+    /// Queue a packet to be written to the output file, writing all queued
+    /// packets if there are too many.
+    void writePkt(const uint64_t inTimeStamp, const float inValue, const uint64_t inSignal);
+
+    /// Write all queued packets to the output file.
+    void flushPkts();
+
+    /// Parse all packets in the file, writing them to the output file.
+    /// \return whether the process completed or it was cancelled
+    AsyncTaskStatus parsePkts(const size_t inEventDataOffset);
+
     /// Add digital GPI and GPO packets based on the packed payload value to the output file.
     void addDigitalGpiPkts(const uint64_t inTsc, const uint16_t inDigitalGpi);
     void addDigitalGpoPkts(const uint64_t inTsc, const uint16_t inDigitalGpo);
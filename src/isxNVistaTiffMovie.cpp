@@ -48,6 +48,8 @@ NVistaTiffMovie::NVistaTiffMovie(
         std::unique_ptr<TiffMovie> p;
         if (useNumFrames)
         {
+            // The file is only opened when it is first read,
+            // so it is also checked against the first file then.
             p.reset(new TiffMovie(inTiffFileNames[f], inNumFrames[f]));
         }
         else
@@ -56,28 +58,17 @@ NVistaTiffMovie::NVistaTiffMovie(
         }
         m_movies.push_back(std::move(p));
 
-        if (f > 1)
+        if (!useNumFrames && f > 0)
         {
-            if (m_movies[0]->getFrameWidth() != m_movies[f]->getFrameWidth()
-                || m_movies[0]->getFrameHeight() != m_movies[f]->getFrameHeight())
-            {
-                ISX_THROW(isx::ExceptionUserInput, "All input files must have the same dimensions.");
-            }
-            if (m_movies[0]->getDataType() != m_movies[f]->getDataType())
-            {
-                ISX_THROW(isx::ExceptionUserInput, "All input files must have the same data type.");
-            }
-        }
-
-        if (!m_movies.empty())
-        {
-            m_dataType = m_movies[0]->getDataType();
+            checkMovieFormat(f);
         }
 
         numFramesAccum += m_movies[f]->getNumFrames();
         m_cumulativeFrames.push_back(numFramesAccum);
     }
 
+    m_dataType = m_movies[0]->getDataType();
+
     if (inTimingInfo.getNumTimes() != 0)
     {
         // Timing info comes from XML
@@ -250,6 +241,7 @@ NVistaTiffMovie::getFrameInternal(isize_t inFrameNumber)
     if (idx > 0)
     {
         newFrameNumber = newFrameNumber - m_cumulativeFrames[idx - 1];
+        checkMovieFormat(idx);
     }
 
     m_movies[idx]->getFrame(newFrameNumber, outFrame);
@@ -257,6 +249,20 @@ NVistaTiffMovie::getFrameInternal(isize_t inFrameNumber)
     return outFrame;
 }
 
+void
+NVistaTiffMovie::checkMovieFormat(isize_t inMovieIndex)
+{
+    const std::unique_ptr<TiffMovie> & movie = m_movies[inMovieIndex];
+    if (m_movies[0]->getFrameWidth() != movie->getFrameWidth()
+        || m_movies[0]->getFrameHeight() != movie->getFrameHeight())
+    {
+        ISX_THROW(isx::ExceptionUserInput, "All input files must have the same dimensions.");
+    }
+    if (m_movies[0]->getDataType() != movie->getDataType())
+    {
+        ISX_THROW(isx::ExceptionUserInput, "All input files must have the same data type.");
+    }
+}
 
 isize_t
 NVistaTiffMovie::getMovieIndex(isize_t inFrameNumber)
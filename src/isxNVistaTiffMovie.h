@@ -98,7 +98,8 @@ private:
     /// The spacing information of the movie.
     SpacingInfo m_spacingInfo;
 
-    /// The vector of pointers to TIFF files.
+    /// The vector of pointers to TIFF files, whose handles are opened
+    /// lazily and bounded by the file handle pool.
     std::vector<std::unique_ptr<TiffMovie>> m_movies;
 
     /// The vector of cumulative frame indices.
@@ -123,6 +124,12 @@ private:
     SpVideoFrame_t
     getFrameInternal(isize_t inFrameNumber);
 
+    /// Check that a TIFF file has the same dimensions and data type as the first one.
+    ///
+    /// \param  inMovieIndex    The index of the TIFF file.
+    /// \throw  isx::ExceptionUserInput If the TIFF file does not match the first one.
+    void checkMovieFormat(isize_t inMovieIndex);
+
     /// \return The movie file index associated with a frame number.
     ///
     isize_t getMovieIndex(isize_t inFrameNumber);
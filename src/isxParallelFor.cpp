@@ -0,0 +1,141 @@
+#include "isxParallelFor.h"
+#include "isxDispatchQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace isx
+{
+
+namespace
+{
+
+/// The state of one call of parallelFor that is shared with the pool threads.
+///
+/// Pool threads may only start running after the caller has taken all the
+/// indices, so they only run tasks while the caller has not closed the call.
+struct ParallelForState
+{
+    ParallelForState(const isize_t inNumTasks, const std::function<void(const isize_t)> & inTask)
+        : m_numTasks(inNumTasks)
+        , m_task(&inTask)
+        , m_failedIndex(inNumTasks)
+    {
+    }
+
+    /// Take and run indices until there are none left or a task failed.
+    void
+    runTasks()
+    {
+        while (!m_failed)
+        {
+            const isize_t i = m_nextIndex++;
+            if (i >= m_numTasks)
+            {
+                break;
+            }
+            try
+            {
+                (*m_task)(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (i < m_failedIndex)
+                {
+                    m_failedIndex = i;
+                    m_error = std::current_exception();
+                }
+                m_failed = true;
+            }
+        }
+    }
+
+    /// Run tasks on a pool thread if the call is not closed yet.
+    void
+    runTasksOnPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_closed)
+            {
+                return;
+            }
+            ++m_numActive;
+        }
+
+        runTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_numActive;
+        }
+        m_condition.notify_one();
+    }
+
+    /// Stop pool threads from joining and wait for the ones that did.
+    void
+    close()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_condition.wait(lock, [this]() { return m_numActive == 0; });
+    }
+
+    const isize_t m_numTasks;
+    const std::function<void(const isize_t)> * m_task;
+    std::atomic<isize_t> m_nextIndex{0};
+    std::atomic<bool> m_failed{false};
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    isize_t m_numActive = 0;
+    bool m_closed = false;
+    isize_t m_failedIndex;
+    std::exception_ptr m_error;
+};
+
+} // namespace
+
+void
+parallelFor(
+    const isize_t inNumTasks,
+    const std::function<void(const isize_t)> & inTask,
+    const isize_t inMaxNumThreads)
+{
+    const isize_t maxNumThreads = (inMaxNumThreads > 0)
+        ? inMaxNumThreads : std::max(isize_t(1), isize_t(std::thread::hardware_concurrency()));
+    const isize_t numThreads = std::min(maxNumThreads, inNumTasks);
+    SpDispatchQueueInterface_t pool = DispatchQueue::isInitialized() ? DispatchQueue::poolQueue() : nullptr;
+    if (numThreads <= 1 || !pool)
+    {
+        for (isize_t i = 0; i < inNumTasks; ++i)
+        {
+            inTask(i);
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(inNumTasks, inTask);
+    for (isize_t t = 1; t < numThreads; ++t)
+    {
+        pool->dispatch([state]()
+        {
+            state->runTasksOnPool();
+        });
+    }
+    state->runTasks();
+    state->close();
+
+    if (state->m_error)
+    {
+        std::rethrow_exception(state->m_error);
+    }
+}
+
+} // namespace isx
@@ -0,0 +1,35 @@
+#ifndef ISX_PARALLEL_FOR_H
+#define ISX_PARALLEL_FOR_H
+
+#include "isxCore.h"
+
+#include <functional>
+
+namespace isx
+{
+
+/// Run a task for each index in [0, inNumTasks) on up to a maximum number of
+/// threads, including this one.
+///
+/// The other threads are taken from the thread pool dispatch queue, so no
+/// threads are created per call. If the dispatch queues are not initialized,
+/// all the tasks are run on this thread.
+///
+/// Indices are taken in order and every index that is taken is run, so
+/// after a task throws no new indices are taken and the error of the
+/// lowest failed index is rethrown once all the taken ones are finished.
+/// That is the error that running the tasks one after another would throw.
+///
+/// \param  inNumTasks      The number of tasks.
+/// \param  inTask          The task to run with each index.
+/// \param  inMaxNumThreads The maximum number of threads. If 0, this is the
+///                         number of hardware threads.
+void
+parallelFor(
+    const isize_t inNumTasks,
+    const std::function<void(const isize_t)> & inTask,
+    const isize_t inMaxNumThreads = 0);
+
+} // namespace isx
+
+#endif // def ISX_PARALLEL_FOR_H
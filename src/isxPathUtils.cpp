@@ -3,6 +3,7 @@
 #include <iostream>
 #include <sstream>
 #include <QFileInfo>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QStringList>
@@ -97,6 +98,19 @@ pathExists(const std::string & inPath)
     return pathInfo.exists();
 }
 
+bool
+getFileStamp(const std::string & inPath, int64_t & outSizeInBytes, int64_t & outModifiedMs)
+{
+    QFileInfo pathInfo(QString::fromStdString(inPath));
+    if (!pathInfo.exists() || !pathInfo.isFile())
+    {
+        return false;
+    }
+    outSizeInBytes = int64_t(pathInfo.size());
+    outModifiedMs = int64_t(pathInfo.lastModified().toMSecsSinceEpoch());
+    return true;
+}
+
 std::vector<std::string>
 getAllDirFiles(const std::string & inPath)
 {
@@ -0,0 +1,199 @@
+#include "isxPixelStatistics.h"
+#include "isxException.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace isx
+{
+
+PixelStatistics::PixelStatistics()
+    : m_min(std::numeric_limits<float>::max())
+    , m_max(std::numeric_limits<float>::lowest())
+{
+}
+
+PixelStatistics::PixelStatistics(const float inHistogramMin, const float inHistogramMax, const isize_t inNumBins)
+    : m_min(std::numeric_limits<float>::max())
+    , m_max(std::numeric_limits<float>::lowest())
+    , m_histogramMin(inHistogramMin)
+    , m_histogramMax(inHistogramMax)
+    , m_histogram(inNumBins, 0)
+{
+    if (inNumBins > 0 && !(inHistogramMin < inHistogramMax))
+    {
+        ISX_THROW(ExceptionUserInput, "Invalid histogram range: [", inHistogramMin, ", ", inHistogramMax, "].");
+    }
+}
+
+PixelStatistics
+PixelStatistics::makeForDataType(const DataType inDataType, const isize_t inNumBins)
+{
+    switch (inDataType)
+    {
+        case DataType::U8:
+        case DataType::RGB888:
+            return PixelStatistics(0.f, float(std::numeric_limits<uint8_t>::max()) + 1.f, inNumBins);
+        case DataType::U16:
+            return PixelStatistics(0.f, float(std::numeric_limits<uint16_t>::max()) + 1.f, inNumBins);
+        default:
+            return PixelStatistics();
+    }
+}
+
+namespace
+{
+
+template <typename T>
+bool
+isFinite(const T inValue)
+{
+    return std::isfinite(inValue);
+}
+
+template <>
+bool
+isFinite(const uint8_t)
+{
+    return true;
+}
+
+template <>
+bool
+isFinite(const uint16_t)
+{
+    return true;
+}
+
+} // namespace
+
+template <typename T>
+void
+PixelStatistics::accumulateInternal(const T * inPixels, const isize_t inNumPixels)
+{
+    T minVal = std::numeric_limits<T>::max();
+    T maxVal = std::numeric_limits<T>::lowest();
+    double sum = 0.0;
+    isize_t numNonFinite = 0;
+
+    const isize_t numBins = m_histogram.size();
+    const double binScale = (numBins > 0) ? double(numBins) / (double(m_histogramMax) - double(m_histogramMin)) : 0.0;
+    const int64_t lastBin = int64_t(numBins) - 1;
+
+    for (isize_t i = 0; i < inNumPixels; ++i)
+    {
+        const T v = inPixels[i];
+        if (!isFinite(v))
+        {
+            ++numNonFinite;
+            continue;
+        }
+        minVal = std::min(minVal, v);
+        maxVal = std::max(maxVal, v);
+        sum += double(v);
+        if (numBins > 0)
+        {
+            const int64_t bin = int64_t((double(v) - double(m_histogramMin)) * binScale);
+            m_histogram[size_t(std::max(int64_t(0), std::min(bin, lastBin)))] += 1;
+        }
+    }
+
+    if (numNonFinite < inNumPixels)
+    {
+        m_min = std::min(m_min, float(minVal));
+        m_max = std::max(m_max, float(maxVal));
+    }
+    m_sum += sum;
+    m_numPixels += inNumPixels - numNonFinite;
+    m_numNonFinitePixels += numNonFinite;
+}
+
+void
+PixelStatistics::accumulate(const uint8_t * inPixels, const isize_t inNumPixels)
+{
+    accumulateInternal<uint8_t>(inPixels, inNumPixels);
+}
+
+void
+PixelStatistics::accumulate(const uint16_t * inPixels, const isize_t inNumPixels)
+{
+    accumulateInternal<uint16_t>(inPixels, inNumPixels);
+}
+
+void
+PixelStatistics::accumulate(const float * inPixels, const isize_t inNumPixels)
+{
+    accumulateInternal<float>(inPixels, inNumPixels);
+}
+
+void
+PixelStatistics::accumulate(const char * inPixels, const DataType inDataType, const isize_t inNumValues)
+{
+    switch (inDataType)
+    {
+        case DataType::U8:
+        case DataType::RGB888:
+            accumulate(reinterpret_cast<const uint8_t *>(inPixels), inNumValues);
+            break;
+        case DataType::U16:
+            accumulate(reinterpret_cast<const uint16_t *>(inPixels), inNumValues);
+            break;
+        case DataType::F32:
+            accumulate(reinterpret_cast<const float *>(inPixels), inNumValues);
+            break;
+        default:
+            ISX_THROW(ExceptionDataIO, "Unsupported data type for pixel statistics: ", int(inDataType));
+    }
+}
+
+void
+PixelStatistics::merge(const PixelStatistics & inOther)
+{
+    if (m_histogram.size() != inOther.m_histogram.size()
+        || (!m_histogram.empty() && (m_histogramMin != inOther.m_histogramMin || m_histogramMax != inOther.m_histogramMax)))
+    {
+        ISX_THROW(ExceptionUserInput, "Cannot merge pixel statistics with different histogram binning.");
+    }
+
+    m_min = std::min(m_min, inOther.m_min);
+    m_max = std::max(m_max, inOther.m_max);
+    m_sum += inOther.m_sum;
+    m_numPixels += inOther.m_numPixels;
+    m_numNonFinitePixels += inOther.m_numNonFinitePixels;
+    for (size_t b = 0; b < m_histogram.size(); ++b)
+    {
+        m_histogram[b] += inOther.m_histogram[b];
+    }
+}
+
+bool
+PixelStatistics::isValid() const
+{
+    return m_numPixels > 0;
+}
+
+double
+PixelStatistics::getMean() const
+{
+    if (m_numPixels == 0)
+    {
+        return 0.0;
+    }
+    return m_sum / double(m_numPixels);
+}
+
+bool
+PixelStatistics::operator ==(const PixelStatistics & inOther) const
+{
+    return (m_min == inOther.m_min)
+        && (m_max == inOther.m_max)
+        && (m_sum == inOther.m_sum)
+        && (m_numPixels == inOther.m_numPixels)
+        && (m_numNonFinitePixels == inOther.m_numNonFinitePixels)
+        && (m_histogramMin == inOther.m_histogramMin)
+        && (m_histogramMax == inOther.m_histogramMax)
+        && (m_histogram == inOther.m_histogram);
+}
+
+} // namespace isx
@@ -1,4 +1,5 @@
 #include "isxProject.h"
+#include "isxCoalescingJsonWriter.h"
 #include "isxException.h"
 #include "isxJsonUtils.h"
 #include "isxPathUtils.h"
@@ -54,6 +55,9 @@ Project::Project(const std::string & inFileName, const std::string & inName)
 
 Project::~Project()
 {
+    // Write the pending temporary project before checking whether it exists.
+    m_tmpWriter.reset();
+
     // Remove the project directory if empty
     std::string dataPath = getDataPath();
     QDir dataDir(QString::fromStdString(dataPath));
@@ -146,8 +150,20 @@ Project::saveTmp()
 {
     if (m_valid)
     {
-        std::string tmp = getTmpFileName();
-        write(tmp);
+        if (!m_tmpWriter)
+        {
+            m_tmpWriter.reset(new CoalescingJsonWriter());
+        }
+        m_tmpWriter->write(getTmpFileName(), toJson());
+    }
+}
+
+void
+Project::flushTmp()
+{
+    if (m_tmpWriter)
+    {
+        m_tmpWriter->flush();
     }
 }
 
@@ -328,6 +344,9 @@ Project::setFileName(const std::string & inFileName, bool inFromTemporary)
     // 6) If coming from temp project, delete old dataDir, old temp project file and old projDir.
     // 7) Adjust stored absolute paths in datasets of current project
     
+    // The temporary project may be removed below, so it must not be written afterwards.
+    flushTmp();
+
     std::string oldPath = getDataPath();
     std::string prevTmpFileName = getTmpFileName();
     std::string prevName = m_fileName;
@@ -442,6 +461,11 @@ Project::isModified() const
 void 
 Project::discard()
 {
+    if (m_tmpWriter)
+    {
+        m_tmpWriter->cancel();
+    }
+
     std::string projPath = isx::getDirName(m_fileName);
     QDir dir(QString::fromStdString(projPath));
     if(!dir.removeRecursively())
@@ -524,7 +548,7 @@ Project::read()
     try
     {
         m_name = jsonObject["name"];
-        m_root = Group::fromJsonString(jsonObject["rootGroup"].dump(), getProjectPath());
+        m_root = Group::fromJson(jsonObject.at("rootGroup"), getProjectPath());
         m_root->setSaveTempProjectCallback([this] () { saveTmp(); });
     }
     catch (const std::exception & error)
@@ -539,12 +563,21 @@ Project::read()
 
 void
 Project::write(const std::string & inFilename) const
+{
+    const json jsonObject = toJson();
+    std::ofstream file(inFilename, std::ios::trunc);
+    file.seekp(std::ios_base::beg);
+    writeJson(jsonObject, file);
+}
+
+json
+Project::toJson() const
 {
     json jsonObject;
     try
     {
         jsonObject["name"] = m_name;
-        jsonObject["rootGroup"] = json::parse(m_root->toJsonString(false, getProjectPath()));
+        jsonObject["rootGroup"] = m_root->toJson(getProjectPath());
         jsonObject["producer"] = getProducerAsJson();
         jsonObject["fileVersion"] = s_version;
     }
@@ -556,10 +589,7 @@ Project::write(const std::string & inFilename) const
     {
         ISX_THROW(ExceptionDataIO, "Unknown error while generating project header.");
     }
-
-    std::ofstream file(inFilename, std::ios::trunc);
-    file.seekp(std::ios_base::beg);
-    writeJson(jsonObject, file);
+    return jsonObject;
 }
 
 std::string 
@@ -0,0 +1,65 @@
+#include "isxRelativeSampleTimes.h"
+
+#include <limits>
+
+namespace
+{
+
+isx::Ratio::intBig_t
+getGreatestCommonDivisor(isx::Ratio::intBig_t inA, isx::Ratio::intBig_t inB)
+{
+    while (inB != 0)
+    {
+        const isx::Ratio::intBig_t rem = inA % inB;
+        inA = inB;
+        inB = rem;
+    }
+    return (inA < 0) ? isx::Ratio::intBig_t(-inA) : inA;
+}
+
+bool
+isExactInDouble(const isx::Ratio::intBig_t & inValue)
+{
+    const isx::Ratio::intBig_t limit = isx::Ratio::intBig_t(1) << std::numeric_limits<double>::digits;
+    return (inValue < limit) && (inValue > -limit);
+}
+
+} // namespace
+
+namespace isx
+{
+
+RelativeSampleTimes::RelativeSampleTimes(const TimingInfo & inTimingInfo, const Time & inBaseTime)
+    : m_timingInfo(inTimingInfo)
+    , m_baseTime(inBaseTime)
+    , m_numTimes(inTimingInfo.getNumTimes())
+{
+    if (m_numTimes < 2)
+    {
+        return;
+    }
+
+    const Ratio first = inTimingInfo.convertIndexToStartTime(0) - inBaseTime;
+    const Ratio step = inTimingInfo.getStep();
+    const Ratio::intBig_t den = (first.getDen() / getGreatestCommonDivisor(first.getDen(), step.getDen())) * step.getDen();
+    const Ratio::intBig_t firstNum = first.getNum() * (den / first.getDen());
+    const Ratio::intBig_t stepNum = step.getNum() * (den / step.getDen());
+    const Ratio::intBig_t lastNum = firstNum + stepNum * Ratio::intBig_t(m_numTimes - 1);
+    if (!isExactInDouble(den) || !isExactInDouble(firstNum) || !isExactInDouble(lastNum))
+    {
+        return;
+    }
+
+    m_firstNum = int64_t(firstNum);
+    m_stepNum = int64_t(stepNum);
+    m_den = double(int64_t(den));
+    m_useIntegers = true;
+}
+
+double
+RelativeSampleTimes::getWithRatio(const isize_t inIndex) const
+{
+    return (m_timingInfo.convertIndexToStartTime(inIndex) - m_baseTime).toDouble();
+}
+
+} // namespace isx
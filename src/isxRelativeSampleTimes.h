@@ -0,0 +1,56 @@
+#ifndef ISX_RELATIVE_SAMPLE_TIMES_H
+#define ISX_RELATIVE_SAMPLE_TIMES_H
+
+#include "isxTimingInfo.h"
+#include "isxTime.h"
+
+namespace isx
+{
+
+/// Computes the time of each sample of a timing info relative to a base time.
+///
+/// This gives exactly (ti.convertIndexToStartTime(s) - inBaseTime).toDouble(),
+/// but uses integer arithmetic instead of Ratio arithmetic for each sample.
+/// All sample times are expressed over a common denominator, which gives the
+/// same double as long as the numerators and denominator are exact in a double.
+/// Otherwise this falls back to Ratio arithmetic.
+///
+/// The timing info and base time must outlive this object.
+class RelativeSampleTimes
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param  inTimingInfo    The timing info of the samples.
+    /// \param  inBaseTime      The time to which sample times are relative.
+    RelativeSampleTimes(const TimingInfo & inTimingInfo, const Time & inBaseTime);
+
+    /// \param  inIndex     The index of a sample.
+    /// \return             The start time of the sample relative to the base time in seconds.
+    double
+    get(const isize_t inIndex) const
+    {
+        if (m_useIntegers && inIndex < m_numTimes)
+        {
+            return double(m_firstNum + int64_t(inIndex) * m_stepNum) / m_den;
+        }
+        return getWithRatio(inIndex);
+    }
+
+private:
+
+    double getWithRatio(const isize_t inIndex) const;
+
+    const TimingInfo & m_timingInfo;
+    const Time & m_baseTime;
+    isize_t m_numTimes = 0;
+    bool m_useIntegers = false;
+    int64_t m_firstNum = 0;
+    int64_t m_stepNum = 0;
+    double m_den = 1.0;
+};
+
+} // namespace isx
+
+#endif // ISX_RELATIVE_SAMPLE_TIMES_H
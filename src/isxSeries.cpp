@@ -850,76 +850,88 @@ Series::getUniqueIdentifier() const
 
 std::string
 Series::toJsonString(const bool inPretty, const std::string & inPathToOmit) const
+{
+    if (inPretty)
+    {
+        return toJson(inPathToOmit).dump(4);
+    }
+    return toJson(inPathToOmit).dump();
+}
+
+json
+Series::toJson(const std::string & inPathToOmit) const
 {
     json jsonObj;
     jsonObj["itemType"] = size_t(getItemType());
     jsonObj["name"] = m_name;
-    jsonObj["dataSets"] = json::array();
+    json dataSets = json::array();
     jsonObj["isUnitary"] = isUnitary();
     if (isUnitary())
     {
-        jsonObj["dataSets"].push_back(json::parse(m_dataSet->toJsonString(inPretty, inPathToOmit)));
+        dataSets.push_back(m_dataSet->toJson(inPathToOmit));
     }
     else
     {
         for (const auto & dataSet : getDataSets())
         {
-            jsonObj["dataSets"].push_back(json::parse(dataSet->toJsonString(inPretty, inPathToOmit)));
+            dataSets.push_back(dataSet->toJson(inPathToOmit));
         }
     }
+    jsonObj["dataSets"] = std::move(dataSets);
 
-    jsonObj["children"] = json::array();
+    json children = json::array();
     for (const auto & c : m_children)
     {
-        jsonObj["children"].push_back(json::parse(c->toJsonString(inPretty, inPathToOmit)));
-    }
-
-    if (inPretty)
-    {
-        return jsonObj.dump(4);
+        children.push_back(c->toJson(inPathToOmit));
     }
-    return jsonObj.dump();
+    jsonObj["children"] = std::move(children);
+    return jsonObj;
 }
 
 SpSeries_t
 Series::fromJsonString(const std::string & inString, const std::string & inAbsolutePathToPrepend)
+{
+    return fromJson(json::parse(inString), inAbsolutePathToPrepend);
+}
+
+SpSeries_t
+Series::fromJson(const json & inJson, const std::string & inAbsolutePathToPrepend)
 {
     SpSeries_t ret;
-    if (inString == json::object().dump())
+    if (inJson.is_object() && inJson.empty())
     {
         return SpSeries_t();
     }
 
-    const json jsonObj = json::parse(inString);
-    const ProjectItem::Type itemType = ProjectItem::Type(size_t(jsonObj.at("itemType")));
+    const ProjectItem::Type itemType = ProjectItem::Type(size_t(inJson.at("itemType")));
     ISX_ASSERT(itemType == ProjectItem::Type::SERIES);
-    const std::string name = jsonObj.at("name");
-    bool isSeriesUnitary = jsonObj.at("isUnitary");
+    const std::string name = inJson.at("name");
+    bool isSeriesUnitary = inJson.at("isUnitary");
     if (isSeriesUnitary)
     {
-        auto jds = jsonObj.at("dataSets")[0];
-        auto dataSet = DataSet::fromJsonString(jds.dump(), inAbsolutePathToPrepend);
+        const json & jds = inJson.at("dataSets")[0];
+        auto dataSet = DataSet::fromJson(jds, inAbsolutePathToPrepend);
         ret = std::make_shared<Series>(dataSet);
         ret->setName(name);
     }
     else
     {
         ret = std::make_shared<Series>(name);
-        for (const auto & jsonDataSet : jsonObj.at("dataSets"))
+        for (const auto & jsonDataSet : inJson.at("dataSets"))
         {
-            SpDataSet_t dataSet = DataSet::fromJsonString(jsonDataSet.dump(), inAbsolutePathToPrepend);
+            SpDataSet_t dataSet = DataSet::fromJson(jsonDataSet, inAbsolutePathToPrepend);
             auto tmpUnitarySeries = std::make_shared<Series>(dataSet);
             // We skip the compatibility check for performance reasons and trust
             // the serialized version is good.
             ret->insertUnitarySeries(tmpUnitarySeries, false);
         }
     }
-    if (jsonObj.find("children") != jsonObj.end())
+    if (inJson.find("children") != inJson.end())
     {
-        auto children = jsonObj.find("children");
+        auto children = inJson.find("children");
         for (const auto & c : *children)
         {
-            ret->addChild(Series::fromJsonString(c.dump(), inAbsolutePathToPrepend));
+            ret->addChild(Series::fromJson(c, inAbsolutePathToPrepend));
         }
     }
 
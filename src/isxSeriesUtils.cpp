@@ -9,12 +9,27 @@
 #include "isxCellSet.h"
 #include "isxEvents.h"
 #include "isxVesselSet.h"
+#include "isxPathUtils.h"
+#include "isxParallelFor.h"
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 
 namespace isx
 {
 
+namespace
+{
+
+/// The maximum number of threads that series members are opened on by default.
+///
+/// Opening a member mostly waits on reading and parsing its footer, so this
+/// bounds the number of files that are read at once rather than using every core.
+const isize_t s_maxNumOpenMemberThreads = 8;
+
+} // namespace
+
 bool
 checkSeriesDataSetType(
         const DataSet::Type inRef,
@@ -226,6 +241,32 @@ checkNewMemberOfSeries(
     return true;
 }
 
+bool
+canOpenSeriesMembersConcurrently(const std::vector<std::string> & inFileNames)
+{
+    for (const auto & fn : inFileNames)
+    {
+        std::string ext = getExtension(fn);
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext != "isxd")
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+forEachSeriesMember(
+        const isize_t inNumMembers,
+        const std::function<void(const isize_t)> & inTask,
+        const isize_t inMaxNumThreads)
+{
+    const isize_t maxNumThreads = (inMaxNumThreads > 0) ? inMaxNumThreads
+        : std::min(s_maxNumOpenMemberThreads, std::max(isize_t(1), isize_t(std::thread::hardware_concurrency())));
+    parallelFor(inNumMembers, inTask, maxNumThreads);
+}
+
 TimingInfo
 makeGaplessTimingInfo(const TimingInfos_t & inTis)
 {
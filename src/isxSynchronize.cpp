@@ -4,6 +4,10 @@
 #include "isxMovieFactory.h"
 #include "isxNVisionMovieFile.h"
 #include "isxMosaicMovieFile.h"
+#include "isxCsvWriter.h"
+
+#include <algorithm>
+#include <fstream>
 
 #include <json.hpp>
 using json = nlohmann::json;
@@ -165,60 +169,70 @@ void setStartTime(
     }
 }
 
-uint64_t getFirstTsc(
-    const std::string inFilename,
-    const DataSet::Type inDataType
-)
+uint64_t getFirstTsc(const SpMovie_t & inMovie)
 {
-    if (inDataType == DataSet::Type::MOVIE || inDataType == DataSet::Type::NVISION_MOVIE)
+    if (inMovie->hasFrameTimestamps())
     {
-        const auto movie = isx::readMovie(inFilename);
-        if (movie->hasFrameTimestamps())
+        // Get first TSC of the movie
+        if (inMovie->getTimingInfo().isIndexValid(0))
         {
-            // Get first TSC of the movie
-            if (movie->getTimingInfo().isIndexValid(0))
-            {
-                return movie->getFrameTimestamp(0);
-            }
-            else
+            return inMovie->getFrameTimestamp(0);
+        }
+        else
+        {
+            // Handle case where there is no tsc value for the first frame of the movie
+            const auto & ti = inMovie->getTimingInfo();
+            size_t firstValidIdx = 0;
+            for (size_t i = 1; i < ti.getNumTimes(); i++)
             {
-                // Handle case where there is no tsc value for the first frame of the movie
-                const auto & ti = movie->getTimingInfo();
-                size_t firstValidIdx = 0;
-                for (size_t i = 1; i < ti.getNumTimes(); i++)
-                {
-                    if (ti.isIndexValid(i))
-                    {
-                        firstValidIdx = i;
-                        break;
-                    }
-                }
-
-                if (firstValidIdx == 0)
+                if (ti.isIndexValid(i))
                 {
-                    ISX_THROW(isx::Exception, "Failed to find index of first valid frame in isxb file.");
+                    firstValidIdx = i;
+                    break;
                 }
+            }
 
-                const auto firstValidTsc = movie->getFrameTimestamp(firstValidIdx);
-                const auto stepSizeUs = ti.getStep().toDouble() * 1e6;
-                return static_cast<uint64_t>(std::round(double(firstValidTsc) - stepSizeUs * double(firstValidIdx)));
+            if (firstValidIdx == 0)
+            {
+                ISX_THROW(isx::Exception, "Failed to find index of first valid frame in isxb file.");
             }
-        }
-        else
-        {
-            ISX_THROW(isx::ExceptionUserInput, "Cannot get first tsc from movie with no frame timestamps.");
+
+            const auto firstValidTsc = inMovie->getFrameTimestamp(firstValidIdx);
+            const auto stepSizeUs = ti.getStep().toDouble() * 1e6;
+            return static_cast<uint64_t>(std::round(double(firstValidTsc) - stepSizeUs * double(firstValidIdx)));
         }
     }
-    else if (inDataType == DataSet::Type::GPIO)
+    else
     {
-        const auto gpio = isx::readGpio(inFilename);
-        json extraProps = json::parse(gpio->getExtraProperties());
-        if (extraProps.find("firstTsc") == extraProps.end())
-        {
-            ISX_THROW(isx::ExceptionUserInput, "GPIO first tsc not stored in file metadata.");
-        }
+        ISX_THROW(isx::ExceptionUserInput, "Cannot get first tsc from movie with no frame timestamps.");
+    }
+
+    return 0;
+}
 
-        return extraProps.at("firstTsc").get<uint64_t>();
+uint64_t getFirstTsc(const SpGpio_t & inGpio)
+{
+    json extraProps = json::parse(inGpio->getExtraProperties());
+    if (extraProps.find("firstTsc") == extraProps.end())
+    {
+        ISX_THROW(isx::ExceptionUserInput, "GPIO first tsc not stored in file metadata.");
+    }
+
+    return extraProps.at("firstTsc").get<uint64_t>();
+}
+
+uint64_t getFirstTsc(
+    const std::string inFilename,
+    const DataSet::Type inDataType
+)
+{
+    if (inDataType == DataSet::Type::MOVIE || inDataType == DataSet::Type::NVISION_MOVIE)
+    {
+        return getFirstTsc(isx::readMovie(inFilename));
+    }
+    else if (inDataType == DataSet::Type::GPIO)
+    {
+        return getFirstTsc(isx::readGpio(inFilename));
     }
     else
     {
@@ -384,83 +398,237 @@ AsyncTaskStatus alignStartTimes(
     return AsyncTaskStatus::COMPLETE;
 }
 
-// Reads frame timestamps from a file of a specified data type
+namespace
+{
+
+/// The number of rows written between check-ins when exporting aligned timestamps.
+const size_t s_numRowsPerCheckIn = 1 << 12;
+
+/// The number of frame timestamps read from a movie at once when exporting aligned timestamps.
+const isize_t s_numFramesPerBlock = isize_t(1) << 14;
+
+/// The duration of the window of a GPIO channel read at once when exporting aligned timestamps.
+const DurationInSeconds s_gpioWindowDuration(60, 1);
+
+/// A data set of a series whose timestamps are exported.
+///
+/// Each data set is opened once and used both to check the inputs
+/// and to read the timestamps.
+struct TimestampSource
+{
+    SpMovie_t m_movie;
+    SpGpio_t m_gpio;
+};
+
+// Opens a data set of a specified data type to read its timestamps
 // Currently only supported for isxd movies, isxb movies, and gpio files
-bool
-readTimestamps(
-    const std::string inFilename,
-    const DataSet::Type inDataType,
-    std::vector<uint64_t> & outTimestamps,
-    std::vector<std::pair<std::string, uint64_t>> & outChannels,
-    AsyncCheckInCB_t inCheckInCB,
-    const float inProgressAllocation,
-    const float inProgressStart
+TimestampSource
+openTimestampSource(
+    const std::string & inFilename,
+    const DataSet::Type inDataType
 )
 {
+    TimestampSource source;
     if (inDataType == DataSet::Type::MOVIE || inDataType == DataSet::Type::NVISION_MOVIE)
     {
-        const auto movie = isx::readMovie(inFilename);
-        if (!movie->hasFrameTimestamps())
-        {
-            ISX_THROW(isx::ExceptionUserInput, "No frame timestamps stored in movie file to export.");
-        }
-        const auto & timingInfo = movie->getTimingInfo();
+        source.m_movie = isx::readMovie(inFilename);
+    }
+    else if (inDataType == DataSet::Type::GPIO)
+    {
+        source.m_gpio = isx::readGpio(inFilename);
+    }
+    else
+    {
+        ISX_THROW(isx::ExceptionUserInput, "Unsupported data type - can only read timestamps from gpio files, isxd movies, and isxb movies.");
+    }
+    return source;
+}
+
+/// Reads the timestamps of a series in order one block at a time,
+/// so that only one block of timestamps is in memory no matter how
+/// long the data sets are.
+///
+/// Movies are read a fixed number of frames at a time. GPIO data sets are
+/// read one channel after the other and a time window at a time, which only
+/// reads the packets of that window from files with a packet index.
+class TimestampCursor
+{
+public:
+    TimestampCursor(std::vector<TimestampSource> inSources)
+        : m_sources(std::move(inSources))
+    {
+        ISX_ASSERT(!m_sources.empty());
+        const SpGpio_t & gpio = m_sources.front().m_gpio;
+        m_hasChannels = gpio && !gpio->getChannelList().empty();
+        startDataSet();
+    }
+
+    /// \return True if the first data set of the series has channels,
+    ///         which determines if the series has a channel column.
+    bool
+    hasChannels() const
+    {
+        return m_hasChannels;
+    }
 
-        const auto numFrames = timingInfo.getNumTimes();
-        outTimestamps.resize(numFrames);
-        for (size_t i = 0; i < numFrames; i++)
+    /// Read the next timestamp of the series.
+    ///
+    /// \param  outTimestamp    The next timestamp.
+    /// \param  outChannel      The name of the channel of the next timestamp,
+    ///                         or nullptr if its data set has no channels.
+    /// \return                 False if all timestamps have been read.
+    bool
+    next(uint64_t & outTimestamp, const std::string *& outChannel)
+    {
+        while (m_localIdx == m_timestamps.size())
         {
-            outTimestamps[i] = movie->getFrameTimestamp(i);
-            if (inCheckInCB(inProgressStart + (float(i) / float(numFrames)) * inProgressAllocation))
+            if (!readBlock())
             {
-                return true;
+                return false;
             }
         }
-    }
-    else if (inDataType == DataSet::Type::GPIO)
-    {
-        const auto firstTsc = getFirstTsc(inFilename, inDataType);
-        const auto gpio = isx::readGpio(inFilename);
-        const auto & timingInfo = gpio->getTimingInfo();
-        const auto startTime = timingInfo.getStart();
 
-        const auto channelNames = gpio->getChannelList();
-        const auto numChannels = channelNames.size();
+        outTimestamp = m_timestamps[m_localIdx];
+        outChannel = m_channelNames.empty() ? nullptr : &m_channelNames[m_blockChannelIdx];
+        m_localIdx++;
+        return true;
+    }
 
-        std::vector<SpLogicalTrace_t> logicalTraces;
-        std::vector<SpFTrace_t> continuousTraces;
-        gpio->getAllTraces(continuousTraces, logicalTraces);
-        size_t numValues = 0;
-        for (size_t c = 0; c < numChannels; c++)
+    /// \return The fraction of the series that has been read.
+    ///
+    float
+    getProgress() const
+    {
+        if (m_dataSetIdx == m_sources.size())
         {
-            const auto & channelName = channelNames[c];
-            numValues += logicalTraces[c]->getValues().size();
-            outChannels.push_back(std::make_pair(channelName, numValues));
+            return 1.f;
         }
 
-        // counter to track number of values iterated over in the gpio set
-        size_t i = 0;
-        for (size_t c = 0; c < numChannels; c++)
+        const TimestampSource & source = m_sources[m_dataSetIdx];
+        float dataSetProgress = 1.f;
+        if (source.m_movie)
         {
-            const auto traceValues = logicalTraces[c]->getValues();
-            for (const auto & tv : traceValues)
+            const isize_t numFrames = source.m_movie->getTimingInfo().getNumTimes();
+            if (numFrames > 0)
             {
-                outTimestamps.push_back(firstTsc + uint64_t((tv.first - startTime).getNum()));
+                dataSetProgress = float(m_frameIdx) / float(numFrames);
             }
+        }
+        else if (!m_channelNames.empty())
+        {
+            const TimingInfo & ti = source.m_gpio->getTimingInfo();
+            const double duration = (ti.getEnd() - ti.getStart()).toDouble();
+            const double channelProgress = (duration > 0.0)
+                ? std::min(1.0, (m_windowStart - ti.getStart()).toDouble() / duration) : 1.0;
+            dataSetProgress = float((double(m_channelIdx) + channelProgress) / double(m_channelNames.size()));
+        }
+        return (float(m_dataSetIdx) + dataSetProgress) / float(m_sources.size());
+    }
+
+private:
+    /// Reset the position to the start of the current data set.
+    void
+    startDataSet()
+    {
+        m_frameIdx = 0;
+        m_channelIdx = 0;
+        m_blockChannelIdx = 0;
+        m_channelNames.clear();
+        if (m_dataSetIdx < m_sources.size() && m_sources[m_dataSetIdx].m_gpio)
+        {
+            const SpGpio_t & gpio = m_sources[m_dataSetIdx].m_gpio;
+            m_channelNames = gpio->getChannelList();
+            m_windowStart = gpio->getTimingInfo().getStart();
+            m_firstTsc = getFirstTsc(gpio);
+        }
+    }
 
-            if (inCheckInCB(inProgressStart + (float(i) / float(numValues)) * inProgressAllocation))
+    /// Replace the current block with the next one of the series,
+    /// which may be empty.
+    ///
+    /// \return False if all blocks have been read.
+    bool
+    readBlock()
+    {
+        m_timestamps.clear();
+        m_localIdx = 0;
+        while (m_dataSetIdx < m_sources.size())
+        {
+            const TimestampSource & source = m_sources[m_dataSetIdx];
+            if (source.m_movie ? readMovieBlock(source.m_movie) : readGpioBlock(source.m_gpio))
             {
                 return true;
             }
-            i += traceValues.size();
+            m_dataSetIdx++;
+            startDataSet();
         }
+        return false;
     }
-    else
+
+    /// \return False if all frames of the movie have been read.
+    bool
+    readMovieBlock(const SpMovie_t & inMovie)
     {
-        ISX_THROW(isx::ExceptionUserInput, "Unsupported data type - can only read timestamps from gpio files, isxd movies, and isxb movies.");
+        const isize_t numFrames = inMovie->getTimingInfo().getNumTimes();
+        if (m_frameIdx >= numFrames)
+        {
+            return false;
+        }
+        const isize_t numBlockFrames = std::min(s_numFramesPerBlock, numFrames - m_frameIdx);
+        m_timestamps = inMovie->getFrameTimestamps(m_frameIdx, numBlockFrames);
+        m_frameIdx += numBlockFrames;
+        return true;
     }
-    return false;
-}
+
+    /// \return False if all windows of all channels of the GPIO data set have been read.
+    bool
+    readGpioBlock(const SpGpio_t & inGpio)
+    {
+        const TimingInfo & ti = inGpio->getTimingInfo();
+        const Time startTime = ti.getStart();
+        while (m_channelIdx < m_channelNames.size())
+        {
+            // The last window also contains values at the end of the timing info.
+            if (m_windowStart <= ti.getEnd())
+            {
+                const Time windowEnd = m_windowStart + s_gpioWindowDuration;
+                const SpLogicalTrace_t trace = inGpio->getLogicalDataInRange(m_channelNames[m_channelIdx], m_windowStart, windowEnd);
+                m_windowStart = windowEnd;
+                m_blockChannelIdx = m_channelIdx;
+                if (trace)
+                {
+                    const auto & traceValues = trace->getValues();
+                    m_timestamps.reserve(traceValues.size());
+                    for (const auto & tv : traceValues)
+                    {
+                        m_timestamps.push_back(m_firstTsc + uint64_t((tv.first - startTime).getNum()));
+                    }
+                }
+                return true;
+            }
+            m_channelIdx++;
+            m_windowStart = startTime;
+        }
+        return false;
+    }
+
+    std::vector<TimestampSource> m_sources;
+    bool m_hasChannels = false;
+
+    size_t m_dataSetIdx = 0;
+    size_t m_localIdx = 0;
+    std::vector<uint64_t> m_timestamps;
+
+    isize_t m_frameIdx = 0;
+
+    std::vector<std::string> m_channelNames;
+    size_t m_channelIdx = 0;
+    size_t m_blockChannelIdx = 0;
+    Time m_windowStart;
+    uint64_t m_firstTsc = 0;
+};
+
+} // namespace
 
 AsyncTaskStatus exportAlignedTimestamps(
     ExportAlignedTimestampsParams inParams,
@@ -521,17 +689,42 @@ AsyncTaskStatus exportAlignedTimestamps(
         }
     }
 
+    std::vector<std::vector<std::string>> inputFilenames = alignSeriesFilenames;
+    inputFilenames.insert(inputFilenames.begin(), inParams.m_refSeriesFilenames);
+
+    std::vector<std::string> inputNames = alignSeriesNames;
+    inputNames.insert(inputNames.begin(), inParams.m_refSeriesName);
+
+    std::vector<DataSet::Type> inputDataTypes = alignDataTypes;
+    inputDataTypes.insert(inputDataTypes.begin(), refDataType);
+
+    // Open every data set once, to check the inputs and then read their timestamps
+    const size_t numInputs = inputFilenames.size();
+    std::vector<std::vector<TimestampSource>> inputSources(numInputs);
+    for (size_t inputIdx = 0; inputIdx < numInputs; inputIdx++)
+    {
+        for (const auto & filename : inputFilenames[inputIdx])
+        {
+            inputSources[inputIdx].push_back(openTimestampSource(filename, inputDataTypes[inputIdx]));
+        }
+    }
+
+    const auto getSourceRecordingUUID = [](const TimestampSource & inSource)
+    {
+        return inSource.m_movie ? isx::getRecordingUUID(inSource.m_movie) : isx::getRecordingUUID(inSource.m_gpio);
+    };
+
     // Check input files share the same recording UUID (and are therefore paired and synchronized)
     {
-        const auto refRecordingUUID = getRecordingUUID(inParams.m_refSeriesFilenames.front(), refDataType);
+        const auto refRecordingUUID = getSourceRecordingUUID(inputSources.front().front());
         if (refRecordingUUID.empty())
         {
             ISX_THROW(isx::ExceptionUserInput, "Cannot determine if files are paired and synchronized - no recording UUID in timing reference file metadata.");
         }
 
-        for (size_t i = 0; i < alignSeriesFilenames.size(); i++)
+        for (size_t inputIdx = 1; inputIdx < numInputs; inputIdx++)
         {
-            const auto alignRecordingUUID = getRecordingUUID(alignSeriesFilenames[i].front(), alignDataTypes[i]);
+            const auto alignRecordingUUID = getSourceRecordingUUID(inputSources[inputIdx].front());
 
             if (alignRecordingUUID != refRecordingUUID)
             {
@@ -540,142 +733,138 @@ AsyncTaskStatus exportAlignedTimestamps(
         }
     }
 
-    // construct output csv
-    std::vector<std::vector<std::string>> inputFilenames = alignSeriesFilenames;
-    inputFilenames.insert(inputFilenames.begin(), inParams.m_refSeriesFilenames);
-
-    std::vector<std::string> inputNames = alignSeriesNames;
-    inputNames.insert(inputNames.begin(), inParams.m_refSeriesName);
-
-    std::vector<DataSet::Type> inputDataTypes = alignDataTypes;
-    inputDataTypes.insert(inputDataTypes.begin(), refDataType);
-
-    // variables to keep track of progress
-    const float progressForRead = 0.3f;
-    const float progressForWrite = 0.7f;
-    float currentProgress = 0.0f;
-
-    const size_t numInputs = inputFilenames.size();
-    size_t numDataSetsTotal = 0;
-    for (size_t inputIdx = 0; inputIdx < numInputs; inputIdx++)
+    // Check that the timestamps of every data set can be read before writing anything
+    for (const auto & sources : inputSources)
     {
-        numDataSetsTotal += inputFilenames[inputIdx].size();
+        for (const auto & source : sources)
+        {
+            if (source.m_movie && !source.m_movie->hasFrameTimestamps())
+            {
+                ISX_THROW(isx::ExceptionUserInput, "No frame timestamps stored in movie file to export.");
+            }
+            else if (source.m_gpio)
+            {
+                getFirstTsc(source.m_gpio);
+            }
+        }
     }
 
-    std::vector<std::vector<std::vector<uint64_t>>> inputTimestamps(numInputs); // numInputs x numDataSets x numSamples
-    std::vector<std::vector<std::vector<std::pair<std::string, uint64_t>>>> inputChannels(numInputs); // numInputs x numDataSets x numChannels
-    size_t maxFrames = 0;
+    const size_t floatDecimalPrecision = 6;
+    const TimestampSource & refSource = inputSources.front().front();
+    const auto refFirstTsc = refSource.m_movie ? getFirstTsc(refSource.m_movie) : getFirstTsc(refSource.m_gpio);
+    const auto refStart = refSource.m_movie ? refSource.m_movie->getTimingInfo().getStart() : refSource.m_gpio->getTimingInfo().getStart();
+    const auto refEpochStartTimestamp = double(refStart.getSecsSinceEpoch().getNum()) / 1e3;
+
+    // The timestamps of each input are read a block at a time, so that memory does not grow
+    // with the length of the recordings. Each row holds the next timestamp of every input,
+    // so they are read in lockstep rather than merged in time order.
+    std::vector<TimestampCursor> cursors;
+    cursors.reserve(numInputs);
     for (size_t inputIdx = 0; inputIdx < numInputs; inputIdx++)
     {
-        const auto numDataSets = inputFilenames[inputIdx].size();
-        inputTimestamps[inputIdx] = std::vector<std::vector<uint64_t>>(numDataSets);
-        inputChannels[inputIdx] = std::vector<std::vector<std::pair<std::string, uint64_t>>>(numDataSets);
+        cursors.emplace_back(std::move(inputSources[inputIdx]));
+    }
 
-        size_t numFrames = 0;
-        for (size_t dataSetIdx = 0; dataSetIdx < numDataSets; dataSetIdx++)
+    const auto getProgress = [&cursors]()
+    {
+        float progress = 1.f;
+        for (const auto & cursor : cursors)
         {
-            if (readTimestamps(inputFilenames[inputIdx][dataSetIdx], inputDataTypes[inputIdx], inputTimestamps[inputIdx][dataSetIdx], inputChannels[inputIdx][dataSetIdx], inCheckInCB, progressForRead / float(numDataSetsTotal), currentProgress))
-            {
-                return AsyncTaskStatus::CANCELLED;
-            }
-            numFrames += inputTimestamps[inputIdx][dataSetIdx].size();
-            currentProgress += progressForRead / float(numDataSetsTotal);
+            progress = std::min(progress, cursor.getProgress());
         }
-        maxFrames = std::max(numFrames, maxFrames);
-    }
+        return progress;
+    };
 
     std::ofstream csv(inParams.m_outputFilename);
+    CsvWriter writer(csv);
     for (size_t inputIdx = 0; inputIdx < numInputs; inputIdx++)
     {
         if (inputIdx > 0)
         {
-            csv << ",";
+            writer.appendChar(',');
         }
 
-        csv << inputNames[inputIdx] << " Timestamp (s)";
-        
-        if (inputChannels[inputIdx].front().size())
+        writer.appendString(inputNames[inputIdx]);
+        writer.appendString(" Timestamp (s)");
+
+        if (cursors[inputIdx].hasChannels())
         {
-            csv << "," << inputNames[inputIdx] << " Channel";
+            writer.appendChar(',');
+            writer.appendString(inputNames[inputIdx]);
+            writer.appendString(" Channel");
         }
     }
-    csv << std::endl;
-    
-    const size_t floatDecimalPrecision = 6;
-    const auto refFirstTsc = getFirstTsc(inParams.m_refSeriesFilenames.front(), refDataType);
-    const auto refEpochStartTimestamp = double(getStart(inParams.m_refSeriesFilenames.front(), refDataType).getSecsSinceEpoch().getNum()) / 1e3;
+    writer.appendChar('\n');
 
-    std::vector<size_t> inputDataSetIdxs(numInputs, 0);
-    std::vector<size_t> inputDataSetLocalIdxs(numInputs, 0);
-    for (size_t sampleIdx = 0; sampleIdx < maxFrames; sampleIdx++)
+    std::vector<uint64_t> rowTimestamps(numInputs);
+    std::vector<const std::string *> rowChannels(numInputs);
+    std::vector<char> rowHasValues(numInputs);
+    for (size_t sampleIdx = 0; ; sampleIdx++)
     {
+        bool rowHasAnyValue = false;
+        for (size_t inputIdx = 0; inputIdx < numInputs; inputIdx++)
+        {
+            rowHasValues[inputIdx] = cursors[inputIdx].next(rowTimestamps[inputIdx], rowChannels[inputIdx]);
+            rowHasAnyValue = rowHasAnyValue || rowHasValues[inputIdx];
+        }
+
+        // All frames in every series have been processed
+        if (!rowHasAnyValue)
+        {
+            break;
+        }
+
         for (size_t inputIdx = 0; inputIdx < numInputs; inputIdx++)
         {
             if (inputIdx > 0)
             {
-                csv << ",";
+                writer.appendChar(',');
             }
 
-            auto & dataSetIdx = inputDataSetIdxs[inputIdx];
             // All frames in this series have been processed, skip this input
-            if (dataSetIdx == inputTimestamps[inputIdx].size())
+            if (!rowHasValues[inputIdx])
             {
                 continue;
             }
 
-            auto & dataSetLocalIdx = inputDataSetLocalIdxs[inputIdx];
-            // All frames in this data set have been processed, move on to the next data set in the series
-            if (dataSetLocalIdx == inputTimestamps[inputIdx][dataSetIdx].size())
-            {
-                dataSetIdx++;
-                dataSetLocalIdx = 0;
-
-                // All frames in this series have been processed, skip this value
-                if (dataSetIdx == inputTimestamps[inputIdx].size())
-                {
-                    continue;
-                }
-            }
-
             // Output timestamp in specified format
-            const auto tsc = inputTimestamps[inputIdx][dataSetIdx][dataSetLocalIdx];
+            const auto tsc = rowTimestamps[inputIdx];
             if (inParams.m_format == WriteTimeRelativeTo::FIRST_DATA_ITEM)
             {
                 // convert tsc from unsigned to signed int in order to handle negative tsc delta
                 const auto timestamp = double(int64_t(tsc) - int64_t(refFirstTsc)) / 1e6;
-                csv << std::fixed << std::setprecision(floatDecimalPrecision) << timestamp;
+                writer.appendFixed(timestamp, int(floatDecimalPrecision));
             }
             else if (inParams.m_format == WriteTimeRelativeTo::UNIX_EPOCH)
             {
                 // convert tsc from unsigned to signed int in order to handle negative tsc delta
                 const auto timestamp = refEpochStartTimestamp + (double(int64_t(tsc) - int64_t(refFirstTsc)) / 1e6);
-                csv << std::fixed << std::setprecision(floatDecimalPrecision) << timestamp;
+                writer.appendFixed(timestamp, int(floatDecimalPrecision));
             }
             else
             {
-                csv << tsc;
+                writer.appendUnsigned(tsc);
             }
 
-            if (inputChannels[inputIdx][dataSetIdx].size())
+            if (rowChannels[inputIdx] != nullptr)
             {
-                // Find the channel that this timestamp belongs to
-                size_t channelIndex = 0;
-                while (channelIndex < (inputChannels[inputIdx][dataSetIdx].size() - 1) && dataSetLocalIdx > (inputChannels[inputIdx][dataSetIdx][channelIndex].second - 1))
-                {
-                    channelIndex++;
-                }
-                ISX_ASSERT(channelIndex < inputChannels[inputIdx][dataSetIdx].size());
-                csv << "," << inputChannels[inputIdx][dataSetIdx][channelIndex].first;
+                writer.appendChar(',');
+                writer.appendString(*rowChannels[inputIdx]);
             }
-
-            dataSetLocalIdx++;
         }
-        csv << std::endl;
-        if (inCheckInCB(currentProgress + (float(sampleIdx) / float(maxFrames)) * progressForWrite))
+        writer.appendChar('\n');
+
+        if ((sampleIdx + 1) % s_numRowsPerCheckIn == 0 && inCheckInCB(getProgress()))
         {
             return AsyncTaskStatus::CANCELLED;
         }
     }
+    writer.flush();
+
+    if (inCheckInCB(1.f))
+    {
+        return AsyncTaskStatus::CANCELLED;
+    }
 
     return AsyncTaskStatus::COMPLETE;
 }
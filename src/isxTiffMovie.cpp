@@ -9,34 +9,78 @@ namespace isx
 {
 
 TiffMovie::TiffMovie(const std::string & inFileName, const isize_t inNumDirectories)
+    : m_fileName(inFileName)
+    , m_numFrames(inNumDirectories)
+    , m_formatRead(false)
 {
-    initialize(inFileName);
-    m_numFrames = inNumDirectories;
+    m_fileHandle.manage([this]() { open(); }, [this]() { close(); }, false);
 }
 
 TiffMovie::TiffMovie(const std::string & inFileName)
+    : m_fileName(inFileName)
+    , m_formatRead(false)
 {
-    initialize(inFileName);
+    open();
     m_numFrames = isize_t(TIFFNumberOfDirectories(m_tif));
+
+    // The file is reopened when its frames are first read.
+    close();
+    m_fileHandle.manage([this]() { open(); }, [this]() { close(); }, false);
 }
 
 TiffMovie::~TiffMovie()
 {
-    TIFFClose(m_tif);
+    m_fileHandle.unmanage();
+    close();
 }
 
 void
-TiffMovie::initialize(const std::string & inFileName)
+TiffMovie::open()
 {
-    m_fileName = inFileName;
-
-    m_tif = TIFFOpen(inFileName.c_str(), "r");
+    m_tif = TIFFOpen(m_fileName.c_str(), "r");
 
     if(!m_tif)
     {
         ISX_THROW(ExceptionFileIO, "Failed to open TIFF file: ", m_fileName);
     }
 
+    if (!m_formatRead)
+    {
+        try
+        {
+            readFormat();
+        }
+        catch (...)
+        {
+            close();
+            throw;
+        }
+        m_formatRead = true;
+    }
+}
+
+void
+TiffMovie::close()
+{
+    if (m_tif)
+    {
+        TIFFClose(m_tif);
+        m_tif = nullptr;
+    }
+}
+
+void
+TiffMovie::ensureFormat() const
+{
+    if (!m_formatRead)
+    {
+        PooledFileHandle::Lease lease(m_fileHandle);
+    }
+}
+
+void
+TiffMovie::readFormat()
+{
     // nVista seems to write TIFF files with 0 samples per pixel (or at least did at some stage).
     // This check is mainly to catch multi-channel files exported by ImageJ (e.g. RGB 8-bit).
     uint16_t channels = 0;
@@ -77,11 +121,12 @@ TiffMovie::initialize(const std::string & inFileName)
 SpVideoFrame_t 
 TiffMovie::getVideoFrame(isize_t inFrameNumber, const SpacingInfo & inSpacingInfo, Time inTimeStamp)
 {
+    const DataType dataType = getDataType();
     const isx::SpVideoFrame_t vf = std::make_shared<isx::VideoFrame>(
         inSpacingInfo,
-        isx::getDataTypeSizeInBytes(m_dataType) * inSpacingInfo.getNumColumns(),
+        isx::getDataTypeSizeInBytes(dataType) * inSpacingInfo.getNumColumns(),
         1, // numChannels
-        m_dataType,
+        dataType,
         inTimeStamp,
         inFrameNumber);
 
@@ -92,6 +137,8 @@ TiffMovie::getVideoFrame(isize_t inFrameNumber, const SpacingInfo & inSpacingInf
 void 
 TiffMovie::getFrame(isize_t inFrameNumber, const SpVideoFrame_t & vf)
 {
+    PooledFileHandle::Lease lease(m_fileHandle);
+
     // Seek to the right directory
     if(1 != TIFFSetDirectory(m_tif, tdir_t(inFrameNumber)))
     {
@@ -128,18 +175,21 @@ TiffMovie::getNumFrames() const
 isize_t
 TiffMovie::getFrameWidth() const
 {
+    ensureFormat();
     return m_frameWidth;
 }
 
 isize_t
 TiffMovie::getFrameHeight() const
 {
+    ensureFormat();
     return m_frameHeight;
 }
 
 DataType
 TiffMovie::getDataType() const
 {
+    ensureFormat();
     return m_dataType;
 }
 
@@ -5,6 +5,9 @@
 #include <isxCore.h>
 #include <isxSpacingInfo.h>
 #include <isxTime.h>
+#include <isxFileHandlePool.h>
+
+#include <atomic>
 #include <string>
 
 /// Forward-declare TIFF formats
@@ -15,6 +18,8 @@ namespace isx
 {
     /// A class managing a single TIFF file
     ///
+    /// The TIFF handle is managed by the file handle pool, so it is closed
+    /// while idle when too many files are open and reopened on access.
     class TiffMovie
     {
     public: 
@@ -25,6 +30,9 @@ namespace isx
 
         /// Constructor that allows specification of number of directories
         /// to avoid expensive IO to get this.
+        ///
+        /// The file is not opened until a frame or its format is first accessed.
+        ///
         /// \param inFileName the filename for one TIFF movie file
         /// \param inNumDirectories the number of directories in the TIFF movie file
         TiffMovie(const std::string & inFileName, const isize_t inNumDirectories);
@@ -69,15 +77,37 @@ namespace isx
 
     private:
 
-        void initialize(const std::string & inFileName);
+        /// Open the file, reading its format if that has not been done yet.
+        ///
+        /// \throw  isx::ExceptionFileIO    If the file cannot be opened.
+        /// \throw  isx::ExceptionDataIO    If the format is not supported.
+        void open();
+
+        /// Close the file if it is open.
+        ///
+        void close();
+
+        /// Read the format of the open file.
+        ///
+        void readFormat();
+
+        /// Open the file if needed to read its format.
+        ///
+        void ensureFormat() const;
 
         std::string m_fileName;
-        tiff *      m_tif;
+        tiff *      m_tif = nullptr;
+
+        isize_t m_frameWidth = 0;
+        isize_t m_frameHeight = 0;
+        isize_t m_numFrames = 0;
+        DataType m_dataType = DataType::U16;
+
+        /// True once the format has been read from the file.
+        std::atomic<bool> m_formatRead;
 
-        isize_t m_frameWidth;
-        isize_t m_frameHeight;
-        isize_t m_numFrames;
-        DataType m_dataType;
+        /// The pool entry of the TIFF handle.
+        mutable PooledFileHandle m_fileHandle;
 
     };
 }
@@ -2,6 +2,9 @@
 #include "isxException.h"
 #include "isxMutex.h"
 #include "isxConditionVariable.h"
+#include "isxVesselCorrelationsReader.h"
+
+#include <cstring>
 
 
 namespace isx
@@ -36,23 +39,29 @@ const
 SpVideoFrame_t
 VesselCorrelationsMovie::getFrame(isize_t inFrameNumber)
 {
-    Mutex mutex;
-    ConditionVariable cv;
-    mutex.lock("getFrame");
-    AsyncTaskResult<SpVideoFrame_t> asyncTaskResult;
-    getFrameAsync(inFrameNumber,
-        [&asyncTaskResult, &cv, &mutex](AsyncTaskResult<SpVideoFrame_t> inAsyncTaskResult)
-        {
-            mutex.lock("getFrame async");
-            asyncTaskResult = inAsyncTaskResult;
-            mutex.unlock();
-            cv.notifyOne();
-        }
-    );
-    cv.wait(mutex);
-    mutex.unlock();
+    if (inFrameNumber >= m_gaplessTimingInfo.getNumTimes())
+    {
+        ISX_THROW(ExceptionDataIO, "The index of the frame (", inFrameNumber,
+                ") is out of range (0-", m_gaplessTimingInfo.getNumTimes(), ").");
+    }
+
+    // Frames are usually requested in order (e.g. when exporting), so they are read
+    // in blocks of triptychs and the next block is prefetched.
+    ScopedMutex locker(m_readerMutex, "VesselCorrelationsMovie::getFrame");
+    if (!m_reader)
+    {
+        m_reader = std::make_shared<VesselCorrelationsReader>(m_vesselSet, m_vesselId);
+    }
+
+    const float * values = m_reader->read(inFrameNumber);
+    if (values == nullptr)
+    {
+        return nullptr;
+    }
 
-    return asyncTaskResult.get();   // throws if asyncTaskResult contains an exception
+    VesselCorrelations correlations(m_vesselSet->getCorrelationSize(m_vesselId));
+    std::memcpy(correlations.getValues(), values, correlations.getTotalNumPixels() * 3 * sizeof(float));
+    return makeFrame(correlations, inFrameNumber);
 }
 
 void
@@ -64,12 +73,8 @@ VesselCorrelationsMovie::getFrameAsync(isize_t inFrameNumber, MovieGetFrameCB_t
                 ") is out of range (0-", m_gaplessTimingInfo.getNumTimes(), ").");
     }
 
-    size_t seriesIndex = 0;
-    size_t frameIndex = 0;
-    std::tie(seriesIndex, frameIndex) = getSegmentAndLocalIndex(m_timingInfos, inFrameNumber);
-
     std::weak_ptr<VesselCorrelationsMovie> weakThis = shared_from_this();
-    m_vesselSet->getCorrelationsAsync(m_vesselId, inFrameNumber, [weakThis, inCallback, inFrameNumber, seriesIndex, frameIndex](isx::AsyncTaskResult<isx::SpVesselCorrelations_t> inAsyncTaskResult)
+    m_vesselSet->getCorrelationsAsync(m_vesselId, inFrameNumber, [weakThis, inCallback, inFrameNumber](isx::AsyncTaskResult<isx::SpVesselCorrelations_t> inAsyncTaskResult)
     {
         auto sharedThis = weakThis.lock();
         if (!sharedThis)
@@ -81,16 +86,7 @@ VesselCorrelationsMovie::getFrameAsync(isize_t inFrameNumber, MovieGetFrameCB_t
         AsyncTaskResult<SpVideoFrame_t> atr;
         if (correlations)
         {
-            SpVideoFrame_t frame = std::make_shared<VideoFrame>(
-                sharedThis->getSpacingInfo(),
-                sharedThis->getSpacingInfo().getNumColumns() * sizeof(float),
-                1,
-                sharedThis->getDataType(),
-                sharedThis->getTimingInfosForSeries().at(seriesIndex).convertIndexToStartTime(frameIndex),
-                inFrameNumber);
-            SpImage_t heatmap = correlations->getHeatmaps();
-            std::memcpy(frame->getPixelsAsF32(), heatmap->getPixelsAsF32(), heatmap->getImageSizeInBytes());
-            atr.setValue(frame);
+            atr.setValue(sharedThis->makeFrame(*correlations, inFrameNumber));
         }
         else
         {
@@ -100,6 +96,25 @@ VesselCorrelationsMovie::getFrameAsync(isize_t inFrameNumber, MovieGetFrameCB_t
     });
 }
 
+SpVideoFrame_t
+VesselCorrelationsMovie::makeFrame(VesselCorrelations & inCorrelations, const isize_t inFrameNumber) const
+{
+    size_t seriesIndex = 0;
+    size_t frameIndex = 0;
+    std::tie(seriesIndex, frameIndex) = getSegmentAndLocalIndex(m_timingInfos, inFrameNumber);
+
+    SpVideoFrame_t frame = std::make_shared<VideoFrame>(
+        getSpacingInfo(),
+        getSpacingInfo().getNumColumns() * sizeof(float),
+        1,
+        getDataType(),
+        m_timingInfos.at(seriesIndex).convertIndexToStartTime(frameIndex),
+        inFrameNumber);
+    SpImage_t heatmap = inCorrelations.getHeatmaps();
+    std::memcpy(frame->getPixelsAsF32(), heatmap->getPixelsAsF32(), heatmap->getImageSizeInBytes());
+    return frame;
+}
+
 void
 VesselCorrelationsMovie::cancelPendingReads()
 {
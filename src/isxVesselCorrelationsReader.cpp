@@ -0,0 +1,112 @@
+#include "isxVesselCorrelationsReader.h"
+#include "isxException.h"
+
+#include <algorithm>
+
+namespace isx
+{
+
+VesselCorrelationsReader::VesselCorrelationsReader(
+    const SpVesselSet_t & inVesselSet,
+    const size_t inVesselId,
+    const size_t inBlockSizeInBytes)
+    : m_vesselSet(inVesselSet)
+    , m_vesselId(inVesselId)
+    , m_numFrames(inVesselSet->getTimingInfo().getNumTimes())
+{
+    const SizeInPixels_t correlationSize = inVesselSet->getCorrelationSize(inVesselId);
+    m_numValuesPerFrame = correlationSize.getWidth() * correlationSize.getHeight() * 3;
+    const isize_t frameSizeInBytes = std::max(m_numValuesPerFrame * sizeof(float), isize_t(1));
+    m_numFramesPerBlock = std::max(inBlockSizeInBytes / frameSizeInBytes, isize_t(1));
+}
+
+VesselCorrelationsReader::~VesselCorrelationsReader()
+{
+    if (m_prefetchThread.joinable())
+    {
+        m_prefetchThread.join();
+    }
+}
+
+const float *
+VesselCorrelationsReader::read(const isize_t inFrameNumber)
+{
+    if (inFrameNumber >= m_numFrames)
+    {
+        ISX_THROW(ExceptionDataIO, "The index of the frame (", inFrameNumber,
+                ") is out of range (0-", m_numFrames, ").");
+    }
+
+    if (!m_current.contains(inFrameNumber))
+    {
+        waitForPrefetch();
+        if (m_next.contains(inFrameNumber))
+        {
+            std::swap(m_current, m_next);
+        }
+        else
+        {
+            // Either the frames are not read in order, or the prefetch failed,
+            // in which case this reports the error.
+            readBlock(m_current, inFrameNumber);
+        }
+
+        if (m_current.m_saved && m_current.m_end < m_numFrames)
+        {
+            startPrefetch(m_current.m_end);
+        }
+    }
+
+    if (!m_current.m_saved)
+    {
+        return nullptr;
+    }
+    return m_current.m_values.data() + (inFrameNumber - m_current.m_begin) * m_numValuesPerFrame;
+}
+
+isize_t
+VesselCorrelationsReader::getNumFramesPerBlock() const
+{
+    return m_numFramesPerBlock;
+}
+
+void
+VesselCorrelationsReader::readBlock(Block & outBlock, const isize_t inBeginFrame)
+{
+    // Mark the block as empty first, so that it is not used if reading fails.
+    outBlock.m_begin = inBeginFrame;
+    outBlock.m_end = inBeginFrame;
+    const isize_t endFrame = std::min(inBeginFrame + m_numFramesPerBlock, m_numFrames);
+    outBlock.m_values.resize((endFrame - inBeginFrame) * m_numValuesPerFrame);
+    outBlock.m_saved = m_vesselSet->getCorrelationsRange(m_vesselId, inBeginFrame, endFrame, outBlock.m_values.data());
+    outBlock.m_end = endFrame;
+}
+
+void
+VesselCorrelationsReader::startPrefetch(const isize_t inBeginFrame)
+{
+    ISX_ASSERT(!m_prefetchThread.joinable());
+    m_prefetchThread = std::thread([this, inBeginFrame]()
+    {
+        try
+        {
+            readBlock(m_next, inBeginFrame);
+        }
+        catch (...)
+        {
+            // A failed prefetch leaves the block empty, so its frames are read
+            // again when requested and the error is reported then.
+        }
+    });
+}
+
+void
+VesselCorrelationsReader::waitForPrefetch()
+{
+    if (m_prefetchThread.joinable())
+    {
+        m_prefetchThread.join();
+    }
+}
+
+} // namespace isx
@@ -0,0 +1,106 @@
+#ifndef ISX_VESSEL_CORRELATIONS_READER_H
+#define ISX_VESSEL_CORRELATIONS_READER_H
+
+#include "isxCore.h"
+#include "isxVesselSet.h"
+
+#include <thread>
+#include <vector>
+
+namespace isx
+{
+
+/// Reads the correlation triptychs of a vessel in frame order.
+///
+/// Triptychs are read in blocks of consecutive frames with
+/// VesselSet::getCorrelationsRange, and the block after the one being read
+/// is prefetched on a background thread, so reading frames in order only
+/// waits for the disk when a block is not ready yet.
+/// Frames can still be read in any order, but each out of order frame
+/// costs a block read.
+class VesselCorrelationsReader
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param  inVesselSet         The vessel set containing the correlation triptychs.
+    /// \param  inVesselId          The id of the vessel to read.
+    /// \param  inBlockSizeInBytes  The approximate size of a block of triptychs.
+    VesselCorrelationsReader(
+        const SpVesselSet_t & inVesselSet,
+        const size_t inVesselId,
+        const size_t inBlockSizeInBytes = s_defaultBlockSizeInBytes);
+
+    VesselCorrelationsReader(const VesselCorrelationsReader &) = delete;
+
+    VesselCorrelationsReader & operator=(const VesselCorrelationsReader &) = delete;
+
+    /// Destructor.
+    ///
+    /// This waits for any prefetch in progress.
+    ~VesselCorrelationsReader();
+
+    /// Read the correlation triptych of a frame.
+    ///
+    /// \param  inFrameNumber   The index of the velocity measurement.
+    /// \return                 The triptych in the same layout as VesselCorrelations::getValues,
+    ///                         which is valid until the next call to read,
+    ///                         or nullptr if no correlation triptychs are saved.
+    /// \throw  isx::ExceptionFileIO    If reading fails.
+    /// \throw  isx::ExceptionDataIO    If the frame is out of range.
+    const float *
+    read(const isize_t inFrameNumber);
+
+    /// \return The number of frames in a block.
+    ///
+    isize_t
+    getNumFramesPerBlock() const;
+
+    /// The default size of a block of triptychs in bytes.
+    static const size_t s_defaultBlockSizeInBytes = 1 << 22;
+
+private:
+
+    /// A block of consecutive triptychs.
+    struct Block
+    {
+        isize_t             m_begin = 0;
+        isize_t             m_end = 0;
+        bool                m_saved = false;
+        std::vector<float>  m_values;
+
+        bool
+        contains(const isize_t inFrameNumber) const
+        {
+            return inFrameNumber >= m_begin && inFrameNumber < m_end;
+        }
+    };
+
+    /// Read the block starting at a frame.
+    void
+    readBlock(Block & outBlock, const isize_t inBeginFrame);
+
+    /// Start reading the block starting at a frame on the background thread.
+    void
+    startPrefetch(const isize_t inBeginFrame);
+
+    /// Wait for the background thread to finish reading.
+    void
+    waitForPrefetch();
+
+    SpVesselSet_t       m_vesselSet;
+    size_t              m_vesselId;
+    isize_t             m_numFrames;
+    isize_t             m_numValuesPerFrame;
+    isize_t             m_numFramesPerBlock;
+
+    Block               m_current;
+    Block               m_next;
+
+    std::thread         m_prefetchThread;
+};
+
+} // namespace isx
+
+#endif // ISX_VESSEL_CORRELATIONS_READER_H
@@ -1,4 +1,5 @@
 #include "isxVesselSetFile.h"
+#include "isxMetadataProbe.h"
 #include "isxImage.h"
 #include "isxException.h"
 #include "isxAssert.h"
@@ -30,6 +31,11 @@ namespace isx
         readHeader();
         m_fileClosedForWriting = !enableWrite;
         m_valid = true;
+
+        if (!enableWrite)
+        {
+            m_fileHandle.manageStream(m_file, m_fileName, m_openmode);
+        }
     }
 
     VesselSetFile::VesselSetFile(const std::string & inFileName,
@@ -61,6 +67,7 @@ namespace isx
                 closeForWriting();
             }
 
+            m_fileHandle.unmanage();
             isx::closeFileStreamWithChecks(m_file, m_fileName);
         }
     }
@@ -122,6 +129,7 @@ namespace isx
     SpFTrace_t
     VesselSetFile::readTrace(isize_t inVesselId)
     {
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToVessel(inVesselId);
 
         const isize_t offsetInBytes = lineEndpointsSizeInBytes();
@@ -146,6 +154,8 @@ namespace isx
     SpImage_t
     VesselSetFile::readProjectionImage()
     {
+        PooledFileHandle::Lease lease(m_fileHandle);
+
         // projection image is the same for all vessels
         // it is stored before individual vessel data
         const isize_t pos = 0;
@@ -174,6 +184,7 @@ namespace isx
     SpVesselLine_t
     VesselSetFile::readLineEndpoints(isize_t inVesselId)
     {
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToVessel(inVesselId);
 
         if (!m_file.good())
@@ -212,6 +223,7 @@ namespace isx
             return nullptr;
         }
 
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToVessel(inVesselId);
 
         // Calculate bytes till beginning of vessel data
@@ -247,6 +259,7 @@ namespace isx
             return nullptr;
         }
 
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToVessel(inVesselId);
 
         // Calculate bytes till beginning of vessel data
@@ -273,6 +286,53 @@ namespace isx
         return correlations;
     }
 
+    bool
+    VesselSetFile::readCorrelationsRange(isize_t inVesselId, isize_t inBeginFrame, isize_t inEndFrame, float * outValues)
+    {
+        if (m_vesselSetType != VesselSetType_t::RBC_VELOCITY)
+        {
+            ISX_THROW(isx::ExceptionUserInput, "Correlation triptychs can only be read from rbc velocity set but this is a vessel diameter set");
+        }
+
+        if (!isCorrelationSaved())
+        {
+            return false;
+        }
+
+        if (inBeginFrame > inEndFrame || inEndFrame > m_timingInfo.getNumTimes())
+        {
+            ISX_THROW(isx::ExceptionDataIO, "The range of frames [", inBeginFrame, ", ", inEndFrame,
+                      ") is out of range (0-", m_timingInfo.getNumTimes(), ").");
+        }
+
+        if (inBeginFrame == inEndFrame)
+        {
+            return true;
+        }
+
+        PooledFileHandle::Lease lease(m_fileHandle);
+        seekToVessel(inVesselId);
+
+        // The triptychs of a vessel are stored contiguously in frame order
+        const isize_t triptychBytes = correlationSizeInBytes(inVesselId) * 3;
+        const isize_t offsetInBytes = lineEndpointsSizeInBytes() + traceSizeInBytes() + directionSizeInBytes()
+                                      + triptychBytes * inBeginFrame;
+
+        m_file.seekg(offsetInBytes, std::ios_base::cur);
+
+        if (!m_file.good())
+        {
+            ISX_THROW(isx::ExceptionFileIO, "Error seeking to vessel correlation triptych for read.");
+        }
+
+        m_file.read(reinterpret_cast<char*>(outValues), std::streamsize(triptychBytes * (inEndFrame - inBeginFrame)));
+        if (!m_file.good())
+        {
+            ISX_THROW(isx::ExceptionFileIO, "Error reading vessel correlation triptych.");
+        }
+        return true;
+    }
+
     SpFTrace_t
     VesselSetFile::readCenterTrace(const isize_t inVesselId)
     {
@@ -286,6 +346,7 @@ namespace isx
             return nullptr;
         }
 
+        PooledFileHandle::Lease lease(m_fileHandle);
         seekToVessel(inVesselId);
 
         // Calculate bytes till beginning of vessel data
@@ -721,6 +782,50 @@ namespace isx
         m_numVessels = m_vesselNames.size();
     }
 
+    bool
+    VesselSetFile::probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata)
+    {
+        std::ifstream file(inFileName, std::ios::binary);
+        if (!file.good() || !file.is_open())
+        {
+            ISX_THROW(isx::ExceptionFileIO,
+                "Failed to open vessel set file for reading (", inFileName, ")", " with error: ", getSystemErrorString());
+        }
+        std::ios::pos_type headerOffset;
+        json j = readJsonHeaderAtEnd(file, headerOffset);
+
+        try
+        {
+            DataSet::Type type = DataSet::Type(size_t(j["type"]));
+            if (type != DataSet::Type::VESSELSET)
+            {
+                ISX_THROW(isx::ExceptionDataIO,
+                        "Expected type to be VesselSet. Instead got ", size_t(type), ".");
+            }
+
+            auto version = j["fileVersion"].get<size_t>();
+            outMetadata.m_timingInfo = convertJsonToTimingInfo(j["timingInfo"]);
+            outMetadata.m_spacingInfo = convertJsonToSpacingInfo(j["spacingInfo"]);
+            outMetadata.m_dataType = DataType::F32;
+
+            json extraProperties = nullptr;
+            if ((version >= 5) && j.find("extraProperties") != j.end())
+            {
+                extraProperties = j["extraProperties"];
+            }
+            outMetadata.m_extraProperties = extraProperties.dump();
+        }
+        catch (const std::exception & error)
+        {
+            ISX_THROW(isx::ExceptionDataIO, "Error parsing vessel set header: ", error.what());
+        }
+        catch (...)
+        {
+            ISX_THROW(isx::ExceptionDataIO, "Unknown error while parsing vessel set header.");
+        }
+        return true;
+    }
+
     void
     VesselSetFile::writeHeader()
     {
@@ -9,11 +9,14 @@
 #include "isxTrace.h"
 #include "isxJsonUtils.h"
 #include "isxVesselSet.h"
+#include "isxFileHandlePool.h"
 
 
 namespace isx
 {
 
+struct ProbedMetadata;
+
 /// A class for a file containing all vessels extracted from a movie
 ///
 class VesselSetFile
@@ -37,6 +40,16 @@ public:
     /// \throw  isx::ExceptionDataIO    If parsing the vessel set file fails.
     VesselSetFile(const std::string & inFileName, bool enableWrite = false);
 
+    /// Read the meta data of a vessel set file from its header only.
+    ///
+    /// \param  inFileName  The name of the vessel set file.
+    /// \param  outMetadata The meta data read from the header.
+    /// \return             True, as the meta data of a vessel set is always in its header.
+    ///
+    /// \throw  isx::ExceptionFileIO    If reading the vessel set file fails.
+    /// \throw  isx::ExceptionDataIO    If parsing the vessel set file header fails.
+    static bool probeMetadata(const std::string & inFileName, ProbedMetadata & outMetadata);
+
     /// Write constructor.
     ///
     /// This opens a new file, writes header information.
@@ -106,6 +119,22 @@ public:
     /// \throw  isx::ExceptionFileIO    If trying to access nonexistent vessel or reading fails.
     SpVesselCorrelations_t readCorrelations(isize_t inVesselId, isize_t inFrameNumber);
 
+    /// Read the correlation triptychs of a range of velocity measurements of a vessel
+    /// with a single read.
+    ///
+    /// The triptychs are written one after the other in the same layout as
+    /// VesselCorrelations::getValues, so the buffer must have space for
+    /// 3 * (inEndFrame - inBeginFrame) correlation heatmaps.
+    ///
+    /// \param  inVesselId      The vessel of interest.
+    /// \param  inBeginFrame    The index of the first velocity measurement to read.
+    /// \param  inEndFrame      One past the index of the last velocity measurement to read.
+    /// \param  outValues       The buffer to read into.
+    /// \return                 False if no correlation triptychs are saved, true otherwise.
+    /// \throw  isx::ExceptionFileIO    If trying to access nonexistent vessel or reading fails.
+    /// \throw  isx::ExceptionDataIO    If the range of velocity measurements is invalid.
+    bool readCorrelationsRange(isize_t inVesselId, isize_t inBeginFrame, isize_t inEndFrame, float * outValues);
+
     /// \return the center trace for the input vessel
     /// \throw  isx::ExceptionFileIO    If trying to access nonexistent vessel or reading fails.
     SpFTrace_t readCenterTrace(const isize_t inVesselId);
@@ -296,6 +325,9 @@ private:
     /// The stream open mode
     std::ios_base::openmode m_openmode;
 
+    /// The pool entry of the file stream, which is only managed when reading.
+    PooledFileHandle m_fileHandle;
+
     bool m_fileClosedForWriting = false;
 
     const static size_t s_version = 5;
@@ -26,10 +26,10 @@ namespace isx
             return;
         }
 
-        for(const auto &fn : inFileNames)
+        m_vesselSets = openSeriesMembers<SpVesselSet_t>(inFileNames, [&inFileNames, enableWrite](const isize_t inIndex)
         {
-            m_vesselSets.emplace_back(readVesselSet(fn, enableWrite));
-        }
+            return readVesselSet(inFileNames[inIndex], enableWrite);
+        });
 
         std::sort(m_vesselSets.begin(), m_vesselSets.end(), [](SpVesselSet_t a, SpVesselSet_t b)
         {
@@ -351,6 +351,48 @@ namespace isx
             });
     }
 
+    bool
+    VesselSetSeries::getCorrelationsRange(isize_t inIndex, isize_t inBeginFrame, isize_t inEndFrame, float * outValues)
+    {
+        if (inBeginFrame > inEndFrame || inEndFrame > m_gaplessTimingInfo.getNumTimes())
+        {
+            ISX_THROW(ExceptionDataIO, "The range of frames [", inBeginFrame, ", ", inEndFrame,
+                    ") is out of range (0-", m_gaplessTimingInfo.getNumTimes(), ").");
+        }
+
+        if (!isCorrelationSaved())
+        {
+            return false;
+        }
+
+        if (inBeginFrame == inEndFrame)
+        {
+            return true;
+        }
+
+        const isize_t numValuesPerFrame = getCorrelationSize(inIndex).getWidth() * getCorrelationSize(inIndex).getHeight() * 3;
+        const TimingInfos_t & tis = getTimingInfosForSeries();
+
+        size_t vesselSetIndex = 0;
+        size_t frameIndex = 0;
+        std::tie(vesselSetIndex, frameIndex) = getSegmentAndLocalIndex(tis, inBeginFrame);
+
+        // Split the range into one read per vessel set
+        isize_t numFramesLeft = inEndFrame - inBeginFrame;
+        float * values = outValues;
+        while (numFramesLeft > 0)
+        {
+            ISX_ASSERT(vesselSetIndex < m_vesselSets.size());
+            const isize_t numFrames = std::min(numFramesLeft, tis[vesselSetIndex].getNumTimes() - frameIndex);
+            m_vesselSets[vesselSetIndex]->getCorrelationsRange(inIndex, frameIndex, frameIndex + numFrames, values);
+            values += numFrames * numValuesPerFrame;
+            numFramesLeft -= numFrames;
+            vesselSetIndex++;
+            frameIndex = 0;
+        }
+        return true;
+    }
+
     SpFTrace_t
     VesselSetSeries::getCenterTrace(isize_t inIndex)
     {
@@ -289,6 +289,38 @@ VesselSetSimple::getCorrelationsAsync(isize_t inIndex, isize_t inFrameNumber, Ve
     m_corrIoTaskTracker->schedule(getCorrelationsCB, inCallback);
 }
 
+bool
+VesselSetSimple::getCorrelationsRange(isize_t inIndex, isize_t inBeginFrame, isize_t inEndFrame, float * outValues)
+{
+    // Read on the IoQueue, so that this does not race with asynchronous reads of the file.
+    std::shared_ptr<VesselSetFile> file = m_file;
+    bool saved = false;
+    Mutex mutex;
+    ConditionVariable cv;
+    mutex.lock("VesselSetSimple::getCorrelationsRange");
+    auto readIoTask = std::make_shared<IoTask>(
+        [file, inIndex, inBeginFrame, inEndFrame, outValues, &saved]()
+        {
+            saved = file->readCorrelationsRange(inIndex, inBeginFrame, inEndFrame, outValues);
+        },
+        [&cv, &mutex](AsyncTaskStatus)
+        {
+            // will only be able to take lock when client reaches cv.wait
+            mutex.lock("VesselSetSimple::getCorrelationsRange finished");
+            mutex.unlock();
+            cv.notifyOne();
+        });
+    readIoTask->schedule();
+    cv.wait(mutex);
+    mutex.unlock();
+
+    if (readIoTask->getTaskStatus() == AsyncTaskStatus::ERROR_EXCEPTION)
+    {
+        std::rethrow_exception(readIoTask->getExceptionPtr());
+    }
+    return saved;
+}
+
 SpFTrace_t
 VesselSetSimple::getCenterTrace(isize_t inIndex)
 {
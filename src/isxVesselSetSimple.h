@@ -114,6 +114,9 @@ public:
     void
     getCorrelationsAsync(isize_t inIndex, isize_t inFrameNumber, VesselSetGetCorrelationsCB_t inCallback) override;
 
+    bool
+    getCorrelationsRange(isize_t inIndex, isize_t inBeginFrame, isize_t inEndFrame, float * outValues) override;
+
     SpFTrace_t
     getCenterTrace(isize_t inIndex) override;
 
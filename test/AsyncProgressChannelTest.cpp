@@ -0,0 +1,171 @@
+#include "isxAsyncProgressChannel.h"
+#include "isxAsyncTask.h"
+#include "isxConditionVariable.h"
+#include "isxMutex.h"
+#include "isxStopWatch.h"
+#include "isxLog.h"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("AsyncProgressChannel", "[core-internal]")
+{
+    SECTION("The first check-in is published")
+    {
+        isx::AsyncProgressChannel channel;
+        REQUIRE(channel.update(0.0f));
+        REQUIRE(channel.takeLatest() == 0.0f);
+    }
+
+    SECTION("Check-ins are coalesced while a publication is pending")
+    {
+        isx::AsyncProgressChannel channel(0, 0.0f);
+        REQUIRE(channel.update(0.1f));
+        REQUIRE(!channel.update(0.2f));
+        REQUIRE(!channel.update(0.5f));
+        REQUIRE(channel.takeLatest() == 0.5f);
+        REQUIRE(channel.update(0.6f));
+        REQUIRE(channel.takeLatest() == 0.6f);
+    }
+
+    SECTION("Small changes are rate limited")
+    {
+        isx::AsyncProgressChannel channel(1, 0.5f);
+        REQUIRE(channel.update(0.1f));
+        channel.takeLatest();
+        REQUIRE(!channel.update(0.2f));
+        REQUIRE(!channel.update(0.3f));
+    }
+
+    SECTION("Significant changes and completion are published regardless of time")
+    {
+        isx::AsyncProgressChannel channel(1, 0.25f);
+        REQUIRE(channel.update(0.1f));
+        channel.takeLatest();
+        REQUIRE(!channel.update(0.2f));
+        REQUIRE(channel.update(0.4f));
+        REQUIRE(channel.takeLatest() == 0.4f);
+        REQUIRE(channel.update(1.0f));
+        REQUIRE(channel.takeLatest() == 1.0f);
+    }
+
+    SECTION("Small changes are published after the minimum interval")
+    {
+        isx::AsyncProgressChannel channel(100, 1.0f);
+        REQUIRE(channel.update(0.1f));
+        channel.takeLatest();
+        REQUIRE(!channel.update(0.2f));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(channel.update(0.3f));
+        REQUIRE(channel.takeLatest() == 0.3f);
+    }
+
+    SECTION("Flush publishes the last coalesced progress")
+    {
+        isx::AsyncProgressChannel channel(1, 0.5f);
+        REQUIRE(channel.update(0.1f));
+        channel.takeLatest();
+        REQUIRE(!channel.update(0.2f));
+        REQUIRE(channel.flush());
+        REQUIRE(channel.takeLatest() == 0.2f);
+        REQUIRE(!channel.flush());
+    }
+
+    SECTION("Cancel")
+    {
+        isx::AsyncProgressChannel channel;
+        REQUIRE(!channel.isCancelPending());
+        channel.cancel();
+        REQUIRE(channel.isCancelPending());
+    }
+
+    SECTION("Number of publications for many check-ins")
+    {
+        const size_t numCheckIns = 10000000;
+        isx::AsyncProgressChannel channel;
+        size_t numPublished = 0;
+
+        isx::StopWatch sw;
+        sw.start();
+        for (size_t i = 0; i < numCheckIns; ++i)
+        {
+            if (channel.update(float(i) / float(numCheckIns)))
+            {
+                channel.takeLatest();
+                ++numPublished;
+            }
+        }
+        sw.stop();
+
+        const float durationInMs = sw.getElapsedMs();
+        // At most one publication per significant change, plus those allowed by time.
+        const size_t maxPublished = size_t(1.0f / isx::AsyncProgressChannel::s_defaultMinProgressDelta) + 1
+            + size_t(durationInMs / 1000.0f * isx::AsyncProgressChannel::s_defaultMaxPublishesPerSecond) + 1;
+        REQUIRE(numPublished <= maxPublished);
+
+        ISX_LOG_INFO(
+                numCheckIns, " check-ins of a progress channel took ", durationInMs, " ms. ",
+                "That's ", double(numCheckIns) / std::max(double(durationInMs), 1e-3) * 1000.0, " check-ins per second ",
+                "with ", numPublished, " publications.");
+    }
+}
+
+TEST_CASE("AsyncTask-checkInOverhead", "[core]")
+{
+    isx::CoreInitialize();
+
+    SECTION("Check in many times from a task with a progress callback")
+    {
+        const size_t numCheckIns = 10000000;
+        float durationInMs = 0.f;
+        bool cancelled = false;
+
+        isx::Mutex mutex;
+        isx::ConditionVariable cv;
+        bool finished = false;
+        isx::AsyncTaskStatus finishedStatus = isx::AsyncTaskStatus::PENDING;
+
+        isx::SpAsyncTaskHandle_t task = std::make_shared<isx::AsyncTask>(
+            [&](isx::AsyncCheckInCB_t inCheckInCB)
+            {
+                isx::StopWatch sw;
+                sw.start();
+                for (size_t i = 0; i < numCheckIns; ++i)
+                {
+                    cancelled = inCheckInCB(float(i) / float(numCheckIns)) || cancelled;
+                }
+                sw.stop();
+                durationInMs = sw.getElapsedMs();
+                return isx::AsyncTaskStatus::COMPLETE;
+            },
+            [](float) {},
+            [&](isx::AsyncTaskStatus inStatus)
+            {
+                mutex.lock("check-in overhead finished");
+                finishedStatus = inStatus;
+                finished = true;
+                mutex.unlock();
+                cv.notifyOne();
+            },
+            isx::AsyncTaskThreadForFinishedCB::USE_WORKER);
+
+        mutex.lock("check-in overhead");
+        task->schedule();
+        while (!finished)
+        {
+            cv.wait(mutex);
+        }
+        mutex.unlock();
+
+        REQUIRE(finishedStatus == isx::AsyncTaskStatus::COMPLETE);
+        REQUIRE(!cancelled);
+
+        ISX_LOG_INFO(
+                numCheckIns, " check-ins of an async task took ", durationInMs, " ms. ",
+                "That's ", double(numCheckIns) / std::max(double(durationInMs), 1e-3) * 1000.0, " check-ins per second.");
+    }
+
+    isx::CoreShutdown();
+}
@@ -3,6 +3,8 @@
 #include "isxBehavMovieFile.h"
 #include "isxDataSet.h"
 #include "isxLog.h"
+#include "isxMovieFactory.h"
+#include "isxMovieCompressedAviExporter.h"
 #include "isxTest.h"
 
 #include "catch.hpp"
@@ -58,3 +60,57 @@ TEST_CASE("BehavMovieFile", "[core]")
 
     isx::CoreShutdown();
 }
+
+TEST_CASE("BehavMovieFile-streamIndex", "[core]")
+{
+    const std::string inputFileName = g_resources["unitTestDataPath"] + "/behavStreamIndexInput.isxd";
+    const std::string mp4FileName = g_resources["unitTestDataPath"] + "/behavStreamIndex.mp4";
+    std::remove(inputFileName.c_str());
+    std::remove(mp4FileName.c_str());
+
+    isx::CoreInitialize();
+
+    const isx::TimingInfo timingInfo(isx::Time(), isx::DurationInSeconds(50, 1000), 47);
+    const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(64, 48));
+    {
+        isx::SpWritableMovie_t movie = isx::writeMosaicMovie(inputFileName, timingInfo, spacingInfo, isx::DataType::U16);
+        for (isx::isize_t f = 0; f < timingInfo.getNumTimes(); ++f)
+        {
+            isx::SpVideoFrame_t frame = movie->makeVideoFrame(f);
+            uint16_t * pixels = frame->getPixelsAsU16();
+            for (isx::isize_t p = 0; p < spacingInfo.getTotalNumPixels(); ++p)
+            {
+                pixels[p] = uint16_t((p * 7 + f * 13) % 4096);
+            }
+            movie->writeFrame(frame);
+        }
+        movie->closeForWriting();
+    }
+    isx::runMovieCompressedAviExporter(isx::MovieCompressedAviExporterParams({isx::readMovie(inputFileName)}, mp4FileName, 0.1));
+
+    SECTION("The stream index of an mp4 gives the same properties as scanning all packets")
+    {
+        isx::DataSet::Properties indexProps;
+        isx::DataSet::Properties scanProps;
+        REQUIRE(isx::BehavMovieFile::getBehavMovieProperties(mp4FileName, indexProps, nullptr, true));
+        REQUIRE(isx::BehavMovieFile::getBehavMovieProperties(mp4FileName, scanProps, nullptr, false));
+
+        REQUIRE(indexProps.at(isx::DataSet::PROP_BEHAV_NUM_FRAMES).value<int64_t>() == int64_t(timingInfo.getNumTimes()));
+        REQUIRE(indexProps.at(isx::DataSet::PROP_BEHAV_NUM_FRAMES).value<int64_t>()
+                == scanProps.at(isx::DataSet::PROP_BEHAV_NUM_FRAMES).value<int64_t>());
+        REQUIRE(indexProps.at(isx::DataSet::PROP_BEHAV_GOP_SIZE).value<int64_t>()
+                == scanProps.at(isx::DataSet::PROP_BEHAV_GOP_SIZE).value<int64_t>());
+    }
+
+    SECTION("Cancelling while getting the properties from the stream index")
+    {
+        isx::DataSet::Properties props;
+        REQUIRE(!isx::BehavMovieFile::getBehavMovieProperties(mp4FileName, props, [](float) { return true; }));
+        REQUIRE(props.find(isx::DataSet::PROP_BEHAV_NUM_FRAMES) == props.end());
+    }
+
+    isx::CoreShutdown();
+
+    std::remove(inputFileName.c_str());
+    std::remove(mp4FileName.c_str());
+}
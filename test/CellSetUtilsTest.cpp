@@ -0,0 +1,292 @@
+#include "isxCellSetUtils.h"
+#include "isxCellSetFactory.h"
+#include "isxImageKernels.h"
+#include "isxException.h"
+#include "catch.hpp"
+#include "isxTest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+float
+getTestPixel(const isx::isize_t inCell, const isx::isize_t inPixel)
+{
+    return float((inPixel * 7 + inCell * 13) % 11);
+}
+
+/// Cells are accepted, undecided and rejected in turn.
+isx::CellSet::CellStatus
+getTestStatus(const isx::isize_t inCell)
+{
+    switch (inCell % 3)
+    {
+        case 0: return isx::CellSet::CellStatus::ACCEPTED;
+        case 1: return isx::CellSet::CellStatus::UNDECIDED;
+        default: return isx::CellSet::CellStatus::REJECTED;
+    }
+}
+
+void
+writeTestCellSet(const std::string & inFileName, const isx::SpacingInfo & inSpacingInfo, const isx::isize_t inNumCells)
+{
+    const isx::TimingInfo timingInfo(isx::Time(), isx::DurationInSeconds(50, 1000), 5);
+    isx::SpCellSet_t cellSet = isx::writeCellSet(inFileName, timingInfo, inSpacingInfo);
+    for (isx::isize_t c = 0; c < inNumCells; ++c)
+    {
+        isx::SpImage_t image = std::make_shared<isx::Image>(
+                inSpacingInfo, sizeof(float) * inSpacingInfo.getNumColumns(), 1, isx::DataType::F32);
+        float * pixels = image->getPixelsAsF32();
+        for (isx::isize_t p = 0; p < inSpacingInfo.getTotalNumPixels(); ++p)
+        {
+            pixels[p] = getTestPixel(c, p);
+        }
+        isx::SpFTrace_t trace = std::make_shared<isx::FTrace_t>(timingInfo);
+        cellSet->writeImageAndTrace(c, image, trace);
+        cellSet->setCellStatus(c, getTestStatus(c));
+    }
+    cellSet->closeForWriting();
+}
+
+/// Compute a cell map one cell and one pixel at a time.
+std::vector<float>
+getExpectedCellMap(
+        const isx::isize_t inNumCells,
+        const isx::isize_t inNumPixels,
+        const bool inAcceptedCellsOnly,
+        const bool inNormalizeImages,
+        const float inNormalizedThreshold)
+{
+    std::vector<float> map(inNumPixels, 0.f);
+    for (isx::isize_t c = 0; c < inNumCells; ++c)
+    {
+        const isx::CellSet::CellStatus status = getTestStatus(c);
+        if ((inAcceptedCellsOnly && status == isx::CellSet::CellStatus::UNDECIDED)
+            || (status == isx::CellSet::CellStatus::REJECTED))
+        {
+            continue;
+        }
+
+        float maxVal = 0.f;
+        for (isx::isize_t p = 0; p < inNumPixels; ++p)
+        {
+            maxVal = std::max(maxVal, getTestPixel(c, p));
+        }
+        float sum = 0.f;
+        for (isx::isize_t p = 0; p < inNumPixels; ++p)
+        {
+            const float pixel = getTestPixel(c, p);
+            sum += (pixel < inNormalizedThreshold * maxVal) ? 0.f : pixel;
+        }
+        for (isx::isize_t p = 0; p < inNumPixels; ++p)
+        {
+            const float pixel = getTestPixel(c, p);
+            if (!inNormalizeImages)
+            {
+                map[p] += pixel;
+            }
+            else if (pixel >= inNormalizedThreshold * maxVal)
+            {
+                map[p] += pixel / sum;
+            }
+        }
+    }
+    return map;
+}
+
+void
+requireCellMap(const isx::SpImage_t & inMap, const std::vector<float> & inExpected)
+{
+    REQUIRE(inMap->getSpacingInfo().getTotalNumPixels() == inExpected.size());
+    const float * pixels = inMap->getPixelsAsF32();
+    for (isx::isize_t p = 0; p < inExpected.size(); ++p)
+    {
+        REQUIRE(pixels[p] == Approx(inExpected[p]).epsilon(1e-5));
+    }
+}
+
+} // namespace
+
+TEST_CASE("ImageKernels", "[core-internal]")
+{
+    const std::vector<isx::isize_t> numValues = {0, 1, 3, 4, 15, 16, 17, 1000, 1003};
+    const isx::isize_t maxNumValues = numValues.back();
+
+    std::vector<float> f32Values(maxNumValues);
+    std::vector<uint16_t> u16Values(maxNumValues);
+    std::vector<uint8_t> u8Values(maxNumValues);
+    for (isx::isize_t i = 0; i < maxNumValues; ++i)
+    {
+        f32Values[i] = float(int64_t((i * 7919) % 1009) - 500) / 8.f;
+        u16Values[i] = uint16_t((i * 40503) % 65536);
+        u8Values[i] = uint8_t((i * 151) % 256);
+    }
+
+    const std::vector<isx::ImageKernelsIsa> allIsas =
+    {
+        isx::ImageKernelsIsa::SCALAR,
+        isx::ImageKernelsIsa::SSE2,
+        isx::ImageKernelsIsa::NEON,
+        isx::ImageKernelsIsa::AVX2
+    };
+    std::vector<isx::ImageKernelsIsa> isas;
+    for (const auto isa : allIsas)
+    {
+        if (isx::isImageKernelsIsaSupported(isa))
+        {
+            isas.push_back(isa);
+        }
+    }
+    REQUIRE(isx::isImageKernelsIsaSupported(isx::getBestImageKernelsIsa()));
+
+    for (const auto isa : isas)
+    {
+        isx::setImageKernelsIsa(isa);
+        REQUIRE(isx::getImageKernelsIsa() == isa);
+
+        for (const isx::isize_t n : numValues)
+        {
+            float expectedF32Min = std::numeric_limits<float>::max();
+            float expectedF32Max = std::numeric_limits<float>::lowest();
+            uint16_t expectedU16Min = std::numeric_limits<uint16_t>::max();
+            uint16_t expectedU16Max = 0;
+            uint8_t expectedU8Min = std::numeric_limits<uint8_t>::max();
+            uint8_t expectedU8Max = 0;
+            float expectedSum = 0.f;
+            for (isx::isize_t i = 0; i < n; ++i)
+            {
+                expectedF32Min = std::min(expectedF32Min, f32Values[i]);
+                expectedF32Max = std::max(expectedF32Max, f32Values[i]);
+                expectedU16Min = std::min(expectedU16Min, u16Values[i]);
+                expectedU16Max = std::max(expectedU16Max, u16Values[i]);
+                expectedU8Min = std::min(expectedU8Min, u8Values[i]);
+                expectedU8Max = std::max(expectedU8Max, u8Values[i]);
+                expectedSum += (f32Values[i] < 10.f) ? 0.f : f32Values[i];
+            }
+
+            float f32Min, f32Max;
+            isx::getMinMaxF32(f32Values.data(), n, f32Min, f32Max);
+            REQUIRE(f32Min == expectedF32Min);
+            REQUIRE(f32Max == expectedF32Max);
+
+            uint16_t u16Min, u16Max;
+            isx::getMinMaxU16(u16Values.data(), n, u16Min, u16Max);
+            REQUIRE(u16Min == expectedU16Min);
+            REQUIRE(u16Max == expectedU16Max);
+
+            uint8_t u8Min, u8Max;
+            isx::getMinMaxU8(u8Values.data(), n, u8Min, u8Max);
+            REQUIRE(u8Min == expectedU8Min);
+            REQUIRE(u8Max == expectedU8Max);
+
+            // The values are multiples of 1/8 that are summed exactly in any order.
+            REQUIRE(isx::sumThresholdedF32(f32Values.data(), n, 10.f) == expectedSum);
+
+            std::vector<float> sums(n, 1.f);
+            std::vector<float> thresholded(n);
+            std::vector<uint8_t> converted(n);
+            isx::addF32(f32Values.data(), n, sums.data());
+            isx::addThresholdedAndDividedF32(f32Values.data(), n, 10.f, 3.f, sums.data());
+            isx::thresholdAndDivideF32(f32Values.data(), n, 10.f, 3.f, thresholded.data());
+            isx::convertF32toU8(f32Values.data(), n, -62.5f, 2.f, converted.data());
+            for (isx::isize_t i = 0; i < n; ++i)
+            {
+                const float expectedThresholded = (f32Values[i] < 10.f) ? 0.f : f32Values[i] / 3.f;
+                REQUIRE(thresholded[i] == expectedThresholded);
+                REQUIRE(sums[i] == (1.f + f32Values[i]) + expectedThresholded);
+                REQUIRE(converted[i] == uint8_t((f32Values[i] + 62.5f) * 2.f));
+            }
+        }
+    }
+
+    SECTION("Unsupported instruction set")
+    {
+        for (const auto isa : allIsas)
+        {
+            if (!isx::isImageKernelsIsaSupported(isa))
+            {
+                REQUIRE_THROWS_AS(isx::setImageKernelsIsa(isa), isx::ExceptionUserInput);
+            }
+        }
+    }
+
+    isx::setImageKernelsIsa(isx::getBestImageKernelsIsa());
+}
+
+TEST_CASE("CellSetUtils", "[core]")
+{
+    std::string fileName = g_resources["unitTestDataPath"] + "/cellset_utils.isxd";
+    std::remove(fileName.c_str());
+
+    isx::CoreInitialize();
+
+    SECTION("Cell map of more cells than are read at once")
+    {
+        const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(8, 6));
+        const isx::isize_t numCells = 200;
+        writeTestCellSet(fileName, spacingInfo, numCells);
+        const isx::SpCellSet_t cellSet = isx::readCellSet(fileName);
+        const isx::isize_t numPixels = spacingInfo.getTotalNumPixels();
+
+        requireCellMap(isx::cellSetToCellMap(cellSet, false, false),
+                getExpectedCellMap(numCells, numPixels, false, false, 0.f));
+        requireCellMap(isx::cellSetToCellMap(cellSet, true, false),
+                getExpectedCellMap(numCells, numPixels, true, false, 0.f));
+        requireCellMap(isx::cellSetToCellMap(cellSet, false, true, 0.5f),
+                getExpectedCellMap(numCells, numPixels, false, true, 0.5f));
+    }
+
+    SECTION("Cell map accumulated in tiles on multiple threads")
+    {
+        const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(320, 256));
+        const isx::isize_t numCells = 6;
+        writeTestCellSet(fileName, spacingInfo, numCells);
+        const isx::SpCellSet_t cellSet = isx::readCellSet(fileName);
+        const isx::isize_t numPixels = spacingInfo.getTotalNumPixels();
+
+        const std::vector<float> expected = getExpectedCellMap(numCells, numPixels, false, true, 0.3f);
+        const isx::SpImage_t serialMap = isx::cellSetToCellMap(cellSet, false, true, 0.3f, 1);
+        const isx::SpImage_t parallelMap = isx::cellSetToCellMap(cellSet, false, true, 0.3f, 4);
+        requireCellMap(serialMap, expected);
+        REQUIRE(std::memcmp(serialMap->getPixels(), parallelMap->getPixels(), serialMap->getImageSizeInBytes()) == 0);
+    }
+
+    SECTION("Normalizing and thresholding does not modify the image")
+    {
+        const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(8, 6));
+        writeTestCellSet(fileName, spacingInfo, 1);
+        const isx::SpImage_t image = isx::readCellSet(fileName)->getImage(0);
+
+        const isx::SpImage_t normalized = isx::normalizeAndThresholdImage(image, 0.5f);
+        requireCellMap(normalized, getExpectedCellMap(1, spacingInfo.getTotalNumPixels(), false, true, 0.5f));
+        for (isx::isize_t p = 0; p < spacingInfo.getTotalNumPixels(); ++p)
+        {
+            REQUIRE(image->getPixelsAsF32()[p] == getTestPixel(0, p));
+        }
+    }
+
+    SECTION("Convert an image to bytes")
+    {
+        const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(8, 6));
+        writeTestCellSet(fileName, spacingInfo, 1);
+        const isx::SpImage_t image = isx::readCellSet(fileName)->getImage(0);
+
+        float minVal, maxVal;
+        isx::getImageMinMax(*image, minVal, maxVal);
+        REQUIRE(minVal == 0.f);
+        REQUIRE(maxVal == 10.f);
+
+        const isx::SpImage_t converted = isx::convertImageF32toU8(image);
+        for (isx::isize_t p = 0; p < spacingInfo.getTotalNumPixels(); ++p)
+        {
+            REQUIRE(converted->getPixelsAsU8()[p] == uint8_t(getTestPixel(0, p) * 25.5f));
+        }
+    }
+
+    isx::CoreShutdown();
+    std::remove(fileName.c_str());
+}
@@ -0,0 +1,82 @@
+#include "isxCoalescingJsonWriter.h"
+#include "isxJsonUtils.h"
+#include "isxTest.h"
+#include "catch.hpp"
+
+#include <fstream>
+#include <thread>
+
+namespace
+{
+
+isx::json
+readJsonFile(const std::string & inFileName)
+{
+    std::ifstream file(inFileName);
+    return isx::readJson(file);
+}
+
+} // namespace
+
+TEST_CASE("CoalescingJsonWriter", "[core-internal]")
+{
+    const std::string fileName = g_resources["unitTestDataPath"] + "/coalescing.json";
+    std::remove(fileName.c_str());
+
+    SECTION("Requests made within the interval are coalesced into the latest one")
+    {
+        isx::CoalescingJsonWriter writer(std::chrono::milliseconds(60000));
+        writer.write(fileName, isx::json({{"value", 0}}));
+        writer.flush();
+        REQUIRE(readJsonFile(fileName).at("value") == 0);
+
+        for (int i = 1; i <= 100; ++i)
+        {
+            writer.write(fileName, isx::json({{"value", i}}));
+        }
+        writer.flush();
+
+        REQUIRE(readJsonFile(fileName).at("value") == 100);
+        const isx::CoalescingJsonWriterStats stats = writer.getStats();
+        REQUIRE(stats.m_numRequests == 101);
+        REQUIRE(stats.m_numWrites == 2);
+    }
+
+    SECTION("The pending request is written on destruction")
+    {
+        {
+            isx::CoalescingJsonWriter writer(std::chrono::milliseconds(60000));
+            writer.write(fileName, isx::json({{"value", 1}}));
+            writer.flush();
+            writer.write(fileName, isx::json({{"value", 2}}));
+        }
+        REQUIRE(readJsonFile(fileName).at("value") == 2);
+    }
+
+    SECTION("A cancelled request is not written")
+    {
+        isx::CoalescingJsonWriter writer(std::chrono::milliseconds(60000));
+        writer.write(fileName, isx::json({{"value", 1}}));
+        writer.flush();
+        writer.write(fileName, isx::json({{"value", 2}}));
+        writer.cancel();
+        writer.flush();
+
+        REQUIRE(readJsonFile(fileName).at("value") == 1);
+        REQUIRE(writer.getStats().m_numWrites == 1);
+    }
+
+    SECTION("Requests are written without flushing once the interval has passed")
+    {
+        isx::CoalescingJsonWriter writer(std::chrono::milliseconds(1));
+        writer.write(fileName, isx::json({{"value", 1}}));
+        for (int i = 0; i < 500 && writer.getStats().m_numWrites == 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE(writer.getStats().m_numWrites == 1);
+        REQUIRE(readJsonFile(fileName).at("value") == 1);
+    }
+
+    std::remove(fileName.c_str());
+}
@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <cstring>
+#include <fstream>
 
 namespace
 {
@@ -649,3 +650,85 @@ TEST_CASE("MOS-1690", "[core][importCsvTraces]")
 
     isx::CoreShutdown();
 }
+
+TEST_CASE("importCsvTraces-manyRows", "[core][importCsvTraces]")
+{
+    const std::string outputDataDir = g_resources["unitTestDataPath"] + "/CSV_traces/many_rows";
+    isx::removeDirectory(outputDataDir);
+    isx::makeDirectory(outputDataDir);
+
+    isx::CoreInitialize();
+
+    // Enough rows to be parsed by several threads.
+    const size_t numTimes = 50000;
+
+    isx::CsvTraceImporterParams params;
+    params.m_inputFile = outputDataDir + "/many_rows.csv";
+    params.m_outputFile = outputDataDir + "/many_rows.isxd";
+    params.m_startTime = isx::Time(2018, 1, 18, 15, 23, 4);
+    params.m_timeUnit = isx::DurationInSeconds(1, 1000);
+
+    const auto writeCsv = [&params, numTimes](const std::map<size_t, std::string> & inBadRows)
+    {
+        std::ofstream file(params.m_inputFile, std::ios::binary | std::ios::trunc);
+        file << "Time,A,B\r\n";
+        for (size_t i = 0; i < numTimes; ++i)
+        {
+            const auto badRow = inBadRows.find(i);
+            if (badRow != inBadRows.end())
+            {
+                file << badRow->second << "\r\n";
+            }
+            else
+            {
+                file << (i * 10) << "," << (float(i) / 8.f) << "," << (i % 2) << "\r\n";
+            }
+        }
+    };
+
+    SECTION("Values")
+    {
+        writeCsv({{7, "70,,1"}});
+        REQUIRE(isx::runCsvTraceImporter(params, nullptr, [](float){return false;}) == isx::AsyncTaskStatus::COMPLETE);
+
+        const isx::SpGpio_t traces = isx::readGpio(params.m_outputFile);
+        REQUIRE(traces->getChannelList() == std::vector<std::string>({"A", "B"}));
+
+        const std::map<isx::Time, float> expA =
+        {
+            {params.m_startTime, 0.f},
+            {params.m_startTime + isx::DurationInSeconds(7, 100), std::numeric_limits<float>::quiet_NaN()},
+            {params.m_startTime + isx::DurationInSeconds(12345, 100), 1543.125f},
+            {params.m_startTime + isx::DurationInSeconds(numTimes - 1, 100), float(numTimes - 1) / 8.f},
+        };
+        requireEqualValues(traces->getLogicalData("A"), numTimes, expA);
+
+        const std::map<isx::Time, float> expB =
+        {
+            {params.m_startTime, 0.f},
+            {params.m_startTime + isx::DurationInSeconds(12345, 100), 1.f},
+        };
+        requireEqualValues(traces->getLogicalData("B"), numTimes, expB);
+    }
+
+    SECTION("The first bad row is reported")
+    {
+        writeCsv({{30000, "300000,1,2,3"}, {45000, "x,1,0"}});
+        ISX_REQUIRE_EXCEPTION(
+                isx::runCsvTraceImporter(params, nullptr, [](float){return false;}),
+                isx::ExceptionUserInput,
+                "Number of columns in row 30001 (4) does not match number of columns in title row (3)."
+        );
+    }
+
+    SECTION("Cancel")
+    {
+        writeCsv({});
+        REQUIRE(isx::runCsvTraceImporter(params, nullptr, [](float){return true;}) == isx::AsyncTaskStatus::CANCELLED);
+        REQUIRE(!isx::pathExists(params.m_outputFile));
+    }
+
+    isx::removeDirectory(outputDataDir);
+
+    isx::CoreShutdown();
+}
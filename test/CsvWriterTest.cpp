@@ -0,0 +1,243 @@
+#include "isxCsvWriter.h"
+#include "isxTest.h"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <cstring>
+
+namespace
+{
+
+std::string
+formatFloatWithStream(const float inValue)
+{
+    std::ostringstream stream;
+    stream << std::setprecision(std::numeric_limits<float>::digits10 + 1) << inValue;
+    return stream.str();
+}
+
+std::string
+formatDoubleWithStream(const double inValue)
+{
+    std::ostringstream stream;
+    stream << std::setprecision(std::numeric_limits<double>::digits10 + 1) << inValue;
+    return stream.str();
+}
+
+std::string
+formatFloat(const float inValue)
+{
+    char chars[isx::s_maxFormattedNumberLength];
+    const size_t length = isx::formatFloatForCsv(inValue, chars);
+    return std::string(chars, length);
+}
+
+std::string
+formatDouble(const double inValue)
+{
+    char chars[isx::s_maxFormattedNumberLength];
+    const size_t length = isx::formatDoubleForCsv(inValue, chars);
+    return std::string(chars, length);
+}
+
+} // namespace
+
+TEST_CASE("CsvWriter-formatFloatForCsv", "[core-internal]")
+{
+    SECTION("Special values")
+    {
+        const std::vector<float> values =
+        {
+            0.f, -0.f, 1.f, -1.f, 0.5f, 10.f, 100.f, 1e6f, 1e7f, 9999999.f, 1234567.5f, 0.0001f, 0.00001f,
+            0.1f, 0.3f, 1.f / 3.f, 2.f / 3.f, 3.4028235e38f, 1.17549435e-38f, 1.4e-45f,
+            std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN(),
+        };
+        for (const auto v : values)
+        {
+            REQUIRE(formatFloat(v) == formatFloatWithStream(v));
+        }
+    }
+
+    SECTION("Random values")
+    {
+        std::mt19937 gen(0);
+        std::uniform_real_distribution<float> typical(-1000.f, 1000.f);
+        std::uniform_int_distribution<uint32_t> bits;
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            const float v = typical(gen);
+            REQUIRE(formatFloat(v) == formatFloatWithStream(v));
+
+            float w = 0.f;
+            const uint32_t b = bits(gen);
+            std::memcpy(&w, &b, sizeof(w));
+            REQUIRE(formatFloat(w) == formatFloatWithStream(w));
+        }
+    }
+}
+
+TEST_CASE("CsvWriter-formatDoubleForCsv", "[core-internal]")
+{
+    const std::vector<double> values = {0.0, -0.0, 0.05, 0.1 + 0.2, 1e-7, 123456.789, 1e17, -2.5e-300};
+    for (const auto v : values)
+    {
+        REQUIRE(formatDouble(v) == formatDoubleWithStream(v));
+    }
+}
+
+TEST_CASE("CsvWriter", "[core-internal]")
+{
+    SECTION("Output is the same as the stream")
+    {
+        std::ostringstream expected;
+        std::ostringstream actual;
+        {
+            // A small buffer so that it needs to be flushed several times.
+            isx::CsvWriter writer(actual, 64);
+            for (size_t i = 0; i < 100; ++i)
+            {
+                const double time = double(i) * 0.05;
+                const float value = float(i) / 7.f;
+                expected << std::setprecision(std::numeric_limits<double>::digits10 + 1) << time
+                         << ", " << "C" << i
+                         << ", " << std::setprecision(std::numeric_limits<float>::digits10 + 1) << value << "\n";
+
+                writer.appendDouble(time);
+                writer.appendSeparator();
+                writer.appendString("C" + std::to_string(i));
+                writer.appendSeparator();
+                writer.appendFloat(value);
+                writer.appendChar('\n');
+            }
+            writer.flush();
+        }
+        REQUIRE(actual.str() == expected.str());
+    }
+
+    SECTION("Destructor writes remaining text")
+    {
+        std::ostringstream actual;
+        {
+            isx::CsvWriter writer(actual);
+            writer.appendString("Time (s), C0");
+        }
+        REQUIRE(actual.str() == "Time (s), C0");
+    }
+
+    SECTION("Flush throws if writing fails")
+    {
+        std::ostringstream actual;
+        actual.setstate(std::ios::badbit);
+        isx::CsvWriter writer(actual);
+        writer.appendFloat(1.f);
+        ISX_REQUIRE_EXCEPTION(writer.flush(), isx::ExceptionFileIO, "Error writing to output file.");
+    }
+}
+
+TEST_CASE("CsvWriter-appendFixed", "[core-internal]")
+{
+    const std::vector<double> values =
+    {
+        0.0, -0.0, 0.0000005, -0.0000015, 0.282199, 1.9518, -12.5, 1696000000.123456, 1e17, -1.7976931348623157e308,
+    };
+    std::ostringstream expected;
+    std::ostringstream actual;
+    {
+        isx::CsvWriter writer(actual, 64);
+        for (const int precision : {0, 3, 6})
+        {
+            for (const auto v : values)
+            {
+                expected << std::fixed << std::setprecision(precision) << v << ",";
+                writer.appendFixed(v, precision);
+                writer.appendChar(',');
+            }
+        }
+    }
+    REQUIRE(actual.str() == expected.str());
+}
+
+TEST_CASE("CsvWriter-appendUnsigned", "[core-internal]")
+{
+    const std::vector<uint64_t> values = {0, 1, 9, 10, 1234567890123ull, std::numeric_limits<uint64_t>::max()};
+    std::ostringstream expected;
+    std::ostringstream actual;
+    {
+        isx::CsvWriter writer(actual);
+        for (const auto v : values)
+        {
+            expected << v << "\n";
+            writer.appendUnsigned(v);
+            writer.appendChar('\n');
+        }
+    }
+    REQUIRE(actual.str() == expected.str());
+}
+
+TEST_CASE("CsvWriter-writeCsvRows", "[core-internal]")
+{
+    isx::CoreInitialize();
+
+    const size_t numRows = 100000;
+    const size_t numValuesPerRow = 5;
+    const auto formatRow = [](isx::CsvWriter & outWriter, const size_t inRow)
+    {
+        outWriter.appendDouble(double(inRow) * 0.05);
+        for (size_t v = 1; v < numValuesPerRow; ++v)
+        {
+            outWriter.appendSeparator();
+            outWriter.appendFloat(float(inRow) / float(v + 6));
+        }
+        outWriter.appendChar('\n');
+    };
+
+    std::ostringstream expected;
+    {
+        isx::CsvWriter writer(expected);
+        for (size_t r = 0; r < numRows; ++r)
+        {
+            formatRow(writer, r);
+        }
+    }
+
+    for (const size_t numThreads : {1, 2, 3, 8})
+    {
+        std::ostringstream actual;
+        std::vector<size_t> checkIns;
+        {
+            isx::CsvWriter writer(actual);
+            const bool cancelled = isx::writeCsvRows(writer, numRows, numValuesPerRow, formatRow,
+                [&checkIns](const size_t inNumRowsWritten)
+                {
+                    checkIns.push_back(inNumRowsWritten);
+                    return false;
+                },
+                numThreads);
+            REQUIRE(!cancelled);
+        }
+        REQUIRE(actual.str() == expected.str());
+        REQUIRE(!checkIns.empty());
+        REQUIRE(std::is_sorted(checkIns.begin(), checkIns.end()));
+        REQUIRE(checkIns.back() == numRows);
+    }
+
+    SECTION("Cancel")
+    {
+        std::ostringstream actual;
+        isx::CsvWriter writer(actual);
+        const bool cancelled = isx::writeCsvRows(writer, numRows, numValuesPerRow, formatRow,
+            [](const size_t) { return true; }, 4);
+        writer.flush();
+        REQUIRE(cancelled);
+        REQUIRE(actual.str().size() < expected.str().size());
+    }
+
+    isx::CoreShutdown();
+}
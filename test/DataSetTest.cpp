@@ -7,6 +7,8 @@
 #include "isxCellSetFactory.h"
 #include "isxVariant.h"
 #include "isxPathUtils.h"
+#include "isxMetadataProbe.h"
+#include "isxCellSetFile.h"
 
 #include "catch.hpp"
 
@@ -460,3 +462,84 @@ TEST_CASE("DataSet-getMetadata", "[core][dataset]")
 
     isx::CoreShutdown();
 }
+
+TEST_CASE("DataSet-metaDataCache", "[core][dataset]")
+{
+    isx::CoreInitialize();
+
+    const isx::TimingInfo ti(isx::Time(2016, 8, 26, 10, 31, 26), isx::DurationInSeconds(50, 1000), 4);
+    const isx::SpacingInfo si(isx::SizeInPixels_t(2, 3));
+    const std::string filePath = g_resources["unitTestDataPath"] + "/DataSet-metaDataCache.isxd";
+
+    SECTION("Probe the meta data of a movie")
+    {
+        makeMovieDataSet("movie", filePath, ti, si);
+        const isx::SpMovie_t movie = isx::readMovie(filePath);
+
+        isx::ProbedMetadata probed;
+        REQUIRE(isx::probeMetadata(filePath, isx::DataSet::Type::MOVIE, probed));
+        REQUIRE(probed.m_timingInfo == movie->getTimingInfo());
+        REQUIRE(probed.m_spacingInfo == movie->getSpacingInfo());
+        REQUIRE(probed.m_dataType == movie->getDataType());
+        REQUIRE(probed.m_extraProperties == movie->getExtraProperties());
+    }
+
+    SECTION("Probe the meta data of a cell set")
+    {
+        std::remove(filePath.c_str());
+        {
+            isx::CellSetFile cellSetFile(filePath, ti, si);
+            cellSetFile.closeForWriting();
+        }
+        const isx::SpCellSet_t cellSet = isx::readCellSet(filePath);
+
+        isx::ProbedMetadata probed;
+        REQUIRE(isx::probeMetadata(filePath, isx::DataSet::Type::CELLSET, probed));
+        REQUIRE(probed.m_timingInfo == cellSet->getTimingInfo());
+        REQUIRE(probed.m_spacingInfo == cellSet->getSpacingInfo());
+        REQUIRE(probed.m_dataType == isx::DataType::F32);
+        REQUIRE(probed.m_extraProperties == cellSet->getExtraProperties());
+    }
+
+    SECTION("Restore the meta data of an unchanged file from JSON")
+    {
+        const isx::SpDataSet_t expected = makeMovieDataSet("movie", filePath, ti, si);
+        REQUIRE(expected->getTimingInfo() == ti);
+
+        const std::string jsonString = expected->toJsonString();
+        REQUIRE(jsonString.find("metaDataCache") != std::string::npos);
+
+        const isx::SpDataSet_t actual = isx::DataSet::fromJsonString(jsonString);
+        REQUIRE(*actual == *expected);
+        REQUIRE(actual->getTimingInfo() == ti);
+        REQUIRE(actual->getSpacingInfo() == si);
+        REQUIRE(actual->getDataType() == isx::DataType::U16);
+        REQUIRE(actual->getExtraProperties() == expected->getExtraProperties());
+    }
+
+    SECTION("Read the meta data of a changed file")
+    {
+        const isx::SpDataSet_t expected = makeMovieDataSet("movie", filePath, ti, si);
+        REQUIRE(expected->getTimingInfo() == ti);
+        const std::string jsonString = expected->toJsonString();
+
+        // Rewriting the movie with more frames changes the size of the file.
+        const isx::TimingInfo newTi(ti.getStart(), ti.getStep(), 6);
+        makeMovieDataSet("movie", filePath, newTi, si);
+
+        const isx::SpDataSet_t actual = isx::DataSet::fromJsonString(jsonString);
+        REQUIRE(actual->getTimingInfo() == newTi);
+    }
+
+    SECTION("Changing a property drops the cached meta data")
+    {
+        const isx::SpDataSet_t ds = makeMovieDataSet("movie", filePath, ti, si);
+        ds->getTimingInfo();
+        ds->setPropertyValue(isx::DataSet::PROP_DATA_MIN, isx::Variant(0.f));
+        REQUIRE(ds->toJsonString().find("metaDataCache") == std::string::npos);
+    }
+
+    std::remove(filePath.c_str());
+
+    isx::CoreShutdown();
+}
@@ -2,8 +2,12 @@
 #include "isxEventBasedFileV2.h"
 #include "isxPathUtils.h"
 #include "isxLogicalTrace.h"
+#include "isxJsonUtils.h"
 #include "catch.hpp"
 
+#include <fstream>
+#include <limits>
+
 namespace
 {
     void compareMetrics(isx::SpTraceMetrics_t a, isx::SpTraceMetrics_t b)
@@ -155,6 +159,92 @@ TEST_CASE("EventBasedFileV2Test", "[core]")
         }
     }
 
+    SECTION("Time window queries only read the blocks of packets that overlap the window")
+    {
+        // Events are written one cell after another, so packets are not sorted by time.
+        const size_t numChannels = 10;
+        const size_t numPktsPerChannel = 20000;
+        const isx::DurationInSeconds step(1, 1000);
+        const isx::TimingInfo ti(isx::Time(), step, numPktsPerChannel);
+        std::vector<std::string> channelNames;
+        for (size_t c = 0; c < numChannels; ++c)
+        {
+            channelNames.push_back("C" + std::to_string(c));
+        }
+
+        {
+            isx::EventBasedFileV2 file(fileName, isx::DataSet::Type::EVENTS, channelNames,
+                    std::vector<isx::DurationInSeconds>(numChannels, step),
+                    std::vector<isx::SignalType>(numChannels, isx::SignalType::SPARSE));
+            for (size_t c = 0; c < numChannels; ++c)
+            {
+                for (size_t p = 0; p < numPktsPerChannel; ++p)
+                {
+                    file.writeDataPkt(isx::EventBasedFileV2::DataPkt(uint64_t(p) * 1000, float(c * numPktsPerChannel + p), c));
+                }
+            }
+            file.setTimingInfo(ti.getStart(), ti.getEnd());
+            file.closeFileForWriting();
+        }
+
+        isx::EventBasedFileV2 file(fileName);
+        const isx::Time windowStart = ti.getStart() + isx::DurationInSeconds(5, 1);
+        const isx::Time windowEnd = windowStart + isx::DurationInSeconds(10, 1000);
+        for (size_t c = 0; c < numChannels; ++c)
+        {
+            const isx::SpLogicalTrace_t trace = file.getLogicalDataInRange(channelNames[c], windowStart, windowEnd);
+            REQUIRE(trace != nullptr);
+            const std::map<isx::Time, float> & values = trace->getValues();
+            REQUIRE(values.size() == 10);
+            REQUIRE(values.begin()->first == windowStart);
+            REQUIRE(values.begin()->second == float(c * numPktsPerChannel + 5000));
+            REQUIRE(values.rbegin()->second == float(c * numPktsPerChannel + 5009));
+        }
+        REQUIRE(file.getNumPktsReadInRange() < numChannels * numPktsPerChannel / 2);
+
+        const isx::SpLogicalTrace_t expected = isx::getLogicalTraceInRange(
+                file.getLogicalData(channelNames[3]), windowStart, windowEnd);
+        REQUIRE(file.getLogicalDataInRange(channelNames[3], windowStart, windowEnd)->getValues() == expected->getValues());
+
+        REQUIRE(file.getLogicalDataInRange("unknown", windowStart, windowEnd) == nullptr);
+        REQUIRE(file.getLogicalDataInRange(channelNames[0], windowEnd, windowStart)->getValues().empty());
+
+        // Files written before the packet index was added compute it while reading the first window.
+        const std::string unindexedFileName = isx::getAbsolutePath(g_resources["unitTestDataPath"] + "/test_gpio_unindexed.isxd");
+        {
+            std::ifstream inStream(fileName, std::ios::binary);
+            std::ios::pos_type headerPos;
+            isx::json footer = isx::readJsonHeaderAtEnd(inStream, headerPos);
+            REQUIRE(footer.find("pktIndex") != footer.end());
+            footer.erase("pktIndex");
+
+            const std::streamoff numPktBytes = headerPos;
+            std::vector<char> pkts(static_cast<size_t>(numPktBytes));
+            inStream.seekg(0, std::ios_base::beg);
+            inStream.read(pkts.data(), std::streamsize(pkts.size()));
+            REQUIRE(inStream.good());
+
+            std::ofstream outStream(unindexedFileName, std::ios::binary | std::ios::trunc);
+            outStream.write(pkts.data(), std::streamsize(pkts.size()));
+            isx::writeJsonHeaderAtEnd(footer, outStream);
+        }
+
+        {
+            isx::EventBasedFileV2 unindexedFile(unindexedFileName);
+            REQUIRE(unindexedFile.getLogicalDataInRange(channelNames[3], windowStart, windowEnd)->getValues() == expected->getValues());
+            const uint64_t numPktsReadFirst = unindexedFile.getNumPktsReadInRange();
+            REQUIRE(numPktsReadFirst < numChannels * numPktsPerChannel / 2);
+            REQUIRE(unindexedFile.getLogicalDataInRange(channelNames[3], windowStart, windowEnd)->getValues() == expected->getValues());
+            REQUIRE(unindexedFile.getNumPktsReadInRange() == 2 * numPktsReadFirst);
+
+            const isx::LogicalTraceTable table = unindexedFile.readLogicalTraceTable(
+                    std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+            REQUIRE(table.getNumTraces() == numChannels);
+            REQUIRE(table.m_values.size() == numChannels * numPktsPerChannel);
+        }
+        std::remove(unindexedFileName.c_str());
+    }
+
     std::remove(fileName.c_str());
     isx::CoreShutdown();
 }
@@ -498,3 +498,82 @@ TEST_CASE("EventsExport-properties-no_metrics", "[core][event_export]")
     isx::removeDirectory(outputDir);
     isx::CoreShutdown();
 }
+
+TEST_CASE("EventsExport-npy", "[core][event_export]")
+{
+    isx::CoreInitialize();
+
+    const std::string inputDir = g_resources["unitTestDataPath"] + "/events-export";
+    const std::string outputDir = inputDir + "/output";
+    makeCleanDirectory(outputDir);
+
+    const isx::Time start(2017, 7, 26, 9, 51, 23, isx::DurationInSeconds(0, 1000));
+    const isx::TimingInfo ti(start, isx::DurationInSeconds(50, 1000), 3);
+    const std::map<std::string, std::map<isx::Time, float>> eventPackets =
+    {
+        {"C0", {{start, 1.0f}, {start + isx::DurationInSeconds(100, 1000), 0.8f}}},
+        {"C1", {{start + isx::DurationInSeconds(50, 1000), 2.5f}}},
+    };
+    const isx::SpEvents_t events = writeNamedPacketsAsEvents(outputDir + "/events.isxd", ti, eventPackets);
+
+    const std::string outputFilePath = outputDir + "/events.csv";
+    const std::string npyFilePath = outputDir + "/events.npy";
+    isx::EventsExporterParams params({events}, outputFilePath, isx::WriteTimeRelativeTo::FIRST_DATA_ITEM);
+    params.m_traceFileFormat = isx::TraceFileFormat::CSV_AND_NPY;
+
+    SECTION("CSV and NumPy files")
+    {
+        REQUIRE(params.getOutputFilePaths() == std::vector<std::string>({outputFilePath, npyFilePath}));
+        REQUIRE(isx::runEventsExporter(params) == isx::AsyncTaskStatus::COMPLETE);
+        requireEqualLines(outputFilePath, {"Time (s), C0, C1", "0, 1, 0", "0.05, 0, 2.5", "0.1, 0.8, 0"});
+    }
+
+    SECTION("NumPy file only")
+    {
+        params.m_fileName = npyFilePath;
+        params.m_traceFileFormat = isx::TraceFileFormat::NPY;
+        REQUIRE(params.getOutputFilePaths() == std::vector<std::string>({npyFilePath}));
+        REQUIRE(isx::runEventsExporter(params) == isx::AsyncTaskStatus::COMPLETE);
+        REQUIRE(!isx::pathExists(outputFilePath));
+    }
+
+    SECTION("NumPy file requires sparse output")
+    {
+        params.m_writeSparseOutput = false;
+        ISX_REQUIRE_EXCEPTION(
+                isx::runEventsExporter(params),
+                isx::ExceptionUserInput,
+                "Exporting events to a .npy file requires sparse output.");
+    }
+
+    if (isx::pathExists(npyFilePath))
+    {
+        std::ifstream npy(npyFilePath, std::ios::binary);
+        char preamble[10];
+        npy.read(preamble, sizeof(preamble));
+        REQUIRE(std::memcmp(preamble, "\x93NUMPY\x01\x00", 8) == 0);
+        const size_t headerSize = size_t(uint8_t(preamble[8])) | (size_t(uint8_t(preamble[9])) << 8);
+        REQUIRE((sizeof(preamble) + headerSize) % 64 == 0);
+
+        std::string header(headerSize, ' ');
+        npy.read(&header[0], std::streamsize(headerSize));
+        REQUIRE(header.find("{'descr': [('Time (s)', '<f8'), ('C0', '<f4'), ('C1', '<f4')], 'fortran_order': False, 'shape': (3,), }") == 0);
+        REQUIRE(header.back() == '\n');
+
+        const std::array<double, 3> expTimes = {0.0, 0.05, 0.1};
+        const std::array<std::array<float, 2>, 3> expValues = {{{1.f, 0.f}, {0.f, 2.5f}, {0.8f, 0.f}}};
+        for (size_t r = 0; r < expTimes.size(); ++r)
+        {
+            double time = 0.0;
+            std::array<float, 2> values;
+            npy.read(reinterpret_cast<char *>(&time), sizeof(time));
+            npy.read(reinterpret_cast<char *>(values.data()), sizeof(values));
+            REQUIRE(time == expTimes[r]);
+            REQUIRE(values == expValues[r]);
+        }
+        REQUIRE(npy.peek() == std::char_traits<char>::eof());
+    }
+
+    isx::removeDirectory(outputDir);
+    isx::CoreShutdown();
+}
@@ -7,6 +7,7 @@
 
 #include <fstream>
 #include <algorithm>
+#include <limits>
 
 void writeEventsTestFile(const std::string & inFileName)
 {
@@ -87,6 +88,42 @@ TEST_CASE("EventsDataTest", "[core]")
 
     }
 
+    SECTION("Read the events of all cells in one pass")
+    {
+        writeEventsTestFile(fileName);
+
+        isx::SpEvents_t f = isx::readEvents(fileName);
+
+        const isx::LogicalTraceTable all = f->getAllLogicalData(0, std::numeric_limits<int64_t>::max());
+        REQUIRE(all.getNumTraces() == 2);
+        REQUIRE(all.m_traceStarts == std::vector<size_t>({0, 2, 5}));
+        REQUIRE(all.m_offsetsMicroSecs == std::vector<int64_t>({75000000, 125000000, 175000000, 250000000, 375000000}));
+        REQUIRE(all.m_values == std::vector<float>({2.f, 1.5f, 1.f, 4.f, 3.f}));
+
+        const isx::LogicalTraceTable window = f->getAllLogicalData(100000000, 250000000);
+        REQUIRE(window.m_traceStarts == std::vector<size_t>({0, 1, 2}));
+        REQUIRE(window.m_offsetsMicroSecs == std::vector<int64_t>({125000000, 175000000}));
+        REQUIRE(window.m_values == std::vector<float>({1.5f, 1.f}));
+    }
+
+    SECTION("Read the events of a cell within a time window")
+    {
+        writeEventsTestFile(fileName);
+
+        isx::SpEvents_t f = isx::readEvents(fileName);
+        const isx::Time start = f->getTimingInfo().getStart();
+        const isx::Time windowStart = start + isx::DurationInSeconds(100, 1);
+        const isx::Time windowEnd = start + isx::DurationInSeconds(250, 1);
+
+        const isx::SpLogicalTrace_t c0 = f->getLogicalDataInRange("C0", windowStart, windowEnd);
+        REQUIRE(c0->getValues() == std::map<isx::Time, float>({{start + isx::DurationInSeconds(125, 1), 1.5f}}));
+
+        const isx::SpLogicalTrace_t c1 = f->getLogicalDataInRange("C1", windowStart, windowEnd);
+        REQUIRE(c1->getValues() == std::map<isx::Time, float>({{start + isx::DurationInSeconds(175, 1), 1.f}}));
+
+        REQUIRE(f->getLogicalDataInRange("C2", windowStart, windowEnd) == nullptr);
+    }
+
     isx::CoreShutdown();
     std::remove(fileName.c_str());
 }
@@ -0,0 +1,243 @@
+#include "isxFileHandlePool.h"
+#include "isxException.h"
+#include "isxTest.h"
+#include "catch.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/// A pooled file that counts how often it is opened and closed.
+struct CountingFile
+{
+    explicit CountingFile(const bool inIsOpen = true)
+        : m_isOpen(inIsOpen)
+    {
+        m_handle.manage(
+            [this]()
+            {
+                if (m_failToOpen)
+                {
+                    ISX_THROW(isx::ExceptionFileIO, "Failed to open counting file.");
+                }
+                m_isOpen = true;
+                ++m_numOpens;
+            },
+            [this]()
+            {
+                m_isOpen = false;
+                ++m_numCloses;
+            },
+            inIsOpen);
+    }
+
+    bool m_isOpen = false;
+    bool m_failToOpen = false;
+    size_t m_numOpens = 0;
+    size_t m_numCloses = 0;
+    isx::PooledFileHandle m_handle;
+};
+
+/// Sets the maximum number of open files of the pool while in scope,
+/// so that a failed test does not change it for later tests.
+struct MaxOpenHandlesGuard
+{
+    explicit MaxOpenHandlesGuard(const isx::isize_t inMaxOpenHandles)
+    {
+        isx::FileHandlePool::setMaxOpenHandles(inMaxOpenHandles);
+    }
+
+    ~MaxOpenHandlesGuard()
+    {
+        isx::FileHandlePool::setMaxOpenHandles(isx::FileHandlePool::s_defaultMaxOpenHandles);
+    }
+};
+
+} // namespace
+
+TEST_CASE("FileHandlePool", "[core-internal]")
+{
+    const MaxOpenHandlesGuard maxOpenHandlesGuard(2);
+    isx::FileHandlePool::resetStats();
+
+    SECTION("Least recently used idle files are closed")
+    {
+        CountingFile a;
+        CountingFile b;
+        REQUIRE(a.m_isOpen);
+        REQUIRE(b.m_isOpen);
+
+        // a is now the most recently used, so b is closed to make room for c.
+        {
+            isx::PooledFileHandle::Lease lease(a.m_handle);
+        }
+        CountingFile c;
+        REQUIRE(a.m_isOpen);
+        REQUIRE(!b.m_isOpen);
+        REQUIRE(c.m_isOpen);
+
+        // Accessing b reopens it and closes a.
+        {
+            isx::PooledFileHandle::Lease lease(b.m_handle);
+            REQUIRE(b.m_isOpen);
+        }
+        REQUIRE(!a.m_isOpen);
+        REQUIRE(b.m_numOpens == 1);
+
+        const isx::FileHandlePoolStats stats = isx::FileHandlePool::getStats();
+        REQUIRE(stats.m_numOpens == 4);
+        REQUIRE(stats.m_numEvictions == 2);
+        REQUIRE(stats.m_numOpenHandles == 2);
+    }
+
+    SECTION("Files are opened lazily")
+    {
+        CountingFile a(false);
+        REQUIRE(!a.m_isOpen);
+        REQUIRE(isx::FileHandlePool::getStats().m_numOpenHandles == 0);
+
+        {
+            isx::PooledFileHandle::Lease lease(a.m_handle);
+            REQUIRE(a.m_isOpen);
+        }
+        {
+            isx::PooledFileHandle::Lease lease(a.m_handle);
+        }
+        REQUIRE(a.m_numOpens == 1);
+        REQUIRE(isx::FileHandlePool::getStats().m_numOpens == 1);
+    }
+
+    SECTION("Sequential access opens each file once")
+    {
+        const size_t numFiles = 10;
+        std::vector<std::unique_ptr<CountingFile>> files;
+        for (size_t i = 0; i < numFiles; ++i)
+        {
+            files.emplace_back(new CountingFile(false));
+        }
+
+        for (auto & file : files)
+        {
+            for (size_t i = 0; i < 5; ++i)
+            {
+                isx::PooledFileHandle::Lease lease(file->m_handle);
+            }
+        }
+
+        for (auto & file : files)
+        {
+            REQUIRE(file->m_numOpens == 1);
+        }
+        const isx::FileHandlePoolStats stats = isx::FileHandlePool::getStats();
+        REQUIRE(stats.m_numOpens == numFiles);
+        REQUIRE(stats.m_numEvictions == numFiles - 2);
+        REQUIRE(stats.m_numOpenHandles == 2);
+    }
+
+    SECTION("Files that are accessed are not closed")
+    {
+        CountingFile a;
+        CountingFile b;
+        {
+            isx::PooledFileHandle::Lease leaseA(a.m_handle);
+            isx::PooledFileHandle::Lease leaseB(b.m_handle);
+            CountingFile c;
+            REQUIRE(a.m_isOpen);
+            REQUIRE(b.m_isOpen);
+            REQUIRE(c.m_isOpen);
+            REQUIRE(isx::FileHandlePool::getStats().m_numOpenHandles == 3);
+        }
+        REQUIRE(isx::FileHandlePool::getStats().m_numOpenHandles == 2);
+    }
+
+    SECTION("Failing to open a file")
+    {
+        CountingFile a(false);
+        a.m_failToOpen = true;
+        REQUIRE_THROWS_AS(isx::PooledFileHandle::Lease(a.m_handle), isx::ExceptionFileIO);
+        REQUIRE(!a.m_isOpen);
+        REQUIRE(isx::FileHandlePool::getStats().m_numOpens == 0);
+
+        a.m_failToOpen = false;
+        {
+            isx::PooledFileHandle::Lease lease(a.m_handle);
+            REQUIRE(a.m_isOpen);
+        }
+    }
+
+    SECTION("Unmanaged handles are not pooled")
+    {
+        CountingFile a;
+        a.m_handle.unmanage();
+        REQUIRE(!a.m_handle.isManaged());
+        CountingFile b;
+        CountingFile c;
+        {
+            isx::PooledFileHandle::Lease lease(a.m_handle);
+        }
+        REQUIRE(a.m_isOpen);
+        REQUIRE(a.m_numCloses == 0);
+        REQUIRE(isx::FileHandlePool::getStats().m_numOpenHandles == 2);
+    }
+
+    SECTION("Lowering the maximum closes idle files")
+    {
+        CountingFile a;
+        CountingFile b;
+        const MaxOpenHandlesGuard lowerMaxOpenHandlesGuard(1);
+        REQUIRE(!a.m_isOpen);
+        REQUIRE(b.m_isOpen);
+        REQUIRE(isx::FileHandlePool::getStats().m_numEvictions == 1);
+    }
+
+    SECTION("Access from multiple threads")
+    {
+        const size_t numFiles = 8;
+        const size_t numIterations = 1000;
+        std::vector<std::unique_ptr<CountingFile>> files;
+        for (size_t i = 0; i < numFiles; ++i)
+        {
+            files.emplace_back(new CountingFile(false));
+        }
+
+        // Failures are recorded and checked on this thread, because an exception
+        // thrown on another thread would terminate the program.
+        std::atomic<size_t> numClosedAccesses(0);
+        std::atomic<size_t> numErrors(0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([t, &files, &numClosedAccesses, &numErrors]()
+            {
+                try
+                {
+                    for (size_t i = 0; i < numIterations; ++i)
+                    {
+                        CountingFile & file = *files[(t + i) % files.size()];
+                        isx::PooledFileHandle::Lease lease(file.m_handle);
+                        if (!file.m_isOpen)
+                        {
+                            ++numClosedAccesses;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    ++numErrors;
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(numClosedAccesses == 0);
+        REQUIRE(numErrors == 0);
+        REQUIRE(isx::FileHandlePool::getStats().m_numOpenHandles <= 2);
+    }
+}
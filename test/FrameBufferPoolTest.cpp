@@ -0,0 +1,135 @@
+#include "isxFrameBufferPool.h"
+#include "isxImage.h"
+#include "isxTest.h"
+#include "catch.hpp"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TEST_CASE("FrameBufferPool", "[core-internal]")
+{
+    isx::FrameBufferPool::clear();
+    isx::FrameBufferPool::setMaxCachedBytes(isx::FrameBufferPool::s_defaultMaxCachedBytes);
+    isx::FrameBufferPool::resetStats();
+
+    SECTION("Buffers are aligned")
+    {
+        for (const isx::isize_t size : {isx::isize_t(0), isx::isize_t(1), isx::isize_t(100), isx::isize_t(1280 * 800 * 2)})
+        {
+            isx::UpFrameBuffer_t buffer = isx::makeFrameBuffer(size);
+            REQUIRE(buffer);
+            REQUIRE(reinterpret_cast<uintptr_t>(buffer.get()) % isx::FrameBufferPool::s_alignment == 0);
+            std::memset(buffer.get(), 0xAB, size);
+        }
+    }
+
+    SECTION("Released buffers are reused")
+    {
+        const isx::isize_t size = 1280 * 800 * 2;
+        char * first = isx::FrameBufferPool::allocate(size);
+        isx::FrameBufferPool::release(first, size);
+
+        isx::FrameBufferPoolStats stats = isx::FrameBufferPool::getStats();
+        REQUIRE(stats.m_numMisses == 1);
+        REQUIRE(stats.m_numHits == 0);
+        REQUIRE(stats.m_numCachedBuffers == 1);
+        REQUIRE(stats.m_numCachedBytes >= size);
+
+        char * second = isx::FrameBufferPool::allocate(size);
+        REQUIRE(second == first);
+
+        // A buffer of a different size is not taken from the same bucket.
+        char * third = isx::FrameBufferPool::allocate(size / 2);
+        REQUIRE(third != first);
+
+        stats = isx::FrameBufferPool::getStats();
+        REQUIRE(stats.m_numHits == 1);
+        REQUIRE(stats.m_numMisses == 2);
+        REQUIRE(stats.m_numCachedBuffers == 0);
+        REQUIRE(stats.m_numCachedBytes == 0);
+
+        isx::FrameBufferPool::release(second, size);
+        isx::FrameBufferPool::release(third, size / 2);
+        REQUIRE(isx::FrameBufferPool::getStats().m_numCachedBuffers == 2);
+
+        isx::FrameBufferPool::clear();
+        REQUIRE(isx::FrameBufferPool::getStats().m_numCachedBuffers == 0);
+        REQUIRE(isx::FrameBufferPool::getStats().m_numCachedBytes == 0);
+    }
+
+    SECTION("Released buffers are freed when the pool is full")
+    {
+        const isx::isize_t size = 1 << 20;
+        isx::FrameBufferPool::setMaxCachedBytes(size);
+
+        char * first = isx::FrameBufferPool::allocate(size);
+        char * second = isx::FrameBufferPool::allocate(size);
+        isx::FrameBufferPool::release(first, size);
+        isx::FrameBufferPool::release(second, size);
+
+        isx::FrameBufferPoolStats stats = isx::FrameBufferPool::getStats();
+        REQUIRE(stats.m_numCachedBuffers == 1);
+        REQUIRE(stats.m_numDiscarded == 1);
+
+        isx::FrameBufferPool::setMaxCachedBytes(0);
+        stats = isx::FrameBufferPool::getStats();
+        REQUIRE(stats.m_numCachedBuffers == 0);
+        REQUIRE(stats.m_numCachedBytes == 0);
+    }
+
+    SECTION("Images draw from the pool")
+    {
+        const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(64, 32));
+        const isx::isize_t rowBytes = 64 * sizeof(uint16_t);
+        const char * pixels = nullptr;
+        {
+            isx::Image image(spacingInfo, rowBytes, 1, isx::DataType::U16);
+            pixels = image.getPixels();
+        }
+        isx::Image image(spacingInfo, rowBytes, 1, isx::DataType::U16);
+        REQUIRE(image.getPixels() == pixels);
+        REQUIRE(isx::FrameBufferPool::getStats().m_numHits == 1);
+
+        isx::Image moved(std::move(image));
+        REQUIRE(moved.getPixels() == pixels);
+        REQUIRE(image.getPixels() == nullptr);
+    }
+
+    SECTION("Allocate and release from multiple threads")
+    {
+        const size_t numThreads = 8;
+        const size_t numIterations = 1000;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back([t]()
+            {
+                const isx::isize_t size = 4096 * (1 + (t % 3));
+                for (size_t i = 0; i < numIterations; ++i)
+                {
+                    isx::UpFrameBuffer_t buffer = isx::makeFrameBuffer(size);
+                    std::memset(buffer.get(), int(t), size);
+                    for (isx::isize_t b = 0; b < size; b += 512)
+                    {
+                        if (buffer.get()[b] != char(t))
+                        {
+                            throw std::runtime_error("Buffer shared between threads.");
+                        }
+                    }
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        const isx::FrameBufferPoolStats stats = isx::FrameBufferPool::getStats();
+        REQUIRE(stats.m_numHits + stats.m_numMisses == numThreads * numIterations);
+        REQUIRE(stats.m_numMisses <= numThreads);
+    }
+
+    isx::FrameBufferPool::clear();
+    isx::FrameBufferPool::setMaxCachedBytes(isx::FrameBufferPool::s_defaultMaxCachedBytes);
+}
@@ -673,6 +673,68 @@ TEST_CASE("NVista3GpioFile", "[core][gpio][nv3_gpio]")
         }, startTime);
     }
 
+    SECTION("Write synthetic file with more packets than are kept in memory while parsing")
+    {
+        const std::string inputFilePath = outputDirPath + "/synthetic.gpio";
+        const uint32_t numPackets = 200000;
+        {
+            std::ofstream inputFile(inputFilePath.c_str(), std::ios::binary);
+            REQUIRE(inputFile.good());
+            for (uint32_t i = 0; i < numPackets; ++i)
+            {
+                writeNV3SyncPacket(inputFile, i, 10 + i, i, (i % 3) == 0);
+            }
+            REQUIRE(inputFile.good());
+            inputFile.flush();
+        }
+
+        std::string outputFilePath;
+        {
+            isx::NVista3GpioFile raw(inputFilePath, outputDirPath);
+            REQUIRE(raw.parse() == isx::AsyncTaskStatus::COMPLETE);
+            outputFilePath = raw.getOutputFileName();
+        }
+
+        const isx::SpGpio_t gpio = isx::readGpio(outputFilePath);
+        REQUIRE(gpio->numberOfChannels() == 1);
+
+        // Time stamps are relative to the first packet.
+        const isx::SpLogicalTrace_t trace = gpio->getLogicalData("BNC Sync Output");
+        const std::map<isx::Time, float> values = trace->getValues();
+        size_t numChanges = 0;
+        for (uint32_t i = 0; i < numPackets; ++i)
+        {
+            const bool changed = ((i % 3) == 0) || ((i % 3) == 1);
+            const auto it = values.find(isx::Time(isx::DurationInSeconds::fromMicroseconds(i)));
+            REQUIRE((it != values.end()) == changed);
+            if (changed)
+            {
+                REQUIRE(it->second == float((i % 3) == 0));
+                ++numChanges;
+            }
+        }
+        REQUIRE(values.size() == numChanges);
+    }
+
+    SECTION("Cancelling removes the output file")
+    {
+        const std::string inputFilePath = outputDirPath + "/synthetic.gpio";
+        {
+            std::ofstream inputFile(inputFilePath.c_str(), std::ios::binary);
+            REQUIRE(inputFile.good());
+            for (uint32_t i = 0; i < 1000; ++i)
+            {
+                writeNV3SyncPacket(inputFile, i, i, i, (i % 2) == 0);
+            }
+            inputFile.flush();
+        }
+
+        isx::NVista3GpioFile raw(inputFilePath, outputDirPath);
+        raw.setCheckInCallback([](float){return true;});
+        REQUIRE(raw.parse() == isx::AsyncTaskStatus::CANCELLED);
+        REQUIRE(!isx::pathExists(raw.getOutputFileName()));
+    }
+
     SECTION("MOS-1559: Trigger")
     {
         const std::string inputFilePath = inputDirPath + "/2018-06-29-23-07-14_video_trig_0.gpio";
@@ -944,7 +1006,10 @@ TEST_CASE("nVista3Gpio-benchmark", "[!hide]")
             sw.start();
             raw.parse();
             sw.stop();
-            ISX_LOG_INFO("Parsing took ", sw.getElapsedMs(), " ms.");
+            const uint64_t numPkts = raw.getNumPktsRead();
+            const float elapsedMs = std::max(sw.getElapsedMs(), 1.f);
+            ISX_LOG_INFO("Parsing ", numPkts, " packets took ", elapsedMs, " ms (",
+                    uint64_t(double(numPkts) * 1000.0 / double(elapsedMs)), " packets/s).");
         }
     }
 
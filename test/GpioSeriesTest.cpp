@@ -80,6 +80,14 @@ TEST_CASE("GpioSeries-GpioSeries", "[core-internal]")
         {
             REQUIRE(kv.second == 1.f);
         }
+
+        // A window that ends within the second member.
+        const isx::TimingInfos_t tis = gpios->getTimingInfosForSeries();
+        REQUIRE(tis.size() == 2);
+        const isx::Time windowStart = tis[0].getStart() + tis[0].getDuration() / 2;
+        const isx::Time windowEnd = tis[1].getStart() + tis[1].getDuration() / 2;
+        const isx::SpLogicalTrace_t syncWindow = gpios->getLogicalDataInRange("SYNC", windowStart, windowEnd);
+        REQUIRE(syncWindow->getValues() == isx::getLogicalTraceInRange(syncTrace, windowStart, windowEnd)->getValues());
     }
 
     SECTION("Two logical GPIO sets with a different number channels")
@@ -2,8 +2,111 @@
 #include "isxIMUFile.h"
 #include "isxEventBasedFileV2.h"
 #include "isxPathUtils.h"
+#include "isxJsonUtils.h"
+#include "isxStopWatch.h"
 #include "catch.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace
+{
+
+int16_t
+makeAccValue(const size_t inIndex, const size_t inAxis)
+{
+    return int16_t((inIndex % 1000) * 3 + inAxis);
+}
+
+int16_t
+makeOriValue(const size_t inIndex, const size_t inAxis)
+{
+    return int16_t((inIndex % 2048) - inAxis);
+}
+
+int16_t
+makeMagValue(const size_t inIndex, const size_t inAxis)
+{
+    return int16_t(-int64_t(inIndex % 500) - int64_t(inAxis));
+}
+
+/// Writes an .imu file with accelerometer and orientation samples every 20 ms,
+/// and magnetometer samples every 400 ms.
+void
+writeImuFile(
+        const std::string & inFileName,
+        const isx::Time & inStart,
+        const size_t inNumAccTimes,
+        const std::vector<isx::isize_t> & inAccDropped,
+        const size_t inNumMagTimes)
+{
+    const size_t numAccPkts = inNumAccTimes - inAccDropped.size();
+    const size_t payloadSize = sizeof(isx::IMUFile::AccPayload);
+
+    isx::IMUFile::IMUHeader header{};
+    header.accCount = numAccPkts;
+    header.accOffset = sizeof(header);
+    header.accSize = numAccPkts * payloadSize;
+    header.magCount = inNumMagTimes;
+    header.magOffset = header.accOffset + header.accSize;
+    header.magSize = inNumMagTimes * payloadSize;
+    header.oriCount = numAccPkts;
+    header.oriOffset = header.magOffset + header.magSize;
+    header.oriSize = numAccPkts * payloadSize;
+    header.sessionOffset = header.oriOffset + header.oriSize;
+
+    std::ofstream file(inFileName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<isx::IMUFile::AccPayload> accPkts(numAccPkts);
+    std::vector<isx::IMUFile::OriPayload> oriPkts(numAccPkts);
+    for (size_t i = 0; i < numAccPkts; ++i)
+    {
+        accPkts[i].timeStamp = i * 20;
+        oriPkts[i].timeStamp = i * 20;
+        for (size_t a = 0; a < 3; ++a)
+        {
+            accPkts[i].accData[a] = makeAccValue(i, a);
+            oriPkts[i].oriData[a] = makeOriValue(i, a);
+        }
+    }
+    std::vector<isx::IMUFile::MagPayload> magPkts(inNumMagTimes);
+    for (size_t i = 0; i < inNumMagTimes; ++i)
+    {
+        magPkts[i].timeStamp = i * 400;
+        for (size_t a = 0; a < 3; ++a)
+        {
+            magPkts[i].magData[a] = makeMagValue(i, a);
+        }
+    }
+    file.write(reinterpret_cast<const char *>(accPkts.data()), std::streamsize(header.accSize));
+    file.write(reinterpret_cast<const char *>(magPkts.data()), std::streamsize(header.magSize));
+    file.write(reinterpret_cast<const char *>(oriPkts.data()), std::streamsize(header.oriSize));
+
+    isx::json accTimingInfo;
+    accTimingInfo["periodMs"] = isx::convertRatioToJson(isx::Ratio(20, 1));
+    accTimingInfo["dropped"] = inAccDropped;
+    accTimingInfo["numTimes"] = inNumAccTimes;
+
+    isx::json magTimingInfo;
+    magTimingInfo["periodMs"] = isx::convertRatioToJson(isx::Ratio(400, 1));
+    magTimingInfo["dropped"] = std::vector<isx::isize_t>();
+    magTimingInfo["numTimes"] = inNumMagTimes;
+
+    isx::json timingInfo;
+    timingInfo["start"] = isx::convertTimeToJson(inStart);
+    timingInfo["end"] = isx::convertTimeToJson(inStart + isx::DurationInSeconds(inNumAccTimes * 20, 1000));
+    timingInfo["accelerometer"] = accTimingInfo;
+    timingInfo["magnetometer"] = magTimingInfo;
+
+    isx::json session;
+    session["timingInfo"] = timingInfo;
+    file << session.dump();
+}
+
+} // namespace
+
 TEST_CASE("IMUFileTest", "[core]")
 {
     isx::CoreInitialize();
@@ -36,3 +139,97 @@ TEST_CASE("IMUFileTest", "[core]")
     std::remove(outputFileName.c_str());
     isx::CoreShutdown();
 }
+
+TEST_CASE("IMUFile-synthetic", "[core]")
+{
+    isx::CoreInitialize();
+
+    const std::string outputDir = g_resources["unitTestDataPath"] + "/imu/output";
+    isx::removeDirectory(outputDir);
+    isx::makeDirectory(outputDir);
+    const std::string fileName = outputDir + "/synthetic.imu";
+
+    // More samples than are read or written at a time.
+    const size_t numAccTimes = isx::IMUFile::s_numPktsPerRead + 1000;
+    const std::vector<isx::isize_t> accDropped = {0, 5, 6, 500, numAccTimes - 1};
+    const size_t numMagTimes = 50;
+    writeImuFile(fileName, isx::Time(), numAccTimes, accDropped, numMagTimes);
+
+    std::string outputFileName;
+    {
+        isx::IMUFile imuFile(fileName, outputDir);
+        REQUIRE(imuFile.parse() == isx::AsyncTaskStatus::COMPLETE);
+        outputFileName = imuFile.getOutputFileName();
+    }
+
+    isx::EventBasedFileV2 ebFile(outputFileName);
+    REQUIRE(ebFile.isValid());
+
+    const std::vector<std::string> channels = ebFile.getChannelList();
+    REQUIRE(channels.size() == 9);
+
+    for (size_t a = 0; a < 3; ++a)
+    {
+        const isx::SpFTrace_t acc = ebFile.getAnalogData(channels[a]);
+        const isx::SpFTrace_t ori = ebFile.getAnalogData(channels[3 + a]);
+        REQUIRE(acc->getTimingInfo().getNumTimes() == numAccTimes);
+        REQUIRE(ori->getTimingInfo().getNumTimes() == numAccTimes);
+
+        size_t numDropped = 0;
+        for (size_t i = 0; i < numAccTimes; ++i)
+        {
+            if (std::find(accDropped.begin(), accDropped.end(), i) != accDropped.end())
+            {
+                REQUIRE(std::isnan(acc->getValue(i)));
+                REQUIRE(std::isnan(ori->getValue(i)));
+                ++numDropped;
+            }
+            else
+            {
+                const size_t recordedIndex = i - numDropped;
+                REQUIRE(acc->getValue(i) == float(makeAccValue(recordedIndex, a)));
+                REQUIRE(ori->getValue(i) == float(makeOriValue(recordedIndex, a)) / 2048.f);
+            }
+        }
+
+        const isx::SpFTrace_t mag = ebFile.getAnalogData(channels[6 + a]);
+        REQUIRE(mag->getTimingInfo().getNumTimes() == numMagTimes);
+        for (size_t i = 0; i < numMagTimes; ++i)
+        {
+            REQUIRE(mag->getValue(i) == float(makeMagValue(i, a)));
+        }
+    }
+
+    isx::removeDirectory(outputDir);
+    isx::CoreShutdown();
+}
+
+TEST_CASE("IMUFile-benchmark", "[!hide]")
+{
+    isx::CoreInitialize();
+
+    const std::string outputDir = g_resources["unitTestDataPath"] + "/imu/output";
+    isx::removeDirectory(outputDir);
+    isx::makeDirectory(outputDir);
+    const std::string fileName = outputDir + "/benchmark.imu";
+
+    // About 11 hours of accelerometer and orientation samples.
+    const size_t numAccTimes = 2000000;
+    const size_t numMagTimes = numAccTimes / 20;
+    writeImuFile(fileName, isx::Time(), numAccTimes, {}, numMagTimes);
+
+    {
+        isx::IMUFile imuFile(fileName, outputDir);
+        isx::StopWatch sw;
+        sw.start();
+        REQUIRE(imuFile.parse() == isx::AsyncTaskStatus::COMPLETE);
+        sw.stop();
+        const uint64_t numPkts = 2 * numAccTimes + numMagTimes;
+        const float elapsedMs = std::max(sw.getElapsedMs(), 1.f);
+        ISX_LOG_INFO("Parsing ", numPkts, " IMU packets took ", elapsedMs, " ms (",
+                uint64_t(double(numPkts) * 1000.0 / double(elapsedMs)), " packets/s).");
+    }
+
+    isx::removeDirectory(outputDir);
+    isx::CoreShutdown();
+}
@@ -97,6 +97,25 @@ TEST_CASE("MosaicGpioTest", "[core]")
         REQUIRE(ledVals.size() == 2);
     }
 
+    SECTION("Logical data within a time window")
+    {
+        // This file was written without a packet index, so it is computed on the first query.
+        std::string fileName = isx::getAbsolutePath(g_resources["unitTestDataPath"] + "/test_gpio_events_2.isxd");
+        std::shared_ptr<isx::MosaicGpio> gpio = std::make_shared<isx::MosaicGpio>(fileName);
+        const isx::TimingInfo ti = gpio->getTimingInfo();
+        const isx::Time windowStart = ti.getStart() + ti.getDuration() / 4;
+        const isx::Time windowEnd = ti.getStart() + ti.getDuration() * 3 / 4;
+
+        for (const auto & channel : gpio->getChannelList())
+        {
+            const isx::SpLogicalTrace_t expected = isx::getLogicalTraceInRange(
+                    gpio->getLogicalData(channel), windowStart, windowEnd);
+            const isx::SpLogicalTrace_t trace = gpio->getLogicalDataInRange(channel, windowStart, windowEnd);
+            REQUIRE(trace != nullptr);
+            REQUIRE(trace->getValues() == expected->getValues());
+        }
+    }
+
     SECTION("Logical data - async")
     {
         std::atomic_int doneCount(0);
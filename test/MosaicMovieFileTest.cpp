@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace
 {
@@ -422,3 +423,246 @@ TEST_CASE("MosaicMovieFileFrameHeaderMetadata", "[core-internal][mosaic_movie_fi
 
     isx::CoreShutdown();
 }
+
+TEST_CASE("MosaicMovieFilePixelStatistics", "[core-internal][mosaic_movie_file]")
+{
+    std::string fileName = g_resources["unitTestDataPath"] + "/movie_pixel_stats.isxd";
+
+    isx::Time start;
+    isx::DurationInSeconds step(50, 1000);
+    isx::isize_t numFrames = 4;
+    isx::TimingInfo timingInfo(start, step, numFrames, {1});
+
+    isx::SizeInPixels_t sizePixels(4, 3);
+    isx::SizeInMicrons_t pixelSize(isx::DEFAULT_PIXEL_SIZE, isx::DEFAULT_PIXEL_SIZE);
+    isx::PointInMicrons_t topLeft(0, 0);
+    isx::SpacingInfo spacingInfo(sizePixels, pixelSize, topLeft);
+    const isx::isize_t numPixels = spacingInfo.getTotalNumPixels();
+    const isx::isize_t rowSizeInBytes = sizeof(uint16_t) * spacingInfo.getNumColumns();
+
+    SECTION("No statistics by default")
+    {
+        writeTestU16Movie(fileName, isx::TimingInfo(start, step, numFrames), spacingInfo);
+        isx::MosaicMovieFile movie(fileName);
+        REQUIRE(!movie.hasPixelStatistics());
+        REQUIRE(!movie.getPixelStatistics().isValid());
+        REQUIRE(!movie.getFramePixelStatistics(0).isValid());
+    }
+
+    SECTION("Write then read statistics")
+    {
+        {
+            isx::MosaicMovieFile movie(fileName, timingInfo, spacingInfo, isx::DataType::U16);
+            movie.enablePixelStatistics(16);
+            for (isx::isize_t f = 0; f < numFrames; ++f)
+            {
+                if (!timingInfo.isIndexValid(f))
+                {
+                    continue;
+                }
+                isx::SpVideoFrame_t frame = std::make_shared<isx::VideoFrame>(
+                    spacingInfo, rowSizeInBytes, 1, isx::DataType::U16, timingInfo.convertIndexToStartTime(f), f);
+                uint16_t * pixels = frame->getPixelsAsU16();
+                for (isx::isize_t p = 0; p < numPixels; ++p)
+                {
+                    pixels[p] = uint16_t(1000 * f + p);
+                }
+                movie.writeFrame(frame);
+            }
+            REQUIRE_THROWS_AS(movie.enablePixelStatistics(), isx::ExceptionFileIO);
+            movie.closeForWriting();
+        }
+
+        isx::MosaicMovieFile movie(fileName);
+        REQUIRE(movie.hasPixelStatistics());
+
+        const isx::PixelStatistics overall = movie.getPixelStatistics();
+        REQUIRE(overall.m_min == 0.f);
+        REQUIRE(overall.m_max == float(3000 + numPixels - 1));
+        REQUIRE(overall.m_numPixels == 3 * numPixels);
+        REQUIRE(overall.getMean() == Approx((0.0 + 2000.0 + 3000.0) / 3.0 + (numPixels - 1) / 2.0));
+        REQUIRE(overall.m_histogram.size() == 16);
+        REQUIRE(overall.m_histogram[0] == 3 * numPixels);
+
+        const isx::PixelStatistics frame2 = movie.getFramePixelStatistics(2);
+        REQUIRE(frame2.m_min == 2000.f);
+        REQUIRE(frame2.m_max == float(2000 + numPixels - 1));
+        REQUIRE(frame2.m_numPixels == numPixels);
+        REQUIRE(frame2.getMean() == Approx(2000.0 + (numPixels - 1) / 2.0));
+        REQUIRE(frame2.m_histogram.empty());
+
+        REQUIRE(!movie.getFramePixelStatistics(1).isValid());
+    }
+
+    SECTION("Write then read statistics of a float movie with non-finite values")
+    {
+        const isx::TimingInfo floatTimingInfo(start, step, 2);
+        {
+            isx::MosaicMovieFile movie(fileName, floatTimingInfo, spacingInfo, isx::DataType::F32);
+            movie.enablePixelStatistics();
+            for (isx::isize_t f = 0; f < 2; ++f)
+            {
+                isx::SpVideoFrame_t frame = std::make_shared<isx::VideoFrame>(
+                    spacingInfo, sizeof(float) * spacingInfo.getNumColumns(), 1, isx::DataType::F32,
+                    floatTimingInfo.convertIndexToStartTime(f), f);
+                float * pixels = frame->getPixelsAsF32();
+                for (isx::isize_t p = 0; p < numPixels; ++p)
+                {
+                    pixels[p] = float(p) - 2.f;
+                }
+                if (f == 0)
+                {
+                    pixels[0] = std::numeric_limits<float>::quiet_NaN();
+                    pixels[3] = std::numeric_limits<float>::infinity();
+                    pixels[7] = -std::numeric_limits<float>::infinity();
+                }
+                movie.writeFrame(frame);
+            }
+            movie.closeForWriting();
+        }
+
+        isx::MosaicMovieFile movie(fileName);
+        REQUIRE(movie.hasPixelStatistics());
+
+        const isx::PixelStatistics frame0 = movie.getFramePixelStatistics(0);
+        REQUIRE(frame0.m_min == -1.f);
+        REQUIRE(frame0.m_max == float(numPixels - 3));
+        REQUIRE(frame0.m_numPixels == numPixels - 3);
+        REQUIRE(frame0.m_numNonFinitePixels == 3);
+        const double sum0 = double(numPixels * (numPixels - 1)) / 2.0 - 2.0 * double(numPixels) - (-2.0 + 1.0 + 5.0);
+        REQUIRE(frame0.getMean() == Approx(sum0 / double(numPixels - 3)));
+
+        const isx::PixelStatistics frame1 = movie.getFramePixelStatistics(1);
+        REQUIRE(frame1.m_min == -2.f);
+        REQUIRE(frame1.m_numPixels == numPixels);
+        REQUIRE(frame1.m_numNonFinitePixels == 0);
+
+        const isx::PixelStatistics overall = movie.getPixelStatistics();
+        REQUIRE(overall.m_min == -2.f);
+        REQUIRE(overall.m_max == float(numPixels - 3));
+        REQUIRE(overall.m_numPixels == 2 * numPixels - 3);
+        REQUIRE(overall.m_numNonFinitePixels == 3);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("MosaicMovieFileAllFrameTimestamps", "[core-internal][mosaic_movie_file]")
+{
+    isx::CoreInitialize();
+
+    SECTION("Timestamps stored in footer")
+    {
+        std::string fileName = g_resources["unitTestDataPath"] + "/movie_frame_timestamps.isxd";
+
+        const isx::isize_t numFrames = 6;
+        const isx::TimingInfo timingInfo(isx::Time(), isx::DurationInSeconds(50, 1000), numFrames, {1, 4});
+        const isx::SpacingInfo spacingInfo(
+                isx::SizeInPixels_t(4, 3),
+                isx::SizeInMicrons_t(isx::DEFAULT_PIXEL_SIZE, isx::DEFAULT_PIXEL_SIZE),
+                isx::PointInMicrons_t(0, 0));
+        const uint64_t firstTsc = 0x0123456789ABCDEF;
+
+        std::vector<uint64_t> expTimestamps(numFrames, 0);
+        {
+            isx::MosaicMovieFile movie(fileName, timingInfo, spacingInfo, isx::DataType::U16, true);
+            movie.enableFooterFrameTimestamps();
+            std::vector<uint16_t> header(2560, 0);
+            std::vector<uint16_t> pixels(spacingInfo.getTotalNumPixels(), 0);
+            std::vector<uint16_t> footer(2560, 0);
+            for (isx::isize_t f = 0; f < numFrames; ++f)
+            {
+                if (!timingInfo.isIndexValid(f))
+                {
+                    continue;
+                }
+
+                // Encode the TSC across the 8 header pixels in the same way as the sensor.
+                expTimestamps[f] = firstTsc + 50000 * f;
+                header[0] = 0x0A0;
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    const uint16_t comp = uint16_t(expTimestamps[f] >> (16 * j));
+                    header[1272 + 2 * j] = uint16_t((comp & 0xF) << 4);
+                    header[1272 + 2 * j + 1] = uint16_t(comp >> 4);
+                }
+                movie.writeFrameWithHeaderFooter(header.data(), pixels.data(), footer.data());
+            }
+            movie.setExtraProperties("{\"producer\":{\"version\":\"1.2.0\"}}");
+            movie.closeForWriting();
+        }
+
+        std::fstream fileStream(fileName, std::ios::binary | std::ios_base::in);
+        std::ios::pos_type headerPos;
+        isx::json j = isx::readJsonHeaderAtEnd(fileStream, headerPos);
+        fileStream.close();
+        REQUIRE(j.at("frameTimestamps").get<std::vector<uint64_t>>() ==
+                std::vector<uint64_t>({expTimestamps[0], expTimestamps[2], expTimestamps[3], expTimestamps[5]}));
+
+        isx::MosaicMovieFile movie(fileName);
+        REQUIRE(movie.hasFrameTimestamps());
+        REQUIRE(movie.readFrameTimestamps(1, 4) == std::vector<uint64_t>(expTimestamps.begin() + 1, expTimestamps.begin() + 5));
+        REQUIRE_THROWS_AS(movie.readFrameTimestamps(1, numFrames), isx::ExceptionUserInput);
+        REQUIRE(movie.getAllFrameTimestamps() == expTimestamps);
+        for (isx::isize_t f = 0; f < numFrames; ++f)
+        {
+            REQUIRE(movie.readFrameTimestamp(f) == expTimestamps[f]);
+        }
+        REQUIRE_THROWS_AS(movie.enableFooterFrameTimestamps(), isx::ExceptionFileIO);
+
+        std::remove(fileName.c_str());
+    }
+
+    SECTION("Timestamps not stored in footer by default")
+    {
+        std::string fileName = g_resources["unitTestDataPath"] + "/movie_no_footer_timestamps.isxd";
+
+        const isx::TimingInfo timingInfo(isx::Time(), isx::DurationInSeconds(50, 1000), 3);
+        const isx::SpacingInfo spacingInfo(
+                isx::SizeInPixels_t(4, 3),
+                isx::SizeInMicrons_t(isx::DEFAULT_PIXEL_SIZE, isx::DEFAULT_PIXEL_SIZE),
+                isx::PointInMicrons_t(0, 0));
+        {
+            isx::MosaicMovieFile movie(fileName, timingInfo, spacingInfo, isx::DataType::U16, true);
+            std::vector<uint16_t> header(2560, 0);
+            std::vector<uint16_t> pixels(spacingInfo.getTotalNumPixels(), 0);
+            std::vector<uint16_t> footer(2560, 0);
+            for (isx::isize_t f = 0; f < timingInfo.getNumTimes(); ++f)
+            {
+                movie.writeFrameWithHeaderFooter(header.data(), pixels.data(), footer.data());
+            }
+            movie.closeForWriting();
+        }
+
+        std::fstream fileStream(fileName, std::ios::binary | std::ios_base::in);
+        std::ios::pos_type headerPos;
+        isx::json j = isx::readJsonHeaderAtEnd(fileStream, headerPos);
+        fileStream.close();
+        REQUIRE(j.find("frameTimestamps") == j.end());
+
+        std::remove(fileName.c_str());
+    }
+
+    SECTION("Timestamps read from frame headers")
+    {
+        std::string fileName = g_resources["unitTestDataPath"] + "/dual_color/DualColorMultiplexingMovie.isxd";
+
+        std::vector<uint64_t> expTimestamps;
+        {
+            isx::MosaicMovieFile movie(fileName);
+            REQUIRE(movie.hasFrameTimestamps());
+            for (isx::isize_t f = 0; f < movie.getTimingInfo().getNumTimes(); ++f)
+            {
+                expTimestamps.push_back(movie.readFrameTimestamp(f));
+            }
+        }
+
+        isx::MosaicMovieFile movie(fileName);
+        REQUIRE(movie.readFrameTimestamps(1, 2) == std::vector<uint64_t>(expTimestamps.begin() + 1, expTimestamps.begin() + 3));
+        REQUIRE(movie.getAllFrameTimestamps() == expTimestamps);
+        REQUIRE(expTimestamps[0] == 258308031709);
+        REQUIRE(expTimestamps[1] == 258308048343);
+    }
+
+    isx::CoreShutdown();
+}
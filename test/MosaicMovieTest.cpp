@@ -8,6 +8,9 @@
 
 #include <stdio.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "json.hpp"
 using json = nlohmann::json;
@@ -190,6 +193,98 @@ TEST_CASE("MosaicMovieU16", "[core-internal][mosaic_movie]")
         }
     }
 
+    SECTION("Read raw frames while reading frames asynchronously")
+    {
+        const isx::isize_t numPixels = spacingInfo.getTotalNumPixels();
+        const size_t numHeaderFooterValues = 2 * 1280;
+        const size_t headerSizeInBytes = numHeaderFooterValues * sizeof(uint16_t);
+        const size_t frameSizeInBytes = numPixels * sizeof(uint16_t);
+        {
+            isx::SpWritableMovie_t movie = isx::writeMosaicMovie(fileName, timingInfo, spacingInfo, dataType, true);
+            for (isx::isize_t f = 0; f < numFrames; ++f)
+            {
+                const std::vector<uint16_t> header(numHeaderFooterValues, uint16_t(f));
+                const std::vector<uint16_t> footer(numHeaderFooterValues, uint16_t(f + 1));
+                std::vector<uint16_t> pixels(numPixels);
+                for (isx::isize_t p = 0; p < numPixels; ++p)
+                {
+                    pixels[p] = uint16_t((f * numPixels) + p);
+                }
+                movie->writeFrameWithHeaderFooter(header.data(), pixels.data(), footer.data());
+            }
+            movie->closeForWriting();
+        }
+
+        const isx::SpMovie_t movie = isx::readMovie(fileName);
+        const size_t numRounds = 50;
+        std::atomic<size_t> numRawMismatches(0);
+        std::atomic<size_t> numAsyncMismatches(0);
+        std::atomic<size_t> numAsyncDone(0);
+
+        std::thread rawReader([&movie, &numRawMismatches, numPixels, headerSizeInBytes, frameSizeInBytes, numRounds, numFrames]()
+        {
+            std::vector<char> rawFrame(movie->getRawFrameSizeInBytes());
+            for (size_t r = 0; r < numRounds; ++r)
+            {
+                for (isx::isize_t f = 0; f < numFrames; ++f)
+                {
+                    try
+                    {
+                        movie->getRawFrame(f, rawFrame.data());
+                        const uint16_t * header = reinterpret_cast<const uint16_t *>(rawFrame.data());
+                        const uint16_t * pixels = reinterpret_cast<const uint16_t *>(rawFrame.data() + headerSizeInBytes);
+                        const uint16_t * footer = reinterpret_cast<const uint16_t *>(rawFrame.data() + headerSizeInBytes + frameSizeInBytes);
+                        if (header[0] != f || pixels[numPixels - 1] != (f * numPixels) + numPixels - 1 || footer[0] != f + 1)
+                        {
+                            ++numRawMismatches;
+                        }
+                    }
+                    catch (...)
+                    {
+                        ++numRawMismatches;
+                    }
+                }
+            }
+        });
+
+        for (size_t r = 0; r < numRounds; ++r)
+        {
+            for (isx::isize_t f = 0; f < numFrames; ++f)
+            {
+                movie->getFrameAsync(f, [&numAsyncMismatches, &numAsyncDone, numPixels, f](isx::AsyncTaskResult<isx::SpVideoFrame_t> inResult)
+                {
+                    try
+                    {
+                        const isx::SpVideoFrame_t frame = inResult.get();
+                        const uint16_t * pixels = frame->getPixelsAsU16();
+                        for (isx::isize_t p = 0; p < numPixels; ++p)
+                        {
+                            if (pixels[p] != (f * numPixels) + p)
+                            {
+                                ++numAsyncMismatches;
+                                break;
+                            }
+                        }
+                    }
+                    catch (...)
+                    {
+                        ++numAsyncMismatches;
+                    }
+                    ++numAsyncDone;
+                });
+            }
+        }
+
+        rawReader.join();
+        while (numAsyncDone < numRounds * numFrames)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        REQUIRE(numRawMismatches == 0);
+        REQUIRE(numAsyncMismatches == 0);
+    }
+
     isx::CoreShutdown();
 }
 
@@ -770,6 +865,9 @@ TEST_CASE("MosaicMovieU16-forTheHub", "[core][mosaic_movie]")
 
         // Check we get the frame data, header, and footer back.
         const isx::SpMovie_t movie = isx::readMovie(filePath);
+        const size_t rawFrameSizeInBytes = headerSizeInBytes + frameSizeInBytes + footerSizeInBytes;
+        REQUIRE(movie->getRawFrameSizeInBytes() == rawFrameSizeInBytes);
+        std::vector<char> rawFrame(rawFrameSizeInBytes);
         for (isx::isize_t f = 0; f < numFrames; ++f)
         {
             const isx::SpVideoFrame_t frame = movie->getFrame(f);
@@ -777,7 +875,13 @@ TEST_CASE("MosaicMovieU16-forTheHub", "[core][mosaic_movie]")
             REQUIRE(std::memcmp(frame->getPixelsAsU16(), frames.at(f).data(), frameSizeInBytes) == 0);
             REQUIRE(movie->getFrameHeader(f) == headers.at(f));
             REQUIRE(movie->getFrameFooter(f) == footers.at(f));
+
+            movie->getRawFrame(f, rawFrame.data());
+            REQUIRE(std::memcmp(rawFrame.data(), headers.at(f).data(), headerSizeInBytes) == 0);
+            REQUIRE(std::memcmp(rawFrame.data() + headerSizeInBytes, frames.at(f).data(), frameSizeInBytes) == 0);
+            REQUIRE(std::memcmp(rawFrame.data() + headerSizeInBytes + frameSizeInBytes, footers.at(f).data(), footerSizeInBytes) == 0);
         }
+        REQUIRE_THROWS_AS(movie->getRawFrame(numFrames, rawFrame.data()), isx::ExceptionDataIO);
 
         REQUIRE(movie->getOriginalSpacingInfo() == isx::SpacingInfo::getDefaultForNVista3());
 
@@ -1,6 +1,7 @@
 #include "isxCore.h"
 #include "isxMosaicMovie.h"
 #include "isxMovieSeries.h"
+#include "isxFileHandlePool.h"
 #include "catch.hpp"
 #include "isxTest.h"
 
@@ -212,6 +213,44 @@ TEST_CASE("MovieSeriesU16", "[core-internal]")
         }
     }
 
+    SECTION("getFrame with fewer open files than movies")
+    {
+        isx::isize_t i = 0;
+        for (const auto & fn: filenames)
+        {
+            writeTestU16Movie(fn, timingInfos[i], spacingInfo, uint16_t((i + 1) * 10));
+            ++i;
+        }
+
+        isx::FileHandlePool::setMaxOpenHandles(1);
+        isx::FileHandlePool::resetStats();
+        auto movieSeries = std::make_shared<isx::MovieSeries>(filenames);
+
+        // The files are only opened when their frames are first read.
+        isx::FileHandlePoolStats stats = isx::FileHandlePool::getStats();
+        REQUIRE(stats.m_numOpens == 0);
+        REQUIRE(stats.m_numOpenHandles == 0);
+
+        const auto tis = movieSeries->getTimingInfosForSeries();
+        for (size_t m = 0; m < tis.size(); ++m)
+        {
+            for (isx::isize_t f = 0; f < tis[m].getNumTimes(); ++f)
+            {
+                const auto globalIndex = isx::getGlobalIndex(tis, std::pair<isx::isize_t, isx::isize_t>(m, f));
+                const auto frame = movieSeries->getFrame(globalIndex);
+                REQUIRE(frame->getPixelsAsU16()[0] == uint16_t((m + 1) * 10 + f));
+            }
+        }
+
+        // Reading the movies in order opens each file once.
+        stats = isx::FileHandlePool::getStats();
+        REQUIRE(stats.m_numOpens == filenames.size());
+        REQUIRE(stats.m_numOpenHandles == 1);
+
+        movieSeries.reset();
+        isx::FileHandlePool::setMaxOpenHandles(isx::FileHandlePool::s_defaultMaxOpenHandles);
+    }
+
     for (const auto & fn: filenames)
     {
         std::remove(fn.c_str());
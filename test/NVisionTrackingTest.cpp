@@ -3,6 +3,10 @@
 
 #include "isxNVisionTracking.h"
 #include "isxMovieFactory.h"
+#include "isxNVisionFrameMetadata.h"
+
+#include <cstdio>
+#include <fstream>
 
 
 TEST_CASE("NVisionTrackingBoundingBox", "[core]")
@@ -181,3 +185,83 @@ TEST_CASE("NVisionTrackingZones", "[core]")
 
     isx::CoreShutdown();
 }
+
+TEST_CASE("NVisionFrameMetadataTable", "[core]")
+{
+    const std::string sidecarFileName = g_resources["unitTestDataPath"] + "/nVisionFrameMetadata.bin";
+    std::remove(sidecarFileName.c_str());
+
+    isx::CoreInitialize();
+
+    const std::vector<std::string> frameMetadatas = {
+        "{\"fc\":19,\"tracker\":{\"box\":[528.115173339844,776.796661376953,699.851165771484,912.584289550781],\"conf\":98.4991912841797,\"zones\":{\"id\":4270701760,\"name\":\"ZONE#1 rectangle\"}},\"tsc\":163958151927}",
+        "{\"fc\":2844,\"tracker\":{\"box\":[1268.00234985352,768.432312011719,1365.31988525391,895.73291015625],\"conf\":80.8296203613281,\"zones\":[{\"event\":\"e\",\"id\":1720032796530,\"name\":\"ZONE#3\",\"trig\":\"softTrig-3\"},{\"event\":\"x\",\"id\":1720032411965,\"name\":\"ZONE#2\",\"trig\":\"softTrig-2\"}]},\"tsc\":1017645148394}",
+        "{\"fc\":2845,\"tracker\":{\"box\":[1270.5,770.25,1366.75,897.5],\"conf\":81.5,\"zones\":[{\"event\":\"o\",\"id\":1720032796530,\"name\":\"ZONE#3\"}]},\"tsc\":1017645181727}",
+        "{\"fc\":1,\"tsc\":215738669569}",
+        "{\"fc\":2,\"tracker\":{\"conf\":0}}",
+        "{\"fc\":3,\"tracker\":{\"box\":[1,2,3],\"conf\":50},\"tsc\":215738733609}",
+        "{\"fc\":4,\"tracker\":{\"box\":[1,2,3,4],\"conf\":50,\"zones\":{\"id\":1,\"name\":\"ZONE#1\",\"event\":\"?\"}},\"tsc\":\"bad\"}",
+    };
+
+    isx::json samples = isx::json::array();
+    for (const auto & frameMetadata : frameMetadatas)
+    {
+        samples.push_back(isx::json::parse(frameMetadata));
+    }
+
+    const auto checkTable = [&frameMetadatas](const isx::NVisionFrameMetadataTable & inTable)
+    {
+        REQUIRE(inTable.getNumFrames() == frameMetadatas.size());
+
+        const std::vector<bool> expHasTimestamp = {true, true, true, true, false, true, false};
+        const std::vector<uint64_t> expTimestamps = {163958151927, 1017645148394, 1017645181727, 215738669569, 0, 215738733609, 0};
+        const std::vector<bool> expHasBoundingBox = {true, true, true, true, true, false, false};
+        for (size_t i = 0; i < frameMetadatas.size(); ++i)
+        {
+            REQUIRE(inTable.hasTimestamp(i) == expHasTimestamp[i]);
+            REQUIRE(inTable.getTimestamps()[i] == expTimestamps[i]);
+            REQUIRE(inTable.hasBoundingBox(i) == expHasBoundingBox[i]);
+            if (inTable.hasBoundingBox(i))
+            {
+                REQUIRE(inTable.getBoundingBox(i) == isx::BoundingBox::fromMetadata(frameMetadatas[i]));
+            }
+        }
+        REQUIRE(!inTable.hasTimestamp(frameMetadatas.size()));
+        REQUIRE(!inTable.hasBoundingBox(frameMetadatas.size()));
+
+        const std::vector<size_t> expZoneEventOffsets = {0, 1, 3, 4, 4, 4, 4, 4};
+        REQUIRE(inTable.getZoneEventOffsets() == expZoneEventOffsets);
+        REQUIRE(inTable.getZoneName(1) == "ZONE#3");
+        REQUIRE(inTable.getZoneName(3) == "ZONE#3");
+        REQUIRE(inTable.getZoneEventTypes()[3] == isx::ZoneEvent::Type::OCCUPIED);
+        REQUIRE(inTable.getZoneEventTriggers()[3] == isx::ZoneEvent::Trigger::NONE);
+    };
+
+    const auto table = isx::NVisionFrameMetadataTable::fromJson(samples);
+
+    SECTION("Decode")
+    {
+        checkTable(table);
+    }
+
+    SECTION("Save and load")
+    {
+        table.save(sidecarFileName);
+        checkTable(isx::NVisionFrameMetadataTable::load(sidecarFileName));
+    }
+
+    SECTION("Load invalid file")
+    {
+        {
+            std::ofstream file(sidecarFileName, std::ios::binary);
+            file << "not a metadata file";
+        }
+        ISX_REQUIRE_EXCEPTION(
+                isx::NVisionFrameMetadataTable::load(sidecarFileName),
+                isx::ExceptionFileIO,
+                "Invalid nVision frame metadata file: " + sidecarFileName);
+    }
+
+    std::remove(sidecarFileName.c_str());
+    isx::CoreShutdown();
+}
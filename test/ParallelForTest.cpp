@@ -0,0 +1,88 @@
+#include "isxParallelFor.h"
+#include "isxException.h"
+#include "catch.hpp"
+#include "isxTest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ParallelFor", "[core-internal]")
+{
+    const isx::isize_t numTasks = 37;
+
+    isx::CoreInitialize();
+
+    SECTION("Every index is run once")
+    {
+        for (const isx::isize_t maxNumThreads : {isx::isize_t(1), isx::isize_t(4), isx::isize_t(0)})
+        {
+            std::vector<std::atomic<int>> numRuns(numTasks);
+            for (auto & n : numRuns)
+            {
+                n = 0;
+            }
+            isx::parallelFor(numTasks, [&numRuns](const isx::isize_t inIndex)
+            {
+                ++numRuns[inIndex];
+            }, maxNumThreads);
+
+            for (const auto & n : numRuns)
+            {
+                REQUIRE(n == 1);
+            }
+        }
+    }
+
+    SECTION("The error of the lowest failed index is rethrown")
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            try
+            {
+                isx::parallelFor(numTasks, [](const isx::isize_t inIndex)
+                {
+                    if (inIndex == 11 || inIndex == 5 || inIndex == 30)
+                    {
+                        ISX_THROW(isx::ExceptionDataIO, "Failed task ", inIndex, ".");
+                    }
+                }, 4);
+                FAIL("No error was rethrown.");
+            }
+            catch (const isx::ExceptionDataIO & error)
+            {
+                REQUIRE(std::string(error.what()) == "Failed task 5.");
+            }
+        }
+    }
+
+    SECTION("Nested calls finish")
+    {
+        std::atomic<isx::isize_t> numRuns(0);
+        isx::parallelFor(numTasks, [&numRuns, numTasks](const isx::isize_t)
+        {
+            isx::parallelFor(numTasks, [&numRuns](const isx::isize_t)
+            {
+                ++numRuns;
+            }, 4);
+        }, 4);
+        REQUIRE(numRuns == numTasks * numTasks);
+    }
+
+    isx::CoreShutdown();
+
+    SECTION("Tasks are run on this thread without the dispatch queues")
+    {
+        const std::thread::id thisId = std::this_thread::get_id();
+        isx::isize_t numOtherThreadRuns = 0;
+        isx::parallelFor(numTasks, [&numOtherThreadRuns, thisId](const isx::isize_t)
+        {
+            if (std::this_thread::get_id() != thisId)
+            {
+                ++numOtherThreadRuns;
+            }
+        }, 4);
+        REQUIRE(numOtherThreadRuns == 0);
+    }
+}
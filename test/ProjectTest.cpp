@@ -7,6 +7,7 @@
 #include "isxCellSet.h"
 #include "isxStopWatch.h"
 #include "isxCellSetFactory.h"
+#include "isxJsonUtils.h"
 
 #include <fstream>
 #include <cstring>
@@ -510,3 +511,46 @@ TEST_CASE("Project-missingFiles", "[core][!hide]")
 
     isx::CoreShutdown();
 }
+
+TEST_CASE("Project-saveTmp", "[core]")
+{
+    const std::string projectFileName = g_resources["unitTestDataPath"] + "/project.isxp";
+    std::remove(projectFileName.c_str());
+    const std::string tmpFileName = projectFileName + ".tmp";
+    std::remove(tmpFileName.c_str());
+
+    SECTION("The temporary project reflects all edits after flushing")
+    {
+        isx::Project project(projectFileName, "myProject");
+        const size_t numSeries = 50;
+        for (size_t i = 0; i < numSeries; ++i)
+        {
+            project.createSeriesInRoot("series" + std::to_string(i));
+        }
+        project.flushTmp();
+
+        std::ifstream file(tmpFileName);
+        const isx::json jsonObject = isx::readJson(file);
+        const isx::SpGroup_t root = isx::Group::fromJson(jsonObject.at("rootGroup"));
+        REQUIRE(root->getNumGroupMembers() == numSeries);
+        REQUIRE(*root == *project.getRootGroup());
+    }
+
+    SECTION("A JSON tree round trips like a JSON string")
+    {
+        isx::Project project(projectFileName, "myProject");
+        isx::HistoricalDetails hd("mainTest", "");
+        project.importDataSetInRoot(
+            "movie",
+            isx::DataSet::Type::MOVIE,
+            g_resources["unitTestDataPath"] + "/recording_20160426_145041-dff_he.isxd",
+            hd);
+        project.createSeriesInRoot("series");
+
+        const isx::Group * root = project.getRootGroup();
+        REQUIRE(root->toJson().dump() == root->toJsonString());
+        REQUIRE(*isx::Group::fromJson(root->toJson()) == *root);
+    }
+
+    std::remove(tmpFileName.c_str());
+}
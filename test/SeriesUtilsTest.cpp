@@ -0,0 +1,135 @@
+#include "isxSeriesUtils.h"
+#include "isxCellSetFactory.h"
+#include "isxException.h"
+#include "catch.hpp"
+#include "isxTest.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+TEST_CASE("SeriesUtils-forEachSeriesMember", "[core-internal]")
+{
+    const isx::isize_t numMembers = 37;
+
+    isx::CoreInitialize();
+
+    SECTION("Every member is run once")
+    {
+        for (const isx::isize_t maxNumThreads : {isx::isize_t(1), isx::isize_t(4), isx::isize_t(0)})
+        {
+            std::vector<std::atomic<int>> numRuns(numMembers);
+            for (auto & n : numRuns)
+            {
+                n = 0;
+            }
+            isx::forEachSeriesMember(numMembers, [&numRuns](const isx::isize_t inIndex)
+            {
+                ++numRuns[inIndex];
+            }, maxNumThreads);
+
+            for (const auto & n : numRuns)
+            {
+                REQUIRE(n == 1);
+            }
+        }
+    }
+
+    SECTION("The error of the first failed member is rethrown")
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            try
+            {
+                isx::forEachSeriesMember(numMembers, [](const isx::isize_t inIndex)
+                {
+                    if (inIndex == 11 || inIndex == 5 || inIndex == 30)
+                    {
+                        ISX_THROW(isx::ExceptionFileIO, "Failed to open member ", inIndex, ".");
+                    }
+                }, 4);
+                FAIL("No error was rethrown.");
+            }
+            catch (const isx::ExceptionFileIO & error)
+            {
+                REQUIRE(std::string(error.what()) == "Failed to open member 5.");
+            }
+        }
+    }
+
+    isx::CoreShutdown();
+}
+
+TEST_CASE("SeriesUtils-openSeriesMembers", "[core-internal]")
+{
+    const isx::TimingInfo timingInfo(isx::Time(), isx::DurationInSeconds(50, 1000), 4);
+    const isx::SpacingInfo spacingInfo(isx::SizeInPixels_t(4, 3));
+    const isx::isize_t numMembers = 12;
+
+    std::vector<std::string> fileNames;
+    for (isx::isize_t i = 0; i < numMembers; ++i)
+    {
+        fileNames.push_back(g_resources["unitTestDataPath"] + "/seriesUtilsCellSet" + std::to_string(i) + ".isxd");
+        std::remove(fileNames.back().c_str());
+    }
+
+    isx::CoreInitialize();
+
+    SECTION("Only .isxd members are opened concurrently")
+    {
+        REQUIRE(isx::canOpenSeriesMembersConcurrently(fileNames));
+        REQUIRE(isx::canOpenSeriesMembersConcurrently({"a.ISXD", "b.isxd"}));
+        REQUIRE(!isx::canOpenSeriesMembersConcurrently({"a.isxd", "b.hdf5"}));
+        REQUIRE(!isx::canOpenSeriesMembersConcurrently({"a.tif"}));
+    }
+
+    SECTION("Members are returned in the order of their file names")
+    {
+        for (const auto & fn : fileNames)
+        {
+            isx::writeCellSet(fn, timingInfo, spacingInfo)->closeForWriting();
+        }
+
+        const std::vector<isx::SpCellSet_t> cellSets = isx::openSeriesMembers<isx::SpCellSet_t>(
+                fileNames, [&fileNames](const isx::isize_t inIndex)
+        {
+            return isx::readCellSet(fileNames[inIndex]);
+        });
+
+        REQUIRE(cellSets.size() == numMembers);
+        for (isx::isize_t i = 0; i < numMembers; ++i)
+        {
+            REQUIRE(cellSets[i]->getFileName() == fileNames[i]);
+        }
+    }
+
+    SECTION("The error is that of the first member that cannot be opened")
+    {
+        for (isx::isize_t i = 0; i < numMembers; ++i)
+        {
+            if (i != 4 && i != 9)
+            {
+                isx::writeCellSet(fileNames[i], timingInfo, spacingInfo)->closeForWriting();
+            }
+        }
+
+        try
+        {
+            isx::readCellSetSeries(fileNames);
+            FAIL("Opening the series did not fail.");
+        }
+        catch (const isx::ExceptionFileIO & error)
+        {
+            const std::string message = error.what();
+            REQUIRE(message.find(fileNames[4]) != std::string::npos);
+            REQUIRE(message.find(fileNames[9]) == std::string::npos);
+        }
+    }
+
+    isx::CoreShutdown();
+
+    for (const auto & fn : fileNames)
+    {
+        std::remove(fn.c_str());
+    }
+}
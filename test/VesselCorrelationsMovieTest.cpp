@@ -4,6 +4,8 @@
 #include "isxTest.h"
 #include "catch.hpp"
 
+#include <cstring>
+
 TEST_CASE("VesselCorrelationsMovieTest", "[core]")
 {
     const std::string dataDirPath = g_resources["unitTestDataPath"] + "/bloodflow";
@@ -62,6 +64,17 @@ TEST_CASE("VesselCorrelationsMovieTest", "[core]")
             REQUIRE(frame != nullptr);
             REQUIRE(frame->getImage().getSpacingInfo() == movie->getSpacingInfo());
         }
+
+        SECTION("get all frames")
+        {
+            for (size_t frameNumber = 0; frameNumber < movie->getTimingInfo().getNumTimes(); frameNumber++)
+            {
+                const isx::SpVideoFrame_t frame = movie->getFrame(frameNumber);
+                const isx::SpImage_t heatmaps = vesselSet->getCorrelations(vesselId, frameNumber)->getHeatmaps();
+                REQUIRE(frame->getFrameIndex() == frameNumber);
+                REQUIRE(std::memcmp(frame->getPixelsAsF32(), heatmaps->getPixelsAsF32(), heatmaps->getImageSizeInBytes()) == 0);
+            }
+        }
     }
     
     isx::CoreShutdown();
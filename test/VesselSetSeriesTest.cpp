@@ -1,6 +1,7 @@
 #include "isxCore.h"
 #include "isxVesselSetFactory.h"
 #include "isxVesselSetSeries.h"
+#include "isxVesselCorrelationsReader.h"
 #include "catch.hpp"
 #include "isxTest.h"
 #include "json.hpp"
@@ -703,6 +704,46 @@ TEST_CASE("VesselSetSeries-RbcVelocity", "[core-internal]")
             }
             
         }
+
+        const size_t numValuesPerFrame = corrNumPixels * 3;
+        const auto requireEqualToTriptych = [&css, numValuesPerFrame](const float * inValues, const isx::isize_t inFrameNumber)
+        {
+            isx::SpVesselCorrelations_t triptych = css->getCorrelations(0, inFrameNumber);
+            REQUIRE(std::memcmp(inValues, triptych->getValues(), numValuesPerFrame * sizeof(float)) == 0);
+        };
+
+        SECTION("Range across vessel sets")
+        {
+            const std::vector<std::pair<isx::isize_t, isx::isize_t>> ranges = {{0, totalNumSamples}, {2, 8}, {4, 5}, {6, 6}};
+            for (const auto & range : ranges)
+            {
+                std::vector<float> values((range.second - range.first) * numValuesPerFrame);
+                REQUIRE(css->getCorrelationsRange(0, range.first, range.second, values.data()));
+                for (isx::isize_t j = range.first; j < range.second; ++j)
+                {
+                    requireEqualToTriptych(values.data() + (j - range.first) * numValuesPerFrame, j);
+                }
+            }
+
+            std::vector<float> values(numValuesPerFrame);
+            ISX_REQUIRE_EXCEPTION(
+                css->getCorrelationsRange(0, totalNumSamples, totalNumSamples + 1, values.data()),
+                isx::ExceptionDataIO,
+                "The range of frames [" + std::to_string(totalNumSamples) + ", " + std::to_string(totalNumSamples + 1)
+                + ") is out of range (0-" + std::to_string(totalNumSamples) + ").");
+        }
+
+        SECTION("Prefetching reader")
+        {
+            isx::VesselCorrelationsReader reader(css, 0, 2 * numValuesPerFrame * sizeof(float));
+            REQUIRE(reader.getNumFramesPerBlock() == 2);
+            for (isx::isize_t j(0); j < totalNumSamples; ++j)
+            {
+                requireEqualToTriptych(reader.read(j), j);
+            }
+            requireEqualToTriptych(reader.read(1), 1);
+            requireEqualToTriptych(reader.read(totalNumSamples - 1), totalNumSamples - 1);
+        }
     }
 
     SECTION("Get max velocity")
@@ -0,0 +1,37 @@
+set(TARGET_NAME_ISXBENCH "isxbench")
+set(ISXBENCH_SRC_DIR ${CMAKE_CURRENT_LIST_DIR}/../../bench)
+
+file(GLOB ISXBENCH_SRCS ${ISXBENCH_SRC_DIR}/*.cpp)
+file(GLOB ISXBENCH_HDRS ${ISXBENCH_SRC_DIR}/*.h)
+
+add_executable(${TARGET_NAME_ISXBENCH}
+    ${ISXBENCH_SRCS} ${ISXBENCH_HDRS}
+)
+
+target_include_directories(${TARGET_NAME_ISXBENCH} PRIVATE
+    ${ISXBENCH_SRC_DIR}
+    ${CORE_SRC_DIR}             # to allow benchmarking internal-only classes
+    ${HDF5_HEADER_SEARCH_PATHS}
+    ${JSON_HEADER_SEARCH_PATHS}
+    ${OPENCV_HEADER_SEARCH_PATHS}
+    ${QT_CORE_HEADER_SEARCH_PATHS}
+    ${LIBTIFF_HEADER_SEARCH_PATHS}
+    ${BOOST_HEADER_SEARCH_PATHS}
+)
+
+target_link_libraries(${TARGET_NAME_ISXBENCH} PRIVATE
+    ${TARGET_NAME_CORE})
+
+if(${ISX_OS_WIN32})
+    # for GetProcessMemoryInfo
+    target_link_libraries(${TARGET_NAME_ISXBENCH} PRIVATE psapi)
+endif()
+
+set_target_properties(${TARGET_NAME_ISXBENCH} PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY_DEBUG "${CMAKE_BINARY_DIR}/../bin"
+    RUNTIME_OUTPUT_DIRECTORY_RELEASE "${CMAKE_BINARY_DIR}/../bin"
+)
+
+setCommonCxxOptionsForTarget(${TARGET_NAME_ISXBENCH})
+setOsDefinesForTarget(${TARGET_NAME_ISXBENCH})
+disableVisualStudioWarnings(${TARGET_NAME_ISXBENCH})
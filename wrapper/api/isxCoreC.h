@@ -671,6 +671,36 @@ isx_events_get_cell_count(
     size_t * out_count
 );
 
+// Gets the number of events of all cells within the time window [in_start_usecs, in_end_usecs),
+// which is given in microseconds since the start of the events.
+// Pass 0 and INT64_MAX to count all events.
+// The events are kept until they are copied out by isx_events_get_all_cells with the same window.
+ISX_DLL_EXPORT
+int
+isx_events_get_all_cells_count(
+    IsxEvents * in_events,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t * out_count
+);
+
+// Gets the events of all cells within a time window with a single read of the file.
+// The events of cell i are at indices [out_cell_starts[i], out_cell_starts[i + 1]) of
+// out_usecs_since_start and out_values, so out_cell_starts must have space for num_cells + 1 values.
+// NOTE: Should be called after isx_events_get_all_cells_count to get the size of the destination arrays,
+// which is passed as in_buffer_size. Fails if the arrays are too small.
+ISX_DLL_EXPORT
+int
+isx_events_get_all_cells(
+    IsxEvents * in_events,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t in_buffer_size,
+    int64_t * out_usecs_since_start,
+    float * out_values,
+    size_t * out_cell_starts
+);
+
 ISX_DLL_EXPORT
 int
 isx_events_get_cell_name(
@@ -761,6 +791,36 @@ isx_gpio_get_channel(
     float * out_values
 );
 
+// Gets the number of values of all channels within the time window [in_start_usecs, in_end_usecs),
+// which is given in microseconds since the start of the GPIO data.
+// Pass 0 and INT64_MAX to count all values.
+// The values are kept until they are copied out by isx_gpio_get_all_channels with the same window.
+ISX_DLL_EXPORT
+int
+isx_gpio_get_all_channels_count(
+    IsxGpio * in_gpio,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t * out_count
+);
+
+// Gets the values of all channels within a time window with a single read of the file.
+// The values of channel i are at indices [out_channel_starts[i], out_channel_starts[i + 1]) of
+// out_usecs_since_start and out_values, so out_channel_starts must have space for num_channels + 1 values.
+// NOTE: Should be called after isx_gpio_get_all_channels_count to get the size of the destination arrays,
+// which is passed as in_buffer_size. Fails if the arrays are too small.
+ISX_DLL_EXPORT
+int
+isx_gpio_get_all_channels(
+    IsxGpio * in_gpio,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t in_buffer_size,
+    int64_t * out_usecs_since_start,
+    float * out_values,
+    size_t * out_channel_starts
+);
+
 ISX_DLL_EXPORT
 int
 isx_gpio_get_channel_name(
@@ -868,9 +928,8 @@ ISX_DLL_EXPORT
 int
 isx_get_is_with_algos();
 
-// Note: This is not thread-safe. Multi-threaded invocation of the fun.ctions here will certainly break
-// this if there is more than one exception.  To make this thread-safe we'll need to design a different
-// API to retrieve the exception string that would probably also make this harder to use.
+// Note: The last exception string is kept per thread, so it must be retrieved
+// from the thread that called the function that failed.
 ISX_DLL_EXPORT
 const char *
 isx_get_last_exception_string();
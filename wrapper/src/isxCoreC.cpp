@@ -1,5 +1,6 @@
 #include "isxCoreC.h"
 #include "isxUtilsC.h"
+#include "isxHandleRegistryC.h"
 
 #include "isxMovieFactory.h"
 #include "isxCellSetFactory.h"
@@ -36,28 +37,32 @@ namespace
 std::unique_ptr<std::pair<int, std::string>> g_core_app_args;
 std::unique_ptr<QCoreApplication> g_core_app;
 
-isx::isize_t g_movie_id = 0;
-std::map <isx::isize_t, isx::SpMovie_t> g_open_movies;
-
-isx::isize_t g_writable_movie_id = 0;
-std::map <isx::isize_t, isx::SpWritableMovie_t> g_open_writable_movies;
-
-isx::isize_t g_cell_set_id = 0;
-std::map <isx::isize_t, isx::SpCellSet_t> g_open_cell_sets;
-
-isx::isize_t g_events_id = 0;
-std::map <isx::isize_t, isx::SpEvents_t> g_open_events;
-
-isx::isize_t g_gpio_id = 0;
-std::map <isx::isize_t, isx::SpGpio_t> g_open_gpios;
-
-isx::isize_t g_vessel_set_id = 0;
-std::map <isx::isize_t, isx::SpVesselSet_t> g_open_vessel_sets;
-
-std::map <std::pair<isx::isize_t, std::string>, isx::SpLogicalTrace_t> g_open_logical_traces;
-
-isx::isize_t g_writable_events_id = 0;
-std::map <isx::isize_t, isx::SpWritableEvents_t> g_open_writable_events;
+// The objects opened through the C API, which are looked up by the ids of
+// their C structs from any thread.
+IsxHandleRegistry<isx::SpMovie_t> g_open_movies("movie");
+IsxHandleRegistry<isx::SpWritableMovie_t> g_open_writable_movies("writable movie");
+IsxHandleRegistry<isx::SpCellSet_t> g_open_cell_sets("cell set");
+IsxHandleRegistry<isx::SpEvents_t> g_open_events("events");
+IsxHandleRegistry<isx::SpGpio_t> g_open_gpios("GPIO");
+IsxHandleRegistry<isx::SpVesselSet_t> g_open_vessel_sets("vessel set");
+IsxHandleRegistry<isx::SpWritableEvents_t> g_open_writable_events("writable events");
+
+// The logical trace of a cell or channel read when getting its count,
+// which is kept until it is copied out.
+using LogicalTraceKey_t = std::pair<isx::isize_t, std::string>;
+IsxLockedMap<LogicalTraceKey_t, isx::SpLogicalTrace_t> g_open_events_traces;
+IsxLockedMap<LogicalTraceKey_t, isx::SpLogicalTrace_t> g_open_gpio_traces;
+
+// The logical traces of all cells or channels read when getting their count,
+// which are kept until they are copied out, along with the time window they were read for.
+struct OpenLogicalTraceTable
+{
+    int64_t start_usecs;
+    int64_t end_usecs;
+    isx::LogicalTraceTable table;
+};
+IsxLockedMap<isx::isize_t, OpenLogicalTraceTable> g_open_events_tables;
+IsxLockedMap<isx::isize_t, OpenLogicalTraceTable> g_open_gpio_tables;
 
 void
 delete_timing(IsxTimingInfo & in_timing)
@@ -83,7 +88,7 @@ isx_movie_flush_internal(
     }
     else
     {
-        isx::SpWritableMovie_t movie = g_open_writable_movies[in_movie->id];
+        isx::SpWritableMovie_t movie = g_open_writable_movies.get(in_movie->id);
         if (in_timing == nullptr)
         {
             movie->closeForWriting();
@@ -102,7 +107,7 @@ isx_cell_set_flush_internal(
 {
     if (!(in_cell_set->read_only))
     {
-        isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+        isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
         cell_set->closeForWriting();
     }
 }
@@ -114,7 +119,7 @@ isx_events_flush_internal(
 {
     if (!in_events->read_only)
     {
-        isx::SpWritableEvents_t events = g_open_writable_events[in_events->id];
+        isx::SpWritableEvents_t events = g_open_writable_events.get(in_events->id);
         events->closeForWriting();
     }
 }
@@ -126,7 +131,7 @@ isx_vessel_set_flush_internal(
 {
     if (!(in_vessel_set->read_only))
     {
-        isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         vessel_set->closeForWriting();
     }
 }
@@ -167,6 +172,49 @@ isx_check_channel_index(
     }
 }
 
+// Get the logical traces of all cells or channels within a time window,
+// either from the tables read when getting their count or by reading them now.
+isx::LogicalTraceTable
+isx_take_logical_trace_table(
+    IsxLockedMap<isx::isize_t, OpenLogicalTraceTable> & in_open_tables,
+    const isx::isize_t in_id,
+    const int64_t in_start_usecs,
+    const int64_t in_end_usecs,
+    const std::function<isx::LogicalTraceTable()> & in_read_table)
+{
+    OpenLogicalTraceTable open_table;
+    if (in_open_tables.take(in_id, open_table))
+    {
+        if (open_table.start_usecs == in_start_usecs && open_table.end_usecs == in_end_usecs)
+        {
+            return std::move(open_table.table);
+        }
+    }
+    return in_read_table();
+}
+
+void
+isx_copy_logical_trace_table(
+    const isx::LogicalTraceTable & in_table,
+    const size_t in_buffer_size,
+    int64_t * out_usecs_since_start,
+    float * out_values,
+    size_t * out_starts)
+{
+    const size_t num_values = in_table.m_values.size();
+    if (in_buffer_size < num_values)
+    {
+        ISX_THROW(isx::ExceptionUserInput, "The buffer size (", in_buffer_size,
+                ") is smaller than the number of values (", num_values, ").");
+    }
+    if (num_values > 0)
+    {
+        memcpy(out_usecs_since_start, in_table.m_offsetsMicroSecs.data(), num_values * sizeof(int64_t));
+        memcpy(out_values, in_table.m_values.data(), num_values * sizeof(float));
+    }
+    memcpy(out_starts, in_table.m_traceStarts.data(), in_table.m_traceStarts.size() * sizeof(size_t));
+}
+
 int
 isx_cell_set_get_name_internal(
     IsxCellSet * in_cell_set,
@@ -177,7 +225,7 @@ isx_cell_set_get_name_internal(
 {
     return isx_process_op([=]()
     {
-        const isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+        const isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
         isx_check_cell_index(in_index, cell_set->getNumCells());
         const std::string cell_name = cell_set->getCellName(isx::isize_t(in_index));
         isx::copyCppStringToCString(cell_name, out_cell_name, in_cell_name_size);
@@ -194,7 +242,7 @@ isx_events_get_cell_name_internal(
 {
     return isx_process_op([=]()
     {
-        const isx::SpEvents_t events = g_open_events[in_events->id];
+        const isx::SpEvents_t events = g_open_events.get(in_events->id);
         isx_check_cell_index(in_index, events->numberOfCells());
         const std::string cell_name = events->getCellNamesList().at(in_index);
         isx::copyCppStringToCString(cell_name, out_cell_name, in_cell_name_size);
@@ -211,7 +259,7 @@ isx_vessel_set_get_name_internal(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         const std::string vessel_name = vessel_set->getVesselName(isx::isize_t(in_index));
         isx::copyCppStringToCString(vessel_name, out_vessel_name, in_vessel_name_size);
@@ -227,7 +275,7 @@ isx_movie_get_extra_properties_internal(
 {
     return isx_process_op([=]()
     {
-        const isx::SpMovie_t movie = g_open_movies[in_movie->id];
+        const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
         const std::string extra_props = movie->getExtraProperties();
         if (extra_props.size() >= in_extra_properties_size)
         {
@@ -419,7 +467,7 @@ isx_movie_get_frame_data_internal(
     T * out_frame_data
 )
 {
-    const isx::SpMovie_t movie = g_open_movies[in_movie->id];
+    const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
     const isx::SpVideoFrame_t frame = movie->getFrame(in_index);
     std::memcpy(reinterpret_cast<char *>(out_frame_data), frame->getPixels(), frame->getImageSizeInBytes());
 }
@@ -434,7 +482,7 @@ isx_movie_write_frame_internal(
 {
     return isx_process_op([=]()
     {
-        isx::SpWritableMovie_t movie = g_open_writable_movies[in_movie->id];
+        isx::SpWritableMovie_t movie = g_open_writable_movies.get(in_movie->id);
         if (movie->getTimingInfo().isIndexValid(in_index))
         {
             isx::SpVideoFrame_t frame = movie->makeVideoFrame(isx::isize_t(in_index));
@@ -546,11 +594,8 @@ isx_read_movie(
 
         isx::SpMovie_t movie = isx::readMovie(in_file_path);
 
-        g_open_movies[g_movie_id] = movie;
-
         *out_movie = new IsxMovie;
 
-        (*out_movie)->id = size_t(g_movie_id);
         (*out_movie)->data_type = int(movie->getDataType());
         (*out_movie)->read_only = true;
         (*out_movie)->file_path = make_canonical_file_path(in_file_path);
@@ -558,7 +603,7 @@ isx_read_movie(
         convert_timing_info_cpp_to_c(movie->getTimingInfo(), &((*out_movie)->timing));
         convert_spacing_info_cpp_to_c(movie->getSpacingInfo(), &((*out_movie)->spacing));
 
-        g_movie_id++;
+        (*out_movie)->id = g_open_movies.add(movie);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_movie);
@@ -588,11 +633,8 @@ isx_write_movie(
 
         isx::SpWritableMovie_t movie = isx::writeMosaicMovie(in_file_path, timing, spacing, isx::DataType(in_data_type), in_has_frame_header_footer);
 
-        g_open_writable_movies[g_writable_movie_id] = movie;
-
         *out_movie = new IsxMovie;
 
-        (*out_movie)->id = size_t(g_writable_movie_id);
         (*out_movie)->data_type= in_data_type;
         (*out_movie)->read_only = false;
         (*out_movie)->file_path = make_canonical_file_path(in_file_path);
@@ -601,7 +643,7 @@ isx_write_movie(
         convert_timing_info_cpp_to_c(timing, &((*out_movie)->timing));
         convert_spacing_info_cpp_to_c(spacing, &((*out_movie)->spacing));
 
-        g_writable_movie_id++;
+        (*out_movie)->id = g_open_writable_movies.add(movie);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_movie);
@@ -631,16 +673,8 @@ isx_movie_get_frame_data_u16_with_header_footer(
     ISX_ASSERT(in_movie->data_type == int(isx::DataType::U16));
     return isx_process_op([=]()
     {
-        const isx::SpMovie_t movie = g_open_movies[in_movie->id];
-
-        const std::vector<uint16_t> header = movie->getFrameHeader(in_index);
-        std::memcpy(out_frame_data, header.data(), sizeof(uint16_t) * header.size());
-
-        const isx::SpVideoFrame_t frame = movie->getFrame(in_index);
-        std::memcpy(out_frame_data + header.size(), frame->getPixels(), frame->getImageSizeInBytes());
-
-        const std::vector<uint16_t> footer = movie->getFrameFooter(in_index);
-        std::memcpy(out_frame_data + header.size() + frame->getImage().getSpacingInfo().getTotalNumPixels(), footer.data(), sizeof(uint16_t) * footer.size());
+        const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
+        movie->getRawFrame(in_index, reinterpret_cast<char *>(out_frame_data));
     });
 }
 
@@ -653,7 +687,7 @@ isx_movie_get_frame_header(
 {
     return isx_process_op([=]()
     {
-        const isx::SpMovie_t movie = g_open_movies[in_movie->id];
+        const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
         const std::vector<uint16_t> header = movie->getFrameHeader(in_index);
         std::memcpy(out_header, header.data(), sizeof(uint16_t) * header.size());
     });
@@ -668,7 +702,7 @@ isx_movie_get_frame_footer(
 {
     return isx_process_op([=]()
     {
-        const isx::SpMovie_t movie = g_open_movies[in_movie->id];
+        const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
         const std::vector<uint16_t> footer = movie->getFrameFooter(in_index);
         std::memcpy(out_footer, footer.data(), sizeof(uint16_t) * footer.size());
     });
@@ -726,7 +760,7 @@ isx_movie_write_frame_u16_with_header_footer(
     ISX_ASSERT(in_movie->data_type == int(isx::DataType::U16));
     return isx_process_op([=]()
     {
-        isx::SpWritableMovie_t movie = g_open_writable_movies[in_movie->id];
+        isx::SpWritableMovie_t movie = g_open_writable_movies.get(in_movie->id);
         movie->writeFrameWithHeaderFooter(in_buffer);
     });
 }
@@ -742,7 +776,7 @@ isx_movie_write_frame_u16_with_header_footer_separately(
     ISX_ASSERT(in_movie->data_type == int(isx::DataType::U16));
     return isx_process_op([=]()
     {
-        isx::SpWritableMovie_t movie = g_open_writable_movies[in_movie->id];
+        isx::SpWritableMovie_t movie = g_open_writable_movies.get(in_movie->id);
         movie->writeFrameWithHeaderFooter(in_header, in_pixels, in_footer);
     });
 }
@@ -766,7 +800,7 @@ isx_movie_set_extra_properties(
 {
     return isx_process_op([=]()
     {
-        isx::SpWritableMovie_t movie = g_open_writable_movies[in_movie->id];
+        isx::SpWritableMovie_t movie = g_open_writable_movies.get(in_movie->id);
         movie->setExtraProperties(in_properties);
     });
 }
@@ -799,7 +833,7 @@ isx_movie_get_extra_properties_size(
 {
     return isx_process_op([=]()
     {
-        const isx::SpMovie_t movie = g_open_movies[in_movie->id];
+        const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
         // +1 for the null terminator
         *out_extra_properties_size = movie->getExtraProperties().size() + 1;
     });
@@ -841,11 +875,11 @@ isx_movie_delete(
             isx_movie_flush_internal(in_movie, nullptr);
             if (in_movie->read_only)
             {
-                g_open_movies.erase(in_movie->id);
+                g_open_movies.remove(in_movie->id);
             }
             else
             {
-                g_open_writable_movies.erase(in_movie->id);
+                g_open_writable_movies.remove(in_movie->id);
             }
             delete_timing(in_movie->timing);
             delete in_movie->file_path;
@@ -864,7 +898,7 @@ isx_movie_get_acquisition_info(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_movies[in_movie->id], out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_movies.get(in_movie->id), out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -878,7 +912,7 @@ isx_movie_get_acquisition_info_for_matlab(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_movies[in_movie->id], *out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_movies.get(in_movie->id), *out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -891,7 +925,7 @@ isx_movie_get_acquisition_info_size(
 {
     return isx_process_op([=]()
     {
-        const std::string info_str = isx_get_acquisition_info_internal(g_open_movies[in_movie->id]);
+        const std::string info_str = isx_get_acquisition_info_internal(g_open_movies.get(in_movie->id));
         *out_acquisition_info_size = info_str.size() + 1;
     });
 }
@@ -905,7 +939,7 @@ isx_movie_get_frame_timestamp(
 {
     return isx_process_op([=]()
     {
-        const isx::SpMovie_t movie = g_open_movies[in_movie->id];
+        const isx::SpMovie_t movie = g_open_movies.get(in_movie->id);
         if (!movie->hasFrameTimestamps())
         {
             ISX_THROW(isx::ExceptionUserInput, "No frame timestamps stored in movie.");
@@ -933,11 +967,8 @@ isx_read_cell_set(
 
         isx::SpCellSet_t cell_set = isx::readCellSet(in_file_path, !in_read_only);
 
-        g_open_cell_sets[g_cell_set_id] = cell_set;
-
         *out_cell_set = new IsxCellSet;
 
-        (*out_cell_set)->id = size_t(g_cell_set_id);
         (*out_cell_set)->read_only = in_read_only;
         (*out_cell_set)->roi_set = cell_set->isRoiSet();
         (*out_cell_set)->num_cells = size_t(cell_set->getNumCells());
@@ -946,7 +977,7 @@ isx_read_cell_set(
         convert_timing_info_cpp_to_c(cell_set->getTimingInfo(), &((*out_cell_set)->timing));
         convert_spacing_info_cpp_to_c(cell_set->getSpacingInfo(), &((*out_cell_set)->spacing));
 
-        g_cell_set_id++;
+        (*out_cell_set)->id = g_open_cell_sets.add(cell_set);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_cell_set);
@@ -983,7 +1014,7 @@ isx_cell_set_get_trace(
 {
     return isx_process_op([=]()
     {
-        const isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+        const isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
         isx_check_cell_index(in_index, cell_set->getNumCells());
         const isx::TimingInfo & ti = cell_set->getTimingInfo();
         const isx::SpFTrace_t trace = cell_set->getTrace(isx::isize_t(in_index));
@@ -1004,7 +1035,7 @@ isx_cell_set_get_image(
 {
     return isx_process_op([=]()
     {
-        const isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+        const isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
         isx_check_cell_index(in_index, cell_set->getNumCells());
         const isx::SpImage_t image = cell_set->getImage(isx::isize_t(in_index));
         const size_t num_pixels = image->getSpacingInfo().getTotalNumPixels();
@@ -1034,11 +1065,8 @@ isx_write_cell_set(
 
         isx::SpCellSet_t cell_set = isx::writeCellSet(in_file_path, timing, spacing, in_roi_set);
 
-        g_open_cell_sets[g_cell_set_id] = cell_set;
-
         *out_cell_set = new IsxCellSet;
 
-        (*out_cell_set)->id = size_t(g_cell_set_id);
         (*out_cell_set)->roi_set = in_roi_set;
         (*out_cell_set)->read_only = false;
         (*out_cell_set)->num_cells = 0;
@@ -1048,7 +1076,7 @@ isx_write_cell_set(
         convert_timing_info_cpp_to_c(timing, &((*out_cell_set)->timing));
         convert_spacing_info_cpp_to_c(spacing, &((*out_cell_set)->spacing));
 
-        g_cell_set_id++;
+        (*out_cell_set)->id = g_open_cell_sets.add(cell_set);
     });
 
     return ret_code;
@@ -1075,7 +1103,7 @@ isx_cell_set_delete(
         if (in_cell_set != nullptr)
         {
             isx_cell_set_flush_internal(in_cell_set);
-            g_open_cell_sets.erase(in_cell_set->id);
+            g_open_cell_sets.remove(in_cell_set->id);
             delete_timing(in_cell_set->timing);
             delete in_cell_set->file_path;
             delete in_cell_set;
@@ -1092,7 +1120,7 @@ isx_cell_set_get_status(
 {
     return isx_process_op([=]()
     {
-        isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+        isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
         isx_check_cell_index(in_index, cell_set->getNumCells());
         *out_status = int(cell_set->getCellStatus(isx::isize_t(in_index)));
     });
@@ -1107,7 +1135,7 @@ isx_cell_set_set_status(
 {
     return isx_process_op([=]()
     {
-        isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+        isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
         isx_check_cell_index(in_index, cell_set->getNumCells());
         cell_set->setCellStatus(isx::isize_t(in_index), isx::CellSet::CellStatus(in_status));
     });
@@ -1126,7 +1154,7 @@ isx_cell_set_write_image_trace(
     {
         if (!in_cell_set->read_only)
         {
-            isx::SpCellSet_t cell_set = g_open_cell_sets[in_cell_set->id];
+            isx::SpCellSet_t cell_set = g_open_cell_sets.get(in_cell_set->id);
             const auto si = cell_set->getSpacingInfo();
             const auto ti = cell_set->getTimingInfo();
 
@@ -1162,7 +1190,7 @@ isx_cell_set_get_acquisition_info(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_cell_sets[in_cell_set->id], out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_cell_sets.get(in_cell_set->id), out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -1176,7 +1204,7 @@ isx_cell_set_get_acquisition_info_for_matlab(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_cell_sets[in_cell_set->id], *out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_cell_sets.get(in_cell_set->id), *out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -1189,7 +1217,7 @@ isx_cell_set_get_acquisition_info_size(
 {
     return isx_process_op([=]()
     {
-        const std::string info_str = isx_get_acquisition_info_internal(g_open_cell_sets[in_cell_set->id]);
+        const std::string info_str = isx_get_acquisition_info_internal(g_open_cell_sets.get(in_cell_set->id));
         *out_acquisition_info_size = info_str.size() + 1;
     });
 }
@@ -1210,18 +1238,15 @@ isx_read_events(
 
         isx::SpEvents_t events = isx::readEvents(in_file_path);
 
-        g_open_events[g_events_id] = events;
-
         *out_events = new IsxEvents;
 
-        (*out_events)->id = size_t(g_events_id);
         (*out_events)->num_cells = size_t(events->numberOfCells());
         (*out_events)->read_only = true;
         (*out_events)->file_path = make_canonical_file_path(in_file_path);
 
         convert_timing_info_cpp_to_c(events->getTimingInfo(), &((*out_events)->timing));
 
-        g_events_id++;
+        (*out_events)->id = g_open_events.add(events);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_events);
@@ -1252,11 +1277,8 @@ isx_write_events(
         isx::SpWritableEvents_t events = isx::writeEvents(in_file_path, channels, steps);
         events->setTimingInfo(timing);
 
-        g_open_writable_events[g_writable_events_id] = events;
-
         *out_events = new IsxEvents;
 
-        (*out_events)->id = size_t(g_writable_events_id);
         (*out_events)->read_only = false;
         (*out_events)->num_cells = in_num_channels;
         (*out_events)->file_path = make_canonical_file_path(in_file_path);
@@ -1265,7 +1287,7 @@ isx_write_events(
         // things in the input struct.
         convert_timing_info_cpp_to_c(timing, &((*out_events)->timing));
 
-        g_writable_events_id++;
+        (*out_events)->id = g_open_writable_events.add(events);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_events);
@@ -1283,12 +1305,12 @@ isx_events_get_cell_count(
         *out_count = 0;
         if (in_events->read_only)
         {
-            auto event = g_open_events[in_events->id];
+            auto event = g_open_events.get(in_events->id);
             auto trace = event->getLogicalData(in_name);
 
-            std::pair<isx::isize_t, std::string> trace_info(in_events->id, in_name);
+            const LogicalTraceKey_t trace_info(in_events->id, in_name);
 
-            g_open_logical_traces[trace_info] = trace;
+            g_open_events_traces.set(trace_info, trace);
 
             *out_count = trace->getValues().size();
         }
@@ -1307,11 +1329,16 @@ isx_events_get_cell(
     {
         if (in_events->read_only)
         {
-            const isx::SpEvents_t events = g_open_events[in_events->id];
+            const isx::SpEvents_t events = g_open_events.get(in_events->id);
             const isx::Time start = events->getTimingInfo().getStart();
 
-            std::pair<isx::isize_t, std::string> trace_info(in_events->id, in_name);
-            auto trace = g_open_logical_traces[trace_info];
+            // The trace is read again if it was not kept when getting its count.
+            const LogicalTraceKey_t trace_info(in_events->id, in_name);
+            isx::SpLogicalTrace_t trace;
+            if (!g_open_events_traces.take(trace_info, trace))
+            {
+                trace = events->getLogicalData(in_name);
+            }
 
             std::map<isx::Time, float> values = trace->getValues();
             size_t index = 0;
@@ -1326,8 +1353,57 @@ isx_events_get_cell(
                 out_values[index] = value.second;
                 index++;
             }
+        }
+    });
+}
 
-            g_open_logical_traces.erase(trace_info);
+int
+isx_events_get_all_cells_count(
+    IsxEvents * in_events,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t * out_count
+)
+{
+    return isx_process_op([=]()
+    {
+        *out_count = 0;
+        if (in_events->read_only)
+        {
+            auto events = g_open_events.get(in_events->id);
+            OpenLogicalTraceTable open_table;
+            open_table.start_usecs = in_start_usecs;
+            open_table.end_usecs = in_end_usecs;
+            open_table.table = events->getAllLogicalData(in_start_usecs, in_end_usecs);
+            *out_count = open_table.table.m_values.size();
+            g_open_events_tables.set(in_events->id, std::move(open_table));
+        }
+    });
+}
+
+int
+isx_events_get_all_cells(
+    IsxEvents * in_events,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t in_buffer_size,
+    int64_t * out_usecs_since_start,
+    float * out_values,
+    size_t * out_cell_starts
+)
+{
+    return isx_process_op([=]()
+    {
+        if (in_events->read_only)
+        {
+            const isx::SpEvents_t events = g_open_events.get(in_events->id);
+            const isx::LogicalTraceTable table = isx_take_logical_trace_table(
+                g_open_events_tables, in_events->id, in_start_usecs, in_end_usecs,
+                [&events, in_start_usecs, in_end_usecs]()
+                {
+                    return events->getAllLogicalData(in_start_usecs, in_end_usecs);
+                });
+            isx_copy_logical_trace_table(table, in_buffer_size, out_usecs_since_start, out_values, out_cell_starts);
         }
     });
 }
@@ -1367,7 +1443,7 @@ isx_events_write_cell(
     {
         if (!in_events->read_only)
         {
-            auto events = g_open_writable_events[in_events->id];
+            auto events = g_open_writable_events.get(in_events->id);
             for (size_t e = 0; e < in_num_packets; e++)
             {
                 events->writeDataPkt(in_index, in_usecs_since_start[e], in_values[e]);
@@ -1399,11 +1475,16 @@ isx_events_delete(
             isx_events_flush_internal(in_events);
             if (in_events->read_only)
             {
-                g_open_events.erase(in_events->id);
+                g_open_events.remove(in_events->id);
+                g_open_events_tables.erase(in_events->id);
+                g_open_events_traces.erase_if([in_events](const LogicalTraceKey_t & in_key)
+                {
+                    return in_key.first == in_events->id;
+                });
             }
             else
             {
-                g_open_writable_events.erase(in_events->id);
+                g_open_writable_events.remove(in_events->id);
             }
             delete_timing(in_events->timing);
             delete in_events->file_path;
@@ -1422,7 +1503,7 @@ isx_events_get_acquisition_info(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_events[in_events->id], out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_events.get(in_events->id), out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -1436,7 +1517,7 @@ isx_events_get_acquisition_info_for_matlab(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_events[in_events->id], *out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_events.get(in_events->id), *out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -1449,7 +1530,7 @@ isx_events_get_acquisition_info_size(
 {
     return isx_process_op([=]()
     {
-        const std::string info_str = isx_get_acquisition_info_internal(g_open_events[in_events->id]);
+        const std::string info_str = isx_get_acquisition_info_internal(g_open_events.get(in_events->id));
         *out_acquisition_info_size = info_str.size() + 1;
     });
 }
@@ -1469,18 +1550,15 @@ isx_read_gpio(
         isx_check_input_file_path(in_file_path, {isx::DataSet::Type::GPIO, isx::DataSet::Type::IMU});
         isx::SpGpio_t gpio = isx::readGpio(in_file_path);
 
-        g_open_gpios[g_gpio_id] = gpio;
-
         *out_gpio = new IsxGpio;
 
-        (*out_gpio)->id = size_t(g_gpio_id);
         (*out_gpio)->num_channels = size_t(gpio->numberOfChannels());
         (*out_gpio)->read_only = true;
         (*out_gpio)->file_path = make_canonical_file_path(in_file_path);
 
         convert_timing_info_cpp_to_c(gpio->getTimingInfo(), &((*out_gpio)->timing));
 
-        g_gpio_id++;
+        (*out_gpio)->id = g_open_gpios.add(gpio);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_gpio);
@@ -1498,12 +1576,12 @@ isx_gpio_get_channel_count(
         *out_count = 0;
         if (in_gpio->read_only)
         {
-            auto gpio = g_open_gpios[in_gpio->id];
+            auto gpio = g_open_gpios.get(in_gpio->id);
             auto trace = gpio->getLogicalData(in_name);
 
-            std::pair<isx::isize_t, std::string> trace_info(in_gpio->id, in_name);
+            const LogicalTraceKey_t trace_info(in_gpio->id, in_name);
 
-            g_open_logical_traces[trace_info] = trace;
+            g_open_gpio_traces.set(trace_info, trace);
 
             *out_count = trace->getValues().size();
         }
@@ -1522,11 +1600,16 @@ isx_gpio_get_channel(
     {
         if (in_gpio->read_only)
         {
-            const isx::SpGpio_t gpio = g_open_gpios[in_gpio->id];
+            const isx::SpGpio_t gpio = g_open_gpios.get(in_gpio->id);
             const isx::Time start = gpio->getTimingInfo().getStart();
 
-            std::pair<isx::isize_t, std::string> trace_info(in_gpio->id, in_name);
-            auto trace = g_open_logical_traces[trace_info];
+            // The trace is read again if it was not kept when getting its count.
+            const LogicalTraceKey_t trace_info(in_gpio->id, in_name);
+            isx::SpLogicalTrace_t trace;
+            if (!g_open_gpio_traces.take(trace_info, trace))
+            {
+                trace = gpio->getLogicalData(in_name);
+            }
 
             std::map<isx::Time, float> values = trace->getValues();
             size_t index = 0;
@@ -1541,8 +1624,57 @@ isx_gpio_get_channel(
                 out_values[index] = value.second;
                 index++;
             }
+        }
+    });
+}
+
+int
+isx_gpio_get_all_channels_count(
+    IsxGpio * in_gpio,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t * out_count
+)
+{
+    return isx_process_op([=]()
+    {
+        *out_count = 0;
+        if (in_gpio->read_only)
+        {
+            auto gpio = g_open_gpios.get(in_gpio->id);
+            OpenLogicalTraceTable open_table;
+            open_table.start_usecs = in_start_usecs;
+            open_table.end_usecs = in_end_usecs;
+            open_table.table = gpio->getAllLogicalData(in_start_usecs, in_end_usecs);
+            *out_count = open_table.table.m_values.size();
+            g_open_gpio_tables.set(in_gpio->id, std::move(open_table));
+        }
+    });
+}
 
-            g_open_logical_traces.erase(trace_info);
+int
+isx_gpio_get_all_channels(
+    IsxGpio * in_gpio,
+    int64_t in_start_usecs,
+    int64_t in_end_usecs,
+    size_t in_buffer_size,
+    int64_t * out_usecs_since_start,
+    float * out_values,
+    size_t * out_channel_starts
+)
+{
+    return isx_process_op([=]()
+    {
+        if (in_gpio->read_only)
+        {
+            const isx::SpGpio_t gpio = g_open_gpios.get(in_gpio->id);
+            const isx::LogicalTraceTable table = isx_take_logical_trace_table(
+                g_open_gpio_tables, in_gpio->id, in_start_usecs, in_end_usecs,
+                [&gpio, in_start_usecs, in_end_usecs]()
+                {
+                    return gpio->getAllLogicalData(in_start_usecs, in_end_usecs);
+                });
+            isx_copy_logical_trace_table(table, in_buffer_size, out_usecs_since_start, out_values, out_channel_starts);
         }
     });
 }
@@ -1557,7 +1689,7 @@ isx_gpio_get_channel_name(
 {
     return isx_process_op([=]()
     {
-        const isx::SpGpio_t gpio = g_open_gpios[in_gpio->id];
+        const isx::SpGpio_t gpio = g_open_gpios.get(in_gpio->id);
         isx_check_channel_index(in_index, gpio->numberOfChannels());
         const std::string channel_name = gpio->getChannelList().at(in_index);
         isx::copyCppStringToCString(channel_name, out_channel_name, in_channel_name_size);
@@ -1573,7 +1705,12 @@ isx_gpio_delete(
     {
         if (in_gpio != nullptr)
         {
-            g_open_gpios.erase(in_gpio->id);
+            g_open_gpios.remove(in_gpio->id);
+            g_open_gpio_tables.erase(in_gpio->id);
+            g_open_gpio_traces.erase_if([in_gpio](const LogicalTraceKey_t & in_key)
+            {
+                return in_key.first == in_gpio->id;
+            });
             delete_timing(in_gpio->timing);
             delete in_gpio->file_path;
             delete in_gpio;
@@ -1591,7 +1728,7 @@ isx_gpio_get_acquisition_info(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_gpios[in_gpio->id], out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_gpios.get(in_gpio->id), out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -1604,7 +1741,7 @@ isx_gpio_get_acquisition_info_size(
 {
     return isx_process_op([=]()
     {
-        const std::string info_str = isx_get_acquisition_info_internal(g_open_gpios[in_gpio->id]);
+        const std::string info_str = isx_get_acquisition_info_internal(g_open_gpios.get(in_gpio->id));
         *out_acquisition_info_size = info_str.size() + 1;
     });
 }
@@ -1626,11 +1763,8 @@ isx_read_vessel_set(
 
         isx::SpVesselSet_t vessel_set = isx::readVesselSet(in_file_path, !in_read_only);
 
-        g_open_vessel_sets[g_vessel_set_id] = vessel_set;
-
         *out_vessel_set = new IsxVesselSet;
 
-        (*out_vessel_set)->id = size_t(g_vessel_set_id);
         (*out_vessel_set)->read_only = in_read_only;
         (*out_vessel_set)->num_vessels = size_t(vessel_set->getNumVessels());
         (*out_vessel_set)->file_path = make_canonical_file_path(in_file_path);
@@ -1638,7 +1772,7 @@ isx_read_vessel_set(
         convert_timing_info_cpp_to_c(vessel_set->getTimingInfo(), &((*out_vessel_set)->timing));
         convert_spacing_info_cpp_to_c(vessel_set->getSpacingInfo(), &((*out_vessel_set)->spacing));
 
-        g_vessel_set_id++;
+        (*out_vessel_set)->id = g_open_vessel_sets.add(vessel_set);
     });
 
     return isx_checked_delete_and_nullify(ret_code, *out_vessel_set);
@@ -1675,7 +1809,7 @@ isx_vessel_set_get_trace(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         const isx::TimingInfo & ti = vessel_set->getTimingInfo();
         const isx::SpFTrace_t trace = vessel_set->getTrace(isx::isize_t(in_index));
@@ -1696,7 +1830,7 @@ isx_vessel_set_get_image(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         const isx::SpImage_t image = vessel_set->getImage(isx::isize_t(in_index));
         const size_t num_pixels = image->getSpacingInfo().getTotalNumPixels();
@@ -1717,7 +1851,7 @@ isx_vessel_set_get_line_endpoints(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         const isx::SpImage_t image = vessel_set->getImage(isx::isize_t(in_index));
         const isx::SpVesselLine_t line_endpoints = vessel_set->getLineEndpoints(isx::isize_t(in_index));
@@ -1744,7 +1878,7 @@ isx_vessel_set_get_type(
 {
     return isx_process_op([=]()
     {
-        isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         *type = int(vessel_set->getVesselSetType());
     });
 }
@@ -1758,7 +1892,7 @@ isx_vessel_set_get_center_trace(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         const isx::TimingInfo & ti = vessel_set->getTimingInfo();
         const isx::SpFTrace_t trace = vessel_set->getCenterTrace(isx::isize_t(in_index));
@@ -1783,7 +1917,7 @@ isx_vessel_set_get_direction_trace(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         const isx::TimingInfo & ti = vessel_set->getTimingInfo();
         const isx::SpFTrace_t trace = vessel_set->getDirectionTrace(isx::isize_t(in_index));
@@ -1807,7 +1941,7 @@ isx_vessel_set_is_correlation_saved(
 {
     return isx_process_op([=]()
     {
-        isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         *out_saved = static_cast<int>(vessel_set->isCorrelationSaved());
     });
 }
@@ -1821,7 +1955,7 @@ isx_vessel_set_get_correlation_size(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         if (!vessel_set->isCorrelationSaved())
         {
@@ -1844,7 +1978,7 @@ isx_vessel_set_get_correlations(
 {
     return isx_process_op([=]()
     {
-        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        const isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         if (!vessel_set->isCorrelationSaved())
         {
@@ -1880,11 +2014,8 @@ isx_write_vessel_set(
 
         isx::SpVesselSet_t vessel_set = isx::writeVesselSet(in_file_path, timing, spacing, type);
 
-        g_open_vessel_sets[g_vessel_set_id] = vessel_set;
-
         *out_vessel_set = new IsxVesselSet;
 
-        (*out_vessel_set)->id = size_t(g_vessel_set_id);
         (*out_vessel_set)->read_only = false;
         (*out_vessel_set)->num_vessels = 0;
         (*out_vessel_set)->file_path = make_canonical_file_path(in_file_path);
@@ -1893,7 +2024,7 @@ isx_write_vessel_set(
         convert_timing_info_cpp_to_c(timing, &((*out_vessel_set)->timing));
         convert_spacing_info_cpp_to_c(spacing, &((*out_vessel_set)->spacing));
 
-        g_vessel_set_id++;
+        (*out_vessel_set)->id = g_open_vessel_sets.add(vessel_set);
     });
 
     return ret_code;
@@ -1920,7 +2051,7 @@ isx_vessel_set_delete(
         if (in_vessel_set != nullptr)
         {
             isx_vessel_set_flush_internal(in_vessel_set);
-            g_open_vessel_sets.erase(in_vessel_set->id);
+            g_open_vessel_sets.remove(in_vessel_set->id);
             delete_timing(in_vessel_set->timing);
             delete in_vessel_set->file_path;
             delete in_vessel_set;
@@ -1937,7 +2068,7 @@ isx_vessel_set_get_status(
 {
     return isx_process_op([=]()
     {
-        isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         *out_status = int(vessel_set->getVesselStatus(isx::isize_t(in_index)));
     });
@@ -1952,7 +2083,7 @@ isx_vessel_set_set_status(
 {
     return isx_process_op([=]()
     {
-        isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+        isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
         isx_check_vessel_index(in_index, vessel_set->getNumVessels());
         vessel_set->setVesselStatus(isx::isize_t(in_index), isx::VesselSet::VesselStatus(in_status));
     });
@@ -1973,7 +2104,7 @@ isx_vessel_set_write_vessel_diameter_data(
     {
         if (!in_vessel_set->read_only)
         {
-            isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+            isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
             const auto si = vessel_set->getSpacingInfo();
             const auto ti = vessel_set->getTimingInfo();
 
@@ -2031,7 +2162,7 @@ isx_vessel_set_write_rbc_velocity_data(
     {
         if (!in_vessel_set->read_only)
         {
-            isx::SpVesselSet_t vessel_set = g_open_vessel_sets[in_vessel_set->id];
+            isx::SpVesselSet_t vessel_set = g_open_vessel_sets.get(in_vessel_set->id);
             const auto si = vessel_set->getSpacingInfo();
             const auto ti = vessel_set->getTimingInfo();
 
@@ -2102,7 +2233,7 @@ isx_vessel_set_get_acquisition_info(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_vessel_sets[in_vessel_set->id], out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_vessel_sets.get(in_vessel_set->id), out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -2116,7 +2247,7 @@ isx_vessel_set_get_acquisition_info_for_matlab(
 {
     return isx_process_op([=]()
     {
-        isx_get_acquisition_info_internal(g_open_vessel_sets[in_vessel_set->id], *out_acquisition_info, in_acquisition_info_size);
+        isx_get_acquisition_info_internal(g_open_vessel_sets.get(in_vessel_set->id), *out_acquisition_info, in_acquisition_info_size);
     });
 }
 
@@ -2129,7 +2260,7 @@ isx_vessel_set_get_acquisition_info_size(
 {
     return isx_process_op([=]()
     {
-        const std::string info_str = isx_get_acquisition_info_internal(g_open_vessel_sets[in_vessel_set->id]);
+        const std::string info_str = isx_get_acquisition_info_internal(g_open_vessel_sets.get(in_vessel_set->id));
         *out_acquisition_info_size = info_str.size() + 1;
     });
 }
@@ -0,0 +1,244 @@
+#ifndef ISX_HANDLE_REGISTRY_C_H
+#define ISX_HANDLE_REGISTRY_C_H
+
+#include "isxException.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// A thread-safe table of the objects opened through the C API, which are
+/// referred to by the ids of their C structs.
+///
+/// The table is split into shards that each have their own mutex, so calls
+/// on different objects from different threads rarely wait for each other.
+/// A lookup only holds the mutex of its shard while it copies the shared
+/// pointer, so reading from an object does not block other lookups.
+///
+/// The low half of the bits of an id is the index of its slot and the high
+/// half is the generation of the slot, which changes every time an object
+/// is removed from it. An id of a removed object is therefore never
+/// confused with the id of an object that later reuses its slot.
+template <typename T>
+class IsxHandleRegistry
+{
+public:
+
+    /// \param  in_name     The name of the type of the objects, which is used in error messages.
+    explicit IsxHandleRegistry(const std::string & in_name)
+        : m_name(in_name)
+    {
+    }
+
+    IsxHandleRegistry(const IsxHandleRegistry &) = delete;
+    IsxHandleRegistry & operator=(const IsxHandleRegistry &) = delete;
+
+    /// Add an object to the table.
+    ///
+    /// \param  in_object   The object to add.
+    /// \return             The id of the object.
+    size_t
+    add(T in_object)
+    {
+        const size_t shard_index = m_next_shard++ % s_num_shards;
+        Shard & shard = m_shards[shard_index];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        size_t index_in_shard = 0;
+        if (shard.free_slots.empty())
+        {
+            index_in_shard = shard.slots.size();
+            shard.slots.emplace_back();
+        }
+        else
+        {
+            index_in_shard = shard.free_slots.back();
+            shard.free_slots.pop_back();
+        }
+
+        const size_t slot_index = index_in_shard * s_num_shards + shard_index;
+        if (slot_index > s_slot_mask)
+        {
+            shard.free_slots.push_back(index_in_shard);
+            ISX_THROW(isx::ExceptionUserInput, "Too many ", m_name, " objects are open.");
+        }
+
+        Slot & slot = shard.slots[index_in_shard];
+        slot.object = std::move(in_object);
+        slot.used = true;
+        return (slot.generation << s_slot_bits) | slot_index;
+    }
+
+    /// \param  in_id   The id of an object.
+    /// \return         The object.
+    /// \throw  isx::ExceptionUserInput If there is no object with the id, usually because it was deleted.
+    T
+    get(const size_t in_id) const
+    {
+        const size_t slot_index = in_id & s_slot_mask;
+        const Shard & shard = m_shards[slot_index % s_num_shards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const Slot * slot = find_slot(shard, in_id);
+        if (slot == nullptr)
+        {
+            ISX_THROW(isx::ExceptionUserInput, "The ", m_name, " with id ", in_id, " is not open.");
+        }
+        return slot->object;
+    }
+
+    /// Remove an object from the table.
+    ///
+    /// The object is returned, so that it is destroyed after the mutex
+    /// of its shard is released if this held the last reference to it.
+    ///
+    /// \param  in_id   The id of the object.
+    /// \return         The removed object, or an empty one if there was no object with the id.
+    T
+    remove(const size_t in_id)
+    {
+        const size_t slot_index = in_id & s_slot_mask;
+        Shard & shard = m_shards[slot_index % s_num_shards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Slot * slot = const_cast<Slot *>(find_slot(shard, in_id));
+        if (slot == nullptr)
+        {
+            return T();
+        }
+
+        T object = std::move(slot->object);
+        slot->object = T();
+        slot->used = false;
+        slot->generation = (slot->generation >= s_max_generation) ? 1 : (slot->generation + 1);
+        shard.free_slots.push_back(slot_index / s_num_shards);
+        return object;
+    }
+
+    /// \return The number of objects in the table.
+    ///
+    size_t
+    size() const
+    {
+        size_t num_objects = 0;
+        for (const Shard & shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            num_objects += shard.slots.size() - shard.free_slots.size();
+        }
+        return num_objects;
+    }
+
+private:
+
+    static const size_t s_num_shards = 16;
+    static const size_t s_slot_bits = sizeof(size_t) * 4;
+    static const size_t s_slot_mask = (size_t(1) << s_slot_bits) - 1;
+    static const size_t s_max_generation = s_slot_mask;
+
+    struct Slot
+    {
+        /// Generations start at 1, so 0 is never a valid id.
+        size_t generation = 1;
+        T object;
+        bool used = false;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<Slot> slots;
+        std::vector<size_t> free_slots;
+    };
+
+    /// Only called with the mutex of the shard held.
+    static
+    const Slot *
+    find_slot(const Shard & in_shard, const size_t in_id)
+    {
+        const size_t index_in_shard = (in_id & s_slot_mask) / s_num_shards;
+        if (index_in_shard >= in_shard.slots.size())
+        {
+            return nullptr;
+        }
+        const Slot & slot = in_shard.slots[index_in_shard];
+        if (!slot.used || slot.generation != (in_id >> s_slot_bits))
+        {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    const std::string m_name;
+    std::array<Shard, s_num_shards> m_shards;
+    std::atomic<size_t> m_next_shard{0};
+};
+
+/// A map guarded by a mutex, for the data that the C API keeps between
+/// two calls on an object (e.g. a trace read when getting its size).
+template <typename K, typename V>
+class IsxLockedMap
+{
+public:
+
+    /// Set the value of a key, replacing any previous value.
+    ///
+    void
+    set(const K & in_key, V in_value)
+    {
+        V previous;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        V & value = m_map[in_key];
+        previous = std::move(value);
+        value = std::move(in_value);
+    }
+
+    /// Remove the value of a key.
+    ///
+    /// \param  in_key      The key.
+    /// \param  out_value   The removed value.
+    /// \return             True if the key had a value.
+    bool
+    take(const K & in_key, V & out_value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_map.find(in_key);
+        if (it == m_map.end())
+        {
+            return false;
+        }
+        out_value = std::move(it->second);
+        m_map.erase(it);
+        return true;
+    }
+
+    /// Remove the value of a key, if it has one.
+    ///
+    void
+    erase(const K & in_key)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_map.erase(in_key);
+    }
+
+    /// Remove the values of all the keys that match a predicate.
+    ///
+    void
+    erase_if(const std::function<bool(const K &)> & in_predicate)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_map.begin(); it != m_map.end();)
+        {
+            it = in_predicate(it->first) ? m_map.erase(it) : std::next(it);
+        }
+    }
+
+private:
+
+    std::mutex m_mutex;
+    std::map<K, V> m_map;
+};
+
+#endif // ISX_HANDLE_REGISTRY_C_H
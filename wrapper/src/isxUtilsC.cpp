@@ -6,7 +6,9 @@
 
 namespace
 {
-    std::string g_last_exception_string;
+    // Each thread has its own last exception, so that concurrent calls
+    // through the C API do not overwrite each other's error messages.
+    thread_local std::string g_last_exception_string;
 }
 
 std::unique_ptr<std::pair<int, std::string>> g_core_app_args;
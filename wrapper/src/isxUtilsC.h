@@ -7,9 +7,8 @@
 #include <functional>
 #include <QCoreApplication>
 
-// Note: This is not thread-safe. Multi-threaded invocation of the functions here will certainly break
-// this if there is more than one exception.  To make this thread-safe we'll need to design a different
-// API to retrieve the exception string that would probably also make this harder to use.
+// Note: The last exception string is kept per thread, so it must be retrieved
+// from the thread that called the function that failed.
 std::string &
 isx_get_last_exception_string_internal();
 
@@ -9,6 +9,10 @@ extern "C"
 #include "stdio.h"
 #include "json.hpp"
 #include <stdexcept>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("IsxMovie-read", "[corec]")
 {
@@ -303,3 +307,225 @@ TEST_CASE("IsxMovie-write_then_read", "[corec]")
 
     remove(file_path.c_str());
 }
+
+namespace
+{
+
+IsxTimingInfo
+make_test_timing_info(const size_t in_num_samples)
+{
+    IsxTimingInfo ti;
+    ti.num_samples = in_num_samples;
+    ti.start.secs_since_epoch.num = 1521586282;
+    ti.start.secs_since_epoch.den = 1000;
+    ti.start.utc_offset = 0;
+    ti.step.num = 50;
+    ti.step.den = 1000;
+    ti.num_dropped = 0;
+    ti.dropped = nullptr;
+    ti.num_cropped = 0;
+    ti.cropped_first = nullptr;
+    ti.cropped_last = nullptr;
+    return ti;
+}
+
+IsxSpacingInfo
+make_test_spacing_info(const size_t in_num_rows, const size_t in_num_cols)
+{
+    IsxSpacingInfo si;
+    si.num_rows = in_num_rows;
+    si.num_cols = in_num_cols;
+    si.pixel_width.num = 3;
+    si.pixel_width.den = 1;
+    si.pixel_height.num = 3;
+    si.pixel_height.den = 1;
+    si.left.num = 0;
+    si.left.den = 1;
+    si.top.num = 0;
+    si.top.den = 1;
+    return si;
+}
+
+float
+get_test_cell_value(const size_t in_file, const size_t in_cell, const size_t in_index)
+{
+    return float((in_file * 31 + in_cell * 7 + in_index) % 97);
+}
+
+} // namespace
+
+TEST_CASE("IsxCoreC-concurrent_readers", "[corec]")
+{
+    const size_t num_files = 4;
+    const size_t num_frames = 10;
+    const size_t num_cells = 3;
+    const size_t num_threads = 8;
+    const size_t num_iterations = 20;
+    const IsxTimingInfo ti = make_test_timing_info(num_frames);
+    const IsxSpacingInfo si = make_test_spacing_info(20, 30);
+    const size_t num_pixels = si.num_rows * si.num_cols;
+    const size_t max_frame_value = 4095;
+
+    std::vector<std::string> movie_file_paths;
+    std::vector<std::string> cell_set_file_paths;
+    for (size_t i = 0; i < num_files; ++i)
+    {
+        const std::string prefix = g_resources["unitTestDataPath"] + "/testcorec-concurrent_readers-" + std::to_string(i);
+        movie_file_paths.push_back(prefix + "-movie.isxd");
+        cell_set_file_paths.push_back(prefix + "-cellset.isxd");
+        remove(movie_file_paths.back().c_str());
+        remove(cell_set_file_paths.back().c_str());
+    }
+
+    REQUIRE(isx_initialize() == 0);
+
+    for (size_t i = 0; i < num_files; ++i)
+    {
+        IsxMovie * movie = nullptr;
+        REQUIRE(isx_write_movie(movie_file_paths[i].c_str(), ti, si, isx_get_data_type_u16(), false, &movie) == 0);
+        std::vector<uint16_t> frame(num_pixels);
+        for (size_t f = 0; f < num_frames; ++f)
+        {
+            for (size_t p = 0; p < num_pixels; ++p)
+            {
+                frame[p] = (uint16_t)hashFrameAndPixelIndex(f + i, p, max_frame_value);
+            }
+            REQUIRE(isx_movie_write_frame_u16(movie, f, frame.data()) == 0);
+        }
+        REQUIRE(isx_movie_delete(movie) == 0);
+
+        IsxCellSet * cell_set = nullptr;
+        REQUIRE(isx_write_cell_set(cell_set_file_paths[i].c_str(), ti, si, false, &cell_set) == 0);
+        std::vector<float> image(num_pixels);
+        std::vector<float> trace(num_frames);
+        for (size_t c = 0; c < num_cells; ++c)
+        {
+            for (size_t p = 0; p < num_pixels; ++p)
+            {
+                image[p] = get_test_cell_value(i, c, p);
+            }
+            for (size_t t = 0; t < num_frames; ++t)
+            {
+                trace[t] = get_test_cell_value(i, c, t);
+            }
+            const std::string name = "C" + std::to_string(c);
+            REQUIRE(isx_cell_set_write_image_trace(cell_set, c, image.data(), trace.data(), name.c_str()) == 0);
+        }
+        REQUIRE(isx_cell_set_delete(cell_set) == 0);
+    }
+
+    SECTION("Read shared handles while other handles are opened and deleted")
+    {
+        std::vector<IsxMovie *> movies(num_files, nullptr);
+        std::vector<IsxCellSet *> cell_sets(num_files, nullptr);
+        for (size_t i = 0; i < num_files; ++i)
+        {
+            REQUIRE(isx_read_movie(movie_file_paths[i].c_str(), &movies[i]) == 0);
+            REQUIRE(isx_read_cell_set(cell_set_file_paths[i].c_str(), true, &cell_sets[i]) == 0);
+        }
+
+        // Catch assertions are not thread-safe, so the threads only count their errors.
+        std::atomic<size_t> num_errors(0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                std::vector<uint16_t> frame(num_pixels);
+                std::vector<float> image(num_pixels);
+                std::vector<float> trace(num_frames);
+                for (size_t it = 0; it < num_iterations; ++it)
+                {
+                    const size_t i = (t + it) % num_files;
+                    const size_t f = (t * 3 + it) % num_frames;
+                    const size_t c = (t + it * 5) % num_cells;
+
+                    if (isx_movie_get_frame_data_u16(movies[i], f, frame.data()) != 0
+                        || frame[num_pixels - 1] != (uint16_t)hashFrameAndPixelIndex(f + i, num_pixels - 1, max_frame_value))
+                    {
+                        ++num_errors;
+                    }
+                    if (isx_cell_set_get_image(cell_sets[i], c, image.data()) != 0
+                        || image[num_pixels - 1] != get_test_cell_value(i, c, num_pixels - 1))
+                    {
+                        ++num_errors;
+                    }
+                    if (isx_cell_set_get_trace(cell_sets[i], c, trace.data()) != 0
+                        || trace[num_frames - 1] != get_test_cell_value(i, c, num_frames - 1))
+                    {
+                        ++num_errors;
+                    }
+
+                    // Churn the registry of movies while the shared ones are being read.
+                    IsxMovie * own_movie = nullptr;
+                    if (isx_read_movie(movie_file_paths[i].c_str(), &own_movie) != 0
+                        || isx_movie_get_frame_data_u16(own_movie, f, frame.data()) != 0
+                        || frame[0] != (uint16_t)hashFrameAndPixelIndex(f + i, 0, max_frame_value)
+                        || isx_movie_delete(own_movie) != 0)
+                    {
+                        ++num_errors;
+                    }
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(num_errors == 0);
+
+        for (size_t i = 0; i < num_files; ++i)
+        {
+            REQUIRE(isx_movie_delete(movies[i]) == 0);
+            REQUIRE(isx_cell_set_delete(cell_sets[i]) == 0);
+        }
+    }
+
+    SECTION("A handle that was deleted is not confused with one that reuses its slot")
+    {
+        IsxMovie * movie = nullptr;
+        REQUIRE(isx_read_movie(movie_file_paths[0].c_str(), &movie) == 0);
+        IsxMovie deleted_movie = *movie;
+        deleted_movie.timing.dropped = nullptr;
+        deleted_movie.timing.cropped_first = nullptr;
+        deleted_movie.timing.cropped_last = nullptr;
+        deleted_movie.file_path = nullptr;
+        REQUIRE(isx_movie_delete(movie) == 0);
+
+        // Handles are spread over 16 shards in turn, so opening one more handle than
+        // that reuses the slot of the deleted handle. The low half of the bits of
+        // an id is the index of its slot and the high half is its generation.
+        const size_t num_shards = 16;
+        const size_t slot_mask = (size_t(1) << (sizeof(size_t) * 4)) - 1;
+        std::vector<IsxMovie *> other_movies(num_shards + 1, nullptr);
+        IsxMovie * reusing_movie = nullptr;
+        for (size_t i = 0; i < other_movies.size(); ++i)
+        {
+            REQUIRE(isx_read_movie(movie_file_paths[i % num_files].c_str(), &other_movies[i]) == 0);
+            REQUIRE(other_movies[i]->id != deleted_movie.id);
+            if ((other_movies[i]->id & slot_mask) == (deleted_movie.id & slot_mask))
+            {
+                reusing_movie = other_movies[i];
+            }
+        }
+        REQUIRE(reusing_movie != nullptr);
+
+        std::vector<uint16_t> frame(num_pixels);
+        REQUIRE(isx_movie_get_frame_data_u16(&deleted_movie, 0, frame.data()) != 0);
+        REQUIRE(std::string(isx_get_last_exception_string()).find("is not open") != std::string::npos);
+        REQUIRE(isx_movie_get_frame_data_u16(reusing_movie, 0, frame.data()) == 0);
+
+        for (IsxMovie * other_movie : other_movies)
+        {
+            REQUIRE(isx_movie_delete(other_movie) == 0);
+        }
+    }
+
+    REQUIRE(isx_shutdown() == 0);
+
+    for (size_t i = 0; i < num_files; ++i)
+    {
+        remove(movie_file_paths[i].c_str());
+        remove(cell_set_file_paths[i].c_str());
+    }
+}